@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __APPS_EXAMPLES_FS_BENCHMARK_FS_BENCHMARK_H
+#define __APPS_EXAMPLES_FS_BENCHMARK_FS_BENCHMARK_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_EXAMPLES_FS_BENCHMARK_MOUNTPT
+#  define CONFIG_EXAMPLES_FS_BENCHMARK_MOUNTPT "/mnt"
+#endif
+
+#ifndef CONFIG_EXAMPLES_FS_BENCHMARK_FILES
+#  define CONFIG_EXAMPLES_FS_BENCHMARK_FILES 8
+#endif
+
+#ifndef CONFIG_EXAMPLES_FS_BENCHMARK_LOOKUPS
+#  define CONFIG_EXAMPLES_FS_BENCHMARK_LOOKUPS 1000
+#endif
+
+#ifdef CONFIG_EXAMPLES_FS_BENCHMARK_SMART
+#ifndef CONFIG_EXAMPLES_FS_BENCHMARK_SMART_MINOR
+#  define CONFIG_EXAMPLES_FS_BENCHMARK_SMART_MINOR 4
+#endif
+
+#ifndef CONFIG_EXAMPLES_FS_BENCHMARK_SMART_SIZE
+#  define CONFIG_EXAMPLES_FS_BENCHMARK_SMART_SIZE 512
+#endif
+
+#ifndef CONFIG_EXAMPLES_FS_BENCHMARK_SMART_READS
+#  define CONFIG_EXAMPLES_FS_BENCHMARK_SMART_READS 1000
+#endif
+
+#ifndef CONFIG_EXAMPLES_FS_BENCHMARK_SMART_WRITES
+#  define CONFIG_EXAMPLES_FS_BENCHMARK_SMART_WRITES 1000
+#endif
+
+#ifndef CONFIG_EXAMPLES_FS_BENCHMARK_SMART_PERIOD
+#  define CONFIG_EXAMPLES_FS_BENCHMARK_SMART_PERIOD 10
+#endif
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* fs_benchmark_main.c ******************************************************/
+
+uint64_t fs_bench_gettime(void);
+
+/* lookup.c *****************************************************************/
+
+int lookup_benchmark(int argc, FAR char *argv[]);
+
+#ifdef CONFIG_EXAMPLES_FS_BENCHMARK_SMART
+
+/* smartvol.c ***************************************************************/
+
+struct inode;
+FAR struct inode *smartvol_open(size_t size);
+void smartvol_close(FAR struct inode *inode);
+
+/* smartmap.c ***************************************************************/
+
+int smartmap_benchmark(int argc, FAR char *argv[]);
+
+/* smartwrite.c *************************************************************/
+
+int smartwrite_benchmark(int argc, FAR char *argv[]);
+
+/* smartgc.c ****************************************************************/
+
+int smartgc_benchmark(int argc, FAR char *argv[]);
+
+/* smartseq.c ***************************************************************/
+
+int smartseq_benchmark(int argc, FAR char *argv[]);
+#endif
+
+#endif /* __APPS_EXAMPLES_FS_BENCHMARK_FS_BENCHMARK_H */
@@ -0,0 +1,209 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/fs_benchmark/lookup.c
+ *
+ * Measures the rate of path lookups.  The benchmark creates a few files
+ * two directories below the test directory, then looks them up in turn
+ * with stat() and with open() and close(), and looks up files of the same
+ * directory that don't exist.  Each file holds a few sectors of data,
+ * since SMARTFS reads every sector of a file to find its length.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/stat.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "fs_benchmark.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define LOOKUP_NFILES       CONFIG_EXAMPLES_FS_BENCHMARK_FILES
+#define LOOKUP_NLOOKUPS     CONFIG_EXAMPLES_FS_BENCHMARK_LOOKUPS
+#define LOOKUP_FILESIZE     4096
+#define LOOKUP_PATHLEN      128
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+enum lookup_mode_e {
+	LOOKUP_STAT = 0,			/* stat() */
+	LOOKUP_OPEN					/* open() and close() */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static char g_lookup_dir[LOOKUP_PATHLEN];
+static char g_lookup_subdir[LOOKUP_PATHLEN];
+static char g_lookup_path[LOOKUP_PATHLEN];
+static char g_lookup_buffer[256];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static FAR const char *lookup_path(int index, bool exists)
+{
+	snprintf(g_lookup_path, LOOKUP_PATHLEN, "%s/%s%02d", g_lookup_subdir, exists ? "file" : "none", index);
+	return g_lookup_path;
+}
+
+static int lookup_create(int index)
+{
+	int written;
+	int fd;
+
+	fd = open(lookup_path(index, true), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	memset(g_lookup_buffer, 'a' + index % 26, sizeof(g_lookup_buffer));
+	for (written = 0; written < LOOKUP_FILESIZE; written += sizeof(g_lookup_buffer)) {
+		if (write(fd, g_lookup_buffer, sizeof(g_lookup_buffer)) != sizeof(g_lookup_buffer)) {
+			close(fd);
+			return -errno;
+		}
+	}
+
+	close(fd);
+	return OK;
+}
+
+static void lookup_cleanup(int nfiles)
+{
+	int i;
+
+	for (i = 0; i < nfiles; i++) {
+		(void)unlink(lookup_path(i, true));
+	}
+
+	(void)rmdir(g_lookup_subdir);
+	(void)rmdir(g_lookup_dir);
+}
+
+static void lookup_run(FAR const char *name, enum lookup_mode_e mode, bool exists)
+{
+	struct stat st;
+	FAR const char *path;
+	uint64_t start;
+	uint64_t elapsed;
+	uint32_t nerrors = 0;
+	int ret;
+	int fd;
+	int i;
+
+	start = fs_bench_gettime();
+	for (i = 0; i < LOOKUP_NLOOKUPS; i++) {
+		path = lookup_path(i % LOOKUP_NFILES, exists);
+
+		if (mode == LOOKUP_STAT) {
+			ret = stat(path, &st);
+			if (ret == OK && st.st_size != LOOKUP_FILESIZE) {
+				nerrors++;
+			}
+		} else {
+			fd = open(path, O_RDONLY);
+			ret = fd;
+			if (fd >= 0) {
+				close(fd);
+			}
+		}
+
+		if (exists ? ret < 0 : (ret >= 0 || errno != ENOENT)) {
+			nerrors++;
+		}
+	}
+
+	elapsed = fs_bench_gettime() - start;
+	if (elapsed == 0) {
+		elapsed = 1;
+	}
+
+	printf("%-12s | %8u | %6u | %6u\n", name,
+		   (unsigned int)(((uint64_t)LOOKUP_NLOOKUPS * 1000000) / elapsed),
+		   (unsigned int)(elapsed / LOOKUP_NLOOKUPS), nerrors);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int lookup_benchmark(int argc, FAR char *argv[])
+{
+	FAR const char *dir = argc > 1 ? argv[1] : CONFIG_EXAMPLES_FS_BENCHMARK_MOUNTPT;
+	int ret;
+	int i;
+
+	snprintf(g_lookup_dir, LOOKUP_PATHLEN, "%s/fsbench", dir);
+	snprintf(g_lookup_subdir, LOOKUP_PATHLEN, "%s/lookup", g_lookup_dir);
+
+	if (mkdir(g_lookup_dir, 0777) < 0 && errno != EEXIST) {
+		printf("Unable to create %s: %d\n", g_lookup_dir, errno);
+		return ERROR;
+	}
+
+	if (mkdir(g_lookup_subdir, 0777) < 0 && errno != EEXIST) {
+		printf("Unable to create %s: %d\n", g_lookup_subdir, errno);
+		(void)rmdir(g_lookup_dir);
+		return ERROR;
+	}
+
+	for (i = 0; i < LOOKUP_NFILES; i++) {
+		ret = lookup_create(i);
+		if (ret != OK) {
+			printf("Unable to create %s: %d\n", lookup_path(i, true), ret);
+			lookup_cleanup(i);
+			return ERROR;
+		}
+	}
+
+	printf("Lookup benchmark: %d files of %d bytes in %s, %d lookups per run\n", LOOKUP_NFILES, LOOKUP_FILESIZE, g_lookup_subdir, LOOKUP_NLOOKUPS);
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+	printf("SMARTFS directory entry cache: %d entries\n", CONFIG_SMARTFS_DIRENT_CACHE_SIZE);
+#else
+	printf("SMARTFS directory entry cache: disabled\n");
+#endif
+
+	printf("\n%-12s | %8s | %6s | %6s\n", "LOOKUP", "OPS/SEC", "US", "ERRORS");
+	printf("-------------|----------|--------|-------\n");
+
+	lookup_run("stat", LOOKUP_STAT, true);
+	lookup_run("stat ENOENT", LOOKUP_STAT, false);
+	lookup_run("open", LOOKUP_OPEN, true);
+	lookup_run("open ENOENT", LOOKUP_OPEN, false);
+
+	lookup_cleanup(LOOKUP_NFILES);
+	return OK;
+}
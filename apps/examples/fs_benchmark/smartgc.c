@@ -0,0 +1,177 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/fs_benchmark/smartgc.c
+ *
+ * Measures the distribution of the write latency of a SMART volume under a
+ * sustained write workload.  Three quarters of the free sectors of the
+ * volume are written, then sectors in random order are written again, one
+ * every CONFIG_EXAMPLES_FS_BENCHMARK_SMART_PERIOD milliseconds, so that
+ * the released sectors must be collected as the test goes.  Without
+ * CONFIG_MTD_SMART_BGGC, some writes collect blocks and take much longer
+ * than the others.  With it, the blocks are collected between the writes.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+#include <tinyara/fs/smart.h>
+
+#include "fs_benchmark.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define SMARTGC_SIZE        (CONFIG_EXAMPLES_FS_BENCHMARK_SMART_SIZE * 1024)
+#define SMARTGC_NWRITES     CONFIG_EXAMPLES_FS_BENCHMARK_SMART_WRITES
+#define SMARTGC_PERIOD      CONFIG_EXAMPLES_FS_BENCHMARK_SMART_PERIOD
+#define SMARTGC_DATASIZE    16
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int smartgc_compare(FAR const void *a, FAR const void *b)
+{
+	uint32_t x = *(FAR const uint32_t *)a;
+	uint32_t y = *(FAR const uint32_t *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+static int smartgc_write(FAR struct inode *inode, uint16_t sector, uint8_t value)
+{
+	struct smart_read_write_s req;
+	uint8_t data[SMARTGC_DATASIZE];
+
+	memset(data, value, SMARTGC_DATASIZE);
+	req.logsector = sector;
+	req.offset = 0;
+	req.count = SMARTGC_DATASIZE;
+	req.buffer = data;
+	return inode->u.i_bops->ioctl(inode, BIOC_WRITESECT, (unsigned long)&req);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int smartgc_benchmark(int argc, FAR char *argv[])
+{
+	struct smart_format_s fmt;
+	FAR struct inode *inode;
+	FAR uint16_t *sectors;
+	FAR uint32_t *latency;
+	uint64_t start;
+	uint32_t nerrors = 0;
+	int nsectors;
+	int ret = OK;
+	int i;
+
+	printf("SMART collection benchmark: %d random writes of %d bytes every %d ms\n", SMARTGC_NWRITES, SMARTGC_DATASIZE, SMARTGC_PERIOD);
+#ifdef CONFIG_MTD_SMART_BGGC
+	printf("Background collection below %d%% free sectors, %d blocks per step\n", CONFIG_MTD_SMART_BGGC_WATERMARK, CONFIG_MTD_SMART_BGGC_BLOCKS);
+#else
+	printf("Collection in the writes\n");
+#endif
+
+	latency = (FAR uint32_t *)malloc(SMARTGC_NWRITES * sizeof(uint32_t));
+	if (latency == NULL) {
+		printf("Unable to allocate %d latencies\n", SMARTGC_NWRITES);
+		return ERROR;
+	}
+
+	inode = smartvol_open(SMARTGC_SIZE);
+	if (inode == NULL) {
+		free(latency);
+		return ERROR;
+	}
+
+	ret = inode->u.i_bops->ioctl(inode, BIOC_GETFORMAT, (unsigned long)&fmt);
+	if (ret != OK) {
+		printf("BIOC_GETFORMAT failed: %d\n", ret);
+		goto errout_with_volume;
+	}
+
+	nsectors = fmt.nfreesectors * 3 / 4;
+	sectors = (FAR uint16_t *)malloc(nsectors * sizeof(uint16_t));
+	if (sectors == NULL) {
+		printf("Unable to allocate %d sectors\n", nsectors);
+		ret = ERROR;
+		goto errout_with_volume;
+	}
+
+	for (i = 0; i < nsectors; i++) {
+		ret = inode->u.i_bops->ioctl(inode, BIOC_ALLOCSECT, 0xFFFF);
+		if (ret < 0) {
+			break;
+		}
+
+		sectors[i] = (uint16_t)ret;
+		ret = smartgc_write(inode, sectors[i], 0);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	if (i < nsectors) {
+		printf("Unable to write sector %d: %d\n", i, ret);
+		ret = ERROR;
+		goto errout_with_sectors;
+	}
+
+	srand(1);
+	for (i = 0; i < SMARTGC_NWRITES; i++) {
+		usleep(SMARTGC_PERIOD * 1000);
+
+		start = fs_bench_gettime();
+		if (smartgc_write(inode, sectors[rand() % nsectors], i & 0xff) < 0) {
+			nerrors++;
+		}
+
+		latency[i] = (uint32_t)(fs_bench_gettime() - start);
+	}
+
+	qsort(latency, SMARTGC_NWRITES, sizeof(uint32_t), smartgc_compare);
+
+	printf("\n%7s | %6s | %6s | %6s | %6s\n", "SECTORS", "P50 US", "P99 US", "MAX US", "ERRORS");
+	printf("--------|--------|--------|--------|-------\n");
+	printf("%7d | %6u | %6u | %6u | %6u\n", fmt.nsectors, (unsigned int)latency[SMARTGC_NWRITES / 2],
+		   (unsigned int)latency[(SMARTGC_NWRITES * 99) / 100], (unsigned int)latency[SMARTGC_NWRITES - 1], nerrors);
+	ret = OK;
+
+errout_with_sectors:
+	free(sectors);
+
+errout_with_volume:
+	smartvol_close(inode);
+	free(latency);
+	return ret;
+}
@@ -0,0 +1,171 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/fs_benchmark/smartmap.c
+ *
+ * Measures the random read latency of SMART volumes of growing size, which
+ * shows the cost of the logical to physical sector map lookups of the mode
+ * of the driver: the full map, the sector cache of
+ * CONFIG_MTD_SMART_MINIMIZE_RAM or the map chunk cache of
+ * CONFIG_MTD_SMART_MAP_CACHE.  Three quarters of the free sectors of each
+ * volume are written, then read back in random order.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+#include <tinyara/fs/smart.h>
+
+#include "fs_benchmark.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define SMARTMAP_MINSIZE    (32 * 1024)
+#define SMARTMAP_MAXSIZE    (CONFIG_EXAMPLES_FS_BENCHMARK_SMART_SIZE * 1024)
+#define SMARTMAP_NREADS     CONFIG_EXAMPLES_FS_BENCHMARK_SMART_READS
+#define SMARTMAP_DATASIZE   16
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void smartmap_run(size_t size)
+{
+	struct smart_format_s fmt;
+	struct smart_read_write_s req;
+	FAR struct inode *inode;
+	FAR uint16_t *sectors;
+	uint8_t data[SMARTMAP_DATASIZE];
+	uint64_t start;
+	uint64_t elapsed;
+	uint32_t nerrors = 0;
+	int nsectors;
+	int index;
+	int ret;
+	int i;
+
+	inode = smartvol_open(size);
+	if (inode == NULL) {
+		return;
+	}
+
+	ret = inode->u.i_bops->ioctl(inode, BIOC_GETFORMAT, (unsigned long)&fmt);
+	if (ret != OK) {
+		printf("%6u KB | BIOC_GETFORMAT failed: %d\n", (unsigned int)(size / 1024), ret);
+		smartvol_close(inode);
+		return;
+	}
+
+	nsectors = fmt.nfreesectors * 3 / 4;
+	sectors = (FAR uint16_t *)malloc(nsectors * sizeof(uint16_t));
+	if (sectors == NULL) {
+		printf("%6u KB | unable to allocate %d sectors\n", (unsigned int)(size / 1024), nsectors);
+		smartvol_close(inode);
+		return;
+	}
+
+	/* Write the sectors, each with its index */
+
+	req.offset = 0;
+	req.count = SMARTMAP_DATASIZE;
+	req.buffer = data;
+	for (i = 0; i < nsectors; i++) {
+		ret = inode->u.i_bops->ioctl(inode, BIOC_ALLOCSECT, 0xFFFF);
+		if (ret < 0) {
+			break;
+		}
+
+		sectors[i] = (uint16_t)ret;
+		memset(data, i & 0xff, SMARTMAP_DATASIZE);
+		req.logsector = sectors[i];
+		if (inode->u.i_bops->ioctl(inode, BIOC_WRITESECT, (unsigned long)&req) < 0) {
+			break;
+		}
+	}
+
+	if (i < nsectors) {
+		printf("%6u KB | unable to write sector %d: %d\n", (unsigned int)(size / 1024), i, ret);
+		free(sectors);
+		smartvol_close(inode);
+		return;
+	}
+
+	/* Read them back in random order */
+
+	srand(1);
+	start = fs_bench_gettime();
+	for (i = 0; i < SMARTMAP_NREADS; i++) {
+		index = rand() % nsectors;
+		req.logsector = sectors[index];
+		ret = inode->u.i_bops->ioctl(inode, BIOC_READSECT, (unsigned long)&req);
+		if (ret < 0 || data[0] != (index & 0xff)) {
+			nerrors++;
+		}
+	}
+
+	elapsed = fs_bench_gettime() - start;
+	if (elapsed == 0) {
+		elapsed = 1;
+	}
+
+	printf("%6u KB | %7d | %8u | %6u | %6u\n", (unsigned int)(size / 1024), fmt.nsectors,
+		   (unsigned int)(((uint64_t)SMARTMAP_NREADS * 1000000) / elapsed),
+		   (unsigned int)(elapsed / SMARTMAP_NREADS), nerrors);
+
+	free(sectors);
+	smartvol_close(inode);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int smartmap_benchmark(int argc, FAR char *argv[])
+{
+	size_t size;
+
+	printf("SMART map benchmark: %d random reads per volume, ", SMARTMAP_NREADS);
+#if !defined(CONFIG_MTD_SMART_MINIMIZE_RAM)
+	printf("full sector map\n");
+#elif defined(CONFIG_MTD_SMART_MAP_CACHE)
+	printf("map cache of %d chunks\n", CONFIG_MTD_SMART_MAP_CACHE_CHUNKS);
+#else
+	printf("sector cache of %d entries\n", CONFIG_MTD_SMART_SECTOR_CACHE_SIZE);
+#endif
+
+	printf("\n%9s | %7s | %8s | %6s | %6s\n", "VOLUME", "SECTORS", "READS/S", "US", "ERRORS");
+	printf("----------|---------|----------|--------|-------\n");
+
+	for (size = SMARTMAP_MINSIZE; size <= SMARTMAP_MAXSIZE; size <<= 1) {
+		smartmap_run(size);
+	}
+
+	return OK;
+}
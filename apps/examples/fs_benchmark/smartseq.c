@@ -0,0 +1,216 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/fs_benchmark/smartseq.c
+ *
+ * Measures the sequential throughput of a SMART volume.  Three quarters of
+ * the free sectors of the volume are allocated in turn, which places them
+ * in adjacent physical sectors, and written in full.  They are then read
+ * and written again in order, one sector per ioctl, and with
+ * CONFIG_MTD_SMART_VECTORED_IO, SMARTSEQ_BATCH sectors per ioctl.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+#include <tinyara/fs/smart.h>
+
+#include "fs_benchmark.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define SMARTSEQ_SIZE       (CONFIG_EXAMPLES_FS_BENCHMARK_SMART_SIZE * 1024)
+#define SMARTSEQ_BATCH      16
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct inode *g_smartseq_inode;
+static FAR uint16_t *g_smartseq_sectors;
+static FAR uint8_t *g_smartseq_buffer;
+static int g_smartseq_nsectors;
+static uint16_t g_smartseq_datasize;
+static uint8_t g_smartseq_fill;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Reads or writes sectors [first, first + count) of the list with one
+ * ioctl per sector, or one vectored ioctl.  Returns the number of errors.
+ */
+
+static int smartseq_transfer(int first, int count, bool write, bool vectored)
+{
+	struct smart_read_write_s req[SMARTSEQ_BATCH];
+	FAR struct inode *inode = g_smartseq_inode;
+	int nerrors = 0;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		req[i].logsector = g_smartseq_sectors[first + i];
+		req[i].offset = 0;
+		req[i].count = g_smartseq_datasize;
+		req[i].buffer = &g_smartseq_buffer[i * g_smartseq_datasize];
+	}
+
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+	if (vectored) {
+		struct smart_multi_rw_s multi;
+
+		multi.sectors = req;
+		multi.nsectors = count;
+		if (inode->u.i_bops->ioctl(inode, write ? BIOC_WRITESECTS : BIOC_READSECTS, (unsigned long)&multi) < 0) {
+			nerrors++;
+		}
+
+		return nerrors;
+	}
+#endif
+
+	for (i = 0; i < count; i++) {
+		if (inode->u.i_bops->ioctl(inode, write ? BIOC_WRITESECT : BIOC_READSECT, (unsigned long)&req[i]) < 0) {
+			nerrors++;
+		}
+	}
+
+	return nerrors;
+}
+
+static void smartseq_run(FAR const char *name, bool write, bool vectored)
+{
+	uint64_t start;
+	uint64_t elapsed;
+	uint64_t nbytes;
+	int nerrors = 0;
+	int count;
+	int i;
+
+	/* Each write changes the data, so that the sectors are moved */
+
+	if (write) {
+		memset(g_smartseq_buffer, ++g_smartseq_fill, SMARTSEQ_BATCH * g_smartseq_datasize);
+	}
+
+	start = fs_bench_gettime();
+	for (i = 0; i < g_smartseq_nsectors; i += count) {
+		count = g_smartseq_nsectors - i;
+		if (count > SMARTSEQ_BATCH) {
+			count = SMARTSEQ_BATCH;
+		}
+
+		nerrors += smartseq_transfer(i, count, write, vectored);
+	}
+
+	elapsed = fs_bench_gettime() - start;
+	if (elapsed == 0) {
+		elapsed = 1;
+	}
+
+	nbytes = (uint64_t)g_smartseq_nsectors * g_smartseq_datasize;
+	printf("%-14s | %8u | %6d\n", name, (unsigned int)((nbytes * 1000000) / (elapsed * 1024)), nerrors);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int smartseq_benchmark(int argc, FAR char *argv[])
+{
+	struct smart_format_s fmt;
+	int ret;
+	int i;
+
+	g_smartseq_inode = smartvol_open(SMARTSEQ_SIZE);
+	if (g_smartseq_inode == NULL) {
+		return ERROR;
+	}
+
+	ret = g_smartseq_inode->u.i_bops->ioctl(g_smartseq_inode, BIOC_GETFORMAT, (unsigned long)&fmt);
+	if (ret != OK) {
+		printf("BIOC_GETFORMAT failed: %d\n", ret);
+		goto errout_with_volume;
+	}
+
+	g_smartseq_datasize = fmt.availbytes;
+	g_smartseq_nsectors = fmt.nfreesectors * 3 / 4;
+	g_smartseq_sectors = (FAR uint16_t *)malloc(g_smartseq_nsectors * sizeof(uint16_t));
+	g_smartseq_buffer = (FAR uint8_t *)malloc(SMARTSEQ_BATCH * g_smartseq_datasize);
+	if (g_smartseq_sectors == NULL || g_smartseq_buffer == NULL) {
+		printf("Unable to allocate %d sectors\n", g_smartseq_nsectors);
+		ret = ERROR;
+		goto errout_with_buffers;
+	}
+
+	for (i = 0; i < g_smartseq_nsectors; i++) {
+		ret = g_smartseq_inode->u.i_bops->ioctl(g_smartseq_inode, BIOC_ALLOCSECT, 0xFFFF);
+		if (ret < 0) {
+			printf("Unable to allocate sector %d: %d\n", i, ret);
+			ret = ERROR;
+			goto errout_with_buffers;
+		}
+
+		g_smartseq_sectors[i] = (uint16_t)ret;
+	}
+
+	printf("SMART sequential benchmark: %d sectors of %d bytes, ", g_smartseq_nsectors, g_smartseq_datasize);
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+	printf("%d sectors per vectored ioctl\n", SMARTSEQ_BATCH);
+#else
+	printf("no vectored ioctls\n");
+#endif
+
+	printf("\n%-14s | %8s | %6s\n", "TRANSFER", "KB/S", "ERRORS");
+	printf("---------------|----------|-------\n");
+
+	smartseq_run("first write", true, false);
+	smartseq_run("read", false, false);
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+	smartseq_run("read vectored", false, true);
+#endif
+	smartseq_run("write", true, false);
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+	smartseq_run("write vectored", true, true);
+#endif
+	ret = OK;
+
+errout_with_buffers:
+	free(g_smartseq_buffer);
+	free(g_smartseq_sectors);
+	g_smartseq_buffer = NULL;
+	g_smartseq_sectors = NULL;
+
+errout_with_volume:
+	smartvol_close(g_smartseq_inode);
+	g_smartseq_inode = NULL;
+	return ret;
+}
@@ -0,0 +1,167 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/fs_benchmark/smartvol.c
+ *
+ * SMART volumes on RAM MTD devices for the benchmarks of the SMART driver.
+ * A SMART device can't be removed, so the volumes are created when first
+ * used and kept.  They all share one RAM buffer of the largest volume size:
+ * only one is used at a time, and it is formatted when opened.  Closing a
+ * volume stops its background garbage collection, so that it can't touch
+ * the buffer once another volume uses it.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+#include <tinyara/fs/mtd.h>
+
+#include "fs_benchmark.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define SMARTVOL_MAXVOLS    8
+#define SMARTVOL_BUFSIZE    (CONFIG_EXAMPLES_FS_BENCHMARK_SMART_SIZE * 1024)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR uint8_t *g_smartvol_buffer;
+static size_t g_smartvol_size[SMARTVOL_MAXVOLS];
+static int g_smartvol_nvols;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void smartvol_path(FAR char *path, size_t len, int index)
+{
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+	snprintf(path, len, "/dev/smart%dd1", CONFIG_EXAMPLES_FS_BENCHMARK_SMART_MINOR + index);
+#else
+	snprintf(path, len, "/dev/smart%d", CONFIG_EXAMPLES_FS_BENCHMARK_SMART_MINOR + index);
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartvol_open
+ *
+ * Description:
+ *   Open a formatted SMART volume of the given size in bytes, which is a
+ *   multiple of the erase block size and at most
+ *   CONFIG_EXAMPLES_FS_BENCHMARK_SMART_SIZE KB.  Returns NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct inode *smartvol_open(size_t size)
+{
+	FAR struct mtd_dev_s *mtd;
+	FAR struct inode *inode;
+	char path[24];
+	int index;
+	int ret;
+
+	if (size > SMARTVOL_BUFSIZE) {
+		printf("Volume of %u bytes is larger than %u\n", (unsigned int)size, SMARTVOL_BUFSIZE);
+		return NULL;
+	}
+
+	if (g_smartvol_buffer == NULL) {
+		g_smartvol_buffer = (FAR uint8_t *)malloc(SMARTVOL_BUFSIZE);
+		if (g_smartvol_buffer == NULL) {
+			printf("Unable to allocate %u bytes\n", SMARTVOL_BUFSIZE);
+			return NULL;
+		}
+	}
+
+	for (index = 0; index < g_smartvol_nvols; index++) {
+		if (g_smartvol_size[index] == size) {
+			break;
+		}
+	}
+
+	if (index == g_smartvol_nvols) {
+		if (index == SMARTVOL_MAXVOLS) {
+			printf("Too many volume sizes\n");
+			return NULL;
+		}
+
+		mtd = rammtd_initialize(g_smartvol_buffer, size);
+		if (mtd == NULL) {
+			printf("rammtd_initialize failed\n");
+			return NULL;
+		}
+
+		ret = smart_initialize(CONFIG_EXAMPLES_FS_BENCHMARK_SMART_MINOR + index, mtd, NULL);
+		if (ret != OK) {
+			printf("smart_initialize failed: %d\n", ret);
+			return NULL;
+		}
+
+		g_smartvol_size[index] = size;
+		g_smartvol_nvols++;
+	}
+
+	smartvol_path(path, sizeof(path), index);
+	ret = open_blockdriver(path, 0, &inode);
+	if (ret != OK) {
+		printf("Unable to open %s: %d\n", path, ret);
+		return NULL;
+	}
+
+	/* The buffer may hold another volume */
+
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+	ret = inode->u.i_bops->ioctl(inode, BIOC_LLFORMAT, 1);
+#else
+	ret = inode->u.i_bops->ioctl(inode, BIOC_LLFORMAT, 0);
+#endif
+	if (ret != OK) {
+		printf("Unable to format %s: %d\n", path, ret);
+		close_blockdriver(inode);
+		return NULL;
+	}
+
+	return inode;
+}
+
+/****************************************************************************
+ * Name: smartvol_close
+ ****************************************************************************/
+
+void smartvol_close(FAR struct inode *inode)
+{
+	(void)close_blockdriver(inode);
+}
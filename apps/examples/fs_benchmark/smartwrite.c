@@ -0,0 +1,178 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/fs_benchmark/smartwrite.c
+ *
+ * Measures the latency of small writes to SMART volumes of growing size.
+ * Three quarters of the free sectors of each volume are written, then
+ * sectors in random order are written again.  Each write moves the sector
+ * to a free sector, so the driver chooses the block to allocate from on
+ * every write, and collects blocks as the free sectors run out.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+#include <tinyara/fs/smart.h>
+
+#include "fs_benchmark.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define SMARTWRITE_MINSIZE  (32 * 1024)
+#define SMARTWRITE_MAXSIZE  (CONFIG_EXAMPLES_FS_BENCHMARK_SMART_SIZE * 1024)
+#define SMARTWRITE_NWRITES  CONFIG_EXAMPLES_FS_BENCHMARK_SMART_WRITES
+#define SMARTWRITE_DATASIZE 16
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int smartwrite_sector(FAR struct inode *inode, uint16_t sector, uint8_t value)
+{
+	struct smart_read_write_s req;
+	uint8_t data[SMARTWRITE_DATASIZE];
+
+	memset(data, value, SMARTWRITE_DATASIZE);
+	req.logsector = sector;
+	req.offset = 0;
+	req.count = SMARTWRITE_DATASIZE;
+	req.buffer = data;
+	return inode->u.i_bops->ioctl(inode, BIOC_WRITESECT, (unsigned long)&req);
+}
+
+static void smartwrite_run(size_t size)
+{
+	struct smart_format_s fmt;
+	FAR struct inode *inode;
+	FAR uint16_t *sectors;
+	uint64_t start;
+	uint64_t elapsed;
+	uint64_t total = 0;
+	uint64_t max = 0;
+	uint32_t nerrors = 0;
+	int nsectors;
+	int ret;
+	int i;
+
+	inode = smartvol_open(size);
+	if (inode == NULL) {
+		return;
+	}
+
+	ret = inode->u.i_bops->ioctl(inode, BIOC_GETFORMAT, (unsigned long)&fmt);
+	if (ret != OK) {
+		printf("%6u KB | BIOC_GETFORMAT failed: %d\n", (unsigned int)(size / 1024), ret);
+		smartvol_close(inode);
+		return;
+	}
+
+	nsectors = fmt.nfreesectors * 3 / 4;
+	sectors = (FAR uint16_t *)malloc(nsectors * sizeof(uint16_t));
+	if (sectors == NULL) {
+		printf("%6u KB | unable to allocate %d sectors\n", (unsigned int)(size / 1024), nsectors);
+		smartvol_close(inode);
+		return;
+	}
+
+	for (i = 0; i < nsectors; i++) {
+		ret = inode->u.i_bops->ioctl(inode, BIOC_ALLOCSECT, 0xFFFF);
+		if (ret < 0) {
+			break;
+		}
+
+		sectors[i] = (uint16_t)ret;
+		ret = smartwrite_sector(inode, sectors[i], 0);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	if (i < nsectors) {
+		printf("%6u KB | unable to write sector %d: %d\n", (unsigned int)(size / 1024), i, ret);
+		free(sectors);
+		smartvol_close(inode);
+		return;
+	}
+
+	/* Write them again in random order */
+
+	srand(1);
+	for (i = 0; i < SMARTWRITE_NWRITES; i++) {
+		start = fs_bench_gettime();
+		ret = smartwrite_sector(inode, sectors[rand() % nsectors], i & 0xff);
+		elapsed = fs_bench_gettime() - start;
+
+		if (ret < 0) {
+			nerrors++;
+		}
+
+		total += elapsed;
+		if (elapsed > max) {
+			max = elapsed;
+		}
+	}
+
+	if (total == 0) {
+		total = 1;
+	}
+
+	printf("%6u KB | %7d | %8u | %6u | %6u | %6u\n", (unsigned int)(size / 1024), fmt.nsectors,
+		   (unsigned int)(((uint64_t)SMARTWRITE_NWRITES * 1000000) / total),
+		   (unsigned int)(total / SMARTWRITE_NWRITES), (unsigned int)max, nerrors);
+
+	free(sectors);
+	smartvol_close(inode);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int smartwrite_benchmark(int argc, FAR char *argv[])
+{
+	size_t size;
+
+	printf("SMART write benchmark: %d random writes of %d bytes per volume, ", SMARTWRITE_NWRITES, SMARTWRITE_DATASIZE);
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	printf("block index\n");
+#else
+	printf("no block index\n");
+#endif
+
+	printf("\n%9s | %7s | %8s | %6s | %6s | %6s\n", "VOLUME", "SECTORS", "WRITES/S", "US", "MAX US", "ERRORS");
+	printf("----------|---------|----------|--------|--------|-------\n");
+
+	for (size = SMARTWRITE_MINSIZE; size <= SMARTWRITE_MAXSIZE; size <<= 1) {
+		smartwrite_run(size);
+	}
+
+	return OK;
+}
@@ -0,0 +1,66 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __APPS_EXAMPLES_IPC_BENCHMARK_IPC_BENCHMARK_H
+#define __APPS_EXAMPLES_IPC_BENCHMARK_IPC_BENCHMARK_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_EXAMPLES_IPC_BENCHMARK_BYTES
+#  define CONFIG_EXAMPLES_IPC_BENCHMARK_BYTES 1048576
+#endif
+
+#ifndef CONFIG_EXAMPLES_IPC_BENCHMARK_RINGSIZE
+#  define CONFIG_EXAMPLES_IPC_BENCHMARK_RINGSIZE 65536
+#endif
+
+#ifndef CONFIG_EXAMPLES_IPC_BENCHMARK_SIGNALS
+#  define CONFIG_EXAMPLES_IPC_BENCHMARK_SIGNALS 10000
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* ipc_benchmark_main.c *****************************************************/
+
+uint64_t ipc_bench_gettime(void);
+
+/* transfer.c ***************************************************************/
+
+int transfer_benchmark(int argc, FAR char *argv[]);
+
+/* mqueue.c *****************************************************************/
+
+int mqueue_benchmark(int argc, FAR char *argv[]);
+
+/* signal.c *****************************************************************/
+
+int signal_benchmark(int argc, FAR char *argv[]);
+
+#endif /* __APPS_EXAMPLES_IPC_BENCHMARK_IPC_BENCHMARK_H */
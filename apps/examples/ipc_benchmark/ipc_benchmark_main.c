@@ -0,0 +1,121 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/ipc_benchmark/ipc_benchmark_main.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "ipc_benchmark.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct ipc_benchmark_s {
+	FAR const char *name;
+	FAR const char *desc;
+	int (*func)(int argc, FAR char *argv[]);
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct ipc_benchmark_s g_benchmarks[] = {
+	{"transfer", "message throughput of mqueue, pipe and the shared memory ring", transfer_benchmark},
+	{"mqueue", "mqueue copy vs buffer passing and priority insertion", mqueue_benchmark},
+	{"signal", "signals per second between two tasks", signal_benchmark},
+};
+
+#define NBENCHMARKS (sizeof(g_benchmarks) / sizeof(g_benchmarks[0]))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(FAR const char *progname)
+{
+	int i;
+
+	printf("\nUsage: %s <benchmark> [options]\n", progname);
+	printf("\nBenchmarks:\n");
+	for (i = 0; i < NBENCHMARKS; i++) {
+		printf("  %-10s %s\n", g_benchmarks[i].name, g_benchmarks[i].desc);
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipc_bench_gettime
+ *
+ * Description:
+ *   Return the current time in microseconds.
+ *
+ ****************************************************************************/
+
+uint64_t ipc_bench_gettime(void)
+{
+	struct timespec ts;
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+	(void)clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/****************************************************************************
+ * ipc_benchmark_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int ipc_benchmark_main(int argc, char *argv[])
+#endif
+{
+	int i;
+
+	if (argc < 2) {
+		show_usage(argv[0]);
+		return ERROR;
+	}
+
+	for (i = 0; i < NBENCHMARKS; i++) {
+		if (strcmp(argv[1], g_benchmarks[i].name) == 0) {
+			return g_benchmarks[i].func(argc - 1, &argv[1]);
+		}
+	}
+
+	printf("Unknown benchmark: %s\n", argv[1]);
+	show_usage(argv[0]);
+	return ERROR;
+}
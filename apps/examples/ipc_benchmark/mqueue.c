@@ -0,0 +1,371 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/ipc_benchmark/mqueue.c
+ *
+ * Compares the message queue paths:
+ *  - the throughput of 8 byte, 256 byte and 4 KB messages passed from the
+ *    calling task to a consumer thread with mq_send()/mq_receive(), which
+ *    copy each message in and out of the queue, and with mq_sendbuf()/
+ *    mq_receivebuf(), which pass the ownership of a malloc()ed buffer.
+ *  - the cost of queueing messages of mixed priorities into a deep queue,
+ *    which depends on how a message finds its place among the queued ones.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <pthread.h>
+#include <mqueue.h>
+
+#include "ipc_benchmark.h"
+
+#if !defined(CONFIG_DISABLE_MQUEUE) && CONFIG_MQ_MAXMSGSIZE > 0
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define MQBENCH_NSIZES      3
+#define MQBENCH_MQNAME      "ipc_mqbench"
+#define MQBENCH_MQMAXMSG    8
+
+/* Depth of the queue and number of rounds of the priority test */
+
+#define MQBENCH_PRIODEPTH   64
+#define MQBENCH_PRIOLOOPS   100
+
+#ifdef CONFIG_MQ_PRIORITY_INDEX
+#define MQBENCH_PRIOINSERT  "priority index"
+#else
+#define MQBENCH_PRIOINSERT  "sorted insert"
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of one run, shared by the producer and the consumer */
+
+struct mqbench_s {
+	mqd_t mq;
+	size_t msgsize;				/* Size of one message */
+	size_t mqmsgsize;			/* Size of the message queue messages */
+	uint32_t nmsgs;				/* Number of messages of the run */
+	uint32_t nerrors;			/* Messages received with wrong contents */
+	FAR uint8_t *buffer;		/* Consumer buffer of the copying path */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const size_t g_mqbench_sizes[MQBENCH_NSIZES] = { 8, 256, 4096 };
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* The producer marks each message with its sequence number and the
+ * consumer checks the first and the last byte.
+ */
+
+static void mqbench_fill(FAR uint8_t *msg, size_t len, uint32_t msgno)
+{
+	msg[0] = (uint8_t)msgno;
+	msg[len - 1] = (uint8_t)msgno;
+}
+
+static void mqbench_check(FAR struct mqbench_s *b, FAR const uint8_t *msg, size_t len, uint32_t msgno)
+{
+	if (len != b->msgsize || msg[0] != (uint8_t)msgno || msg[len - 1] != (uint8_t)msgno) {
+		b->nerrors++;
+	}
+}
+
+/* Copying path: messages larger than CONFIG_MQ_MAXMSGSIZE are sent in
+ * pieces. The last piece is short when CONFIG_MQ_MAXMSGSIZE does not
+ * divide the message size.
+ */
+
+static void mqbench_copy_produce(FAR struct mqbench_s *b)
+{
+	FAR uint8_t *msg;
+	uint32_t msgno;
+	size_t off;
+	size_t len;
+
+	msg = (FAR uint8_t *)malloc(b->msgsize);
+	if (msg == NULL) {
+		return;
+	}
+
+	memset(msg, 0, b->msgsize);
+	for (msgno = 0; msgno < b->nmsgs; msgno++) {
+		mqbench_fill(msg, b->msgsize, msgno);
+		for (off = 0; off < b->msgsize; off += len) {
+			len = b->msgsize - off;
+			if (len > b->mqmsgsize) {
+				len = b->mqmsgsize;
+			}
+
+			(void)mq_send(b->mq, (FAR const char *)msg + off, len, 0);
+		}
+	}
+
+	free(msg);
+}
+
+static FAR void *mqbench_copy_consume(FAR void *arg)
+{
+	FAR struct mqbench_s *b = (FAR struct mqbench_s *)arg;
+	uint32_t msgno;
+	size_t off;
+	size_t len;
+
+	/* mq_receive() wants room for a full mq_msgsize message, so the buffer
+	 * is allocated with a whole number of pieces; only the message size is
+	 * expected back for the short last piece.
+	 */
+
+	for (msgno = 0; msgno < b->nmsgs; msgno++) {
+		for (off = 0; off < b->msgsize; off += len) {
+			len = b->msgsize - off;
+			if (len > b->mqmsgsize) {
+				len = b->mqmsgsize;
+			}
+
+			if (mq_receive(b->mq, (FAR char *)b->buffer + off, b->mqmsgsize, NULL) != (ssize_t)len) {
+				b->nerrors++;
+				return NULL;
+			}
+		}
+
+		mqbench_check(b, b->buffer, b->msgsize, msgno);
+	}
+
+	return NULL;
+}
+
+#ifdef CONFIG_MQ_ZEROCOPY
+/* Buffer passing path: the producer allocates every message and the
+ * consumer frees it, as users of the queue would.
+ */
+
+static void mqbench_buf_produce(FAR struct mqbench_s *b)
+{
+	FAR uint8_t *msg;
+	uint32_t msgno;
+
+	for (msgno = 0; msgno < b->nmsgs; msgno++) {
+		msg = (FAR uint8_t *)malloc(b->msgsize);
+		if (msg == NULL) {
+			return;
+		}
+
+		mqbench_fill(msg, b->msgsize, msgno);
+		if (mq_sendbuf(b->mq, msg, b->msgsize, 0) != OK) {
+			free(msg);
+			return;
+		}
+	}
+}
+
+static FAR void *mqbench_buf_consume(FAR void *arg)
+{
+	FAR struct mqbench_s *b = (FAR struct mqbench_s *)arg;
+	FAR void *msg;
+	uint32_t msgno;
+	ssize_t len;
+
+	for (msgno = 0; msgno < b->nmsgs; msgno++) {
+		len = mq_receivebuf(b->mq, &msg, NULL);
+		if (len < 0) {
+			b->nerrors++;
+			return NULL;
+		}
+
+		mqbench_check(b, (FAR const uint8_t *)msg, len, msgno);
+		free(msg);
+	}
+
+	return NULL;
+}
+#endif							/* CONFIG_MQ_ZEROCOPY */
+
+/* Run one path with one message size.  The consumer thread gets the
+ * priority of the caller, so that both sides alternate whenever one of
+ * them blocks.
+ */
+
+static void mqbench_run(FAR const char *name, void (*produce)(FAR struct mqbench_s *b), pthread_startroutine_t consume, size_t msgsize)
+{
+	struct mqbench_s b;
+	struct mq_attr attr;
+	struct sched_param param;
+	pthread_attr_t pattr;
+	pthread_t consumer;
+	uint64_t start;
+	uint64_t elapsed;
+
+	memset(&b, 0, sizeof(b));
+	b.msgsize = msgsize;
+	b.mqmsgsize = msgsize < CONFIG_MQ_MAXMSGSIZE ? msgsize : CONFIG_MQ_MAXMSGSIZE;
+	b.nmsgs = CONFIG_EXAMPLES_IPC_BENCHMARK_BYTES / msgsize;
+
+	attr.mq_maxmsg = MQBENCH_MQMAXMSG;
+	attr.mq_msgsize = b.mqmsgsize;
+	attr.mq_flags = 0;
+
+	b.buffer = (FAR uint8_t *)malloc((msgsize + b.mqmsgsize - 1) / b.mqmsgsize * b.mqmsgsize);
+	b.mq = mq_open(MQBENCH_MQNAME, O_RDWR | O_CREAT, 0666, &attr);
+	if (b.buffer == NULL || b.mq == (mqd_t)ERROR) {
+		printf("%-6s | %6u | setup failed\n", name, msgsize);
+		free(b.buffer);
+		return;
+	}
+
+	(void)sched_getparam(0, &param);
+	pthread_attr_init(&pattr);
+	pthread_attr_setschedparam(&pattr, &param);
+
+	start = ipc_bench_gettime();
+	if (pthread_create(&consumer, &pattr, consume, &b) != 0) {
+		printf("%-6s | %6u | pthread_create failed\n", name, msgsize);
+	} else {
+		produce(&b);
+		pthread_join(consumer, NULL);
+		elapsed = ipc_bench_gettime() - start;
+		if (elapsed == 0) {
+			elapsed = 1;
+		}
+
+		printf("%-6s | %6u | %8u | %9u | %6u\n", name, msgsize,
+			   (unsigned int)(((uint64_t)b.nmsgs * 1000000) / elapsed),
+			   (unsigned int)(((uint64_t)b.nmsgs * msgsize * 1000000) / (elapsed * 1024)), b.nerrors);
+	}
+
+	mq_close(b.mq);
+	mq_unlink(MQBENCH_MQNAME);
+	free(b.buffer);
+}
+
+/* Fill a queue of MQBENCH_PRIODEPTH messages with scattered priorities and
+ * drain it again, MQBENCH_PRIOLOOPS times.
+ */
+
+static void mqbench_priority(void)
+{
+	struct mq_attr attr;
+	uint64_t start;
+	uint64_t sendtime = 0;
+	uint64_t rcvtime = 0;
+	uint32_t nerrors = 0;
+	char msg[1];
+	mqd_t mq;
+	int prio;
+	int last;
+	int loop;
+	int i;
+
+	attr.mq_maxmsg = MQBENCH_PRIODEPTH;
+	attr.mq_msgsize = sizeof(msg);
+	attr.mq_flags = 0;
+
+	mq = mq_open(MQBENCH_MQNAME, O_RDWR | O_CREAT | O_NONBLOCK, 0666, &attr);
+	if (mq == (mqd_t)ERROR) {
+		printf("priority test: mq_open failed\n");
+		return;
+	}
+
+	for (loop = 0; loop < MQBENCH_PRIOLOOPS; loop++) {
+		start = ipc_bench_gettime();
+		for (i = 0; i < MQBENCH_PRIODEPTH; i++) {
+			(void)mq_send(mq, msg, sizeof(msg), (i * 89 + loop) % (MQ_PRIO_MAX + 1));
+		}
+
+		sendtime += ipc_bench_gettime() - start;
+
+		/* The messages must come out with decreasing priorities */
+
+		last = MQ_PRIO_MAX;
+		start = ipc_bench_gettime();
+		for (i = 0; i < MQBENCH_PRIODEPTH; i++) {
+			if (mq_receive(mq, msg, sizeof(msg), &prio) < 0 || prio > last) {
+				nerrors++;
+			}
+
+			last = prio;
+		}
+
+		rcvtime += ipc_bench_gettime() - start;
+	}
+
+	printf("\nPriority test: %d messages of mixed priorities queued, %s\n", MQBENCH_PRIODEPTH, MQBENCH_PRIOINSERT);
+	printf("  mq_send    %6u ns per message\n", (unsigned int)(sendtime * 1000 / (MQBENCH_PRIODEPTH * MQBENCH_PRIOLOOPS)));
+	printf("  mq_receive %6u ns per message\n", (unsigned int)(rcvtime * 1000 / (MQBENCH_PRIODEPTH * MQBENCH_PRIOLOOPS)));
+	printf("  errors     %6u\n", nerrors);
+
+	mq_close(mq);
+	mq_unlink(MQBENCH_MQNAME);
+}
+
+#endif							/* !CONFIG_DISABLE_MQUEUE && CONFIG_MQ_MAXMSGSIZE > 0 */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int mqueue_benchmark(int argc, FAR char *argv[])
+{
+#if !defined(CONFIG_DISABLE_MQUEUE) && CONFIG_MQ_MAXMSGSIZE > 0
+	int size;
+
+	printf("Message queue benchmark: %d bytes per run\n", CONFIG_EXAMPLES_IPC_BENCHMARK_BYTES);
+	printf("Copied messages of up to %d bytes\n", CONFIG_MQ_MAXMSGSIZE);
+
+	printf("\n%-6s | %6s | %8s | %9s | %6s\n", "PATH", "SIZE", "MSGS/SEC", "KB/SEC", "ERRORS");
+	printf("-------|--------|----------|-----------|-------\n");
+
+	for (size = 0; size < MQBENCH_NSIZES; size++) {
+		mqbench_run("copy", mqbench_copy_produce, mqbench_copy_consume, g_mqbench_sizes[size]);
+#ifdef CONFIG_MQ_ZEROCOPY
+		mqbench_run("buffer", mqbench_buf_produce, mqbench_buf_consume, g_mqbench_sizes[size]);
+#endif
+	}
+
+#ifndef CONFIG_MQ_ZEROCOPY
+	printf("\nCONFIG_MQ_ZEROCOPY is not enabled, buffer passing was not measured\n");
+#endif
+
+	mqbench_priority();
+	return OK;
+#else
+	printf("Message queues are not available\n");
+	return ERROR;
+#endif
+}
@@ -0,0 +1,275 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/ipc_benchmark/signal.c
+ *
+ * Measures the rate of signals sent from the calling task to a receiver
+ * thread of higher priority:
+ *  - pending: the receiver has the signal masked and waits on a semaphore,
+ *    so the signal becomes pending.  The sender then posts the semaphore
+ *    and the receiver takes the signal with sigwaitinfo().  Sent with
+ *    kill(), which needs no pending signal structure with
+ *    CONFIG_SIG_PENDING_BITMAP, and with sigqueue(), which always does.
+ *  - handler: the receiver has a handler for the signal and waits on a
+ *    semaphore.  The signal interrupts the wait and the handler runs.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <signal.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "ipc_benchmark.h"
+
+#ifndef CONFIG_DISABLE_SIGNALS
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define SIGBENCH_SIGNO      SIGUSR1
+#define SIGBENCH_NSIGNALS   CONFIG_EXAMPLES_IPC_BENCHMARK_SIGNALS
+
+#ifdef CONFIG_SIG_PENDING_BITMAP
+#define SIGBENCH_PENDING    "bitmap"
+#else
+#define SIGBENCH_PENDING    "list"
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The ways of sending and taking the signal */
+
+enum sigbench_mode_e {
+	SIGBENCH_KILL = 0,			/* kill(), pending, sigwaitinfo() */
+	SIGBENCH_QUEUE,				/* sigqueue(), pending, sigwaitinfo() */
+	SIGBENCH_HANDLER			/* kill(), handler */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static sem_t g_sigbench_go;
+static volatile pid_t g_sigbench_rxpid;
+static volatile bool g_sigbench_stop;
+static volatile uint32_t g_sigbench_nreceived;
+static uint32_t g_sigbench_nerrors;
+static enum sigbench_mode_e g_sigbench_mode;
+static pid_t g_sigbench_txpid;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void sigbench_handler(int signo, FAR siginfo_t *info, FAR void *context)
+{
+	g_sigbench_nreceived++;
+}
+
+/* Check the information of a signal that was pending */
+
+static void sigbench_check(FAR const siginfo_t *info)
+{
+	int code = g_sigbench_mode == SIGBENCH_KILL ? SI_USER : SI_QUEUE;
+
+	if (info->si_signo != SIGBENCH_SIGNO || info->si_code != code) {
+		g_sigbench_nerrors++;
+	}
+#ifdef CONFIG_SCHED_HAVE_PARENT
+	if (info->si_pid != g_sigbench_txpid) {
+		g_sigbench_nerrors++;
+	}
+#endif
+}
+
+static FAR void *sigbench_receiver(FAR void *arg)
+{
+	struct sigaction act;
+	siginfo_t info;
+	sigset_t set;
+
+	sigemptyset(&set);
+	sigaddset(&set, SIGBENCH_SIGNO);
+
+	if (g_sigbench_mode == SIGBENCH_HANDLER) {
+		memset(&act, 0, sizeof(act));
+		act.sa_sigaction = sigbench_handler;
+		act.sa_flags = SA_SIGINFO;
+		sigemptyset(&act.sa_mask);
+		(void)sigaction(SIGBENCH_SIGNO, &act, NULL);
+		(void)pthread_sigmask(SIG_UNBLOCK, &set, NULL);
+	} else {
+		(void)pthread_sigmask(SIG_BLOCK, &set, NULL);
+	}
+
+	g_sigbench_rxpid = getpid();
+
+	/* The semaphore wait returns early when the handler ran */
+
+	while (!g_sigbench_stop) {
+		if (sem_wait(&g_sigbench_go) != OK || g_sigbench_mode == SIGBENCH_HANDLER) {
+			continue;
+		}
+
+		if (g_sigbench_stop) {
+			break;
+		}
+
+		if (sigwaitinfo(&set, &info) == SIGBENCH_SIGNO) {
+			sigbench_check(&info);
+			g_sigbench_nreceived++;
+		} else {
+			g_sigbench_nerrors++;
+		}
+	}
+
+	return NULL;
+}
+
+static void sigbench_run(FAR const char *name, enum sigbench_mode_e mode)
+{
+	struct sched_param param;
+	pthread_attr_t attr;
+	pthread_t receiver;
+	union sigval value;
+	sigset_t set;
+	sigset_t oldset;
+	uint64_t start;
+	uint64_t elapsed;
+	uint32_t i;
+
+	g_sigbench_mode = mode;
+	g_sigbench_stop = false;
+	g_sigbench_rxpid = 0;
+	g_sigbench_nreceived = 0;
+	g_sigbench_nerrors = 0;
+	g_sigbench_txpid = getpid();
+	sem_init(&g_sigbench_go, 0, 0);
+
+	/* The sender shares the task group of the receiver.  It blocks the
+	 * signal, so that a signal sent to the group is never delivered to the
+	 * sender, which has no action for it.  The receiver sets its own mask.
+	 */
+
+	sigemptyset(&set);
+	sigaddset(&set, SIGBENCH_SIGNO);
+	(void)pthread_sigmask(SIG_BLOCK, &set, &oldset);
+
+	/* The receiver runs as soon as it can, so every signal is taken before
+	 * the next one is sent.
+	 */
+
+	(void)sched_getparam(0, &param);
+	param.sched_priority++;
+	pthread_attr_init(&attr);
+	pthread_attr_setschedparam(&attr, &param);
+
+	if (pthread_create(&receiver, &attr, sigbench_receiver, NULL) != 0) {
+		printf("%-8s | pthread_create failed\n", name);
+		pthread_attr_destroy(&attr);
+		sem_destroy(&g_sigbench_go);
+		(void)pthread_sigmask(SIG_SETMASK, &oldset, NULL);
+		return;
+	}
+
+	pthread_attr_destroy(&attr);
+	while (g_sigbench_rxpid == 0) {
+		usleep(1000);
+	}
+
+	value.sival_int = 0;
+	start = ipc_bench_gettime();
+	for (i = 0; i < SIGBENCH_NSIGNALS; i++) {
+		switch (mode) {
+		case SIGBENCH_KILL:
+			(void)kill(g_sigbench_rxpid, SIGBENCH_SIGNO);
+			sem_post(&g_sigbench_go);
+			break;
+
+		case SIGBENCH_QUEUE:
+#ifdef CONFIG_CAN_PASS_STRUCTS
+			(void)sigqueue(g_sigbench_rxpid, SIGBENCH_SIGNO, value);
+#else
+			(void)sigqueue(g_sigbench_rxpid, SIGBENCH_SIGNO, value.sival_ptr);
+#endif
+			sem_post(&g_sigbench_go);
+			break;
+
+		case SIGBENCH_HANDLER:
+			(void)kill(g_sigbench_rxpid, SIGBENCH_SIGNO);
+			break;
+		}
+	}
+
+	elapsed = ipc_bench_gettime() - start;
+	if (elapsed == 0) {
+		elapsed = 1;
+	}
+
+	g_sigbench_stop = true;
+	sem_post(&g_sigbench_go);
+	pthread_join(receiver, NULL);
+	sem_destroy(&g_sigbench_go);
+	(void)pthread_sigmask(SIG_SETMASK, &oldset, NULL);
+
+	if (g_sigbench_nreceived != SIGBENCH_NSIGNALS) {
+		g_sigbench_nerrors += SIGBENCH_NSIGNALS - g_sigbench_nreceived;
+	}
+
+	printf("%-8s | %8u | %6u | %6u\n", name,
+		   (unsigned int)(((uint64_t)SIGBENCH_NSIGNALS * 1000000) / elapsed),
+		   (unsigned int)((elapsed * 1000) / SIGBENCH_NSIGNALS), g_sigbench_nerrors);
+}
+
+#endif							/* !CONFIG_DISABLE_SIGNALS */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int signal_benchmark(int argc, FAR char *argv[])
+{
+#ifndef CONFIG_DISABLE_SIGNALS
+	printf("Signal benchmark: %d signals per run, %s of pending signals\n", SIGBENCH_NSIGNALS, SIGBENCH_PENDING);
+
+	printf("\n%-8s | %8s | %6s | %6s\n", "PATH", "SIGS/SEC", "NS", "ERRORS");
+	printf("---------|----------|--------|-------\n");
+
+	sigbench_run("kill", SIGBENCH_KILL);
+	sigbench_run("sigqueue", SIGBENCH_QUEUE);
+	sigbench_run("handler", SIGBENCH_HANDLER);
+	return OK;
+#else
+	printf("Signals are not available\n");
+	return ERROR;
+#endif
+}
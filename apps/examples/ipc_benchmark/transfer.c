@@ -0,0 +1,430 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/ipc_benchmark/transfer.c
+ *
+ * Passes messages of 64 bytes, 1 KB and 16 KB from the calling task to a
+ * consumer thread of the same priority through a message queue, a pipe
+ * and the shared memory frame ring, and reports the throughput.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <mqueue.h>
+
+#ifdef CONFIG_LIBC_SHMRING
+#include <tinyara/shmring.h>
+#endif
+
+#include "ipc_benchmark.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define TRANSFER_NSIZES     3
+#define TRANSFER_MQNAME     "ipc_bench"
+#define TRANSFER_MQMAXMSG   8
+
+#if !defined(CONFIG_DISABLE_MQUEUE) && CONFIG_MQ_MAXMSGSIZE > 0
+#define TRANSFER_MQUEUE
+#endif
+
+#if defined(CONFIG_PIPES) && CONFIG_DEV_PIPE_SIZE > 0
+#define TRANSFER_PIPE
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of one run, shared by the producer and the consumer */
+
+struct transfer_s {
+	size_t msgsize;				/* Size of one message */
+	uint32_t nmsgs;				/* Number of messages of the run */
+	uint32_t nerrors;			/* Messages received with wrong contents */
+	FAR uint8_t *buffer;		/* Consumer buffer of the copying transports */
+#ifdef TRANSFER_MQUEUE
+	mqd_t mq;
+	size_t mqmsgsize;			/* Size of the message queue messages */
+#endif
+#ifdef TRANSFER_PIPE
+	int fd[2];
+#endif
+#ifdef CONFIG_LIBC_SHMRING
+	FAR struct shmring_s *ring;
+#endif
+};
+
+/* One transport: set up, the producer, the consumer and the tear down */
+
+struct transfer_ops_s {
+	FAR const char *name;
+	int (*setup)(FAR struct transfer_s *t);
+	void (*produce)(FAR struct transfer_s *t);
+	FAR void *(*consume)(FAR void *arg);
+	void (*teardown)(FAR struct transfer_s *t);
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const size_t g_msgsizes[TRANSFER_NSIZES] = { 64, 1024, 16384 };
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* The producer fills message 'msgno' with its sequence number and the
+ * consumer checks every word of it.
+ */
+
+static void transfer_fill(FAR uint8_t *msg, size_t len, uint32_t msgno)
+{
+	memset(msg, (int)(msgno & 0xff), len);
+}
+
+static void transfer_check(FAR struct transfer_s *t, FAR const uint8_t *msg, size_t len, uint32_t msgno)
+{
+	FAR const uint32_t *word = (FAR const uint32_t *)msg;
+	uint32_t pattern = (msgno & 0xff) * 0x01010101;
+	size_t i;
+
+	if (len != t->msgsize) {
+		t->nerrors++;
+		return;
+	}
+
+	for (i = 0; i < len / sizeof(uint32_t); i++) {
+		if (word[i] != pattern) {
+			t->nerrors++;
+			return;
+		}
+	}
+}
+
+#ifdef TRANSFER_MQUEUE
+/****************************************************************************
+ * Message queue: messages larger than CONFIG_MQ_MAXMSGSIZE are sent in
+ * pieces.
+ ****************************************************************************/
+
+static int transfer_mq_setup(FAR struct transfer_s *t)
+{
+	struct mq_attr attr;
+
+	t->mqmsgsize = t->msgsize < CONFIG_MQ_MAXMSGSIZE ? t->msgsize : CONFIG_MQ_MAXMSGSIZE;
+
+	attr.mq_maxmsg = TRANSFER_MQMAXMSG;
+	attr.mq_msgsize = t->mqmsgsize;
+	attr.mq_flags = 0;
+
+	t->mq = mq_open(TRANSFER_MQNAME, O_RDWR | O_CREAT, 0666, &attr);
+	return t->mq == (mqd_t)ERROR ? ERROR : OK;
+}
+
+static void transfer_mq_produce(FAR struct transfer_s *t)
+{
+	FAR uint8_t *msg;
+	uint32_t msgno;
+	size_t off;
+
+	msg = (FAR uint8_t *)malloc(t->msgsize);
+	if (msg == NULL) {
+		return;
+	}
+
+	for (msgno = 0; msgno < t->nmsgs; msgno++) {
+		transfer_fill(msg, t->msgsize, msgno);
+		for (off = 0; off < t->msgsize; off += t->mqmsgsize) {
+			(void)mq_send(t->mq, (FAR const char *)msg + off, t->mqmsgsize, 0);
+		}
+	}
+
+	free(msg);
+}
+
+static FAR void *transfer_mq_consume(FAR void *arg)
+{
+	FAR struct transfer_s *t = (FAR struct transfer_s *)arg;
+	uint32_t msgno;
+	size_t off;
+
+	for (msgno = 0; msgno < t->nmsgs; msgno++) {
+		for (off = 0; off < t->msgsize; off += t->mqmsgsize) {
+			if (mq_receive(t->mq, (FAR char *)t->buffer + off, t->mqmsgsize, NULL) < 0) {
+				t->nerrors++;
+				return NULL;
+			}
+		}
+
+		transfer_check(t, t->buffer, t->msgsize, msgno);
+	}
+
+	return NULL;
+}
+
+static void transfer_mq_teardown(FAR struct transfer_s *t)
+{
+	mq_close(t->mq);
+	mq_unlink(TRANSFER_MQNAME);
+}
+#endif							/* TRANSFER_MQUEUE */
+
+#ifdef TRANSFER_PIPE
+/****************************************************************************
+ * Pipe
+ ****************************************************************************/
+
+static int transfer_pipe_setup(FAR struct transfer_s *t)
+{
+	return pipe(t->fd);
+}
+
+static void transfer_pipe_produce(FAR struct transfer_s *t)
+{
+	FAR uint8_t *msg;
+	uint32_t msgno;
+	ssize_t nwritten;
+	size_t off;
+
+	msg = (FAR uint8_t *)malloc(t->msgsize);
+	if (msg == NULL) {
+		return;
+	}
+
+	for (msgno = 0; msgno < t->nmsgs; msgno++) {
+		transfer_fill(msg, t->msgsize, msgno);
+		for (off = 0; off < t->msgsize; off += nwritten) {
+			nwritten = write(t->fd[1], msg + off, t->msgsize - off);
+			if (nwritten <= 0) {
+				free(msg);
+				return;
+			}
+		}
+	}
+
+	free(msg);
+}
+
+static FAR void *transfer_pipe_consume(FAR void *arg)
+{
+	FAR struct transfer_s *t = (FAR struct transfer_s *)arg;
+	uint32_t msgno;
+	ssize_t nread;
+	size_t off;
+
+	for (msgno = 0; msgno < t->nmsgs; msgno++) {
+		for (off = 0; off < t->msgsize; off += nread) {
+			nread = read(t->fd[0], t->buffer + off, t->msgsize - off);
+			if (nread <= 0) {
+				t->nerrors++;
+				return NULL;
+			}
+		}
+
+		transfer_check(t, t->buffer, t->msgsize, msgno);
+	}
+
+	return NULL;
+}
+
+static void transfer_pipe_teardown(FAR struct transfer_s *t)
+{
+	close(t->fd[1]);
+	close(t->fd[0]);
+}
+#endif							/* TRANSFER_PIPE */
+
+#ifdef CONFIG_LIBC_SHMRING
+/****************************************************************************
+ * Shared memory frame ring: the producer fills the frame in place and the
+ * consumer checks it in place.
+ ****************************************************************************/
+
+static int transfer_ring_setup(FAR struct transfer_s *t)
+{
+	FAR void *mem;
+
+	mem = malloc(SHMRING_MEMSIZE(CONFIG_EXAMPLES_IPC_BENCHMARK_RINGSIZE));
+	if (mem == NULL) {
+		return ERROR;
+	}
+
+	t->ring = shmring_initialize(mem, SHMRING_MEMSIZE(CONFIG_EXAMPLES_IPC_BENCHMARK_RINGSIZE));
+	if (t->ring == NULL || t->msgsize > SHMRING_MAXFRAME(t->ring)) {
+		free(mem);
+		return ERROR;
+	}
+
+	return OK;
+}
+
+static void transfer_ring_produce(FAR struct transfer_s *t)
+{
+	FAR uint8_t *frame;
+	uint32_t msgno;
+
+	for (msgno = 0; msgno < t->nmsgs; msgno++) {
+		frame = (FAR uint8_t *)shmring_reserve(t->ring, t->msgsize, true);
+		if (frame == NULL) {
+			return;
+		}
+
+		transfer_fill(frame, t->msgsize, msgno);
+		shmring_commit(t->ring, t->msgsize);
+	}
+}
+
+static FAR void *transfer_ring_consume(FAR void *arg)
+{
+	FAR struct transfer_s *t = (FAR struct transfer_s *)arg;
+	FAR uint8_t *frame;
+	uint32_t msgno;
+	size_t len;
+
+	for (msgno = 0; msgno < t->nmsgs; msgno++) {
+		frame = (FAR uint8_t *)shmring_peek(t->ring, &len, true);
+		if (frame == NULL) {
+			t->nerrors++;
+			return NULL;
+		}
+
+		transfer_check(t, frame, len, msgno);
+		shmring_release(t->ring);
+	}
+
+	return NULL;
+}
+
+static void transfer_ring_teardown(FAR struct transfer_s *t)
+{
+	shmring_uninitialize(t->ring);
+	free(t->ring);
+}
+#endif							/* CONFIG_LIBC_SHMRING */
+
+static const struct transfer_ops_s g_transports[] = {
+#ifdef TRANSFER_MQUEUE
+	{"mqueue", transfer_mq_setup, transfer_mq_produce, transfer_mq_consume, transfer_mq_teardown},
+#endif
+#ifdef TRANSFER_PIPE
+	{"pipe", transfer_pipe_setup, transfer_pipe_produce, transfer_pipe_consume, transfer_pipe_teardown},
+#endif
+#ifdef CONFIG_LIBC_SHMRING
+	{"shmring", transfer_ring_setup, transfer_ring_produce, transfer_ring_consume, transfer_ring_teardown},
+#endif
+};
+
+#define TRANSFER_NTRANSPORTS (sizeof(g_transports) / sizeof(g_transports[0]))
+
+/* Run one transport with one message size.  The consumer thread gets the
+ * priority of the caller, so that both sides alternate whenever one of
+ * them blocks.
+ */
+
+static void transfer_run(FAR const struct transfer_ops_s *ops, size_t msgsize)
+{
+	struct transfer_s t;
+	struct sched_param param;
+	pthread_attr_t attr;
+	pthread_t consumer;
+	uint64_t start;
+	uint64_t elapsed;
+
+	memset(&t, 0, sizeof(t));
+	t.msgsize = msgsize;
+	t.nmsgs = CONFIG_EXAMPLES_IPC_BENCHMARK_BYTES / msgsize;
+
+	t.buffer = (FAR uint8_t *)malloc(msgsize);
+	if (t.buffer == NULL || ops->setup(&t) != OK) {
+		printf("%-8s | %6u | setup failed\n", ops->name, msgsize);
+		free(t.buffer);
+		return;
+	}
+
+	(void)sched_getparam(0, &param);
+	pthread_attr_init(&attr);
+	pthread_attr_setschedparam(&attr, &param);
+
+	start = ipc_bench_gettime();
+	if (pthread_create(&consumer, &attr, ops->consume, &t) != 0) {
+		printf("%-8s | %6u | pthread_create failed\n", ops->name, msgsize);
+		ops->teardown(&t);
+		free(t.buffer);
+		return;
+	}
+
+	ops->produce(&t);
+	pthread_join(consumer, NULL);
+	elapsed = ipc_bench_gettime() - start;
+	if (elapsed == 0) {
+		elapsed = 1;
+	}
+
+	printf("%-8s | %6u | %8u | %9u | %6u\n", ops->name, msgsize,
+		   (unsigned int)(((uint64_t)t.nmsgs * 1000000) / elapsed),
+		   (unsigned int)(((uint64_t)t.nmsgs * msgsize * 1000000) / (elapsed * 1024)), t.nerrors);
+
+	ops->teardown(&t);
+	free(t.buffer);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int transfer_benchmark(int argc, FAR char *argv[])
+{
+	int size;
+	int i;
+
+	printf("Transfer benchmark: %d bytes per run\n", CONFIG_EXAMPLES_IPC_BENCHMARK_BYTES);
+#ifdef TRANSFER_MQUEUE
+	printf("Message queue messages of up to %d bytes\n", CONFIG_MQ_MAXMSGSIZE);
+#endif
+
+	printf("\n%-8s | %6s | %8s | %9s | %6s\n", "RUN", "SIZE", "MSGS/SEC", "KB/SEC", "ERRORS");
+	printf("---------|--------|----------|-----------|-------\n");
+
+	for (size = 0; size < TRANSFER_NSIZES; size++) {
+		for (i = 0; i < TRANSFER_NTRANSPORTS; i++) {
+			transfer_run(&g_transports[i], g_msgsizes[size]);
+		}
+	}
+
+#ifndef CONFIG_LIBC_SHMRING
+	printf("\nCONFIG_LIBC_SHMRING is not enabled, the frame ring was not measured\n");
+#endif
+
+	return OK;
+}
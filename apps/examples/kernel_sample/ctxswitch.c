@@ -0,0 +1,244 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/kernel_sample/ctxswitch.c
+ *
+ * Measures the scheduler with a number of ready-to-run threads that do not
+ * get the CPU during the measurement.  The ready threads are spread over
+ * the priorities from just below the switch pair down to below the
+ * requeued thread, so the ready-to-run list holds many different
+ * priorities and the priority bitmap has bits in several words.  On a
+ * single CPU, a ready thread above the pair would take the CPU from it.
+ *
+ * - switch:  two threads of the same priority, right above the ready
+ *   threads, hand the CPU to each other with semaphores.  Reported per
+ *   context switch.
+ * - requeue: a ready thread in the middle of the others is moved between
+ *   two priorities, so it is taken out of the ready-to-run list and
+ *   inserted again between ready threads of other priorities each time.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "kernel_sample.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define CTXSW_PRIO_MEASURE   200	/* The measuring thread */
+#define CTXSW_PRIO_PINGPONG  180	/* The switch pair */
+#define CTXSW_PRIO_READYHIGH 179	/* The highest ready thread */
+#define CTXSW_PRIO_READYLOW  20	/* The lowest ready thread */
+#define CTXSW_PRIO_REQUEUE   100	/* The requeued thread */
+
+#define CTXSW_LOOPS          CONFIG_EXAMPLES_KERNEL_SAMPLE_CTXSW_LOOPS
+#define CTXSW_NREADY         CONFIG_EXAMPLES_KERNEL_SAMPLE_CTXSW_NREADY
+
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+#define CTXSW_READYLIST      "indexed"
+#else
+#define CTXSW_READYLIST      "sorted"
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static sem_t g_ping;
+static sem_t g_pong;
+static uint64_t g_switch_elapsed;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint64_t ctxsw_gettime(void)
+{
+	struct timespec ts;
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+	(void)clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static pthread_addr_t ctxsw_ping(pthread_addr_t arg)
+{
+	uint64_t start;
+	int i;
+
+	start = ctxsw_gettime();
+	for (i = 0; i < CTXSW_LOOPS; i++) {
+		sem_post(&g_pong);
+		sem_wait(&g_ping);
+	}
+
+	g_switch_elapsed = ctxsw_gettime() - start;
+	return NULL;
+}
+
+static pthread_addr_t ctxsw_pong(pthread_addr_t arg)
+{
+	int i;
+
+	for (i = 0; i < CTXSW_LOOPS; i++) {
+		sem_wait(&g_pong);
+		sem_post(&g_ping);
+	}
+
+	return NULL;
+}
+
+/* The ready threads and the requeued thread only run after the measurement */
+
+static pthread_addr_t ctxsw_ready(pthread_addr_t arg)
+{
+	return NULL;
+}
+
+static int ctxsw_create(FAR pthread_t *thread, int prio, pthread_startroutine_t entry)
+{
+	struct sched_param sparam;
+	pthread_attr_t attr;
+	int status;
+
+	pthread_attr_init(&attr);
+	sparam.sched_priority = prio;
+	(void)pthread_attr_setschedparam(&attr, &sparam);
+	status = pthread_create(thread, &attr, entry, NULL);
+	pthread_attr_destroy(&attr);
+
+	if (status != 0) {
+		printf("ctxswitch_test: ERROR pthread_create failed, status=%d\n", status);
+	}
+
+	return status;
+}
+
+static void ctxsw_run(int nready)
+{
+	pthread_t ready[CTXSW_NREADY];
+	pthread_t requeue;
+	pthread_t ping;
+	pthread_t pong;
+	uint64_t requeue_elapsed = 0;
+	uint64_t start;
+	bool requeued = false;
+	int created;
+	int prio;
+	int i;
+
+	/* The measuring thread has the highest priority, so the threads created
+	 * here stay in the ready-to-run list until it blocks.
+	 */
+
+	for (created = 0; created < nready; created++) {
+		prio = CTXSW_PRIO_READYHIGH;
+		if (nready > 1) {
+			prio -= created * (CTXSW_PRIO_READYHIGH - CTXSW_PRIO_READYLOW) / (nready - 1);
+		}
+
+		if (ctxsw_create(&ready[created], prio, ctxsw_ready) != 0) {
+			break;
+		}
+	}
+
+	if (ctxsw_create(&requeue, CTXSW_PRIO_REQUEUE, ctxsw_ready) == 0) {
+		requeued = true;
+		start = ctxsw_gettime();
+		for (i = 0; i < CTXSW_LOOPS; i++) {
+			(void)pthread_setschedprio(requeue, CTXSW_PRIO_REQUEUE + (i & 1));
+		}
+
+		requeue_elapsed = ctxsw_gettime() - start;
+	}
+
+	/* Only the switch pair runs while this thread waits for it */
+
+	sem_init(&g_ping, 0, 0);
+	sem_init(&g_pong, 0, 0);
+	g_switch_elapsed = 0;
+
+	if (ctxsw_create(&pong, CTXSW_PRIO_PINGPONG, ctxsw_pong) == 0) {
+		if (ctxsw_create(&ping, CTXSW_PRIO_PINGPONG, ctxsw_ping) == 0) {
+			pthread_join(ping, NULL);
+		} else {
+			sem_post(&g_pong);
+		}
+
+		pthread_join(pong, NULL);
+	}
+
+	sem_destroy(&g_ping);
+	sem_destroy(&g_pong);
+
+	printf("%5d | %9u | %10u\n", created, (unsigned int)(g_switch_elapsed * 1000 / (2 * CTXSW_LOOPS)),
+		   (unsigned int)(requeue_elapsed * 1000 / CTXSW_LOOPS));
+
+	/* The remaining threads run and exit when this thread waits for them */
+
+	if (requeued) {
+		pthread_join(requeue, NULL);
+	}
+
+	while (created > 0) {
+		pthread_join(ready[--created], NULL);
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void ctxswitch_test(void)
+{
+	struct sched_param sparam;
+	int policy;
+	int prio;
+
+	(void)pthread_getschedparam(pthread_self(), &policy, &sparam);
+	prio = sparam.sched_priority;
+	sparam.sched_priority = CTXSW_PRIO_MEASURE;
+	(void)pthread_setschedparam(pthread_self(), policy, &sparam);
+
+	printf("ctxswitch_test: %d loops, %s ready-to-run list\n", CTXSW_LOOPS, CTXSW_READYLIST);
+	printf("READY | SWITCH NS | REQUEUE NS\n");
+	printf("------|-----------|-----------\n");
+
+	ctxsw_run(0);
+	ctxsw_run(CTXSW_NREADY);
+
+	sparam.sched_priority = prio;
+	(void)pthread_setschedparam(pthread_self(), policy, &sparam);
+}
@@ -192,6 +192,14 @@ void sighand_test(void);
 
 void timer_test(void);
 
+/* wdstress.c ***************************************************************/
+
+void wdstress_test(void);
+
+/* wakeups.c ****************************************************************/
+
+void wakeups_test(void);
+
 /* roundrobin.c *************************************************************/
 
 void rr_test(void);
@@ -200,6 +208,18 @@ void rr_test(void);
 
 void barrier_test(void);
 
+/* ctxswitch.c **************************************************************/
+
+void ctxswitch_test(void);
+
+/* mutexperf.c **************************************************************/
+
+void mutexperf_test(void);
+
+/* semholder.c **************************************************************/
+
+void semholder_test(void);
+
 /* prioinherit.c ************************************************************/
 
 void priority_inheritance(void);
@@ -440,6 +440,22 @@ static int user_main(int argc, char *argv[])
 		check_test_memory_usage();
 #endif
 
+#ifndef CONFIG_DISABLE_POSIX_TIMERS
+		/* Measure watchdogs with many timers armed */
+
+		printf("\nuser_main: watchdog stress test\n");
+		wdstress_test();
+		check_test_memory_usage();
+#endif
+
+#if defined(CONFIG_SCHED_TICKLESS) && !defined(CONFIG_DISABLE_PTHREAD)
+		/* Count the wakeups of the tick-less OS with and without slack */
+
+		printf("\nuser_main: wakeup test\n");
+		wakeups_test();
+		check_test_memory_usage();
+#endif
+
 #if !defined(CONFIG_DISABLE_PTHREAD) && CONFIG_RR_INTERVAL > 0
 		/* Verify round robin scheduling */
 
@@ -456,6 +472,30 @@ static int user_main(int argc, char *argv[])
 		check_test_memory_usage();
 #endif
 
+#ifndef CONFIG_DISABLE_PTHREAD
+		/* Measure context switches with threads in the ready-to-run list */
+
+		printf("\nuser_main: context switch test\n");
+		ctxswitch_test();
+		check_test_memory_usage();
+#endif
+
+#ifndef CONFIG_DISABLE_PTHREAD
+		/* Measure mutex lock and unlock */
+
+		printf("\nuser_main: mutex performance test\n");
+		mutexperf_test();
+		check_test_memory_usage();
+#endif
+
+#if defined(CONFIG_PRIORITY_INHERITANCE) && !defined(CONFIG_DISABLE_PTHREAD)
+		/* Measure semaphore holder bookkeeping with many holders */
+
+		printf("\nuser_main: semaphore holder test\n");
+		semholder_test();
+		check_test_memory_usage();
+#endif
+
 #if defined(CONFIG_PRIORITY_INHERITANCE) && !defined(CONFIG_DISABLE_SIGNALS) && !defined(CONFIG_DISABLE_PTHREAD)
 		/* Verify priority inheritance */
 
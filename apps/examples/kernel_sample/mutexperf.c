@@ -0,0 +1,346 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/kernel_sample/mutexperf.c
+ *
+ * Measures pthread mutexes:
+ *
+ * - uncontended: one thread locks a set of free mutexes and unlocks them
+ *   again.  Reported per lock and per unlock.
+ * - contended: a low priority thread holds the mutex while a high priority
+ *   thread blocks on it, then unlocks it and hands it over.  Reported per
+ *   round, which includes the lock and unlock of both threads and two
+ *   context switches.  With priority inheritance, the holder also checks
+ *   that it was boosted while the other thread waited.
+ * - preempted: two threads of the same priority take turns on a mutex and
+ *   yield or are preempted by round robin while they lock and hold it, so
+ *   the fast path and the semaphore path interleave.  Checks that every
+ *   lock and unlock succeeds and that the mutex is free at the end.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "kernel_sample.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define MUTEXPERF_PRIO_HIGH  200	/* The waiting thread */
+#define MUTEXPERF_PRIO_LOW   180	/* The holding thread */
+
+#define MUTEXPERF_LOOPS      CONFIG_EXAMPLES_KERNEL_SAMPLE_MUTEX_LOOPS
+#define MUTEXPERF_NMUTEX     16
+#define MUTEXPERF_NRACERS    2
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+#define MUTEXPERF_PATH       "fast path"
+#else
+#define MUTEXPERF_PATH       "semaphore"
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static pthread_mutex_t g_mutex;
+static sem_t g_go;
+static volatile int g_round;
+static volatile bool g_stop;
+static uint64_t g_contended_elapsed;
+static int g_notboosted;
+static volatile int g_counter;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint64_t mutexperf_gettime(void)
+{
+	struct timespec ts;
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+	(void)clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void mutexperf_uncontended(void)
+{
+	pthread_mutex_t mutex[MUTEXPERF_NMUTEX];
+	uint64_t lock_elapsed = 0;
+	uint64_t unlock_elapsed = 0;
+	uint64_t start;
+	int nops;
+	int i;
+	int j;
+
+	for (j = 0; j < MUTEXPERF_NMUTEX; j++) {
+		pthread_mutex_init(&mutex[j], NULL);
+	}
+
+	for (i = 0; i < MUTEXPERF_LOOPS; i += MUTEXPERF_NMUTEX) {
+		start = mutexperf_gettime();
+		for (j = 0; j < MUTEXPERF_NMUTEX; j++) {
+			pthread_mutex_lock(&mutex[j]);
+		}
+
+		lock_elapsed += mutexperf_gettime() - start;
+
+		start = mutexperf_gettime();
+		for (j = MUTEXPERF_NMUTEX - 1; j >= 0; j--) {
+			pthread_mutex_unlock(&mutex[j]);
+		}
+
+		unlock_elapsed += mutexperf_gettime() - start;
+	}
+
+	for (j = 0; j < MUTEXPERF_NMUTEX; j++) {
+		pthread_mutex_destroy(&mutex[j]);
+	}
+
+	nops = i;
+	printf("uncontended | %7u | %9u | %8s\n", (unsigned int)(lock_elapsed * 1000 / nops), (unsigned int)(unlock_elapsed * 1000 / nops), "-");
+}
+
+/* The high priority thread blocks on the mutex each round until the low
+ * priority thread unlocks it.
+ */
+
+static pthread_addr_t mutexperf_waiter(pthread_addr_t arg)
+{
+	int i;
+
+	for (i = 0; i < MUTEXPERF_LOOPS; i++) {
+		sem_wait(&g_go);
+		if (g_stop) {
+			break;
+		}
+
+		g_round = i;
+		pthread_mutex_lock(&g_mutex);
+		pthread_mutex_unlock(&g_mutex);
+	}
+
+	return NULL;
+}
+
+static pthread_addr_t mutexperf_holder(pthread_addr_t arg)
+{
+#ifdef CONFIG_PRIORITY_INHERITANCE
+	struct sched_param sparam;
+#endif
+	uint64_t start;
+	int i;
+
+	start = mutexperf_gettime();
+	for (i = 0; i < MUTEXPERF_LOOPS; i++) {
+		pthread_mutex_lock(&g_mutex);
+
+		/* The waiter runs right away and comes back blocked on the mutex */
+
+		sem_post(&g_go);
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+		if (g_round == i) {
+			(void)sched_getparam(0, &sparam);
+			if (sparam.sched_priority != MUTEXPERF_PRIO_HIGH) {
+				g_notboosted++;
+			}
+		}
+#endif
+
+		pthread_mutex_unlock(&g_mutex);
+	}
+
+	g_contended_elapsed = mutexperf_gettime() - start;
+	return NULL;
+}
+
+static int mutexperf_create(FAR pthread_t *thread, int prio, pthread_startroutine_t entry)
+{
+	struct sched_param sparam;
+	pthread_attr_t attr;
+	int status;
+
+	pthread_attr_init(&attr);
+	sparam.sched_priority = prio;
+	(void)pthread_attr_setschedparam(&attr, &sparam);
+	status = pthread_create(thread, &attr, entry, NULL);
+	pthread_attr_destroy(&attr);
+
+	if (status != 0) {
+		printf("mutexperf_test: ERROR pthread_create failed, status=%d\n", status);
+	}
+
+	return status;
+}
+
+static void mutexperf_contended(void)
+{
+	pthread_t waiter;
+	pthread_t holder;
+
+	pthread_mutex_init(&g_mutex, NULL);
+	sem_init(&g_go, 0, 0);
+	g_round = -1;
+	g_stop = false;
+	g_contended_elapsed = 0;
+	g_notboosted = 0;
+
+	if (mutexperf_create(&waiter, MUTEXPERF_PRIO_HIGH, mutexperf_waiter) == 0) {
+		if (mutexperf_create(&holder, MUTEXPERF_PRIO_LOW, mutexperf_holder) == 0) {
+			pthread_join(holder, NULL);
+		} else {
+			g_stop = true;
+			sem_post(&g_go);
+		}
+
+		pthread_join(waiter, NULL);
+	}
+
+	sem_destroy(&g_go);
+	pthread_mutex_destroy(&g_mutex);
+
+	printf("contended   | %7s | %9s | %8u\n", "-", "-", (unsigned int)(g_contended_elapsed * 1000 / MUTEXPERF_LOOPS));
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+	if (g_notboosted > 0) {
+		printf("mutexperf_test: ERROR holder not boosted in %d of %d rounds\n", g_notboosted, MUTEXPERF_LOOPS);
+	}
+#endif
+}
+
+/* Each racer counts its own errors in the int that 'arg' points to */
+
+static pthread_addr_t mutexperf_racer(pthread_addr_t arg)
+{
+	FAR int *nerrors = (FAR int *)arg;
+	int count;
+	int i;
+
+	for (i = 0; i < MUTEXPERF_LOOPS; i++) {
+		if (pthread_mutex_lock(&g_mutex) != 0) {
+			(*nerrors)++;
+			continue;
+		}
+
+		/* Let the other racer block on the mutex now and then */
+
+		count = g_counter;
+		if ((i & 7) == 0) {
+			sched_yield();
+		}
+
+		g_counter = count + 1;
+
+		if (pthread_mutex_unlock(&g_mutex) != 0) {
+			(*nerrors)++;
+		}
+	}
+
+	return NULL;
+}
+
+static void mutexperf_preempted(void)
+{
+	struct sched_param sparam;
+	pthread_attr_t attr;
+	pthread_t racer[MUTEXPERF_NRACERS];
+	int nerrors[MUTEXPERF_NRACERS];
+	int nracers;
+	int total = 0;
+	int status;
+	int i;
+
+	pthread_mutex_init(&g_mutex, NULL);
+	g_counter = 0;
+
+	pthread_attr_init(&attr);
+	sparam.sched_priority = MUTEXPERF_PRIO_LOW;
+	(void)pthread_attr_setschedparam(&attr, &sparam);
+#if CONFIG_RR_INTERVAL > 0
+	(void)pthread_attr_setschedpolicy(&attr, SCHED_RR);
+#endif
+
+	for (nracers = 0; nracers < MUTEXPERF_NRACERS; nracers++) {
+		nerrors[nracers] = 0;
+		status = pthread_create(&racer[nracers], &attr, mutexperf_racer, &nerrors[nracers]);
+		if (status != 0) {
+			printf("mutexperf_test: ERROR pthread_create failed, status=%d\n", status);
+			break;
+		}
+	}
+
+	pthread_attr_destroy(&attr);
+
+	for (i = 0; i < nracers; i++) {
+		pthread_join(racer[i], NULL);
+		total += nerrors[i];
+	}
+
+	if (g_counter != nracers * MUTEXPERF_LOOPS) {
+		total++;
+	}
+
+	/* A racer that owned the mutex without being its owner left it locked */
+
+	if (pthread_mutex_trylock(&g_mutex) != 0) {
+		total++;
+	} else {
+		pthread_mutex_unlock(&g_mutex);
+	}
+
+	pthread_mutex_destroy(&g_mutex);
+
+	if (total > 0) {
+		printf("mutexperf_test: ERROR %d errors with %d preempted threads\n", total, nracers);
+	} else {
+		printf("mutexperf_test: %d preempted threads, no errors\n", nracers);
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void mutexperf_test(void)
+{
+	printf("mutexperf_test: %d loops, %s\n", MUTEXPERF_LOOPS, MUTEXPERF_PATH);
+	printf("            | LOCK NS | UNLOCK NS | ROUND NS\n");
+	printf("------------|---------|-----------|---------\n");
+
+	mutexperf_uncontended();
+	mutexperf_contended();
+	mutexperf_preempted();
+}
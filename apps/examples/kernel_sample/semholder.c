@@ -0,0 +1,240 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/kernel_sample/semholder.c
+ *
+ * Measures the priority inheritance bookkeeping of a counting semaphore
+ * with a growing number of threads holding a count each:
+ *
+ * - wait+post: the measuring thread takes the last count and gives it
+ *   back.  Each takes a holder lookup.
+ * - contended: while the measuring thread holds the last count, a higher
+ *   priority thread blocks on the semaphore, which boosts every holder,
+ *   and gets the count when it is posted, which restores every holder.
+ *   Reported per round, including two context switches.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "kernel_sample.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define SEMHOLDER_PRIO_WAITER   200	/* The thread that blocks */
+#define SEMHOLDER_PRIO_HOLDER   190	/* The threads that hold a count */
+#define SEMHOLDER_PRIO_MEASURE  180	/* The measuring thread */
+
+#define SEMHOLDER_LOOPS         CONFIG_EXAMPLES_KERNEL_SAMPLE_SEMHOLDER_LOOPS
+
+/* The measuring and the waiting thread need a holder record too */
+
+#if CONFIG_SEM_PREALLOCHOLDERS < CONFIG_EXAMPLES_KERNEL_SAMPLE_SEMHOLDER_NTHREADS + 2
+#if CONFIG_SEM_PREALLOCHOLDERS > 2
+#define SEMHOLDER_NTHREADS      (CONFIG_SEM_PREALLOCHOLDERS - 2)
+#else
+#define SEMHOLDER_NTHREADS      0
+#endif
+#else
+#define SEMHOLDER_NTHREADS      CONFIG_EXAMPLES_KERNEL_SAMPLE_SEMHOLDER_NTHREADS
+#endif
+
+#ifdef CONFIG_SEM_HOLDER_INDEX
+#define SEMHOLDER_LOOKUP        "indexed"
+#else
+#define SEMHOLDER_LOOKUP        "list"
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static sem_t g_sem;
+static sem_t g_release;
+static sem_t g_go;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint64_t semholder_gettime(void)
+{
+	struct timespec ts;
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+	(void)clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* A holder takes its count as soon as it is created and keeps it until it
+ * is released.
+ */
+
+static pthread_addr_t semholder_holder(pthread_addr_t arg)
+{
+	sem_wait(&g_sem);
+	sem_wait(&g_release);
+	sem_post(&g_sem);
+	return NULL;
+}
+
+static pthread_addr_t semholder_waiter(pthread_addr_t arg)
+{
+	int i;
+
+	for (i = 0; i < SEMHOLDER_LOOPS; i++) {
+		sem_wait(&g_go);
+		sem_wait(&g_sem);
+		sem_post(&g_sem);
+	}
+
+	return NULL;
+}
+
+static int semholder_create(FAR pthread_t *thread, int prio, pthread_startroutine_t entry)
+{
+	struct sched_param sparam;
+	pthread_attr_t attr;
+	int status;
+
+	pthread_attr_init(&attr);
+	sparam.sched_priority = prio;
+	(void)pthread_attr_setschedparam(&attr, &sparam);
+	status = pthread_create(thread, &attr, entry, NULL);
+	pthread_attr_destroy(&attr);
+
+	if (status != 0) {
+		printf("semholder_test: ERROR pthread_create failed, status=%d\n", status);
+	}
+
+	return status;
+}
+
+static void semholder_run(int nholders)
+{
+	pthread_t holder[SEMHOLDER_NTHREADS + 1];
+	pthread_t waiter;
+	uint64_t pair_elapsed;
+	uint64_t round_elapsed = 0;
+	uint64_t start;
+	int created;
+	int i;
+
+	/* One count for each holder and one for this thread */
+
+	sem_init(&g_sem, 0, nholders + 1);
+	sem_init(&g_release, 0, 0);
+	sem_init(&g_go, 0, 0);
+
+	for (created = 0; created < nholders; created++) {
+		if (semholder_create(&holder[created], SEMHOLDER_PRIO_HOLDER, semholder_holder) != 0) {
+			break;
+		}
+	}
+
+	start = semholder_gettime();
+	for (i = 0; i < SEMHOLDER_LOOPS; i++) {
+		sem_wait(&g_sem);
+		sem_post(&g_sem);
+	}
+
+	pair_elapsed = semholder_gettime() - start;
+
+	/* The waiter runs right away on each g_go and blocks on the semaphore
+	 * until this thread posts its count.
+	 */
+
+	if (semholder_create(&waiter, SEMHOLDER_PRIO_WAITER, semholder_waiter) == 0) {
+		start = semholder_gettime();
+		for (i = 0; i < SEMHOLDER_LOOPS; i++) {
+			sem_wait(&g_sem);
+			sem_post(&g_go);
+			sem_post(&g_sem);
+		}
+
+		round_elapsed = semholder_gettime() - start;
+		pthread_join(waiter, NULL);
+	}
+
+	printf("%7d | %12u | %12u\n", created, (unsigned int)(pair_elapsed * 1000 / SEMHOLDER_LOOPS), (unsigned int)(round_elapsed * 1000 / SEMHOLDER_LOOPS));
+
+	for (i = 0; i < created; i++) {
+		sem_post(&g_release);
+	}
+
+	while (created > 0) {
+		pthread_join(holder[--created], NULL);
+	}
+
+	sem_destroy(&g_go);
+	sem_destroy(&g_release);
+	sem_destroy(&g_sem);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void semholder_test(void)
+{
+	struct sched_param sparam;
+	int nholders;
+	int policy;
+	int prio;
+
+	(void)pthread_getschedparam(pthread_self(), &policy, &sparam);
+	prio = sparam.sched_priority;
+	sparam.sched_priority = SEMHOLDER_PRIO_MEASURE;
+	(void)pthread_setschedparam(pthread_self(), policy, &sparam);
+
+	printf("semholder_test: %d loops, %s holder lookup\n", SEMHOLDER_LOOPS, SEMHOLDER_LOOKUP);
+	printf("HOLDERS | WAIT+POST NS | CONTENDED NS\n");
+	printf("--------|--------------|-------------\n");
+
+	nholders = 0;
+	for (;;) {
+		semholder_run(nholders);
+		if (nholders >= SEMHOLDER_NTHREADS) {
+			break;
+		}
+
+		nholders = nholders > 0 ? 2 * nholders : 1;
+		if (nholders > SEMHOLDER_NTHREADS) {
+			nholders = SEMHOLDER_NTHREADS;
+		}
+	}
+
+	sparam.sched_priority = prio;
+	(void)pthread_setschedparam(pthread_self(), policy, &sparam);
+}
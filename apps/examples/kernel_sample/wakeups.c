@@ -0,0 +1,132 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/kernel_sample/wakeups.c
+ *
+ * Counts the wakeups of the tick-less OS while a few threads poll with
+ * usleep() at slightly different periods, like the logger and the work
+ * queues do.  Without timer slack every sleep takes its own wakeup.  With
+ * CONFIG_SCHED_TICKLESS_SLACK, the test runs again with the threads
+ * accepting CONFIG_EXAMPLES_KERNEL_SAMPLE_WAKEUPS_SLACK microseconds of
+ * slack, so that sleeps that end close together share a wakeup.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/prctl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <tinyara/sched.h>
+
+#include "kernel_sample.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define WAKEUPS_NTHREADS     4
+#define WAKEUPS_PERIOD       100000	/* Period of the first thread in usec */
+#define WAKEUPS_STAGGER      7000	/* Period difference of the threads */
+#define WAKEUPS_SECONDS      CONFIG_EXAMPLES_KERNEL_SAMPLE_WAKEUPS_SECONDS
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static volatile bool g_stop;
+static unsigned long g_slack;
+static uint32_t g_nsleeps[WAKEUPS_NTHREADS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static pthread_addr_t wakeups_sleeper(pthread_addr_t arg)
+{
+	int index = (int)arg;
+	useconds_t period = WAKEUPS_PERIOD + index * WAKEUPS_STAGGER;
+
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+	(void)prctl(PR_SET_TIMERSLACK, g_slack, 0);
+#endif
+
+	while (!g_stop) {
+		usleep(period);
+		g_nsleeps[index]++;
+	}
+
+	return NULL;
+}
+
+static void wakeups_run(unsigned long slack)
+{
+	pthread_t thread[WAKEUPS_NTHREADS];
+	uint32_t nwakeups;
+	uint32_t nsleeps;
+	int created;
+	int i;
+
+	g_stop = false;
+	g_slack = slack;
+
+	for (created = 0; created < WAKEUPS_NTHREADS; created++) {
+		g_nsleeps[created] = 0;
+		if (pthread_create(&thread[created], NULL, wakeups_sleeper, (pthread_addr_t)created) != 0) {
+			printf("wakeups_test: ERROR pthread_create failed\n");
+			break;
+		}
+	}
+
+	nwakeups = sched_timer_wakeups();
+	sleep(WAKEUPS_SECONDS);
+	nwakeups = sched_timer_wakeups() - nwakeups;
+
+	g_stop = true;
+	nsleeps = 0;
+	for (i = 0; i < created; i++) {
+		pthread_join(thread[i], NULL);
+		nsleeps += g_nsleeps[i];
+	}
+
+	printf("%8lu | %9u | %8u\n", slack, (unsigned int)(nwakeups / WAKEUPS_SECONDS), (unsigned int)(nsleeps / WAKEUPS_SECONDS));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void wakeups_test(void)
+{
+	printf("wakeups_test: %d threads, %d seconds\n", WAKEUPS_NTHREADS, WAKEUPS_SECONDS);
+	printf("SLACK US | WAKEUPS/S | SLEEPS/S\n");
+	printf("---------|-----------|---------\n");
+
+	wakeups_run(0);
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+	wakeups_run(CONFIG_EXAMPLES_KERNEL_SAMPLE_WAKEUPS_SLACK);
+#endif
+}
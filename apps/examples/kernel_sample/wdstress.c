@@ -0,0 +1,210 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/kernel_sample/wdstress.c
+ *
+ * Arms thousands of POSIX timers, each backed by a watchdog, and measures
+ * how long arming and disarming one more timer takes while they are armed.
+ * That is one wd_start() and one wd_cancel() of a watchdog that expires
+ * after all the others, the worst case for a sorted list of watchdogs.
+ * Both run with interrupts disabled, so the time is close to the longest
+ * interrupt disabled windows that they cause with that many armed timers.
+ *
+ * The worst case is timed with the cycle counter of the CPU if
+ * CONFIG_EXAMPLES_KERNEL_SAMPLE_WDSTRESS_CYCLES is enabled.  Else it is
+ * timed with clock_gettime(), which only has the resolution of the system
+ * tick, and is reported in microseconds.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+
+#ifdef CONFIG_EXAMPLES_KERNEL_SAMPLE_WDSTRESS_CYCLES
+#  include <tinyara/arch.h>
+#endif
+
+#include "kernel_sample.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define WDSTRESS_NTIMERS     CONFIG_EXAMPLES_KERNEL_SAMPLE_WDSTRESS_NTIMERS
+#define WDSTRESS_LOOPS       1000
+
+/* No timer expires during the test */
+
+#define WDSTRESS_DELAY_SEC   3600
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+#define WDSTRESS_WDOGLIST    "timer wheel"
+#else
+#define WDSTRESS_WDOGLIST    "sorted list"
+#endif
+
+#ifdef CONFIG_EXAMPLES_KERNEL_SAMPLE_WDSTRESS_CYCLES
+#define WDSTRESS_MAXUNIT     "CYCLES"
+#else
+#define WDSTRESS_MAXUNIT     "US"
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint64_t wdstress_gettime(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_REALTIME, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* Time stamp for the worst case, in cycles or in microseconds */
+
+static uint32_t wdstress_stamp(void)
+{
+#ifdef CONFIG_EXAMPLES_KERNEL_SAMPLE_WDSTRESS_CYCLES
+	return up_cyclecount();
+#else
+	return (uint32_t)wdstress_gettime();
+#endif
+}
+
+static int wdstress_arm(timer_t timerid, int sec, int msec)
+{
+	struct itimerspec its;
+
+	memset(&its, 0, sizeof(its));
+	its.it_value.tv_sec = sec;
+	its.it_value.tv_nsec = msec * 1000000;
+	return timer_settime(timerid, 0, &its, NULL);
+}
+
+/* Start and cancel the probe timer behind 'armed' armed timers.  Reports
+ * the average and the worst time of one start and cancel.
+ */
+
+static void wdstress_probe(timer_t probe, int armed)
+{
+	uint64_t start;
+	uint32_t stamp;
+	uint32_t elapsed;
+	uint32_t worst = 0;
+	int i;
+
+	start = wdstress_gettime();
+	for (i = 0; i < WDSTRESS_LOOPS; i++) {
+		stamp = wdstress_stamp();
+		(void)wdstress_arm(probe, 2 * WDSTRESS_DELAY_SEC, 0);
+		(void)wdstress_arm(probe, 0, 0);
+
+		elapsed = wdstress_stamp() - stamp;
+		if (elapsed > worst) {
+			worst = elapsed;
+		}
+	}
+
+	printf("%6d | %15u | %12u\n", armed, (unsigned int)((wdstress_gettime() - start) * 1000 / WDSTRESS_LOOPS),
+		   (unsigned int)worst);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void wdstress_test(void)
+{
+	FAR timer_t *timers;
+	struct sigevent sigev;
+	timer_t probe;
+	uint64_t start;
+	uint64_t elapsed = 0;
+	int quarter;
+	int created;
+	int armed;
+
+	timers = (FAR timer_t *)malloc(WDSTRESS_NTIMERS * sizeof(timer_t));
+	if (timers == NULL) {
+		printf("wdstress_test: ERROR failed to allocate %d timers\n", WDSTRESS_NTIMERS);
+		return;
+	}
+
+	/* The timers never expire, so their signal is never sent */
+
+	memset(&sigev, 0, sizeof(sigev));
+	sigev.sigev_notify = SIGEV_SIGNAL;
+	sigev.sigev_signo = SIGUSR1;
+
+	if (timer_create(CLOCK_REALTIME, &sigev, &probe) != 0) {
+		printf("wdstress_test: ERROR timer_create failed\n");
+		free(timers);
+		return;
+	}
+
+	for (created = 0; created < WDSTRESS_NTIMERS; created++) {
+		if (timer_create(CLOCK_REALTIME, &sigev, &timers[created]) != 0) {
+			printf("wdstress_test: timer_create failed after %d timers\n", created);
+			break;
+		}
+	}
+
+	printf("wdstress_test: %d loops, %s of watchdogs\n", WDSTRESS_LOOPS, WDSTRESS_WDOGLIST);
+	printf(" ARMED | START+CANCEL NS | %12s\n", "MAX " WDSTRESS_MAXUNIT);
+	printf("-------|-----------------|-------------\n");
+
+	wdstress_probe(probe, 0);
+
+	/* Arm the timers in the order in which they expire and measure again
+	 * with a quarter, half, three quarters and all of them armed.
+	 */
+
+	armed = 0;
+	for (quarter = 1; quarter <= 4; quarter++) {
+		start = wdstress_gettime();
+		for (; armed < created * quarter / 4; armed++) {
+			(void)wdstress_arm(timers[armed], WDSTRESS_DELAY_SEC + armed / 1000, armed % 1000);
+		}
+
+		elapsed += wdstress_gettime() - start;
+		wdstress_probe(probe, armed);
+	}
+
+	if (created > 0) {
+		printf("wdstress_test: arming %d timers took %u us, %u ns per timer\n", created,
+			   (unsigned int)elapsed, (unsigned int)(elapsed * 1000 / created));
+	}
+
+	while (created > 0) {
+		(void)timer_delete(timers[--created]);
+	}
+
+	(void)timer_delete(probe);
+	free(timers);
+}
@@ -0,0 +1,270 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/mm_benchmark/arena.c
+ *
+ * Replays the allocations that the webserver makes to parse one request
+ * (receive buffer, header list, URL parameter list and divided URL query)
+ * with malloc()/free() and with an arena (CONFIG_MM_ARENA), and reports
+ * the number of heap allocations per request.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tinyara/mm/mm.h>
+
+#include "mm_benchmark.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define ARENA_BENCH_SEED       0xa7e4
+#define ARENA_BENCH_REQUESTS   (CONFIG_EXAMPLES_MM_BENCHMARK_ITERATIONS / 10)
+
+/* Sizes as configured in protocols/webserver/http_server.h */
+
+#define ARENA_BENCH_REQBUF     4096	/* HTTP_CONF_MAX_REQUEST_LENGTH */
+#define ARENA_BENCH_KEYVALUE   (32 + 256 + 2 * sizeof(void *))	/* struct http_keyvalue_t */
+#define ARENA_BENCH_PATHLEN    32	/* HTTP_CONF_MAX_DIVIDED_PATH_LENGTH */
+#define ARENA_BENCH_BLKSIZE    12288	/* HTTP_CONF_ARENA_BLOCK_SIZE */
+
+#define ARENA_BENCH_MAXHEADERS 16
+#define ARENA_BENCH_MAXPARAMS  4
+#define ARENA_BENCH_MAXSLASHES 4
+
+/* Number of live allocations of one request: the request buffer, the
+ * header and parameter lists with their head and tail, and the paths.
+ */
+
+#define ARENA_BENCH_MAXPTRS    (1 + ARENA_BENCH_MAXHEADERS + 2 + ARENA_BENCH_MAXPARAMS + 2 + 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Allocation interface of one run, either the heap or an arena */
+
+struct arena_bench_ops_s {
+	FAR void *(*alloc)(FAR void *priv, size_t size);
+	void (*release)(FAR void *priv, FAR void **ptrs, int nptrs);
+	FAR void *priv;
+	uint32_t nheapallocs;
+	uint32_t nbufmisses;		/* Receive buffers not from a regular block */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static FAR void *arena_bench_heap_alloc(FAR void *priv, size_t size)
+{
+	FAR struct arena_bench_ops_s *ops = (FAR struct arena_bench_ops_s *)priv;
+
+	ops->nheapallocs++;
+	return malloc(size);
+}
+
+static void arena_bench_heap_release(FAR void *priv, FAR void **ptrs, int nptrs)
+{
+	int i;
+
+	for (i = 0; i < nptrs; i++) {
+		free(ptrs[i]);
+	}
+}
+
+#ifdef CONFIG_MM_ARENA
+static FAR void *arena_bench_arena_alloc(FAR void *priv, size_t size)
+{
+	FAR struct arena_bench_ops_s *ops = (FAR struct arena_bench_ops_s *)priv;
+	FAR struct mm_arena_s *arena = (FAR struct mm_arena_s *)ops->priv;
+	FAR char *next = arena->next;
+	FAR void *mem;
+
+	/* The receive buffer is the first allocation after a reset, so it
+	 * must be taken from the start of the first block.
+	 */
+
+	mem = mm_arena_alloc(arena, size);
+	if (size == ARENA_BENCH_REQBUF && mem != (FAR void *)next) {
+		ops->nbufmisses++;
+	}
+
+	return mem;
+}
+
+static void arena_bench_arena_release(FAR void *priv, FAR void **ptrs, int nptrs)
+{
+	FAR struct arena_bench_ops_s *ops = (FAR struct arena_bench_ops_s *)priv;
+
+	mm_arena_reset((FAR struct mm_arena_s *)ops->priv);
+}
+#endif
+
+/* Allocate the memory of one request in the order of the webserver and
+ * release it again.  Some unrelated allocations are left alive in between,
+ * as other tasks would, so that the heap run also shows the fragmentation.
+ */
+
+static int arena_bench_request(FAR struct arena_bench_ops_s *ops, FAR uint32_t *seed)
+{
+	FAR void *ptrs[ARENA_BENCH_MAXPTRS];
+	int nheaders = 4 + mm_bench_rand(seed) % (ARENA_BENCH_MAXHEADERS - 3);
+	int nparams = mm_bench_rand(seed) % (ARENA_BENCH_MAXPARAMS + 1);
+	int nslashes = 1 + mm_bench_rand(seed) % ARENA_BENCH_MAXSLASHES;
+	int nptrs = 0;
+	int i;
+
+	/* http_recv_and_handle_request(): receive buffer and header list */
+
+	ptrs[nptrs++] = ops->alloc(ops, ARENA_BENCH_REQBUF);
+	ptrs[nptrs++] = ops->alloc(ops, ARENA_BENCH_KEYVALUE);
+	ptrs[nptrs++] = ops->alloc(ops, ARENA_BENCH_KEYVALUE);
+	for (i = 0; i < nheaders; i++) {
+		ptrs[nptrs++] = ops->alloc(ops, ARENA_BENCH_KEYVALUE);
+	}
+
+	/* http_dispatch_url(): divided query and parameter list */
+
+	ptrs[nptrs++] = ops->alloc(ops, nslashes * ARENA_BENCH_PATHLEN);
+	ptrs[nptrs++] = ops->alloc(ops, ARENA_BENCH_KEYVALUE);
+	ptrs[nptrs++] = ops->alloc(ops, ARENA_BENCH_KEYVALUE);
+	for (i = 0; i < nparams; i++) {
+		ptrs[nptrs++] = ops->alloc(ops, ARENA_BENCH_KEYVALUE);
+	}
+
+	for (i = 0; i < nptrs; i++) {
+		if (ptrs[i] == NULL) {
+			break;
+		}
+
+		memset(ptrs[i], 0, 4);
+	}
+
+	ops->release(ops, ptrs, nptrs);
+	return i == nptrs ? OK : ERROR;
+}
+
+static void arena_bench_run(FAR struct arena_bench_ops_s *ops, FAR struct mm_bench_result_s *result)
+{
+	FAR void *others[CONFIG_EXAMPLES_MM_BENCHMARK_SLOTS];
+	uint32_t seed = ARENA_BENCH_SEED;
+	uint64_t start;
+	int slot;
+	int i;
+
+	memset(result, 0, sizeof(struct mm_bench_result_s));
+	memset(others, 0, sizeof(others));
+
+	start = mm_bench_gettime();
+	for (i = 0; i < ARENA_BENCH_REQUESTS; i++) {
+		if (arena_bench_request(ops, &seed) != OK) {
+			result->nfails++;
+		}
+
+		/* Background allocations of other tasks */
+
+		slot = mm_bench_rand(&seed) % CONFIG_EXAMPLES_MM_BENCHMARK_SLOTS;
+		if (others[slot] != NULL) {
+			free(others[slot]);
+			others[slot] = NULL;
+		} else {
+			others[slot] = malloc(16 + mm_bench_rand(&seed) % 256);
+		}
+	}
+
+	result->elapsed = mm_bench_gettime() - start;
+	result->nops = ARENA_BENCH_REQUESTS;
+
+	mm_bench_mallinfo(&result->info);
+
+	for (slot = 0; slot < CONFIG_EXAMPLES_MM_BENCHMARK_SLOTS; slot++) {
+		free(others[slot]);
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int arena_benchmark(int argc, FAR char *argv[])
+{
+	struct arena_bench_ops_s ops;
+	struct mm_bench_result_s result;
+	uint32_t heapallocs;
+#ifdef CONFIG_MM_ARENA
+	FAR struct mm_arena_s *arena;
+#endif
+
+	printf("Arena benchmark: %d requests of the webserver parsing path\n", ARENA_BENCH_REQUESTS);
+
+	/* OPS/SEC is the number of requests per second */
+
+	mm_bench_print_header();
+
+	memset(&ops, 0, sizeof(ops));
+	ops.alloc = arena_bench_heap_alloc;
+	ops.release = arena_bench_heap_release;
+	arena_bench_run(&ops, &result);
+	mm_bench_print_result("heap", &result);
+	heapallocs = ops.nheapallocs;
+
+#ifdef CONFIG_MM_ARENA
+	arena = umm_arena_create(ARENA_BENCH_BLKSIZE);
+	if (arena == NULL) {
+		printf("Failed to create the arena\n");
+		return ERROR;
+	}
+
+	mm_arena_setlargesize(arena, ARENA_BENCH_REQBUF);
+
+	memset(&ops, 0, sizeof(ops));
+	ops.alloc = arena_bench_arena_alloc;
+	ops.release = arena_bench_arena_release;
+	ops.priv = arena;
+	arena_bench_run(&ops, &result);
+	mm_bench_print_result("arena", &result);
+
+	printf("\nHeap allocations per request: heap %u.%02u, arena %u.%02u (peak %u bytes)\n",
+		   heapallocs / ARENA_BENCH_REQUESTS, (heapallocs * 100 / ARENA_BENCH_REQUESTS) % 100,
+		   arena->nheapallocs / ARENA_BENCH_REQUESTS, (arena->nheapallocs * 100 / ARENA_BENCH_REQUESTS) % 100,
+		   arena->peak);
+
+	if (ops.nbufmisses > 0) {
+		printf("ERROR: the receive buffer did not come from the arena block in %u requests\n", ops.nbufmisses);
+	}
+
+	mm_arena_destroy(arena);
+#else
+	printf("\nHeap allocations per request: %u.%02u\n", heapallocs / ARENA_BENCH_REQUESTS,
+		   (heapallocs * 100 / ARENA_BENCH_REQUESTS) % 100);
+	printf("CONFIG_MM_ARENA is not enabled, only the heap was measured\n");
+#endif
+
+	return OK;
+}
@@ -0,0 +1,306 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/mm_benchmark/gran.c
+ *
+ * Measures the latency of granule allocations with the GAT filled to
+ * different levels.  The bit-at-a-time search of the previous granule
+ * allocator, serialized with a semaphore, is kept here as the reference.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <semaphore.h>
+
+#include <tinyara/mm/gran.h>
+
+#include "mm_benchmark.h"
+
+#if defined(CONFIG_GRAN) && !defined(CONFIG_GRAN_SINGLE)
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define GRAN_BENCH_SEED        0x96a1
+#define GRAN_BENCH_LOG2GRAN    6
+#define GRAN_BENCH_NGRANULES   512
+#define GRAN_BENCH_NGAT        (GRAN_BENCH_NGRANULES / 32)
+#define GRAN_BENCH_HEAPSIZE    (GRAN_BENCH_NGRANULES << GRAN_BENCH_LOG2GRAN)
+#define GRAN_BENCH_OPS         (CONFIG_EXAMPLES_MM_BENCHMARK_ITERATIONS / 10)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The GAT of the reference allocator */
+
+struct gran_bench_ref_s {
+	sem_t exclsem;
+	uint32_t gat[GRAN_BENCH_NGAT];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const unsigned int g_gran_bench_sizes[] = { 1, 4, 16 };
+static const unsigned int g_gran_bench_fills[] = { 0, 50, 90 };
+
+static struct gran_bench_ref_s g_gran_ref;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void gran_bench_ref_mark(unsigned int granno, unsigned int ngranules, bool alloc)
+{
+	unsigned int i;
+
+	for (i = granno; i < granno + ngranules; i++) {
+		if (alloc) {
+			g_gran_ref.gat[i >> 5] |= (uint32_t)1 << (i & 31);
+		} else {
+			g_gran_ref.gat[i >> 5] &= ~((uint32_t)1 << (i & 31));
+		}
+	}
+}
+
+/* The search of the previous gran_common_alloc() */
+
+static int gran_bench_ref_alloc(unsigned int ngranules)
+{
+	uint32_t curr;
+	uint32_t next;
+	uint32_t mask;
+	int granidx;
+	int bitidx;
+	int shift;
+
+	while (sem_wait(&g_gran_ref.exclsem) < 0) ;
+
+	mask = 0xffffffff >> (32 - ngranules);
+
+	for (granidx = 0; granidx < GRAN_BENCH_NGRANULES; granidx += 32) {
+		curr = g_gran_ref.gat[granidx >> 5];
+		if (curr == 0xffffffff) {
+			continue;
+		}
+
+		next = granidx + 32 < GRAN_BENCH_NGRANULES ? g_gran_ref.gat[(granidx >> 5) + 1] : 0xffffffff;
+
+		for (bitidx = 0; bitidx < 32 && (granidx + bitidx + ngranules) <= GRAN_BENCH_NGRANULES;) {
+			if (curr == 0xffffffff) {
+				break;
+			} else if ((curr & 0x0000ffff) == 0x0000ffff) {
+				shift = 16;
+			} else if ((curr & 0x000000ff) == 0x000000ff) {
+				shift = 8;
+			} else if ((curr & 0x0000000f) == 0x0000000f) {
+				shift = 4;
+			} else if ((curr & 0x00000003) == 0x00000003) {
+				shift = 2;
+			} else if ((curr & mask) == 0) {
+				gran_bench_ref_mark(granidx + bitidx, ngranules, true);
+				sem_post(&g_gran_ref.exclsem);
+				return granidx + bitidx;
+			} else {
+				shift = 1;
+			}
+
+			curr    = (curr >> shift) | (next << (32 - shift));
+			next  >>= shift;
+			bitidx += shift;
+		}
+	}
+
+	sem_post(&g_gran_ref.exclsem);
+	return ERROR;
+}
+
+static void gran_bench_ref_free(unsigned int granno, unsigned int ngranules)
+{
+	while (sem_wait(&g_gran_ref.exclsem) < 0) ;
+	gran_bench_ref_mark(granno, ngranules, false);
+	sem_post(&g_gran_ref.exclsem);
+}
+
+/* Allocate every granule of both allocators and release the same random
+ * granules in both until only 'fill' percent remain allocated.
+ */
+
+static int gran_bench_fill(GRAN_HANDLE handle, FAR char *heap, unsigned int fill)
+{
+	uint32_t seed = GRAN_BENCH_SEED;
+	unsigned int nfree;
+	unsigned int granno;
+
+	memset(g_gran_ref.gat, 0xff, sizeof(g_gran_ref.gat));
+	for (granno = 0; granno < GRAN_BENCH_NGRANULES; granno++) {
+		if (gran_alloc(handle, 1) != heap + (granno << GRAN_BENCH_LOG2GRAN)) {
+			return ERROR;
+		}
+	}
+
+	nfree = GRAN_BENCH_NGRANULES * (100 - fill) / 100;
+	while (nfree > 0) {
+		granno = mm_bench_rand(&seed) % GRAN_BENCH_NGRANULES;
+		if (g_gran_ref.gat[granno >> 5] & ((uint32_t)1 << (granno & 31))) {
+			gran_bench_ref_mark(granno, 1, false);
+			gran_free(handle, heap + (granno << GRAN_BENCH_LOG2GRAN), 1);
+			nfree--;
+		}
+	}
+
+	return OK;
+}
+
+static void gran_bench_drain(GRAN_HANDLE handle, FAR char *heap)
+{
+	unsigned int granno;
+
+	for (granno = 0; granno < GRAN_BENCH_NGRANULES; granno++) {
+		if (g_gran_ref.gat[granno >> 5] & ((uint32_t)1 << (granno & 31))) {
+			gran_free(handle, heap + (granno << GRAN_BENCH_LOG2GRAN), 1);
+		}
+	}
+}
+
+/* Returns the average time of one allocation and release in nanoseconds */
+
+static uint32_t gran_bench_run_ref(unsigned int ngranules, FAR uint32_t *nfails)
+{
+	uint64_t start;
+	int granno;
+	int i;
+
+	*nfails = 0;
+	start = mm_bench_gettime();
+	for (i = 0; i < GRAN_BENCH_OPS; i++) {
+		granno = gran_bench_ref_alloc(ngranules);
+		if (granno < 0) {
+			(*nfails)++;
+		} else {
+			gran_bench_ref_free(granno, ngranules);
+		}
+	}
+
+	return (uint32_t)((mm_bench_gettime() - start) * 1000 / GRAN_BENCH_OPS);
+}
+
+static uint32_t gran_bench_run_gran(GRAN_HANDLE handle, unsigned int ngranules, FAR uint32_t *nfails)
+{
+	size_t size = ngranules << GRAN_BENCH_LOG2GRAN;
+	uint64_t start;
+	FAR void *mem;
+	int i;
+
+	*nfails = 0;
+	start = mm_bench_gettime();
+	for (i = 0; i < GRAN_BENCH_OPS; i++) {
+		mem = gran_alloc(handle, size);
+		if (mem == NULL) {
+			(*nfails)++;
+		} else {
+			gran_free(handle, mem, size);
+		}
+	}
+
+	return (uint32_t)((mm_bench_gettime() - start) * 1000 / GRAN_BENCH_OPS);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int gran_benchmark(int argc, FAR char *argv[])
+{
+	GRAN_HANDLE handle;
+	FAR char *heap;
+	uint32_t reffails;
+	uint32_t granfails;
+	uint32_t refns;
+	uint32_t granns;
+	int fill;
+	int size;
+
+	heap = (FAR char *)memalign(1 << GRAN_BENCH_LOG2GRAN, GRAN_BENCH_HEAPSIZE);
+	if (heap == NULL) {
+		printf("Failed to allocate the granule heap\n");
+		return ERROR;
+	}
+
+	handle = gran_initialize(heap, GRAN_BENCH_HEAPSIZE, GRAN_BENCH_LOG2GRAN, GRAN_BENCH_LOG2GRAN);
+	if (handle == NULL) {
+		printf("Failed to initialize the granule allocator\n");
+		free(heap);
+		return ERROR;
+	}
+
+	sem_init(&g_gran_ref.exclsem, 0, 1);
+
+	printf("Granule benchmark: %d alloc/free of %d granules of %d bytes\n", GRAN_BENCH_OPS, GRAN_BENCH_NGRANULES, 1 << GRAN_BENCH_LOG2GRAN);
+	printf("\n%8s | %5s | %9s | %9s | %7s | %5s\n", "GRANULES", "FILL%", "REF NS/OP", "NEW NS/OP", "SPEEDUP", "FAILS");
+	printf("---------|-------|-----------|-----------|---------|------\n");
+
+	for (fill = 0; fill < sizeof(g_gran_bench_fills) / sizeof(g_gran_bench_fills[0]); fill++) {
+		if (gran_bench_fill(handle, heap, g_gran_bench_fills[fill]) != OK) {
+			printf("The granule heap is not empty\n");
+			break;
+		}
+
+		for (size = 0; size < sizeof(g_gran_bench_sizes) / sizeof(g_gran_bench_sizes[0]); size++) {
+			refns = gran_bench_run_ref(g_gran_bench_sizes[size], &reffails);
+			granns = gran_bench_run_gran(handle, g_gran_bench_sizes[size], &granfails);
+
+			printf("%8u | %5u | %9u | %9u | %4u.%02u | %5u\n", g_gran_bench_sizes[size], g_gran_bench_fills[fill],
+				   refns, granns, refns / (granns > 0 ? granns : 1), (refns * 100 / (granns > 0 ? granns : 1)) % 100,
+				   granfails);
+
+			if (reffails != granfails) {
+				printf("  mismatch: the reference failed %u times\n", reffails);
+			}
+		}
+
+		gran_bench_drain(handle, heap);
+	}
+
+	sem_destroy(&g_gran_ref.exclsem);
+	gran_release(handle);
+	free(heap);
+	return OK;
+}
+
+#else
+
+int gran_benchmark(int argc, FAR char *argv[])
+{
+	printf("Needs CONFIG_GRAN without CONFIG_GRAN_SINGLE\n");
+	return ERROR;
+}
+
+#endif
@@ -0,0 +1,96 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __APPS_EXAMPLES_MM_BENCHMARK_MM_BENCHMARK_H
+#define __APPS_EXAMPLES_MM_BENCHMARK_MM_BENCHMARK_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_EXAMPLES_MM_BENCHMARK_ITERATIONS
+#  define CONFIG_EXAMPLES_MM_BENCHMARK_ITERATIONS 100000
+#endif
+
+#ifndef CONFIG_EXAMPLES_MM_BENCHMARK_SLOTS
+#  define CONFIG_EXAMPLES_MM_BENCHMARK_SLOTS 256
+#endif
+
+#ifndef CONFIG_EXAMPLES_MM_BENCHMARK_THREADS
+#  define CONFIG_EXAMPLES_MM_BENCHMARK_THREADS 4
+#endif
+
+#ifndef CONFIG_EXAMPLES_MM_BENCHMARK_DURATION
+#  define CONFIG_EXAMPLES_MM_BENCHMARK_DURATION 5
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The result of one benchmark run */
+
+struct mm_bench_result_s {
+	uint32_t nops;				/* Number of malloc/free operations */
+	uint32_t nfails;			/* Number of failed allocations */
+	uint64_t elapsed;			/* Elapsed time in microseconds */
+	struct mallinfo info;		/* Heap state with the working set allocated */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* mm_benchmark_main.c ******************************************************/
+
+uint64_t mm_bench_gettime(void);
+uint32_t mm_bench_rand(FAR uint32_t *seed);
+void mm_bench_mallinfo(FAR struct mallinfo *info);
+void mm_bench_print_header(void);
+void mm_bench_print_result(FAR const char *name, FAR struct mm_bench_result_s *result);
+
+/* slab.c *******************************************************************/
+
+int slab_benchmark(int argc, FAR char *argv[]);
+
+/* tlcache.c ****************************************************************/
+
+int tlcache_benchmark(int argc, FAR char *argv[]);
+
+/* arena.c ******************************************************************/
+
+int arena_benchmark(int argc, FAR char *argv[]);
+
+/* gran.c *******************************************************************/
+
+int gran_benchmark(int argc, FAR char *argv[]);
+
+/* realloc.c ****************************************************************/
+
+int realloc_benchmark(int argc, FAR char *argv[]);
+
+#endif /* __APPS_EXAMPLES_MM_BENCHMARK_MM_BENCHMARK_H */
@@ -0,0 +1,183 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/mm_benchmark/mm_benchmark_main.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "mm_benchmark.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct mm_benchmark_s {
+	FAR const char *name;
+	FAR const char *desc;
+	int (*func)(int argc, FAR char *argv[]);
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct mm_benchmark_s g_benchmarks[] = {
+	{"slab", "small object alloc/free with and without the slab front-end", slab_benchmark},
+	{"tlcache", "concurrent alloc/free with and without per-thread caches", tlcache_benchmark},
+	{"arena", "webserver request allocations with malloc/free and with an arena", arena_benchmark},
+	{"gran", "granule alloc/free latency against the previous bitmap search", gran_benchmark},
+	{"realloc", "growing buffers with realloc and with malloc/memcpy/free", realloc_benchmark},
+};
+
+#define NBENCHMARKS (sizeof(g_benchmarks) / sizeof(g_benchmarks[0]))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(FAR const char *progname)
+{
+	int i;
+
+	printf("\nUsage: %s <benchmark> [options]\n", progname);
+	printf("\nBenchmarks:\n");
+	for (i = 0; i < NBENCHMARKS; i++) {
+		printf("  %-10s %s\n", g_benchmarks[i].name, g_benchmarks[i].desc);
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_bench_gettime
+ *
+ * Description:
+ *   Return the current time in microseconds.
+ *
+ ****************************************************************************/
+
+uint64_t mm_bench_gettime(void)
+{
+	struct timespec ts;
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+	(void)clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/****************************************************************************
+ * Name: mm_bench_rand
+ *
+ * Description:
+ *   A small linear congruential generator.  Every run with the same seed
+ *   produces the same sequence, so that runs can be compared.
+ *
+ ****************************************************************************/
+
+uint32_t mm_bench_rand(FAR uint32_t *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	return (*seed >> 16) & 0x7fff;
+}
+
+/****************************************************************************
+ * Name: mm_bench_mallinfo
+ ****************************************************************************/
+
+void mm_bench_mallinfo(FAR struct mallinfo *info)
+{
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	*info = mallinfo();
+#else
+	(void)mallinfo(info);
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_bench_print_header / mm_bench_print_result
+ *
+ * Description:
+ *   Print the throughput and the heap fragmentation of one run.  The
+ *   fragmentation index is the part of the free memory that is not in the
+ *   largest free chunk.
+ *
+ ****************************************************************************/
+
+void mm_bench_print_header(void)
+{
+	printf("\n%-12s | %9s | %7s | %5s | %8s | %8s | %6s | %5s\n", "RUN", "OPS/SEC", "NS/OP", "FAILS", "FREE", "LARGEST", "CHUNKS", "FRAG%");
+	printf("-------------|-----------|---------|-------|----------|----------|--------|------\n");
+}
+
+void mm_bench_print_result(FAR const char *name, FAR struct mm_bench_result_s *result)
+{
+	uint64_t elapsed = result->elapsed > 0 ? result->elapsed : 1;
+	int frag = 0;
+
+	if (result->info.fordblks > 0) {
+		frag = 100 - (int)(((uint64_t)result->info.mxordblk * 100) / result->info.fordblks);
+	}
+
+	printf("%-12s | %9u | %7u | %5u | %8d | %8d | %6d | %5d\n", name,
+		   (unsigned int)(((uint64_t)result->nops * 1000000) / elapsed),
+		   (unsigned int)((elapsed * 1000) / (result->nops > 0 ? result->nops : 1)),
+		   result->nfails, result->info.fordblks, result->info.mxordblk,
+		   result->info.ordblks, frag);
+}
+
+/****************************************************************************
+ * mm_benchmark_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int mm_benchmark_main(int argc, char *argv[])
+#endif
+{
+	int i;
+
+	if (argc < 2) {
+		show_usage(argv[0]);
+		return ERROR;
+	}
+
+	for (i = 0; i < NBENCHMARKS; i++) {
+		if (strcmp(argv[1], g_benchmarks[i].name) == 0) {
+			return g_benchmarks[i].func(argc - 1, &argv[1]);
+		}
+	}
+
+	printf("Unknown benchmark: %s\n", argv[1]);
+	show_usage(argv[0]);
+	return ERROR;
+}
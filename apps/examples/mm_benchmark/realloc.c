@@ -0,0 +1,240 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/mm_benchmark/realloc.c
+ *
+ * Grows a set of buffers with realloc(), either geometrically or by small
+ * appends, while other allocations come and go around them, and counts how
+ * often the data had to be moved and how many bytes were copied.  Each
+ * pattern is run with realloc() and with malloc()/memcpy()/free(), which
+ * always copies.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tinyara/mm/mm.h>
+
+#include "mm_benchmark.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define REALLOC_BENCH_SEED     0x5eed
+#define REALLOC_BENCH_NBUFS    8
+#define REALLOC_BENCH_MINSIZE  32
+#define REALLOC_BENCH_MAXSIZE  8192
+#define REALLOC_BENCH_ROUNDS   (CONFIG_EXAMPLES_MM_BENCHMARK_ITERATIONS / 1000)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Counters of one run */
+
+struct realloc_bench_s {
+	uint32_t nreallocs;			/* Number of resize operations */
+	uint32_t nmoved;			/* Operations that returned a new address */
+	uint32_t nfails;			/* Failed operations */
+	uint64_t copied;			/* Bytes of data at the old address */
+	uint64_t grown;				/* Bytes added to the buffers */
+	uint64_t elapsed;			/* Elapsed time in microseconds */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* realloc() replaced by a new allocation and a copy */
+
+static FAR void *realloc_bench_copy(FAR void *oldmem, size_t oldsize, size_t newsize)
+{
+	FAR void *newmem;
+
+	newmem = malloc(newsize);
+	if (newmem) {
+		memcpy(newmem, oldmem, oldsize < newsize ? oldsize : newsize);
+		free(oldmem);
+	}
+
+	return newmem;
+}
+
+/* Grow REALLOC_BENCH_NBUFS buffers in turn from REALLOC_BENCH_MINSIZE up to
+ * REALLOC_BENCH_MAXSIZE, by half of their size if 'geometric' or by a
+ * random append of 16-80 bytes otherwise.  A small allocation is made or
+ * released between two steps, so that the buffers do not always have free
+ * neighbors.
+ */
+
+static void realloc_bench_run(bool geometric, bool copy, FAR struct realloc_bench_s *bench)
+{
+	FAR char *bufs[REALLOC_BENCH_NBUFS];
+	size_t sizes[REALLOC_BENCH_NBUFS];
+	FAR void *others[CONFIG_EXAMPLES_MM_BENCHMARK_SLOTS];
+	uint32_t seed = REALLOC_BENCH_SEED;
+	uint64_t start;
+	FAR char *newbuf;
+	size_t newsize;
+	int round;
+	int slot;
+	int done;
+	int i;
+
+	memset(bench, 0, sizeof(struct realloc_bench_s));
+	memset(others, 0, sizeof(others));
+
+	start = mm_bench_gettime();
+	for (round = 0; round < REALLOC_BENCH_ROUNDS; round++) {
+		for (i = 0; i < REALLOC_BENCH_NBUFS; i++) {
+			bufs[i] = malloc(REALLOC_BENCH_MINSIZE);
+			sizes[i] = bufs[i] ? REALLOC_BENCH_MINSIZE : 0;
+		}
+
+		do {
+			done = 0;
+			for (i = 0; i < REALLOC_BENCH_NBUFS; i++) {
+				if (bufs[i] == NULL || sizes[i] >= REALLOC_BENCH_MAXSIZE) {
+					done++;
+					continue;
+				}
+
+				if (geometric) {
+					newsize = sizes[i] + sizes[i] / 2;
+				} else {
+					newsize = sizes[i] + 16 + mm_bench_rand(&seed) % 65;
+				}
+
+				if (newsize > REALLOC_BENCH_MAXSIZE) {
+					newsize = REALLOC_BENCH_MAXSIZE;
+				}
+
+				if (copy) {
+					newbuf = (FAR char *)realloc_bench_copy(bufs[i], sizes[i], newsize);
+				} else {
+					newbuf = (FAR char *)realloc(bufs[i], newsize);
+				}
+
+				bench->nreallocs++;
+				if (newbuf == NULL) {
+					bench->nfails++;
+					free(bufs[i]);
+					bufs[i] = NULL;
+					continue;
+				}
+
+				if (newbuf != bufs[i]) {
+					bench->nmoved++;
+					bench->copied += sizes[i];
+				}
+
+				/* Write the new part as an appending user would */
+
+				memset(newbuf + sizes[i], (int)i, newsize - sizes[i]);
+				bench->grown += newsize - sizes[i];
+				bufs[i] = newbuf;
+				sizes[i] = newsize;
+
+				/* Background allocations of other tasks */
+
+				slot = mm_bench_rand(&seed) % CONFIG_EXAMPLES_MM_BENCHMARK_SLOTS;
+				if (others[slot] != NULL) {
+					free(others[slot]);
+					others[slot] = NULL;
+				} else {
+					others[slot] = malloc(16 + mm_bench_rand(&seed) % 256);
+				}
+			}
+		} while (done < REALLOC_BENCH_NBUFS);
+
+		for (i = 0; i < REALLOC_BENCH_NBUFS; i++) {
+			free(bufs[i]);
+		}
+	}
+
+	bench->elapsed = mm_bench_gettime() - start;
+
+	for (slot = 0; slot < CONFIG_EXAMPLES_MM_BENCHMARK_SLOTS; slot++) {
+		free(others[slot]);
+	}
+}
+
+static void realloc_bench_print(FAR const char *name, FAR struct realloc_bench_s *bench)
+{
+	uint64_t grown = bench->grown > 0 ? bench->grown : 1;
+
+	printf("%-18s | %8u | %7u | %8u | %5u | %10llu | %9u.%02u\n", name, bench->nreallocs,
+		   (unsigned int)((bench->elapsed * 1000) / (bench->nreallocs > 0 ? bench->nreallocs : 1)),
+		   bench->nmoved, bench->nfails, (unsigned long long)bench->copied,
+		   (unsigned int)(bench->copied / grown), (unsigned int)((bench->copied * 100 / grown) % 100));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int realloc_benchmark(int argc, FAR char *argv[])
+{
+	struct realloc_bench_s bench;
+#ifdef CONFIG_MM_REALLOC_STATS
+	struct mm_reallocinfo_s before;
+	struct mm_reallocinfo_s after;
+#endif
+	int geometric;
+
+	printf("Realloc benchmark: %d rounds of %d buffers grown from %d to %d bytes\n", REALLOC_BENCH_ROUNDS,
+		   REALLOC_BENCH_NBUFS, REALLOC_BENCH_MINSIZE, REALLOC_BENCH_MAXSIZE);
+
+	/* COPIED/GROWN is the number of bytes copied per byte added */
+
+	printf("\n%-18s | %8s | %7s | %8s | %5s | %10s | %12s\n", "RUN", "REALLOCS", "NS/OP", "MOVED", "FAILS", "COPIED", "COPIED/GROWN");
+	printf("-------------------|----------|---------|----------|-------|------------|-------------\n");
+
+	for (geometric = 1; geometric >= 0; geometric--) {
+		realloc_bench_run(geometric, true, &bench);
+		realloc_bench_print(geometric ? "geometric copy" : "append copy", &bench);
+
+#ifdef CONFIG_MM_REALLOC_STATS
+		(void)umm_reallocinfo(&before);
+#endif
+		realloc_bench_run(geometric, false, &bench);
+		realloc_bench_print(geometric ? "geometric realloc" : "append realloc", &bench);
+#ifdef CONFIG_MM_REALLOC_STATS
+		(void)umm_reallocinfo(&after);
+		printf("%-18s   in place %u, memmove %u, copied %u, %u bytes\n", "",
+			   after.nkeep + after.ngrow - before.nkeep - before.ngrow, after.nmove - before.nmove,
+			   after.ncopy - before.ncopy, after.copied - before.copied);
+#endif
+	}
+
+#ifndef CONFIG_MM_REALLOC_STATS
+	printf("\nCONFIG_MM_REALLOC_STATS is not enabled, the heap counters are not shown\n");
+#endif
+
+	return OK;
+}
@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/mm_benchmark/slab.c
+ *
+ * Compares the small object throughput and the heap fragmentation with and
+ * without the slab front-end of the heap (CONFIG_MM_SLAB).
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tinyara/mm/mm.h>
+
+#include "mm_benchmark.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define SLAB_BENCH_SEED      0x5eed
+#define SLAB_BENCH_MINSIZE   16
+#define SLAB_BENCH_MAXSIZE   128
+
+/* One slot out of SLAB_BENCH_LARGE_RATIO holds a larger buffer, like the
+ * packet and media buffers that are mixed with small objects in practice.
+ */
+
+#define SLAB_BENCH_LARGE_RATIO 16
+#define SLAB_BENCH_LARGE_MIN   256
+#define SLAB_BENCH_LARGE_MAX   2048
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR void *g_slots[CONFIG_EXAMPLES_MM_BENCHMARK_SLOTS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static size_t slab_bench_size(int slot, FAR uint32_t *seed)
+{
+	if ((slot % SLAB_BENCH_LARGE_RATIO) == 0) {
+		return SLAB_BENCH_LARGE_MIN + mm_bench_rand(seed) % (SLAB_BENCH_LARGE_MAX - SLAB_BENCH_LARGE_MIN);
+	}
+
+	return SLAB_BENCH_MINSIZE + mm_bench_rand(seed) % (SLAB_BENCH_MAXSIZE - SLAB_BENCH_MINSIZE + 1);
+}
+
+static void slab_bench_run(FAR struct mm_bench_result_s *result)
+{
+	uint32_t seed = SLAB_BENCH_SEED;
+	uint64_t start;
+	int slot;
+	int i;
+
+	memset(result, 0, sizeof(struct mm_bench_result_s));
+	memset(g_slots, 0, sizeof(g_slots));
+
+	start = mm_bench_gettime();
+	for (i = 0; i < CONFIG_EXAMPLES_MM_BENCHMARK_ITERATIONS; i++) {
+		slot = mm_bench_rand(&seed) % CONFIG_EXAMPLES_MM_BENCHMARK_SLOTS;
+		if (g_slots[slot] != NULL) {
+			free(g_slots[slot]);
+			g_slots[slot] = NULL;
+		} else {
+			g_slots[slot] = malloc(slab_bench_size(slot, &seed));
+			if (g_slots[slot] == NULL) {
+				result->nfails++;
+			} else {
+				*(FAR char *)g_slots[slot] = (char)slot;
+			}
+		}
+	}
+
+	result->elapsed = mm_bench_gettime() - start;
+	result->nops = CONFIG_EXAMPLES_MM_BENCHMARK_ITERATIONS;
+
+	/* Sample the fragmentation while the working set is still allocated */
+
+	mm_bench_mallinfo(&result->info);
+
+	for (slot = 0; slot < CONFIG_EXAMPLES_MM_BENCHMARK_SLOTS; slot++) {
+		free(g_slots[slot]);
+		g_slots[slot] = NULL;
+	}
+}
+
+#ifdef CONFIG_MM_SLAB
+static void slab_bench_show_classes(void)
+{
+	struct mm_slabinfo_s info;
+	int ndx;
+
+	printf("\n%6s | %5s | %6s | %6s | %10s | %10s\n", "CHUNK", "PAGES", "USED", "FREE", "ALLOCS", "MISSES");
+	printf("-------|-------|--------|--------|------------|------------\n");
+	for (ndx = 0; ndx < MM_SLAB_NCLASSES; ndx++) {
+		if (mm_slab_info(&g_mmheap, ndx, &info) == OK && info.nallocs + info.nmisses > 0) {
+			printf("%6u | %5d | %6d | %6d | %10u | %10u\n", info.chunksize, info.npages, info.nused, info.nfree, info.nallocs, info.nmisses);
+		}
+	}
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int slab_benchmark(int argc, FAR char *argv[])
+{
+	struct mm_bench_result_s result;
+
+	printf("Slab benchmark: %d operations, %d slots, %d-%d bytes (1/%d up to %d bytes)\n",
+		   CONFIG_EXAMPLES_MM_BENCHMARK_ITERATIONS, CONFIG_EXAMPLES_MM_BENCHMARK_SLOTS,
+		   SLAB_BENCH_MINSIZE, SLAB_BENCH_MAXSIZE, SLAB_BENCH_LARGE_RATIO, SLAB_BENCH_LARGE_MAX);
+
+	mm_bench_print_header();
+
+#ifdef CONFIG_MM_SLAB
+	mm_slab_enable(&g_mmheap, false);
+	slab_bench_run(&result);
+	mm_bench_print_result("heap", &result);
+
+	mm_slab_enable(&g_mmheap, true);
+	slab_bench_run(&result);
+	mm_bench_print_result("slab", &result);
+
+	slab_bench_show_classes();
+#else
+	slab_bench_run(&result);
+	mm_bench_print_result("heap", &result);
+
+	printf("\nCONFIG_MM_SLAB is not enabled, only the heap was measured\n");
+#endif
+
+	return OK;
+}
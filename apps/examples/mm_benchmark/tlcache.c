@@ -0,0 +1,204 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * examples/mm_benchmark/tlcache.c
+ *
+ * Measures the malloc/free throughput of several threads that allocate
+ * concurrently, with and without the per-thread allocation caches of the
+ * user heap (CONFIG_MM_TLCACHE).
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include <tinyara/mm/mm.h>
+
+#include "mm_benchmark.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define TLCACHE_BENCH_MAXTHREADS 16
+#define TLCACHE_BENCH_WINDOW     8
+#define TLCACHE_BENCH_MINSIZE    16
+#define TLCACHE_BENCH_MAXSIZE    128
+
+/* The time is checked once per this number of operations */
+
+#define TLCACHE_BENCH_BATCH      256
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct tlcache_bench_thread_s {
+	pthread_t thread;
+	bool usecache;
+	uint64_t deadline;
+	uint32_t nallocs;
+	uint32_t nfails;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Each thread keeps a small window of live allocations and replaces the
+ * oldest one in each step.  The sizes repeat, as they do for the message
+ * and control blocks of network and IPC code.
+ */
+
+static FAR void *tlcache_bench_thread(FAR void *arg)
+{
+	FAR struct tlcache_bench_thread_s *priv = (FAR struct tlcache_bench_thread_s *)arg;
+	FAR void *window[TLCACHE_BENCH_WINDOW];
+	uint32_t seed = (uint32_t)getpid();
+	size_t size;
+	int slot = 0;
+	int i;
+
+#ifdef CONFIG_MM_TLCACHE
+	if (priv->usecache && umm_tlcache_enable(true) != OK) {
+		printf("Failed to enable the allocation cache\n");
+	}
+#endif
+
+	memset(window, 0, sizeof(window));
+
+	while (mm_bench_gettime() < priv->deadline) {
+		for (i = 0; i < TLCACHE_BENCH_BATCH; i++) {
+			free(window[slot]);
+
+			size = TLCACHE_BENCH_MINSIZE + mm_bench_rand(&seed) % (TLCACHE_BENCH_MAXSIZE - TLCACHE_BENCH_MINSIZE + 1);
+			window[slot] = malloc(size);
+			if (window[slot] == NULL) {
+				priv->nfails++;
+			} else {
+				priv->nallocs++;
+			}
+
+			slot = (slot + 1) % TLCACHE_BENCH_WINDOW;
+		}
+	}
+
+	for (i = 0; i < TLCACHE_BENCH_WINDOW; i++) {
+		free(window[i]);
+	}
+
+#ifdef CONFIG_MM_TLCACHE
+	(void)umm_tlcache_enable(false);
+#endif
+
+	return NULL;
+}
+
+static int tlcache_bench_run(int nthreads, int seconds, bool usecache, FAR struct mm_bench_result_s *result)
+{
+	struct tlcache_bench_thread_s threads[TLCACHE_BENCH_MAXTHREADS];
+	uint64_t start;
+	int ret;
+	int i;
+
+	memset(result, 0, sizeof(struct mm_bench_result_s));
+	memset(threads, 0, sizeof(threads));
+
+	start = mm_bench_gettime();
+	for (i = 0; i < nthreads; i++) {
+		threads[i].usecache = usecache;
+		threads[i].deadline = start + (uint64_t)seconds * 1000000;
+
+		ret = pthread_create(&threads[i].thread, NULL, tlcache_bench_thread, &threads[i]);
+		if (ret != OK) {
+			printf("pthread_create failed: %d\n", ret);
+			nthreads = i;
+			break;
+		}
+	}
+
+	for (i = 0; i < nthreads; i++) {
+		pthread_join(threads[i].thread, NULL);
+		result->nops   += threads[i].nallocs;
+		result->nfails += threads[i].nfails;
+	}
+
+	result->elapsed = mm_bench_gettime() - start;
+	mm_bench_mallinfo(&result->info);
+
+	return nthreads > 0 ? OK : ERROR;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int tlcache_benchmark(int argc, FAR char *argv[])
+{
+	struct mm_bench_result_s result;
+	int nthreads = CONFIG_EXAMPLES_MM_BENCHMARK_THREADS;
+	int seconds = CONFIG_EXAMPLES_MM_BENCHMARK_DURATION;
+
+	if (argc > 1) {
+		nthreads = atoi(argv[1]);
+	}
+
+	if (argc > 2) {
+		seconds = atoi(argv[2]);
+	}
+
+	if (nthreads < 1 || nthreads > TLCACHE_BENCH_MAXTHREADS || seconds < 1) {
+		printf("Usage: tlcache [<threads 1-%d> [<seconds>]]\n", TLCACHE_BENCH_MAXTHREADS);
+		return ERROR;
+	}
+
+	printf("Allocation cache benchmark: %d threads, %d seconds, %d-%d bytes\n",
+		   nthreads, seconds, TLCACHE_BENCH_MINSIZE, TLCACHE_BENCH_MAXSIZE);
+
+	/* OPS/SEC is the number of allocations per second of all threads */
+
+	mm_bench_print_header();
+
+	if (tlcache_bench_run(nthreads, seconds, false, &result) != OK) {
+		return ERROR;
+	}
+
+	mm_bench_print_result("heap", &result);
+
+#ifdef CONFIG_MM_TLCACHE
+	if (tlcache_bench_run(nthreads, seconds, true, &result) != OK) {
+		return ERROR;
+	}
+
+	mm_bench_print_result("tlcache", &result);
+#else
+	printf("\nCONFIG_MM_TLCACHE is not enabled, only the heap was measured\n");
+#endif
+
+	return OK;
+}
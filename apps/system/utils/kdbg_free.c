@@ -56,6 +56,33 @@
 #include <tinyara/config.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#if defined(CONFIG_MM_FRAGINFO) || defined(CONFIG_MM_COMPACT)
+#include <tinyara/mm/mm.h>
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+#ifdef CONFIG_MM_FRAGINFO
+static void kdbg_free_fraginfo(void)
+{
+	struct mm_fraginfo_s frag;
+	int bin;
+
+	if (umm_fraginfo(&frag) != OK) {
+		return;
+	}
+
+	printf("\nFree chunks: %u, largest: %u, fragmentation: %d%%\n", frag.nfree, frag.largest, frag.fragindex);
+	printf("  %10s %8s\n", "CHUNK >=", "COUNT");
+	for (bin = 0; bin < MM_NNODES; bin++) {
+		if (frag.nchunks[bin] > 0) {
+			printf("  %10u %8u\n", MM_MIN_CHUNK << bin, frag.nchunks[bin]);
+		}
+	}
+}
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -64,6 +91,24 @@ int kdbg_free(int argc, char **args)
 {
 	struct mallinfo data;
 
+	if (argc > 1) {
+#ifdef CONFIG_MM_COMPACT
+		if (strcmp(args[1], "-c") == 0) {
+			printf("Compaction released %u bytes\n", umm_compact());
+		} else
+#endif
+		{
+			printf("Usage: free");
+#ifdef CONFIG_MM_COMPACT
+			printf(" [-c]\n");
+			printf(" -c    Compact the heap before showing it\n");
+#else
+			printf("\n");
+#endif
+			return ERROR;
+		}
+	}
+
 #ifdef CONFIG_CAN_PASS_STRUCTS
 	data = mallinfo();
 #else
@@ -73,5 +118,9 @@ int kdbg_free(int argc, char **args)
 	printf("              total       used       free    largest\n");
 	printf("Data:   %11d%11d%11d%11d\n", data.arena, data.uordblks, data.fordblks, data.mxordblk);
 
+#ifdef CONFIG_MM_FRAGINFO
+	kdbg_free_fraginfo();
+#endif
+
 	return OK;
 }
@@ -65,6 +65,50 @@ static void kdbg_heapinfo_task(FAR struct tcb_s *tcb, FAR void *arg)
 }
 #endif
 
+#ifdef CONFIG_DEBUG_MM_HEAPINFO_STATS
+static int kdbg_heapinfo_stats(struct mm_heap_s *heap)
+{
+	struct heapinfo_stats_s *stats;
+	int ndx;
+
+	/* Copy the incremental statistics, this does not walk the heap */
+
+	stats = (struct heapinfo_stats_s *)malloc(sizeof(struct heapinfo_stats_s));
+	if (stats == NULL) {
+		printf("Not enough memory for the statistics\n");
+		return ERROR;
+	}
+	heapinfo_stats_snapshot(heap, stats);
+
+	printf("Current Allocated Size : %u\n", stats->total_alloc_size);
+	printf("Peak Allocated Size    : %u\n", stats->peak_alloc_size);
+
+	printf("\n%5s | %6s | %9s | %9s\n", "PID", "CHUNKS", "CURR_HEAP", "PEAK_HEAP");
+	printf("------|--------|-----------|----------\n");
+	for (ndx = 0; ndx < CONFIG_MAX_TASKS; ndx++) {
+		if (stats->pid[ndx].nallocs > 0 || stats->pid[ndx].peak_size > 0) {
+			printf("%4d%c | %6u | %9u | %9u\n", stats->pid[ndx].pid, sched_gettcb(stats->pid[ndx].pid) ? ' ' : '*',
+				   stats->pid[ndx].nallocs, stats->pid[ndx].curr_size, stats->pid[ndx].peak_size);
+		}
+	}
+	printf("%5s | %6u | %9u | %9u\n", "other", stats->pid_other.nallocs, stats->pid_other.curr_size, stats->pid_other.peak_size);
+
+	printf("\n%10s | %5s | %6s | %9s | %9s\n", "CALLER", "PID", "CHUNKS", "CURR_HEAP", "PEAK_HEAP");
+	printf("-----------|-------|--------|-----------|----------\n");
+	for (ndx = 0; ndx < CONFIG_DEBUG_MM_HEAPINFO_NCALLERS; ndx++) {
+		if (stats->caller[ndx].caller != 0) {
+			printf("0x%08x | %5d | %6u | %9u | %9u\n", stats->caller[ndx].caller, stats->caller[ndx].pid,
+				   stats->caller[ndx].nallocs, stats->caller[ndx].curr_size, stats->caller[ndx].peak_size);
+		}
+	}
+	printf("%10s |       | %6u | %9u | %9u\n", "other", stats->caller_other.nallocs, stats->caller_other.curr_size, stats->caller_other.peak_size);
+	printf("\n* PID with '*' has exited but still owns heap memory\n");
+
+	free(stats);
+	return OK;
+}
+#endif
+
 #ifdef CONFIG_HEAPINFO_USER_GROUP
 static void kdbg_heapinfo_group_threadlist(void)
 {
@@ -94,7 +138,7 @@ int kdbg_heapinfo(int argc, char **args)
 	}
 
 	struct mm_heap_s *user_heap = mm_get_heap_info();
-	while ((option = getopt(argc, args, "iap:fg")) != ERROR) {
+	while ((option = getopt(argc, args, "iap:fgc")) != ERROR) {
 		switch (option) {
 		case 'i':
 			sched_foreach(kdbg_heapinfo_init, NULL);
@@ -115,6 +159,13 @@ int kdbg_heapinfo(int argc, char **args)
 		case 'g':
 			show_group = true;
 			break;
+		case 'c':
+#ifdef CONFIG_DEBUG_MM_HEAPINFO_STATS
+			return kdbg_heapinfo_stats(user_heap);
+#else
+			printf("NOT supported!! Please enable CONFIG_DEBUG_MM_HEAPINFO_STATS\n");
+			return ERROR;
+#endif
 		case '?':
 		default:
 			printf("Invalid option\n");
@@ -171,6 +222,9 @@ usage:
 #ifdef CONFIG_HEAPINFO_USER_GROUP
 	printf(" -g           Show the User defined group allocation details \n");
 #endif
+#ifdef CONFIG_DEBUG_MM_HEAPINFO_STATS
+	printf(" -c           Show the per task and per caller usage without walking the heap\n");
+#endif
 #endif
 	return ERROR;
 }
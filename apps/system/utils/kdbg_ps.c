@@ -79,7 +79,16 @@ static const char *kdbg_ttypenames[4] = {
 
 static void kdbg_pseach(FAR struct tcb_s *tcb, FAR void *arg)
 {
+#ifdef CONFIG_SCHED_CPUACCT
+	struct cpuacct_s cpuacct;
+#endif
+
 	printf("%5d | %4d | %4s | %7s | %c%c | %8s", tcb->pid, tcb->sched_priority, tcb->flags & TCB_FLAG_ROUND_ROBIN ? "RR  " : "FIFO", kdbg_ttypenames[(tcb->flags & TCB_FLAG_TTYPE_MASK) >> TCB_FLAG_TTYPE_SHIFT], tcb->flags & TCB_FLAG_NONCANCELABLE ? 'N' : ' ', tcb->flags & TCB_FLAG_CANCEL_PENDING ? 'P' : ' ', kdbg_statenames[tcb->task_state]);
+#ifdef CONFIG_SCHED_CPUACCT
+	if (sched_cpuacct(tcb->pid, &cpuacct) == OK) {
+		printf(" | %9u | %8u | %8u", (unsigned int)(cpuacct.runtime / 1000), (unsigned int)(cpuacct.irqtime / 1000), (unsigned int)cpuacct.nswitches);
+	}
+#endif
 #if CONFIG_TASK_NAME_SIZE > 0
 	printf(" | %s", tcb->name);
 #endif
@@ -88,7 +97,15 @@ static void kdbg_pseach(FAR struct tcb_s *tcb, FAR void *arg)
 
 int kdbg_ps(int argc, char **args)
 {
-#if CONFIG_TASK_NAME_SIZE > 0
+#if defined(CONFIG_SCHED_CPUACCT) && CONFIG_TASK_NAME_SIZE > 0
+	printf("\n");
+	printf("  PID | PRIO | FLAG |  TYPE   | NP |  STATUS  |  RUN MS   |  IRQ MS  | SWITCHES | NAME\n");
+	printf("------|------|------|---------|----|----------|-----------|----------|----------|----------\n");
+#elif defined(CONFIG_SCHED_CPUACCT)
+	printf("\n");
+	printf("  PID | PRIO | FLAG |  TYPE   | NP |  STATUS  |  RUN MS   |  IRQ MS  | SWITCHES\n");
+	printf("------|------|------|---------|----|----------|-----------|----------|---------\n");
+#elif CONFIG_TASK_NAME_SIZE > 0
 	printf("\n");
 	printf("  PID | PRIO | FLAG |  TYPE   | NP |  STATUS  | NAME\n");
 	printf("------|------|------|---------|----|----------|----------\n");
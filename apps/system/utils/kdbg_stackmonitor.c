@@ -137,9 +137,9 @@ static void stkmon_active_check(struct tcb_s *tcb, void *arg)
 		tcb->stack_alloc_ptr = (void *)(g_idle_topstack - CONFIG_IDLETHREAD_STACKSIZE);
 	}
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
-	printf("%5d | %8s | %8d | %10d | %10d | %7lld | ", tcb->pid, "ACTIVE", tcb->adj_stack_size, up_check_tcbstack(tcb), tcb->peak_alloc_size, (uint64_t)((clock_t)clock()));
+	printf("%5d | %8s | %8d | %10d | %10d | %7lld | ", tcb->pid, "ACTIVE", tcb->adj_stack_size, up_check_tcbstack_hwm(tcb), tcb->peak_alloc_size, (uint64_t)((clock_t)clock()));
 #else
-	printf("%5d | %8s | %8d | %10d | %10lld | ", tcb->pid, "ACTIVE", tcb->adj_stack_size, up_check_tcbstack(tcb), (uint64_t)((clock_t)clock()));
+	printf("%5d | %8s | %8d | %10d | %10lld | ", tcb->pid, "ACTIVE", tcb->adj_stack_size, up_check_tcbstack_hwm(tcb), (uint64_t)((clock_t)clock()));
 #endif
 #if (CONFIG_TASK_NAME_SIZE > 0)
 	printf("%s\n", tcb->name);
@@ -34,6 +34,9 @@
 
 #include <stdio.h>
 #include <protocols/webserver/http_server.h>
+#ifdef CONFIG_NETUTILS_WEBSERVER_ARENA
+#include <tinyara/mm/mm.h>
+#endif
 
 #ifdef __cplusplus
 #define EXTERN extern "C"
@@ -63,6 +66,9 @@ struct http_keyvalue_t {
 struct http_keyvalue_list_t {
 	struct http_keyvalue_t *head;
 	struct http_keyvalue_t *tail;
+#ifdef CONFIG_NETUTILS_WEBSERVER_ARENA
+	struct mm_arena_s *arena;
+#endif
 };
 
 /****************************************************************************
@@ -79,6 +85,21 @@ struct http_keyvalue_list_t {
  */
 int   http_keyvalue_list_init(struct http_keyvalue_list_t *list);
 
+#ifdef CONFIG_NETUTILS_WEBSERVER_ARENA
+/**
+ * @brief http_keyvalue_list_init_arena() allocates list's head and tail
+ *        from an arena. The keyvalues added to the list are allocated from
+ *        the arena too and are freed when the arena is reset.
+ *
+ * @param[in] list the keyvalue list to be initialized.
+ * @param[in] arena the arena to allocate from, or NULL to use the heap.
+ * @return On success, HTTP_OK(0) is returned.
+ *         On failure, HTTP_ERROR(-1) is returned.
+ * @since TizenRT v2.0
+ */
+int   http_keyvalue_list_init_arena(struct http_keyvalue_list_t *list, struct mm_arena_s *arena);
+#endif
+
 /**
  * @brief http_keyvalue_list_release() frees list.
  *
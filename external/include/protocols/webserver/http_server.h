@@ -106,6 +106,7 @@
 #define HTTP_CONF_MAX_SLASH_COUNT               32
 #define HTTP_CONF_MAX_QUERY_HANDLER_COUNT       64
 #define HTTP_CONF_MAX_ENTITY_LENGTH             2048
+#define HTTP_CONF_ARENA_BLOCK_SIZE              12288
 
 #define HTTP_ERROR_400            "Bad Request"
 #define HTTP_ERROR_404            "Not Found"
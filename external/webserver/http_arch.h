@@ -31,4 +31,18 @@
 #define HTTP_FREE   free
 #define HTTP_ATOI   atoi
 
+/*
+ * Request-scoped memory. With an arena, the memory is released when the
+ * arena is reset, so HTTP_ARENA_FREE does nothing.
+ */
+#ifdef CONFIG_NETUTILS_WEBSERVER_ARENA
+#include <tinyara/mm/mm.h>
+
+#define HTTP_ARENA_ALLOC(arena, size) ((arena) ? mm_arena_alloc((arena), (size)) : HTTP_MALLOC(size))
+#define HTTP_ARENA_FREE(arena, ptr)   do { if (!(arena)) { HTTP_FREE(ptr); } } while (0)
+#else
+#define HTTP_ARENA_ALLOC(arena, size) HTTP_MALLOC(size)
+#define HTTP_ARENA_FREE(arena, ptr)   HTTP_FREE(ptr)
+#endif
+
 #endif
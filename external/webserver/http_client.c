@@ -44,16 +44,34 @@ pthread_addr_t http_handle_client(pthread_addr_t arg)
 	struct http_client_t *p;
 	mqd_t msg_q;
 	struct mq_attr mqattr;
+	struct mm_arena_s *arena = NULL;
 
 	if ((msg_q = http_server_mq_open(server->port)) == NULL) {
 		HTTP_LOGE("msg queue open fail in http_handle_client\n");
 		return NULL;
 	}
 
+#ifdef CONFIG_NETUTILS_WEBSERVER_ARENA
+	/* All memory of a request comes from this arena, which is reset after
+	 * each request. Fall back to the heap if it cannot be created.
+	 */
+	arena = umm_arena_create(HTTP_CONF_ARENA_BLOCK_SIZE);
+	if (arena == NULL) {
+		HTTP_LOGE("Error: Cannot create request arena, use heap\n");
+	} else {
+		/* The receive buffer always comes from a regular block */
+
+		mm_arena_setlargesize(arena, HTTP_CONF_MAX_REQUEST_LENGTH);
+	}
+#endif
+
 	mq_getattr(msg_q, &mqattr);
 
 	while (1) {
 		if (mq_receive(msg_q, (char *)&msg, mqattr.mq_msgsize, NULL) < 0) {
+#ifdef CONFIG_NETUTILS_WEBSERVER_ARENA
+			mm_arena_destroy(arena);
+#endif
 			return NULL;
 		}
 
@@ -84,6 +102,7 @@ pthread_addr_t http_handle_client(pthread_addr_t arg)
 		}
 
 		HTTP_LOGD("Client %d.\n", p->client_fd);
+		p->arena = arena;
 
 #ifdef CONFIG_NET_SECURITY_TLS
 		if (server->tls_init) {
@@ -94,9 +113,18 @@ pthread_addr_t http_handle_client(pthread_addr_t arg)
 			}
 		}
 #endif
+#ifdef CONFIG_NETUTILS_WEBSERVER_ARENA
+		http_keyvalue_list_init_arena(&request_params, arena);
+#else
 		http_keyvalue_list_init(&request_params);
+#endif
 		result = http_recv_and_handle_request(p, &request_params);
 		http_keyvalue_list_release(&request_params);
+#ifdef CONFIG_NETUTILS_WEBSERVER_ARENA
+		if (arena) {
+			mm_arena_reset(arena);
+		}
+#endif
 
 		if (result != HTTP_OK) {
 			HTTP_LOGD("Client %d  in error case.\n", sock_fd);
@@ -107,6 +135,9 @@ pthread_addr_t http_handle_client(pthread_addr_t arg)
 		HTTP_LOGD("Release client....\n");
 	}
 
+#ifdef CONFIG_NETUTILS_WEBSERVER_ARENA
+	mm_arena_destroy(arena);
+#endif
 	mq_close(msg_q);
 
 	HTTP_LOGD("Closed client handle %d\n", getpid());
@@ -245,7 +276,7 @@ int http_parse_message(char *buf, int buf_len, int *method, char *url,
 						if (client) {
 							len->chunked_remain = 0;
 							len->entity_len = 0;
-							entity = HTTP_MALLOC(HTTP_CONF_MAX_ENTITY_LENGTH);
+							entity = HTTP_ARENA_ALLOC(client->arena, HTTP_CONF_MAX_ENTITY_LENGTH);
 							if (entity == NULL) {
 								HTTP_LOGE("Error: Fail to alloc memory\n");
 								return HTTP_ERROR;
@@ -456,7 +487,7 @@ int http_recv_and_handle_request(struct http_client_t *client, struct http_keyva
 
 	client->ws_state = 0;
 
-	buf = HTTP_MALLOC(HTTP_CONF_MAX_REQUEST_LENGTH);
+	buf = HTTP_ARENA_ALLOC(client->arena, HTTP_CONF_MAX_REQUEST_LENGTH);
 	if (buf == NULL) {
 		HTTP_LOGE("Error: Fail to malloc buf\n");
 		close(client->client_fd);
@@ -550,16 +581,16 @@ int http_recv_and_handle_request(struct http_client_t *client, struct http_keyva
 		close(client->client_fd);
 	}
 
-	HTTP_FREE(buf);
+	HTTP_ARENA_FREE(client->arena, buf);
 	if (enc == HTTP_CHUNKED_ENCODING) {
-		HTTP_FREE(body);
+		HTTP_ARENA_FREE(client->arena, body);
 	}
 	return HTTP_OK;
 errout:
 	close(client->client_fd);
-	HTTP_FREE(buf);
+	HTTP_ARENA_FREE(client->arena, buf);
 	if (enc == HTTP_CHUNKED_ENCODING) {
-		HTTP_FREE(body);
+		HTTP_ARENA_FREE(client->arena, body);
 	}
 	return HTTP_ERROR;
 }
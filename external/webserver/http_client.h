@@ -36,6 +36,8 @@
 #include "mbedtls/ssl_cache.h"
 #endif
 
+struct mm_arena_s;
+
 enum {
 	HTTP_REQUEST_HEADER, HTTP_REQUEST_PARAMETERS, HTTP_REQUEST_BODY
 };
@@ -46,6 +48,9 @@ struct http_client_t {
 	int ws_state;
 	unsigned char ws_key[WEBSOCKET_CLIENT_KEY_LEN];
 
+	/* Request-scoped memory, NULL to use the heap */
+	struct mm_arena_s *arena;
+
 #ifdef CONFIG_NET_SECURITY_TLS
 	mbedtls_ssl_context       tls_ssl;
 	mbedtls_net_context       tls_client_fd;
@@ -29,16 +29,28 @@
 
 char *null_string = "(null)";
 
+#ifdef CONFIG_NETUTILS_WEBSERVER_ARENA
 int http_keyvalue_list_init(struct http_keyvalue_list_t *list)
+{
+	return http_keyvalue_list_init_arena(list, NULL);
+}
+
+int http_keyvalue_list_init_arena(struct http_keyvalue_list_t *list, struct mm_arena_s *arena)
+#else
+int http_keyvalue_list_init(struct http_keyvalue_list_t *list)
+#endif
 {
 	HTTP_MEMSET(list, 0, sizeof(struct http_keyvalue_list_t));
+#ifdef CONFIG_NETUTILS_WEBSERVER_ARENA
+	list->arena = arena;
+#endif
 
-	list->head = (struct http_keyvalue_t *)HTTP_MALLOC(sizeof(struct http_keyvalue_t));
+	list->head = (struct http_keyvalue_t *)HTTP_ARENA_ALLOC(list->arena, sizeof(struct http_keyvalue_t));
 	if (!list->head) {
 		return HTTP_ERROR;
 	}
 
-	list->tail = (struct http_keyvalue_t *)HTTP_MALLOC(sizeof(struct http_keyvalue_t));
+	list->tail = (struct http_keyvalue_t *)HTTP_ARENA_ALLOC(list->arena, sizeof(struct http_keyvalue_t));
 	if (!list->tail) {
 		return HTTP_ERROR;
 	}
@@ -59,8 +71,8 @@ int http_keyvalue_list_release(struct http_keyvalue_list_t *list)
 			/* Delete all containers */
 		}
 
-		HTTP_FREE(list->head);
-		HTTP_FREE(list->tail);
+		HTTP_ARENA_FREE(list->arena, list->head);
+		HTTP_ARENA_FREE(list->arena, list->tail);
 	}
 	return HTTP_OK;
 }
@@ -69,7 +81,7 @@ int http_keyvalue_list_add(struct http_keyvalue_list_t *list, const char *key, c
 {
 	struct http_keyvalue_t *keyvalue = NULL;
 
-	keyvalue = (struct http_keyvalue_t *)HTTP_MALLOC(sizeof(struct http_keyvalue_t));
+	keyvalue = (struct http_keyvalue_t *)HTTP_ARENA_ALLOC(list->arena, sizeof(struct http_keyvalue_t));
 	if (!keyvalue) {
 		HTTP_LOGE("Error: Cannot allocate keyvalue!!\n");
 		return HTTP_ERROR;
@@ -95,7 +107,7 @@ int http_keyvalue_list_delete_tail(struct http_keyvalue_list_t *list)
 
 		target->prev->next = target->next;
 		target->next->prev = target->prev;
-		HTTP_FREE(target);
+		HTTP_ARENA_FREE(list->arena, target);
 
 		return HTTP_OK;
 	}
@@ -83,10 +83,14 @@ int http_dispatch_url(struct http_client_t *client, struct http_req_message *req
 	req->url = query;
 	req->query_string = params;
 
-	http_parse_query(query, &dq);
+	http_parse_query(query, &dq, client->arena);
+#ifdef CONFIG_NETUTILS_WEBSERVER_ARENA
+	if (http_keyvalue_list_init_arena(&params_list, client->arena) == HTTP_ERROR) {
+#else
 	if (http_keyvalue_list_init(&params_list) == HTTP_ERROR) {
+#endif
 		http_keyvalue_list_release(&params_list);
-		http_release_query(&dq);
+		http_release_query(&dq, client->arena);
 		return HTTP_ERROR;
 	}
 
@@ -103,7 +107,7 @@ int http_dispatch_url(struct http_client_t *client, struct http_req_message *req
 				cur->func(client, req);
 				req->url = origin_url;
 				http_keyvalue_list_release(&params_list);
-				http_release_query(&dq);
+				http_release_query(&dq, client->arena);
 				return HTTP_OK;
 			}
 		}
@@ -115,7 +119,7 @@ int http_dispatch_url(struct http_client_t *client, struct http_req_message *req
 
 	req->url = origin_url;
 	http_keyvalue_list_release(&params_list);
-	http_release_query(&dq);
+	http_release_query(&dq, client->arena);
 	return HTTP_OK;
 }
 
@@ -164,7 +168,7 @@ int http_server_register_cb(struct http_server_t *server, int method, const char
 
 	HTTP_MEMSET(cur, 0, sizeof(struct http_query_handler_t));
 
-	http_parse_query(url_format, &cur->dq);
+	http_parse_query(url_format, &cur->dq, NULL);
 
 	cur->method = method;
 	cur->func = func;
@@ -192,26 +196,26 @@ int http_server_deregister_cb(struct http_server_t *server, int method, const ch
 		return HTTP_OK;
 	}
 
-	http_parse_query(url_format, &dq);
+	http_parse_query(url_format, &dq, NULL);
 
 	for (i = 0; i < HTTP_CONF_MAX_QUERY_HANDLER_COUNT; i++) {
 		if (server->query_handlers[i] != NULL) {
 			if (server->query_handlers[i]->method == method &&
 				http_compare_dq(&server->query_handlers[i]->dq, &dq, NULL) == HTTP_OK) {
-				http_release_query(&server->query_handlers[i]->dq);
+				http_release_query(&server->query_handlers[i]->dq, NULL);
 				HTTP_FREE(server->query_handlers[i]);
 				server->query_handlers[i] = NULL;
-				http_release_query(&dq);
+				http_release_query(&dq, NULL);
 				return HTTP_OK;
 			}
 		}
 	}
 
-	http_release_query(&dq);
+	http_release_query(&dq, NULL);
 	return HTTP_ERROR;
 }
 
-int http_parse_query(const char *query, struct http_divided_query_t *dq)
+int http_parse_query(const char *query, struct http_divided_query_t *dq, struct mm_arena_s *arena)
 {
 	int i = 0;
 	int query_len = (int)strlen(query);
@@ -228,7 +232,7 @@ int http_parse_query(const char *query, struct http_divided_query_t *dq)
 	/* Set the last slash position as query length. To calculate devided path length */
 	slash_position[dq->slash_count] = query_len;
 
-	dq->paths = (char *)HTTP_MALLOC(dq->slash_count * HTTP_CONF_MAX_DIVIDED_PATH_LENGTH);
+	dq->paths = (char *)HTTP_ARENA_ALLOC(arena, dq->slash_count * HTTP_CONF_MAX_DIVIDED_PATH_LENGTH);
 	if (!(dq->paths)) {
 		return HTTP_ERROR;
 	}
@@ -287,10 +291,10 @@ int http_parse_params(const char *params, struct http_keyvalue_list_t *params_li
 	return HTTP_OK;
 }
 
-void http_release_query(struct http_divided_query_t *dq)
+void http_release_query(struct http_divided_query_t *dq, struct mm_arena_s *arena)
 {
 	if (dq->paths) {
-		HTTP_FREE(dq->paths);
+		HTTP_ARENA_FREE(arena, dq->paths);
 	}
 }
 
@@ -36,11 +36,12 @@ struct http_query_handler_t {
 struct http_server_t;
 struct http_client_t;
 struct http_keyvalue_list_t;
+struct mm_arena_s;
 
 int  http_divide_query_params(const char *url, char *query, char *params);
-int  http_parse_query(const char *query, struct http_divided_query_t *dq);
+int  http_parse_query(const char *query, struct http_divided_query_t *dq, struct mm_arena_s *arena);
 int  http_parse_params(const char *params, struct http_keyvalue_list_t *params_list);
-void http_release_query(struct http_divided_query_t *dq);
+void http_release_query(struct http_divided_query_t *dq, struct mm_arena_s *arena);
 
 int  http_dispatch_url(struct http_client_t *client, struct http_req_message *req);
 
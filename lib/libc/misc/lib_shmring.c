@@ -0,0 +1,368 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * libc/misc/lib_shmring.c
+ *
+ * Single-producer/single-consumer frame ring, see include/tinyara/shmring.h.
+ *
+ * The producer only writes sr_head and the consumer only writes sr_tail.
+ * Both are free running byte offsets into the frame data; their difference
+ * is the number of bytes in use.  Each frame starts with a header holding
+ * its length.  A frame never wraps around the end of the frame data: if it
+ * does not fit before the end, a wrap marker is written instead and the
+ * frame starts at the beginning.
+ *
+ * A side that has to wait sets its waiting flag, checks the ring again and
+ * then sleeps on its semaphore.  The other side checks the flag after it
+ * has moved its index and posts the semaphore only if the flag is set, so
+ * no system call is made while the ring neither runs full nor empty.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <semaphore.h>
+#include <errno.h>
+
+#ifdef CONFIG_MM_SHM
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#endif
+
+#include <tinyara/semaphore.h>
+#include <tinyara/shmring.h>
+
+#ifdef CONFIG_LIBC_SHMRING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The smallest frame data size of a ring */
+
+#define SHMRING_MINSIZE       64
+
+/* The length of the frame header of a wrap marker */
+
+#define SHMRING_WRAP          0xffffffff
+
+/* The address of the frame data at the free running offset 'off' */
+
+#define SHMRING_DATA(ring, off) \
+	((FAR uint8_t *)(ring) + SHMRING_HDRSIZE + ((off) & ((ring)->sr_size - 1)))
+
+/* The size of a frame of 'len' bytes in the ring */
+
+#define SHMRING_FRAMESIZE(len) SHMRING_ALIGN_UP(SHMRING_FRAMEHDR + (len))
+
+/* Orders the accesses to the frames, the indexes and the waiting flags as
+ * seen by the other side.
+ */
+
+#define SHMRING_BARRIER()     __sync_synchronize()
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmring_wake
+ *
+ * Description:
+ *   Wake up the other side if it is waiting.  Called after an index has
+ *   been moved.
+ *
+ ****************************************************************************/
+
+static void shmring_wake(FAR volatile uint8_t *flag, FAR sem_t *sem)
+{
+	SHMRING_BARRIER();
+	if (*flag) {
+		*flag = 0;
+		sem_post(sem);
+	}
+}
+
+/****************************************************************************
+ * Name: shmring_space
+ *
+ * Description:
+ *   Return the free space of the ring as seen by the producer.
+ *
+ ****************************************************************************/
+
+static inline uint32_t shmring_space(FAR struct shmring_s *ring, uint32_t head)
+{
+	return ring->sr_size - (head - ring->sr_tail);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmring_initialize
+ ****************************************************************************/
+
+FAR struct shmring_s *shmring_initialize(FAR void *mem, size_t memsize)
+{
+	FAR struct shmring_s *ring = (FAR struct shmring_s *)mem;
+	uint32_t size;
+
+	if (mem == NULL || memsize < SHMRING_MEMSIZE(SHMRING_MINSIZE)) {
+		set_errno(EINVAL);
+		return NULL;
+	}
+
+	for (size = SHMRING_MINSIZE; size < 0x80000000 && SHMRING_MEMSIZE((size_t)size << 1) <= memsize; size <<= 1) ;
+
+	ring->sr_size = size;
+	ring->sr_head = 0;
+	ring->sr_tail = 0;
+	ring->sr_rwait = 0;
+	ring->sr_wwait = 0;
+
+	/* The semaphores are only used for signalling between the tasks */
+
+	sem_init(&ring->sr_datasem, 1, 0);
+	sem_init(&ring->sr_spacesem, 1, 0);
+#ifdef CONFIG_PRIORITY_INHERITANCE
+	sem_setprotocol(&ring->sr_datasem, SEM_PRIO_NONE);
+	sem_setprotocol(&ring->sr_spacesem, SEM_PRIO_NONE);
+#endif
+
+	return ring;
+}
+
+/****************************************************************************
+ * Name: shmring_uninitialize
+ ****************************************************************************/
+
+void shmring_uninitialize(FAR struct shmring_s *ring)
+{
+	sem_destroy(&ring->sr_datasem);
+	sem_destroy(&ring->sr_spacesem);
+}
+
+/****************************************************************************
+ * Name: shmring_reserve
+ ****************************************************************************/
+
+FAR void *shmring_reserve(FAR struct shmring_s *ring, size_t len, bool wait)
+{
+	uint32_t head = ring->sr_head;
+	uint32_t framesize;
+	uint32_t pad;
+
+	if (len > SHMRING_MAXFRAME(ring)) {
+		set_errno(EMSGSIZE);
+		return NULL;
+	}
+
+	/* The frame has to be contiguous.  If it does not fit before the end of
+	 * the frame data, the rest up to the end is skipped.
+	 */
+
+	framesize = SHMRING_FRAMESIZE(len);
+	pad = ring->sr_size - (head & (ring->sr_size - 1));
+	if (pad >= framesize) {
+		pad = 0;
+	}
+
+	while (shmring_space(ring, head) < pad + framesize) {
+		if (!wait) {
+			set_errno(EAGAIN);
+			return NULL;
+		}
+
+		/* Check again after setting the flag, so that a release between
+		 * the two checks cannot be missed.  A post that is not needed any
+		 * more only makes a later wait return early.
+		 */
+
+		ring->sr_wwait = 1;
+		SHMRING_BARRIER();
+		if (shmring_space(ring, head) < pad + framesize) {
+			(void)sem_wait(&ring->sr_spacesem);
+		}
+
+		ring->sr_wwait = 0;
+	}
+
+	if (pad > 0) {
+		/* Publish the wrap marker so that the consumer skips the end */
+
+		*(FAR uint32_t *)SHMRING_DATA(ring, head) = SHMRING_WRAP;
+		SHMRING_BARRIER();
+		head += pad;
+		ring->sr_head = head;
+	}
+
+	return SHMRING_DATA(ring, head) + SHMRING_FRAMEHDR;
+}
+
+/****************************************************************************
+ * Name: shmring_commit
+ ****************************************************************************/
+
+void shmring_commit(FAR struct shmring_s *ring, size_t len)
+{
+	uint32_t head = ring->sr_head;
+
+	/* The frame and its length must be visible before the new head */
+
+	*(FAR uint32_t *)SHMRING_DATA(ring, head) = (uint32_t)len;
+	SHMRING_BARRIER();
+	ring->sr_head = head + SHMRING_FRAMESIZE(len);
+
+	shmring_wake(&ring->sr_rwait, &ring->sr_datasem);
+}
+
+/****************************************************************************
+ * Name: shmring_peek
+ ****************************************************************************/
+
+FAR void *shmring_peek(FAR struct shmring_s *ring, FAR size_t *len, bool wait)
+{
+	uint32_t tail = ring->sr_tail;
+	uint32_t framelen;
+
+	for (;;) {
+		while (ring->sr_head == tail) {
+			if (!wait) {
+				set_errno(EAGAIN);
+				return NULL;
+			}
+
+			/* The same as in shmring_reserve() */
+
+			ring->sr_rwait = 1;
+			SHMRING_BARRIER();
+			if (ring->sr_head == tail) {
+				(void)sem_wait(&ring->sr_datasem);
+			}
+
+			ring->sr_rwait = 0;
+		}
+
+		/* Read the frame only after the head that covers it */
+
+		SHMRING_BARRIER();
+		framelen = *(FAR uint32_t *)SHMRING_DATA(ring, tail);
+		if (framelen != SHMRING_WRAP) {
+			break;
+		}
+
+		/* Skip to the beginning and give the end back to the producer */
+
+		tail += ring->sr_size - (tail & (ring->sr_size - 1));
+		ring->sr_tail = tail;
+		shmring_wake(&ring->sr_wwait, &ring->sr_spacesem);
+	}
+
+	*len = framelen;
+	return SHMRING_DATA(ring, tail) + SHMRING_FRAMEHDR;
+}
+
+/****************************************************************************
+ * Name: shmring_release
+ ****************************************************************************/
+
+void shmring_release(FAR struct shmring_s *ring)
+{
+	uint32_t tail = ring->sr_tail;
+	uint32_t framelen = *(FAR uint32_t *)SHMRING_DATA(ring, tail);
+
+	/* The frame must have been read before its space is given back */
+
+	SHMRING_BARRIER();
+	ring->sr_tail = tail + SHMRING_FRAMESIZE(framelen);
+
+	shmring_wake(&ring->sr_wwait, &ring->sr_spacesem);
+}
+
+#ifdef CONFIG_MM_SHM
+/****************************************************************************
+ * Name: shmring_create
+ ****************************************************************************/
+
+FAR struct shmring_s *shmring_create(key_t key, size_t datasize)
+{
+	FAR struct shmring_s *ring;
+	FAR void *mem;
+	int shmid;
+
+	shmid = shmget(key, SHMRING_MEMSIZE(datasize), IPC_CREAT | IPC_EXCL | 0666);
+	if (shmid < 0) {
+		return NULL;
+	}
+
+	mem = shmat(shmid, NULL, 0);
+	if (mem == (FAR void *)-1) {
+		(void)shmctl(shmid, IPC_RMID, NULL);
+		return NULL;
+	}
+
+	ring = shmring_initialize(mem, SHMRING_MEMSIZE(datasize));
+	if (ring == NULL) {
+		(void)shmdt(mem);
+		(void)shmctl(shmid, IPC_RMID, NULL);
+	}
+
+	return ring;
+}
+
+/****************************************************************************
+ * Name: shmring_attach
+ ****************************************************************************/
+
+FAR struct shmring_s *shmring_attach(key_t key)
+{
+	FAR void *mem;
+	int shmid;
+
+	shmid = shmget(key, 0, 0);
+	if (shmid < 0) {
+		return NULL;
+	}
+
+	mem = shmat(shmid, NULL, 0);
+	if (mem == (FAR void *)-1) {
+		return NULL;
+	}
+
+	return (FAR struct shmring_s *)mem;
+}
+
+/****************************************************************************
+ * Name: shmring_detach
+ ****************************************************************************/
+
+int shmring_detach(FAR struct shmring_s *ring)
+{
+	return shmdt(ring);
+}
+#endif							/* CONFIG_MM_SHM */
+
+#endif							/* CONFIG_LIBC_SHMRING */
@@ -67,6 +67,7 @@
 #ifndef __ASSEMBLY__
 #include <tinyara/compiler.h>
 #include <stdint.h>
+#include <stdbool.h>
 #endif
 
 /* Included implementation-dependent register save structure layouts */
@@ -191,6 +192,17 @@ struct xcptcontext {
 
 #ifndef __ASSEMBLY__
 
+/* The longest interrupts disabled section is timed by the kernel (see
+ * CONFIG_IRQ_STATS_CSECTION).  irqsave() reports when it disables the
+ * interrupts and irqrestore() when it is about to enable them again.
+ */
+
+#if defined(CONFIG_IRQ_STATS_CSECTION) && (!defined(CONFIG_BUILD_PROTECTED) || defined(__KERNEL__))
+#define IRQ_CSECTION_STATS 1
+void irq_csection_enter(void);
+void irq_csection_leave(void);
+#endif
+
 /* Get/set the PRIMASK register */
 
 static inline uint8_t getprimask(void) inline_function;
@@ -275,6 +287,11 @@ static inline irqstate_t irqsave(void)
 
 	uint8_t basepri = getbasepri();
 	setbasepri(NVIC_SYSH_DISABLE_PRIORITY);
+#ifdef IRQ_CSECTION_STATS
+	if (basepri == 0) {
+		irq_csection_enter();
+	}
+#endif
 	return (irqstate_t)basepri;
 
 #else
@@ -294,6 +311,11 @@ static inline irqstate_t irqsave(void)
 		: "memory"
 	);
 
+#ifdef IRQ_CSECTION_STATS
+	if ((primask & 1) == 0) {
+		irq_csection_enter();
+	}
+#endif
 	return primask;
 #endif
 }
@@ -313,8 +335,18 @@ static inline void irqrestore(irqstate_t flags) inline_function;
 static inline void irqrestore(irqstate_t flags)
 {
 #ifdef CONFIG_ARMV7M_USEBASEPRI
+#ifdef IRQ_CSECTION_STATS
+	if (flags == 0) {
+		irq_csection_leave();
+	}
+#endif
 	setbasepri((uint32_t)flags);
 #else
+#ifdef IRQ_CSECTION_STATS
+	if ((flags & 1) == 0) {
+		irq_csection_leave();
+	}
+#endif
 	/* If bit 0 of the primask is 0, then we need to restore
 	 * interrupts.
 	 */
@@ -390,6 +422,61 @@ static inline void setcontrol(uint32_t control)
 	);
 }
 
+/* Atomic compare and exchange.  Store 'newval' at 'addr' if it holds
+ * 'oldval' and return true; return false if it holds any other value.  The
+ * local exclusive monitor is cleared on exception entry, so a context switch
+ * between the LDREX and the STREX makes the store fail and the sequence is
+ * retried.
+ */
+
+static inline bool up_cmpxchg(FAR volatile int *addr, int oldval, int newval) inline_function;
+static inline bool up_cmpxchg(FAR volatile int *addr, int oldval, int newval)
+{
+	int value;
+	uint32_t failed;
+
+	__asm__ __volatile__
+	(
+		"1:\tldrex   %0, [%2]\n"
+		"\tcmp     %0, %3\n"
+		"\tbne     2f\n"
+		"\tstrex   %1, %4, [%2]\n"
+		"\tcmp     %1, #0\n"
+		"\tbne     1b\n"
+		"2:\n"
+		: "=&r"(value), "=&r"(failed)
+		: "r"(addr), "r"(oldval), "r"(newval)
+		: "cc", "memory"
+	);
+
+	return value == oldval;
+}
+
+static inline bool up_cmpxchg16(FAR volatile int16_t *addr, int16_t oldval, int16_t newval) inline_function;
+static inline bool up_cmpxchg16(FAR volatile int16_t *addr, int16_t oldval, int16_t newval)
+{
+	uint32_t value;
+	uint32_t failed;
+
+	/* LDREXH zero-extends, so compare with the zero-extended old value */
+
+	__asm__ __volatile__
+	(
+		"1:\tldrexh  %0, [%2]\n"
+		"\tcmp     %0, %3\n"
+		"\tbne     2f\n"
+		"\tstrexh  %1, %4, [%2]\n"
+		"\tcmp     %1, #0\n"
+		"\tbne     1b\n"
+		"2:\n"
+		: "=&r"(value), "=&r"(failed)
+		: "r"(addr), "r"((uint32_t)(uint16_t)oldval), "r"((uint32_t)(uint16_t)newval)
+		: "cc", "memory"
+	);
+
+	return value == (uint16_t)oldval;
+}
+
 #endif							/* __ASSEMBLY__ */
 
 /****************************************************************************
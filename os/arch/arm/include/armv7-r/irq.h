@@ -66,6 +66,7 @@
 
 #ifndef __ASSEMBLY__
 #include <stdint.h>
+#include <stdbool.h>
 #include <arch/arch.h>
 #endif
 
@@ -373,6 +374,17 @@ struct xcptcontext {
 
 #ifndef __ASSEMBLY__
 
+/* The longest interrupts disabled section is timed by the kernel (see
+ * CONFIG_IRQ_STATS_CSECTION).  irqsave() reports when it disables the
+ * interrupts and irqrestore() when it is about to enable them again.
+ */
+
+#if defined(CONFIG_IRQ_STATS_CSECTION) && (!defined(CONFIG_BUILD_PROTECTED) || defined(__KERNEL__))
+#define IRQ_CSECTION_STATS 1
+void irq_csection_enter(void);
+void irq_csection_leave(void);
+#endif
+
 /* Return the current IRQ state */
 
 static inline irqstate_t irqstate(void)
@@ -408,6 +420,13 @@ static inline irqstate_t irqsave(void)
 		: "memory"
 	);
 
+#ifdef IRQ_CSECTION_STATS
+	/* Bit 7 of the CPSR is the IRQ mask bit */
+
+	if ((cpsr & (1 << 7)) == 0) {
+		irq_csection_enter();
+	}
+#endif
 	return cpsr;
 }
 
@@ -436,6 +455,11 @@ static inline irqstate_t irqenable(void)
 
 static inline void irqrestore(irqstate_t flags)
 {
+#ifdef IRQ_CSECTION_STATS
+	if ((flags & (1 << 7)) == 0) {
+		irq_csection_leave();
+	}
+#endif
 	__asm__ __volatile__
 	(
 		"msr    cpsr_c, %0"
@@ -445,6 +469,62 @@ static inline void irqrestore(irqstate_t flags)
 	);
 }
 
+/* Atomic compare and exchange.  Store 'newval' at 'addr' if it holds
+ * 'oldval' and return true; return false if it holds any other value.
+ * ARMv7-R does not clear the local exclusive monitor on exceptions, so the
+ * IRQ and FIQ vectors do it with CLREX (see arm_vectors.S).  A context
+ * switch between the LDREX and the STREX then makes the store fail and the
+ * sequence is retried.
+ */
+
+static inline bool up_cmpxchg(FAR volatile int *addr, int oldval, int newval);
+static inline bool up_cmpxchg(FAR volatile int *addr, int oldval, int newval)
+{
+	int value;
+	uint32_t failed;
+
+	__asm__ __volatile__
+	(
+		"1:\tldrex   %0, [%2]\n"
+		"\tcmp     %0, %3\n"
+		"\tbne     2f\n"
+		"\tstrex   %1, %4, [%2]\n"
+		"\tcmp     %1, #0\n"
+		"\tbne     1b\n"
+		"2:\n"
+		: "=&r"(value), "=&r"(failed)
+		: "r"(addr), "r"(oldval), "r"(newval)
+		: "cc", "memory"
+	);
+
+	return value == oldval;
+}
+
+static inline bool up_cmpxchg16(FAR volatile int16_t *addr, int16_t oldval, int16_t newval);
+static inline bool up_cmpxchg16(FAR volatile int16_t *addr, int16_t oldval, int16_t newval)
+{
+	uint32_t value;
+	uint32_t failed;
+
+	/* LDREXH zero-extends, so compare with the zero-extended old value */
+
+	__asm__ __volatile__
+	(
+		"1:\tldrexh  %0, [%2]\n"
+		"\tcmp     %0, %3\n"
+		"\tbne     2f\n"
+		"\tstrexh  %1, %4, [%2]\n"
+		"\tcmp     %1, #0\n"
+		"\tbne     1b\n"
+		"2:\n"
+		: "=&r"(value), "=&r"(failed)
+		: "r"(addr), "r"((uint32_t)(uint16_t)oldval), "r"((uint32_t)(uint16_t)newval)
+		: "cc", "memory"
+	);
+
+	return value == (uint16_t)oldval;
+}
+
 #endif							/* __ASSEMBLY__ */
 
 /****************************************************************************
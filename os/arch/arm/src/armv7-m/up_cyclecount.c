@@ -0,0 +1,79 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * arch/arm/src/armv7-m/up_cyclecount.c
+ *
+ * The cycle counter of the Data Watchpoint and Trace unit.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+
+#include <tinyara/arch.h>
+
+#include "up_arch.h"
+#include "up_internal.h"
+#include "nvic.h"
+#include "dwt.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_cyclecount_initialize
+ *
+ * Description:
+ *   Start the DWT cycle counter.  It needs the trace blocks enabled in the
+ *   core debug unit.
+ *
+ ****************************************************************************/
+
+void up_cyclecount_initialize(void)
+{
+	uint32_t regval;
+
+	regval = getreg32(NVIC_DEMCR);
+	regval |= NVIC_DEMCR_TRCENA;
+	putreg32(regval, NVIC_DEMCR);
+
+	putreg32(0, DWT_CYCCNT);
+
+	regval = getreg32(DWT_CTRL);
+	regval |= DWT_CTRL_CYCCNTENA_Msk;
+	putreg32(regval, DWT_CTRL);
+}
+
+/****************************************************************************
+ * Name: up_cyclecount
+ *
+ * Description:
+ *   Return the CPU cycle counter.  It wraps around at 32 bits.
+ *
+ ****************************************************************************/
+
+uint32_t up_cyclecount(void)
+{
+	return getreg32(DWT_CYCCNT);
+}
@@ -65,6 +65,7 @@
 
 #include "up_arch.h"
 #include "up_internal.h"
+#include "sched/sched.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -88,6 +89,9 @@
 
 uint32_t *up_doirq(int irq, uint32_t *regs)
 {
+#ifdef CONFIG_IRQ_STATS
+	irq_stats_entry();
+#endif
 	board_led_on(LED_INIRQ);
 #ifdef CONFIG_SUPPRESS_INTERRUPTS
 	PANIC();
@@ -109,6 +113,10 @@ uint32_t *up_doirq(int irq, uint32_t *regs)
 	savestate = (uint32_t *)current_regs;
 	current_regs = regs;
 
+#ifdef CONFIG_SCHED_CPUACCT
+	sched_cpuacct_irqenter();
+#endif
+
 	/* Acknowledge the interrupt */
 
 	up_ack_irq(irq);
@@ -125,6 +133,10 @@ uint32_t *up_doirq(int irq, uint32_t *regs)
 
 	regs = (uint32_t *)current_regs;
 
+#ifdef CONFIG_SCHED_CPUACCT
+	sched_cpuacct_irqleave();
+#endif
+
 	/* Restore the previous value of current_regs.  NULL would indicate that
 	 * we are no longer in an interrupt handler.  It will be non-NULL if we
 	 * are returning from a nested interrupt.
@@ -0,0 +1,77 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * arch/arm/src/armv7-r/arm_cyclecount.c
+ *
+ * The cycle counter (PMCCNTR) of the performance monitors.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+
+#include <tinyara/arch.h>
+
+#include "up_internal.h"
+#include "sctlr.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_cyclecount_initialize
+ *
+ * Description:
+ *   Reset the cycle counter and start it, without the divide by 64.
+ *
+ ****************************************************************************/
+
+void up_cyclecount_initialize(void)
+{
+	unsigned int regval;
+
+	__asm__ __volatile__("\tmrc p15, 0, %0, c9, c12, 0\n" : "=r"(regval));
+	regval &= ~PCMR_D;
+	regval |= PCMR_E | PCMR_C;
+	__asm__ __volatile__("\tmcr p15, 0, %0, c9, c12, 0\n" : : "r"(regval));
+
+	regval = PMCNTENSET_C;
+	__asm__ __volatile__("\tmcr p15, 0, %0, c9, c12, 1\n" : : "r"(regval));
+}
+
+/****************************************************************************
+ * Name: up_cyclecount
+ *
+ * Description:
+ *   Return the CPU cycle counter.  It wraps around at 32 bits.
+ *
+ ****************************************************************************/
+
+uint32_t up_cyclecount(void)
+{
+	uint32_t count;
+
+	__asm__ __volatile__("\tmrc p15, 0, %0, c9, c13, 0\n" : "=r"(count));
+	return count;
+}
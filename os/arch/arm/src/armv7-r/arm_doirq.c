@@ -68,6 +68,7 @@
 #include "up_internal.h"
 
 #include "group/group.h"
+#include "sched/sched.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -91,6 +92,9 @@
 
 uint32_t *arm_doirq(int irq, uint32_t *regs)
 {
+#ifdef CONFIG_IRQ_STATS
+	irq_stats_entry();
+#endif
 	board_autoled_on(LED_INIRQ);
 
 #ifdef CONFIG_SUPPRESS_INTERRUPTS
@@ -106,6 +110,10 @@ uint32_t *arm_doirq(int irq, uint32_t *regs)
 
 	current_regs = regs;
 
+#ifdef CONFIG_SCHED_CPUACCT
+	sched_cpuacct_irqenter();
+#endif
+
 	/* Deliver the IRQ */
 
 	irq_dispatch(irq, regs);
@@ -132,6 +140,10 @@ uint32_t *arm_doirq(int irq, uint32_t *regs)
 	regs = (uint32_t *)current_regs;
 	current_regs = NULL;
 
+#ifdef CONFIG_SCHED_CPUACCT
+	sched_cpuacct_irqleave();
+#endif
+
 	board_autoled_off(LED_INIRQ);
 #endif
 	return regs;
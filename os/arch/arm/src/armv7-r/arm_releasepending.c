@@ -116,6 +116,9 @@ void up_release_pending(void)
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(rtcb);
 #endif
+#ifdef CONFIG_SCHED_CPUACCT
+			sched_cpuacct_switch(rtcb);
+#endif
 
 			/* Then switch contexts.  Any necessary address environment
 			 * changes will be made when the interrupt returns.
@@ -140,6 +143,9 @@ void up_release_pending(void)
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(rtcb);
 #endif
+#ifdef CONFIG_SCHED_CPUACCT
+			sched_cpuacct_switch(rtcb);
+#endif
 
 			/* Then switch contexts */
 			up_fullcontextrestore(rtcb->xcp.regs);
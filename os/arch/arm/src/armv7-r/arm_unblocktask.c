@@ -145,6 +145,9 @@ void up_unblock_task(struct tcb_s *tcb)
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(rtcb);
 #endif
+#ifdef CONFIG_SCHED_CPUACCT
+			sched_cpuacct_switch(rtcb);
+#endif
 
 			/* Then switch contexts.  Any necessary address environment
 			 * changes will be made when the interrupt returns.
@@ -172,6 +175,9 @@ void up_unblock_task(struct tcb_s *tcb)
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(rtcb);
 #endif
+#ifdef CONFIG_SCHED_CPUACCT
+			sched_cpuacct_switch(rtcb);
+#endif
 
 			/* Then switch contexts */
 
@@ -272,6 +272,8 @@
  * TODO: To be provided
  */
 
+#define PMCNTENSET_C       (1 << 31)	/* Enable the cycle counter (PMCCNTR) */
+
 /* 32-bit Performance Monitors Count Enable Clear register (PMCNTENCLR): CRn=c9, opc1=0, CRm=c12, opc2=2
  * TODO: To be provided
  */
@@ -72,6 +72,10 @@
 
 #ifdef CONFIG_STACK_COLORATION
 
+/* The number of untouched words that end an incremental scan */
+
+#define STACK_HWM_GAPWORDS (CONFIG_STACK_COLORATION_GAP >> 2)
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -80,6 +84,7 @@
  * Private Function Prototypes
  ****************************************************************************/
 static size_t do_stackcheck(uintptr_t alloc, size_t size);
+static size_t do_stackcheck_hwm(uintptr_t alloc, size_t size, size_t used);
 
 /****************************************************************************
  * Name: do_stackcheck
@@ -156,6 +161,57 @@ static size_t do_stackcheck(uintptr_t alloc, size_t size)
 	return mark << 2;
 }
 
+/****************************************************************************
+ * Name: do_stackcheck_hwm
+ *
+ * Description:
+ *   Like do_stackcheck(), but the words above a known high water mark are
+ *   not looked at.  The search goes down from the mark and ends when
+ *   STACK_HWM_GAPWORDS words in a row still have the magic value, so it
+ *   costs only the growth of the stack since the last check plus the gap.
+ *
+ * Input Parameters:
+ *   alloc - Allocation base address of the stack
+ *   size - The size of the stack in bytes
+ *   used - The stack space used at the last check
+ *
+ * Returned value:
+ *   The estimated amount of stack space used.
+ *
+ ****************************************************************************/
+
+static size_t do_stackcheck_hwm(uintptr_t alloc, size_t size, size_t used)
+{
+	FAR uintptr_t start;
+	FAR uintptr_t end;
+	FAR uint32_t *ptr;
+	size_t nwords;
+	size_t mark;
+	size_t gap;
+
+	start = alloc & ~3;
+	end = (alloc + size + 3) & ~3;
+	nwords = (end - start) >> 2;
+
+	/* 'mark' is the lowest word known to be used.  The stack grows toward
+	 * lower addresses, so any new usage is below it.
+	 */
+
+	used >>= 2;
+	mark = used < nwords ? nwords - used : 0;
+
+	for (ptr = (FAR uint32_t *)start + mark, gap = 0; ptr > (FAR uint32_t *)start && gap < STACK_HWM_GAPWORDS;) {
+		if (*--ptr == STACK_COLOR) {
+			gap++;
+		} else {
+			mark = ptr - (FAR uint32_t *)start;
+			gap = 0;
+		}
+	}
+
+	return (nwords - mark) << 2;
+}
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -178,7 +234,20 @@ static size_t do_stackcheck(uintptr_t alloc, size_t size)
 
 size_t up_check_tcbstack(FAR struct tcb_s *tcb)
 {
-	return do_stackcheck((uintptr_t)tcb->stack_alloc_ptr, tcb->adj_stack_size);
+	tcb->stack_hwm = do_stackcheck((uintptr_t)tcb->stack_alloc_ptr, tcb->adj_stack_size);
+	return tcb->stack_hwm;
+}
+
+size_t up_check_tcbstack_hwm(FAR struct tcb_s *tcb)
+{
+	/* The first check of a stack has no mark to start from */
+
+	if (tcb->stack_hwm == 0) {
+		return up_check_tcbstack(tcb);
+	}
+
+	tcb->stack_hwm = do_stackcheck_hwm((uintptr_t)tcb->stack_alloc_ptr, tcb->adj_stack_size, tcb->stack_hwm);
+	return tcb->stack_hwm;
 }
 
 ssize_t up_check_tcbstack_remain(FAR struct tcb_s *tcb)
@@ -227,6 +227,9 @@ int up_create_stack(FAR struct tcb_s *tcb, size_t stack_size, uint8_t ttype)
 
 		tcb->adj_stack_ptr = (uint32_t *)top_of_stack;
 		tcb->adj_stack_size = size_of_stack;
+#ifdef CONFIG_STACK_COLORATION
+		tcb->stack_hwm = 0;
+#endif
 
 		/* If stack debug is enabled, then fill the stack with a
 		 * recognizable value that we can use later to test for high
@@ -197,6 +197,12 @@ void up_initialize(void)
 	}
 #endif
 
+#ifdef CONFIG_ARCH_USE_CYCLECOUNTER
+	/* Start the cycle counter for the CPU accounting and statistics */
+
+	up_cyclecount_initialize();
+#endif
+
 	/* Initialize the system timer interrupt */
 
 #if !defined(CONFIG_SUPPRESS_INTERRUPTS) && !defined(CONFIG_SUPPRESS_TIMER_INTS) && \
@@ -464,6 +464,10 @@ void up_restorefpu(const uint32_t *regs);
 void up_timer_initialize(void);
 int up_timerisr(int irq, uint32_t *regs);
 
+#ifdef CONFIG_ARCH_USE_CYCLECOUNTER
+void up_cyclecount_initialize(void);
+#endif
+
 /* Low level serial output **************************************************/
 
 void up_lowputc(char ch);
@@ -144,4 +144,7 @@ void up_release_stack(FAR struct tcb_s *dtcb, uint8_t ttype)
 	/* The size of the allocated stack is now zero */
 
 	dtcb->adj_stack_size = 0;
+#ifdef CONFIG_STACK_COLORATION
+	dtcb->stack_hwm = 0;
+#endif
 }
@@ -68,6 +68,9 @@ void up_schedyield(struct tcb_s *rtcb)
 		 */
 
 		rtcb = this_task();
+#ifdef CONFIG_SCHED_CPUACCT
+		sched_cpuacct_switch(rtcb);
+#endif
 		/* Then switch contexts.  Any necessary address environment
 		 * changes will be made when the interrupt returns.
 		 */
@@ -86,6 +89,9 @@ void up_schedyield(struct tcb_s *rtcb)
 		 */
 
 		rtcb = this_task();
+#ifdef CONFIG_SCHED_CPUACCT
+		sched_cpuacct_switch(rtcb);
+#endif
 		/* Then switch contexts */
 
 		up_fullcontextrestore(rtcb->xcp.regs);
@@ -177,6 +177,9 @@ int up_use_stack(struct tcb_s *tcb, void *stack, size_t stack_size)
 
 	tcb->adj_stack_ptr = (uint32_t *)top_of_stack;
 	tcb->adj_stack_size = size_of_stack;
+#ifdef CONFIG_STACK_COLORATION
+	tcb->stack_hwm = 0;
+#endif
 
 	return OK;
 }
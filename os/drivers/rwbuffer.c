@@ -226,7 +226,7 @@ static void rwb_wrstarttimeout(FAR struct rwbuffer_s *rwb)
 	 */
 
 	int ticks = (CONFIG_DRVR_WRDELAY + CLK_TCK / 2) / CLK_TCK;
-	(void)work_queue(LPWORK, &rwb->work, rwb_wrtimeout, (FAR void *)rwb, ticks);
+	(void)work_queue(FSWORK, &rwb->work, rwb_wrtimeout, (FAR void *)rwb, ticks);
 }
 
 /****************************************************************************
@@ -235,7 +235,7 @@ static void rwb_wrstarttimeout(FAR struct rwbuffer_s *rwb)
 
 static inline void rwb_wrcanceltimeout(struct rwbuffer_s *rwb)
 {
-	(void)work_cancel(LPWORK, &rwb->work);
+	(void)work_cancel(FSWORK, &rwb->work);
 }
 
 /****************************************************************************
@@ -126,6 +126,16 @@ int aio_signal(pid_t pid, FAR struct aiocb *aiocbp)
 
 	/* Signal the client */
 
+#ifdef CONFIG_SIG_EVTHREAD
+	if (aiocbp->aio_sigevent.sigev_notify == SIGEV_THREAD) {
+		status = sig_evthread(&aiocbp->aio_sigwork);
+		if (status < 0) {
+			errcode = -status;
+			fdbg("ERROR: sig_evthread failed: %d\n", errcode);
+			ret = ERROR;
+		}
+	} else
+#endif
 	if (aiocbp->aio_sigevent.sigev_notify == SIGEV_SIGNAL) {
 #ifdef CONFIG_CAN_PASS_STRUCTS
 		status = sigqueue(pid, aiocbp->aio_sigevent.sigev_signo, aiocbp->aio_sigevent.sigev_value);
@@ -149,6 +149,19 @@ FAR struct aio_container_s *aio_contain(FAR struct aiocb *aiocbp)
 	aioc->u.ptr = u.ptr;
 	aioc->aioc_pid = getpid();
 
+#ifdef CONFIG_SIG_EVTHREAD
+	/* The notification of a SIGEV_THREAD request.  sig_evthread() copies
+	 * it into its own work structure when the request completes, so the
+	 * aiocb may be submitted again or freed before the notification ran.
+	 */
+
+	memset(&aiocbp->aio_sigwork, 0, sizeof(struct sigwork_s));
+	if (aiocbp->aio_sigevent.sigev_notify == SIGEV_THREAD) {
+		aiocbp->aio_sigwork.func = aiocbp->aio_sigevent.sigev_notify_function;
+		aiocbp->aio_sigwork.value.sival_ptr = aiocbp->aio_sigevent.sigev_value.sival_ptr;
+	}
+#endif
+
 #ifdef CONFIG_PRIORITY_INHERITANCE
 	DEBUGVERIFY(sched_getparam(aioc->aioc_pid, &param));
 	aioc->aioc_prio = param.sched_priority;
@@ -66,6 +66,7 @@
 #include <stdlib.h>
 #include <stddef.h>
 #include <string.h>
+#include <semaphore.h>
 #include <debug.h>
 #include <errno.h>
 
@@ -74,6 +75,8 @@
 #include <crc32.h>
 #include <tinyara/math.h>
 #include <tinyara/kmalloc.h>
+#include <tinyara/clock.h>
+#include <tinyara/wqueue.h>
 #include <tinyara/fs/fs.h>
 #include <tinyara/fs/ioctl.h>
 #include <tinyara/fs/mtd.h>
@@ -155,6 +158,44 @@
 #endif
 
 #define SMART_MAX_ALLOCS        6
+
+/* Background garbage collection */
+
+#ifdef CONFIG_MTD_SMART_BGGC
+#ifndef CONFIG_MTD_SMART_BGGC_WATERMARK
+#define CONFIG_MTD_SMART_BGGC_WATERMARK 12
+#endif
+#ifndef CONFIG_MTD_SMART_BGGC_BLOCKS
+#define CONFIG_MTD_SMART_BGGC_BLOCKS 1
+#endif
+#ifndef CONFIG_MTD_SMART_BGGC_DELAY
+#define CONFIG_MTD_SMART_BGGC_DELAY 10
+#endif
+
+#define SMART_BGGC_WATERMARK(dev) ((uint32_t)(dev)->totalsectors * CONFIG_MTD_SMART_BGGC_WATERMARK / 100)
+#define SMART_BGGC_MINRELEASE(dev) ((dev)->availSectPerBlk >> 2)
+#endif
+
+/* Sector map cache of CONFIG_MTD_SMART_MINIMIZE_RAM.  With
+ * CONFIG_MTD_SMART_MAP_CACHE, each entry holds a chunk of the map and a
+ * hash bucket head is allocated with it.
+ */
+
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#ifdef CONFIG_MTD_SMART_MAP_CACHE
+#define SMART_MAP_CHUNKSHIFT    4
+#define SMART_MAP_CHUNKSIZE     (1 << SMART_MAP_CHUNKSHIFT)
+#define SMART_MAP_CHUNKMASK     (SMART_MAP_CHUNKSIZE - 1)
+#define SMART_CACHE_ENTRIES     CONFIG_MTD_SMART_MAP_CACHE_CHUNKS
+#define SMART_CACHE_ALLOCSIZE   (SMART_CACHE_ENTRIES * (sizeof(struct smart_cache_s) + sizeof(uint16_t)))
+#else
+#ifndef CONFIG_MTD_SMART_SECTOR_CACHE_SIZE
+#define CONFIG_MTD_SMART_SECTOR_CACHE_SIZE 512
+#endif
+#define SMART_CACHE_ENTRIES     CONFIG_MTD_SMART_SECTOR_CACHE_SIZE
+#define SMART_CACHE_ALLOCSIZE   (SMART_CACHE_ENTRIES * sizeof(struct smart_cache_s))
+#endif
+#endif
 //#define CONFIG_MTD_SMART_PACK_COUNTS
 
 #ifndef CONFIG_MTD_SMART_ALLOC_DEBUG
@@ -235,12 +276,23 @@ static const uint8_t gWearBitToLevelMap4[] = {
  ****************************************************************************/
 
 #ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#ifdef CONFIG_MTD_SMART_MAP_CACHE
+struct smart_cache_s {
+	uint16_t chunk;				/* Logical sector >> SMART_MAP_CHUNKSHIFT, 0xFFFF if free */
+	uint16_t known;				/* Bit set for each sector with a known mapping */
+	uint16_t hashnext;			/* Next entry in the same hash bucket */
+	uint16_t newer;				/* Next more recently used entry */
+	uint16_t older;				/* Next less recently used entry */
+	uint16_t physical[SMART_MAP_CHUNKSIZE];	/* Physical sectors, 0xFFFF if unused */
+};
+#else
 struct smart_cache_s {
 	uint16_t logical;			/* Logical sector number */
 	uint16_t physical;			/* Associated physical sector */
 	uint16_t birth;				/* The "birthday" of this entry */
 };
 #endif
+#endif
 
 /* When CRC is enabled, we allocate sectors in memory only and only write
  * to the device when an actual writesector is performed.  If during the
@@ -258,6 +310,21 @@ struct smart_allocsector_s {
 };
 #endif
 
+/* With CONFIG_MTD_SMART_BLOCK_INDEX, the erase blocks with the same free
+ * count, and with the same release count, are linked in a circular list.
+ * The block to allocate from and the block to collect are then found
+ * without reading the counts of every erase block.
+ */
+
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+struct smart_blkindex_s {
+	FAR uint16_t *head;			/* First block of each count, 0xFFFF if none */
+	FAR uint16_t *next;			/* Next block of the same count, 0xFFFF if not linked */
+	FAR uint16_t *prev;			/* Previous block of the same count */
+	uint16_t maxcount;			/* No block has a higher count */
+};
+#endif
+
 struct smart_struct_s {
 	FAR struct mtd_dev_s *mtd;	/* Contained MTD interface */
 	struct mtd_geometry_s geo;	/* Device geometry */
@@ -301,6 +368,18 @@ struct smart_struct_s {
 	uint8_t *wearstatus;		/* Array of wear leveling bits */
 	uint32_t uneven_wearcount;	/* Number of times the the wear level has gone over max */
 #endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	struct smart_blkindex_s freeindex;	/* Erase blocks by free count */
+	struct smart_blkindex_s releaseindex;	/* Erase blocks by release count */
+#endif
+#ifdef CONFIG_MTD_SMART_BGGC
+	sem_t exclsem;				/* Serializes the ioctls and the collection */
+	struct work_s gcwork;		/* Background garbage collection */
+	uint16_t crefs;				/* Opens; the collection runs only while open */
+#endif
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+	FAR uint8_t *runbuffer;		/* Buffer for runs of adjacent sectors */
+#endif
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
 	FAR struct smart_allocsector_s
 			*allocsector;				/* Pointer to first alloc sector */
@@ -313,8 +392,14 @@ struct smart_struct_s {
 	uint16_t cache_entries;	/* Number of valid entries in the cache */
 	uint16_t cache_lastlog;	/* Keep track of the last sector accessed */
 	uint16_t cache_lastphys;	/* Keep the physical sector number also */
+#ifdef CONFIG_MTD_SMART_MAP_CACHE
+	FAR uint16_t *cache_hash;	/* Hash bucket heads, after the entries */
+	uint16_t cache_newest;		/* Most recently used entry */
+	uint16_t cache_oldest;		/* Least recently used entry */
+#else
 	uint16_t cache_nextbirth;	/* Sector cache aging value */
 #endif
+#endif
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
 	FAR uint8_t *erasecounts;	/* Number of erases for each erase block */
 #endif
@@ -415,11 +500,26 @@ static int smart_geometry(FAR struct inode *inode, struct geometry *geometry);
 static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg);
 
 static uint16_t smart_findfreephyssector(FAR struct smart_struct_s *dev, uint8_t canrelocate);
+static uint8_t smart_get_count(FAR struct smart_struct_s *dev, FAR uint8_t *pCount, uint16_t block);
+#ifdef CONFIG_MTD_SMART_MAP_CACHE
+static void smart_cache_reset(FAR struct smart_struct_s *dev);
+#endif
 
 #ifdef CONFIG_FS_WRITABLE
 static int smart_writesector(FAR struct smart_struct_s *dev, unsigned long arg);
 #endif
 static int smart_readsector(FAR struct smart_struct_s *dev, unsigned long arg);
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+static int smart_readsectors(FAR struct smart_struct_s *dev, unsigned long arg);
+#ifdef CONFIG_FS_WRITABLE
+static int smart_writesectors(FAR struct smart_struct_s *dev, unsigned long arg);
+#endif
+#endif
+#ifdef CONFIG_MTD_SMART_BGGC
+static void smart_lock(FAR struct smart_struct_s *dev);
+static void smart_unlock(FAR struct smart_struct_s *dev);
+static void smart_bggc_schedule(FAR struct smart_struct_s *dev);
+#endif
 
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 static int smart_read_wearstatus(FAR struct smart_struct_s *dev);
@@ -428,7 +528,9 @@ static int smart_relocate_static_data(FAR struct smart_struct_s *dev, uint16_t b
 static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t block, uint8_t forceerase);
 static int smart_relocate_sector(FAR struct smart_struct_s *dev, uint16_t oldsector, uint16_t newsector);
 static int smart_validate_crc(FAR struct smart_struct_s *dev);
+static int smart_validate_buffer_crc(FAR struct smart_struct_s *dev, FAR const uint8_t *buffer);
 static crc_t smart_calc_sector_crc(FAR struct smart_struct_s *dev);
+static crc_t smart_calc_buffer_crc(FAR struct smart_struct_s *dev, FAR const uint8_t *buffer);
 
 /****************************************************************************
  * Private Data
@@ -527,7 +629,23 @@ static void smart_free(FAR struct smart_struct_s *dev, FAR void *ptr)
 
 static int smart_open(FAR struct inode *inode)
 {
+#ifdef CONFIG_MTD_SMART_BGGC
+	FAR struct smart_struct_s *dev;
+#endif
+
 	fvdbg("Entry\n");
+
+#ifdef CONFIG_MTD_SMART_BGGC
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+	dev = ((FAR struct smart_multiroot_device_s *)inode->i_private)->dev;
+#else
+	dev = (FAR struct smart_struct_s *)inode->i_private;
+#endif
+
+	smart_lock(dev);
+	dev->crefs++;
+	smart_unlock(dev);
+#endif
 	return OK;
 }
 
@@ -540,10 +658,166 @@ static int smart_open(FAR struct inode *inode)
 
 static int smart_close(FAR struct inode *inode)
 {
+#ifdef CONFIG_MTD_SMART_BGGC
+	FAR struct smart_struct_s *dev;
+#endif
+
 	fvdbg("Entry\n");
+
+#ifdef CONFIG_MTD_SMART_BGGC
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+	dev = ((FAR struct smart_multiroot_device_s *)inode->i_private)->dev;
+#else
+	dev = (FAR struct smart_struct_s *)inode->i_private;
+#endif
+
+	/* Stop the background collection with the last close.  A collection
+	 * that is running completes before the lock is taken, and one that
+	 * waits for the lock finds the device closed.
+	 */
+
+	smart_lock(dev);
+	if (dev->crefs > 0) {
+		dev->crefs--;
+	}
+
+	if (dev->crefs == 0) {
+		(void)work_cancel(LPWORK, &dev->gcwork);
+	}
+
+	smart_unlock(dev);
+#endif
 	return OK;
 }
 
+/****************************************************************************
+ * Name: smart_index_alloc
+ *
+ * Description: Allocate the free and release count indexes, with no block
+ *              linked.  The blocks are linked as their counts are set.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+static int smart_index_alloc(FAR struct smart_struct_s *dev)
+{
+	size_t nheads = dev->sectorsPerBlk + 1;
+	size_t size = (nheads * 2 + dev->neraseblocks * 4) * sizeof(uint16_t);
+
+	dev->freeindex.head = (FAR uint16_t *)smart_malloc(dev, size, "Block index");
+	if (dev->freeindex.head == NULL) {
+		return -ENOMEM;
+	}
+
+	dev->releaseindex.head = dev->freeindex.head + nheads;
+	dev->freeindex.next = dev->releaseindex.head + nheads;
+	dev->freeindex.prev = dev->freeindex.next + dev->neraseblocks;
+	dev->releaseindex.next = dev->freeindex.prev + dev->neraseblocks;
+	dev->releaseindex.prev = dev->releaseindex.next + dev->neraseblocks;
+
+	memset(dev->freeindex.head, 0xFF, size);
+	dev->freeindex.maxcount = 0;
+	dev->releaseindex.maxcount = 0;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: smart_index_bucket
+ *
+ * Description: Returns the index of a count array and the list of the
+ *              current count of a block in it.
+ *
+ ****************************************************************************/
+
+static FAR struct smart_blkindex_s *smart_index_bucket(FAR struct smart_struct_s *dev, FAR uint8_t *pCount, uint16_t block, FAR uint16_t *bucket)
+{
+	*bucket = smart_get_count(dev, pCount, block);
+	if (*bucket > dev->sectorsPerBlk) {
+		*bucket = dev->sectorsPerBlk;
+	}
+
+	return pCount == dev->freecount ? &dev->freeindex : &dev->releaseindex;
+}
+
+/****************************************************************************
+ * Name: smart_index_unlink
+ *
+ * Description: Remove a block from the list of its current count.
+ *
+ ****************************************************************************/
+
+static void smart_index_unlink(FAR struct smart_struct_s *dev, FAR uint8_t *pCount, uint16_t block)
+{
+	FAR struct smart_blkindex_s *index;
+	uint16_t bucket;
+
+	index = smart_index_bucket(dev, pCount, block, &bucket);
+	if (index->next[block] == 0xFFFF) {
+		return;
+	}
+
+	if (index->next[block] == block) {
+		index->head[bucket] = 0xFFFF;
+	} else {
+		index->next[index->prev[block]] = index->next[block];
+		index->prev[index->next[block]] = index->prev[block];
+		if (index->head[bucket] == block) {
+			index->head[bucket] = index->next[block];
+		}
+	}
+
+	index->next[block] = 0xFFFF;
+}
+
+/****************************************************************************
+ * Name: smart_index_link
+ *
+ * Description: Add a block at the end of the list of its current count, so
+ *              that the blocks with the same count are chosen in turn.
+ *
+ ****************************************************************************/
+
+static void smart_index_link(FAR struct smart_struct_s *dev, FAR uint8_t *pCount, uint16_t block)
+{
+	FAR struct smart_blkindex_s *index;
+	uint16_t bucket;
+	uint16_t head;
+
+	index = smart_index_bucket(dev, pCount, block, &bucket);
+	head = index->head[bucket];
+	if (head == 0xFFFF) {
+		index->head[bucket] = block;
+		index->next[block] = block;
+		index->prev[block] = block;
+	} else {
+		index->next[block] = head;
+		index->prev[block] = index->prev[head];
+		index->next[index->prev[head]] = block;
+		index->prev[head] = block;
+	}
+
+	if (bucket > index->maxcount) {
+		index->maxcount = bucket;
+	}
+}
+
+/****************************************************************************
+ * Name: smart_index_maxcount
+ *
+ * Description: Returns the highest count of a block in an index.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_index_maxcount(FAR struct smart_blkindex_s *index)
+{
+	while (index->maxcount > 0 && index->head[index->maxcount] == 0xFFFF) {
+		index->maxcount--;
+	}
+
+	return index->maxcount;
+}
+#endif							/* CONFIG_MTD_SMART_BLOCK_INDEX */
+
 /****************************************************************************
  * Name: smart_set_count
  *
@@ -552,9 +826,13 @@ static int smart_close(FAR struct inode *inode)
  *
  ****************************************************************************/
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 static void smart_set_count(FAR struct smart_struct_s *dev, FAR uint8_t *pCount, uint16_t block, uint8_t count)
 {
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	smart_index_unlink(dev, pCount, block);
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 	if (dev->sectorsPerBlk > 16) {
 		pCount[block] = count;
 	} else {
@@ -578,8 +856,14 @@ static void smart_set_count(FAR struct smart_struct_s *dev, FAR uint8_t *pCount,
 			}
 		}
 	}
-}
+#else
+	pCount[block] = count;
+#endif
+
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	smart_index_link(dev, pCount, block);
 #endif
+}
 
 /****************************************************************************
  * Name: smart_get_count
@@ -589,9 +873,9 @@ static void smart_set_count(FAR struct smart_struct_s *dev, FAR uint8_t *pCount,
  *
  ****************************************************************************/
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 static uint8_t smart_get_count(FAR struct smart_struct_s *dev, FAR uint8_t *pCount, uint16_t block)
 {
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 	uint8_t count;
 
 	if (dev->sectorsPerBlk > 16) {
@@ -617,8 +901,10 @@ static uint8_t smart_get_count(FAR struct smart_struct_s *dev, FAR uint8_t *pCou
 	}
 
 	return count;
-}
+#else
+	return pCount[block];
 #endif
+}
 
 /****************************************************************************
  * Name: smart_add_count
@@ -627,7 +913,6 @@ static uint8_t smart_get_count(FAR struct smart_struct_s *dev, FAR uint8_t *pCou
  *
  ****************************************************************************/
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 static void smart_add_count(struct smart_struct_s *dev, uint8_t *pCount, uint16_t block, int adder)
 {
 	int16_t value;
@@ -635,7 +920,6 @@ static void smart_add_count(struct smart_struct_s *dev, uint8_t *pCount, uint16_
 	value = smart_get_count(dev, pCount, block) + adder;
 	smart_set_count(dev, pCount, block, value);
 }
-#endif
 
 /****************************************************************************
  * Name: smart_checkfree
@@ -1025,7 +1309,9 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 
 	dev->cache_entries = 0;
 	dev->cache_lastlog = 0xFFFF;
+#ifndef CONFIG_MTD_SMART_MAP_CACHE
 	dev->cache_nextbirth = 0;
+#endif
 #endif
 
 	if (dev->rwbuffer != NULL) {
@@ -1036,12 +1322,24 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 		smart_free(dev, dev->bytebuffer);
 		dev->bytebuffer = NULL;
 	}
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+	if (dev->runbuffer != NULL) {
+		smart_free(dev, dev->runbuffer);
+		dev->runbuffer = NULL;
+	}
+#endif
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 	if (dev->wearstatus != NULL) {
 		smart_free(dev, dev->wearstatus);
 		dev->wearstatus = NULL;
 	}
 #endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	if (dev->freeindex.head != NULL) {
+		smart_free(dev, dev->freeindex.head);
+		dev->freeindex.head = NULL;
+	}
+#endif
 
 #ifdef CONFIG_SMARTFS_BAD_SECTOR
 
@@ -1129,7 +1427,7 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 	/* Allocate the sector cache */
 
 	if (dev->sCache == NULL) {
-		dev->sCache = (FAR struct smart_cache_s *)smart_malloc(dev, CONFIG_MTD_SMART_SECTOR_CACHE_SIZE * sizeof(struct smart_cache_s) + allocsize, "Sector Cache");
+		dev->sCache = (FAR struct smart_cache_s *)smart_malloc(dev, SMART_CACHE_ALLOCSIZE + allocsize, "Sector Cache");
 	}
 
 	if (!dev->sCache) {
@@ -1137,7 +1435,7 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 		goto errexit;
 	}
 
-	dev->releasecount = (FAR uint8_t *)dev->sCache + (CONFIG_MTD_SMART_SECTOR_CACHE_SIZE * sizeof(struct smart_cache_s));
+	dev->releasecount = (FAR uint8_t *)dev->sCache + SMART_CACHE_ALLOCSIZE;
 
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
 	if (dev->sectorsPerBlk > 16) {
@@ -1152,6 +1450,10 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 	dev->freecount = dev->releasecount + dev->neraseblocks;
 #endif
 
+#ifdef CONFIG_MTD_SMART_MAP_CACHE
+	dev->cache_hash = (FAR uint16_t *)&dev->sCache[SMART_CACHE_ENTRIES];
+	smart_cache_reset(dev);
+#endif
 #endif							/* CONFIG_MTD_SMART_MINIMIZE_RAM */
 
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
@@ -1183,6 +1485,15 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 	dev->uneven_wearcount = 0;
 #endif
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	/* Allocate the free and release count indexes */
+
+	if (smart_index_alloc(dev) != OK) {
+		fdbg("Error allocating block index\n");
+		goto errexit;
+	}
+#endif
+
 	/* Allocate a read/write buffer */
 
 	dev->rwbuffer = (FAR char *)smart_malloc(dev, size, "RW Buffer");
@@ -1197,6 +1508,16 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 		goto errexit;
 	}
 
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+	/* Allocate the buffer of the vectored sector reads */
+
+	dev->runbuffer = (FAR uint8_t *)smart_malloc(dev, size * CONFIG_MTD_SMART_VECTORED_RUN, "Run Buffer");
+	if (!dev->runbuffer) {
+		fdbg("Error allocating SMART run buffer\n");
+		goto errexit;
+	}
+#endif
+
 	return OK;
 
 	/* On error for any allocation, we jump here and free anything that had
@@ -1234,6 +1555,18 @@ errexit:
 	}
 #endif
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	if (dev->freeindex.head) {
+		smart_free(dev, dev->freeindex.head);
+	}
+#endif
+
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+	if (dev->runbuffer) {
+		smart_free(dev, dev->runbuffer);
+	}
+#endif
+
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
 	if (dev->erasecounts) {
 		smart_free(dev, dev->erasecounts);
@@ -1318,7 +1651,7 @@ errout:
  *
  ****************************************************************************/
 
-#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#if defined(CONFIG_MTD_SMART_MINIMIZE_RAM) && !defined(CONFIG_MTD_SMART_MAP_CACHE)
 static int smart_add_sector_to_cache(FAR struct smart_struct_s *dev, uint16_t logical, uint16_t physical, int line)
 {
 	uint16_t index, x;
@@ -1385,7 +1718,7 @@ static int smart_add_sector_to_cache(FAR struct smart_struct_s *dev, uint16_t lo
  *
  ****************************************************************************/
 
-#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#if defined(CONFIG_MTD_SMART_MINIMIZE_RAM) && !defined(CONFIG_MTD_SMART_MAP_CACHE)
 static uint16_t smart_cache_lookup(FAR struct smart_struct_s *dev, uint16_t logical)
 {
 	int ret;
@@ -1457,7 +1790,7 @@ static uint16_t smart_cache_lookup(FAR struct smart_struct_s *dev, uint16_t logi
 
 				/* Test if this sector has been release and skip it if it has */
 
-				if (SECOR_IS_RELEASED(header)) {
+				if (SECTOR_IS_RELEASED(header)) {
 					continue;
 				}
 
@@ -1497,7 +1830,7 @@ err_out:
  *
  ****************************************************************************/
 
-#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#if defined(CONFIG_MTD_SMART_MINIMIZE_RAM) && !defined(CONFIG_MTD_SMART_MAP_CACHE)
 static void smart_update_cache(FAR struct smart_struct_s *dev, uint16_t logical, uint16_t physical)
 {
 	uint16_t x;
@@ -1534,6 +1867,330 @@ static void smart_update_cache(FAR struct smart_struct_s *dev, uint16_t logical,
 }
 #endif
 
+/****************************************************************************
+ * Name: smart_cache_reset
+ *
+ * Description: Empties the map chunk cache.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CACHE
+static void smart_cache_reset(FAR struct smart_struct_s *dev)
+{
+	uint16_t x;
+
+	for (x = 0; x < SMART_CACHE_ENTRIES; x++) {
+		dev->sCache[x].chunk = 0xFFFF;
+		dev->cache_hash[x] = 0xFFFF;
+	}
+
+	dev->cache_entries = 0;
+	dev->cache_newest = 0xFFFF;
+	dev->cache_oldest = 0xFFFF;
+	dev->cache_lastlog = 0xFFFF;
+}
+
+/****************************************************************************
+ * Name: smart_cache_unlink / smart_cache_link
+ *
+ * Description: Remove an entry from the least recently used list, or
+ *              insert it as the most recently used entry.
+ *
+ ****************************************************************************/
+
+static void smart_cache_unlink(FAR struct smart_struct_s *dev, uint16_t index)
+{
+	FAR struct smart_cache_s *entry = &dev->sCache[index];
+
+	if (entry->newer != 0xFFFF) {
+		dev->sCache[entry->newer].older = entry->older;
+	} else {
+		dev->cache_newest = entry->older;
+	}
+
+	if (entry->older != 0xFFFF) {
+		dev->sCache[entry->older].newer = entry->newer;
+	} else {
+		dev->cache_oldest = entry->newer;
+	}
+}
+
+static void smart_cache_link(FAR struct smart_struct_s *dev, uint16_t index)
+{
+	FAR struct smart_cache_s *entry = &dev->sCache[index];
+
+	entry->newer = 0xFFFF;
+	entry->older = dev->cache_newest;
+	if (dev->cache_newest != 0xFFFF) {
+		dev->sCache[dev->cache_newest].newer = index;
+	} else {
+		dev->cache_oldest = index;
+	}
+
+	dev->cache_newest = index;
+}
+
+/****************************************************************************
+ * Name: smart_cache_find
+ *
+ * Description: Returns the index of the entry of a chunk, or 0xFFFF if the
+ *              chunk is not cached.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_cache_find(FAR struct smart_struct_s *dev, uint16_t chunk)
+{
+	uint16_t index;
+
+	index = dev->cache_hash[chunk % SMART_CACHE_ENTRIES];
+	while (index != 0xFFFF && dev->sCache[index].chunk != chunk) {
+		index = dev->sCache[index].hashnext;
+	}
+
+	return index;
+}
+
+/****************************************************************************
+ * Name: smart_cache_getchunk
+ *
+ * Description: Returns the index of the entry of a chunk, made the most
+ *              recently used entry.  If the chunk is not cached, the least
+ *              recently used entry is replaced by an entry with no known
+ *              mappings.  Entries with the mappings of system sectors are
+ *              replaced last.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_cache_getchunk(FAR struct smart_struct_s *dev, uint16_t chunk)
+{
+	FAR uint16_t *link;
+	uint16_t index;
+
+	index = smart_cache_find(dev, chunk);
+	if (index != 0xFFFF) {
+		if (index != dev->cache_newest) {
+			smart_cache_unlink(dev, index);
+			smart_cache_link(dev, index);
+		}
+
+		return index;
+	}
+
+	if (dev->cache_entries < SMART_CACHE_ENTRIES) {
+		index = dev->cache_entries++;
+	} else {
+		/* Replace the oldest entry that doesn't map system sectors */
+
+		index = dev->cache_oldest;
+		while (index != 0xFFFF && (dev->sCache[index].chunk << SMART_MAP_CHUNKSHIFT) < dev->reservedsector) {
+			index = dev->sCache[index].newer;
+		}
+
+		if (index == 0xFFFF) {
+			index = dev->cache_oldest;
+		}
+
+		/* Remove it from its hash bucket and from the list */
+
+		link = &dev->cache_hash[dev->sCache[index].chunk % SMART_CACHE_ENTRIES];
+		while (*link != index) {
+			link = &dev->sCache[*link].hashnext;
+		}
+
+		*link = dev->sCache[index].hashnext;
+		smart_cache_unlink(dev, index);
+	}
+
+	dev->sCache[index].chunk = chunk;
+	dev->sCache[index].known = 0;
+	dev->sCache[index].hashnext = dev->cache_hash[chunk % SMART_CACHE_ENTRIES];
+	dev->cache_hash[chunk % SMART_CACHE_ENTRIES] = index;
+	smart_cache_link(dev, index);
+
+	return index;
+}
+
+/****************************************************************************
+ * Name: smart_cache_fill
+ *
+ * Description: Finds the mappings of the sectors of a cached chunk that are
+ *              not known.  Sectors that are not in use map to 0xFFFF.  The
+ *              others are searched for in one pass over the sector headers,
+ *              which stops when all of them are found.
+ *
+ ****************************************************************************/
+
+static int smart_cache_fill(FAR struct smart_struct_s *dev, uint16_t index)
+{
+	FAR struct smart_cache_s *entry = &dev->sCache[index];
+	struct smart_sect_header_s header;
+	uint16_t first;
+	uint16_t logical;
+	uint16_t physical;
+	uint16_t wanted;
+	uint16_t block;
+	uint16_t sector;
+	uint16_t x;
+	int ret;
+
+	first = entry->chunk << SMART_MAP_CHUNKSHIFT;
+	wanted = 0;
+
+	for (x = 0; x < SMART_MAP_CHUNKSIZE; x++) {
+		if (entry->known & (1 << x)) {
+			continue;
+		}
+
+		logical = first + x;
+		if (logical < dev->totalsectors && (dev->sBitMap[logical >> 3] & (1 << (logical & 0x07)))) {
+			wanted |= 1 << x;
+		} else {
+			entry->physical[x] = 0xFFFF;
+			entry->known |= 1 << x;
+		}
+	}
+
+	/* Scan like smart_cache_lookup(), across the erase blocks */
+
+	for (sector = 0; sector < dev->sectorsPerBlk && wanted != 0; sector++) {
+		for (block = 0; block < dev->geo.neraseblocks && wanted != 0; block++) {
+			physical = block * dev->sectorsPerBlk + sector;
+			if (physical >= dev->totalsectors) {
+				continue;
+			}
+
+			ret = MTD_READ(dev->mtd, physical * dev->mtdBlksPerSector * dev->geo.blocksize, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
+			if (ret != sizeof(struct smart_sect_header_s)) {
+				return -EIO;
+			}
+
+			logical = UINT8TOUINT16(header.logicalsector);
+#if CONFIG_SMARTFS_ERASEDSTATE == 0x00
+			if (logical == 0) {
+				continue;
+			}
+#endif
+
+			if (!SECTOR_IS_COMMITTED(header) || SECTOR_IS_RELEASED(header)) {
+				continue;
+			}
+
+			if ((header.status & SMART_STATUS_VERBITS) != SMART_STATUS_VERSION) {
+				continue;
+			}
+
+			x = logical - first;
+			if (x < SMART_MAP_CHUNKSIZE && (wanted & (1 << x))) {
+				entry->physical[x] = physical;
+				entry->known |= 1 << x;
+				wanted &= ~(1 << x);
+			}
+		}
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: smart_add_sector_to_cache
+ *
+ * Description: Adds a logical to physical sector mapping to the chunk of
+ *              the map that holds it.
+ *
+ ****************************************************************************/
+
+static int smart_add_sector_to_cache(FAR struct smart_struct_s *dev, uint16_t logical, uint16_t physical, int line)
+{
+	FAR struct smart_cache_s *entry;
+	uint16_t index;
+	uint16_t x;
+
+	index = smart_cache_getchunk(dev, logical >> SMART_MAP_CHUNKSHIFT);
+	entry = &dev->sCache[index];
+	x = logical & SMART_MAP_CHUNKMASK;
+	entry->physical[x] = physical;
+	entry->known |= 1 << x;
+
+	dev->cache_lastlog = logical;
+	dev->cache_lastphys = physical;
+	if (dev->debuglevel > 1) {
+		dbg("Add Cache sector:  Log=%d, Phys=%d at index %d from line %d\n", logical, physical, index, line);
+	}
+
+	return index;
+}
+
+/****************************************************************************
+ * Name: smart_cache_lookup
+ *
+ * Description: Perform a cache lookup for the requested logical sector.
+ *              If the mapping isn't known, the mappings of its chunk are
+ *              read from the volume.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_cache_lookup(FAR struct smart_struct_s *dev, uint16_t logical)
+{
+	FAR struct smart_cache_s *entry;
+	uint16_t physical;
+	uint16_t index;
+	uint16_t x;
+
+	if (logical == dev->cache_lastlog) {
+		return dev->cache_lastphys;
+	}
+
+	if (logical >= dev->totalsectors) {
+		return 0xFFFF;
+	}
+
+	index = smart_cache_getchunk(dev, logical >> SMART_MAP_CHUNKSHIFT);
+	entry = &dev->sCache[index];
+	x = logical & SMART_MAP_CHUNKMASK;
+
+	if (!(entry->known & (1 << x)) && smart_cache_fill(dev, index) != OK) {
+		return 0xFFFF;
+	}
+
+	/* A sector in use that is not on the volume yet stays unknown */
+
+	physical = (entry->known & (1 << x)) ? entry->physical[x] : 0xFFFF;
+
+	dev->cache_lastlog = logical;
+	dev->cache_lastphys = physical;
+	return physical;
+}
+
+/****************************************************************************
+ * Name: smart_update_cache
+ *
+ * Description: Updates the mapping of a logical sector if its chunk is
+ *              cached.  A physical sector of 0xFFFF frees the sector.
+ *
+ ****************************************************************************/
+
+static void smart_update_cache(FAR struct smart_struct_s *dev, uint16_t logical, uint16_t physical)
+{
+	uint16_t index;
+	uint16_t x;
+
+	index = smart_cache_find(dev, logical >> SMART_MAP_CHUNKSHIFT);
+	if (index != 0xFFFF) {
+		x = logical & SMART_MAP_CHUNKMASK;
+		dev->sCache[index].physical[x] = physical;
+		dev->sCache[index].known |= 1 << x;
+
+		if (dev->debuglevel > 1) {
+			dbg("Update Cache:  Log=%d, Phys=%d at index %d\n", logical, physical, index);
+		}
+	}
+
+	if (dev->cache_lastlog == logical) {
+		dev->cache_lastphys = physical;
+	}
+}
+#endif							/* CONFIG_MTD_SMART_MAP_CACHE */
+
 /****************************************************************************
  * Name: smart_get_wear_level
  *
@@ -1805,13 +2462,8 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 			prerelease = 0;
 		}
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 		smart_set_count(dev, dev->freecount, sector, dev->availSectPerBlk - prerelease);
 		smart_set_count(dev, dev->releasecount, sector, prerelease);
-#else
-		dev->freecount[sector] = dev->availSectPerBlk - prerelease;
-		dev->releasecount[sector] = prerelease;
-#endif
 	}
 
 	/* Initialize the sector map */
@@ -1979,11 +2631,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 		 * erase block's freecount.
 		 */
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 		smart_add_count(dev, dev->freecount, sector / dev->sectorsPerBlk, -1);
-#else
-		dev->freecount[sector / dev->sectorsPerBlk]--;
-#endif
 		dev->freesectors--;
 
 		/* Test if this sector has been release and if it has,
@@ -1996,11 +2644,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 			 */
 
 			dev->releasesectors++;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 			smart_add_count(dev, dev->releasecount, sector / dev->sectorsPerBlk, 1);
-#else
-			dev->releasecount[sector / dev->sectorsPerBlk]++;
-#endif
 			continue;
 		}
 
@@ -2271,13 +2915,11 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
 			dev->sMap[0] = newsector;
-			dev->freecount[newsector / dev->sectorsPerBlk]--;
-			dev->releasecount[sector / dev->sectorsPerBlk]++;
 #else
 			smart_update_cache(dev, 0, newsector);
+#endif
 			smart_add_count(dev, dev->freecount, newsector / dev->sectorsPerBlk, -1);
 			smart_add_count(dev, dev->releasecount, sector / dev->sectorsPerBlk, 1);
-#endif
 
 		}
 	}
@@ -2433,13 +3075,8 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t
 		dev->freesectors += dev->availSectPerBlk - prerelease - freecount;
 		dev->releasesectors -= releasecount - prerelease;
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 		smart_set_count(dev, dev->releasecount, block, prerelease);
 		smart_set_count(dev, dev->freecount, block, dev->availSectPerBlk - prerelease);
-#else
-		dev->releasecount[block] = prerelease;
-		dev->freecount[block] = dev->availSectPerBlk - prerelease;
-#endif							/* CONFIG_MTD_SMART_PACK_COUNTS */
 
 		/* Now that we have erased this block and updated the release / free counts,
 		 * if we are in WEAR LEVELING enabled mode, we must check if this erase block's
@@ -2642,11 +3279,7 @@ static int smart_relocate_static_data(FAR struct smart_struct_s *dev, uint16_t b
 			smart_update_cache(dev, *((FAR uint16_t *)header->logicalsector), newsector);
 #endif
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 			smart_add_count(dev, dev->freecount, block, -1);
-#else
-			dev->freecount[block]--;
-#endif							/* CONFIG_MTD_SMART_PACK_COUNTS */
 		}
 
 #ifdef CONFIG_SMART_LOCAL_CHECKFREE
@@ -2671,14 +3304,14 @@ errout:
 #endif
 
 /****************************************************************************
- * Name: smart_calc_sector_crc
+ * Name: smart_calc_buffer_crc
  *
- * Description:  Calculate the CRC value for the sector data in the RW buffer
+ * Description:  Calculate the CRC value for the sector data in a buffer
  *               based on the configured CRC size.
  *
  ****************************************************************************/
 
-static crc_t smart_calc_sector_crc(FAR struct smart_struct_s *dev)
+static crc_t smart_calc_buffer_crc(FAR struct smart_struct_s *dev, FAR const uint8_t *buffer)
 {
 	crc_t crc = 0;
 
@@ -2686,41 +3319,41 @@ static crc_t smart_calc_sector_crc(FAR struct smart_struct_s *dev)
 
 	/* Calculate CRC on data region of the sector */
 
-	crc = crc8((uint8_t *)&dev->rwbuffer[sizeof(struct smart_sect_header_s)], dev->mtdBlksPerSector * dev->geo.blocksize - sizeof(struct smart_sect_header_s));
+	crc = crc8(&buffer[sizeof(struct smart_sect_header_s)], dev->mtdBlksPerSector * dev->geo.blocksize - sizeof(struct smart_sect_header_s));
 
 	/* Add logical sector number and seq to the CRC calculation */
 
-	crc = crc8part((uint8_t *)dev->rwbuffer, 3, crc);
+	crc = crc8part(buffer, 3, crc);
 
 	/* Add status to the CRC calculation */
 
-	crc = crc8part((uint8_t *)&dev->rwbuffer[offsetof(struct smart_sect_header_s, status)], 1, crc);
+	crc = crc8part(&buffer[offsetof(struct smart_sect_header_s, status)], 1, crc);
 
 #elif defined(CONFIG_SMART_CRC_16)
 	/* Calculate CRC on data region of the sector */
 
-	crc = crc16((uint8_t *)&dev->rwbuffer[sizeof(struct smart_sect_header_s)], dev->mtdBlksPerSector * dev->geo.blocksize - sizeof(struct smart_sect_header_s));
+	crc = crc16(&buffer[sizeof(struct smart_sect_header_s)], dev->mtdBlksPerSector * dev->geo.blocksize - sizeof(struct smart_sect_header_s));
 
 	/* Add logical sector number to the CRC calculation */
 
-	crc = crc16part((uint8_t *)dev->rwbuffer, 2, crc);
+	crc = crc16part(buffer, 2, crc);
 
 	/* Add status and seq to the CRC calculation */
 
-	crc = crc16part((uint8_t *)&dev->rwbuffer[offsetof(struct smart_sect_header_s, status)], 2, crc);
+	crc = crc16part(&buffer[offsetof(struct smart_sect_header_s, status)], 2, crc);
 
 #elif defined(CONFIG_SMART_CRC_32)
 	/* Calculate CRC on data region of the sector */
 
-	crc = crc32((uint8_t *)&dev->rwbuffer[sizeof(struct smart_sect_header_s)], dev->mtdBlksPerSector * dev->geo.blocksize - sizeof(struct smart_sect_header_s));
+	crc = crc32(&buffer[sizeof(struct smart_sect_header_s)], dev->mtdBlksPerSector * dev->geo.blocksize - sizeof(struct smart_sect_header_s));
 
 	/* Add logical sector number, status and seq to the CRC calculation */
 
-	crc = crc32part((uint8_t *)dev->rwbuffer, 6, crc);
+	crc = crc32part(buffer, 6, crc);
 #else
 	/* Add logical sector number and seq to the CRC calculation for basic crc */
 
-	crc = crc8((uint8_t *)dev->rwbuffer, 3);
+	crc = crc8(buffer, 3);
 
 #endif
 
@@ -2728,6 +3361,19 @@ static crc_t smart_calc_sector_crc(FAR struct smart_struct_s *dev)
 }
 
 
+/****************************************************************************
+ * Name: smart_calc_sector_crc
+ *
+ * Description:  Calculate the CRC value for the sector data in the RW buffer
+ *               based on the configured CRC size.
+ *
+ ****************************************************************************/
+
+static crc_t smart_calc_sector_crc(FAR struct smart_struct_s *dev)
+{
+	return smart_calc_buffer_crc(dev, (FAR const uint8_t *)dev->rwbuffer);
+}
+
 /*Name: smart_write_bad_sector_info
  *
  *
@@ -2956,22 +3602,13 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 		} else {
 			prerelease = 0;
 		}
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 		smart_set_count(dev, dev->releasecount, x, prerelease);
 		smart_set_count(dev, dev->freecount, x, dev->availSectPerBlk - prerelease);
-#else
-		dev->releasecount[x] = prerelease;
-		dev->freecount[x] = dev->availSectPerBlk - prerelease;
-#endif
 	}
 
 	/* Account for the format sector */
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 	smart_set_count(dev, dev->freecount, 0, dev->availSectPerBlk - 1);
-#else
-	dev->freecount[0]--;
-#endif
 
 	/* Now initialize the logical to physical sector map */
 
@@ -2982,6 +3619,14 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 
 		dev->sMap[x] = -1;
 	}
+#else
+	/* Mark logical sector zero as the only sector in use.  The sector
+	 * cache was emptied by smart_setsectorsize().
+	 */
+
+	memset(dev->sBitMap, 0, (dev->totalsectors + 7) >> 3);
+	dev->sBitMap[0] = 0x01;
+	smart_add_sector_to_cache(dev, 0, 0, __LINE__);
 #endif
 
 #ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
@@ -3182,7 +3827,7 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 #endif
 #endif
 
-	dev->freecount[block] = 0;
+	smart_set_count(dev, dev->freecount, block, 0);
 #endif
 
 	/* Next move all live data in the block to a new home. */
@@ -3284,11 +3929,7 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 		smart_update_cache(dev, *((FAR uint16_t *)header->logicalsector), newsector);
 #endif
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 		smart_add_count(dev, dev->freecount, newsector / dev->sectorsPerBlk, -1);
-#else
-		dev->freecount[newsector / dev->sectorsPerBlk]--;
-#endif
 	}
 
 	/* Now erase the erase block */
@@ -3334,8 +3975,8 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 	oldrelease = dev->releasecount[block];
 	dev->freesectors += oldrelease - prerelease;
 	dev->releasesectors -= oldrelease - prerelease;
-	dev->freecount[block] = dev->availSectPerBlk - prerelease;
-	dev->releasecount[block] = prerelease;
+	smart_set_count(dev, dev->freecount, block, dev->availSectPerBlk - prerelease);
+	smart_set_count(dev, dev->releasecount, block, prerelease);
 #endif
 
 #ifdef CONFIG_SMART_LOCAL_CHECKFREE
@@ -3357,11 +3998,7 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 errout:
 	/* Restore the block's freecount if error */
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 	smart_set_count(dev, dev->freecount, block, freecount);
-#else
-	dev->freecount[block] = freecount;
-#endif
 	return ret;
 }
 
@@ -3408,6 +4045,43 @@ retry:
 		dev->lastallocblock = 0;
 	}
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	/* Take the first block that isn't worn from the lists of the highest
+	 * free counts.  The worn blocks are only all visited if there is no
+	 * other block with free sectors.
+	 */
+
+	for (count = smart_index_maxcount(&dev->freeindex); count > 0 && allocblock == 0xFFFF; count--) {
+		block = dev->freeindex.head[count];
+		if (block == 0xFFFF) {
+			continue;
+		}
+
+		do {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+			wearlevel = smart_get_wear_level(dev, block);
+			if (wearlevel >= SMART_WEAR_FULL_RELOCATE_THRESHOLD) {
+				if (wearlevel > maxwearlevel) {
+					maxwearlevel = wearlevel;
+				}
+
+				if (count > wornfreecount || wearlevel < wornlevel) {
+					wornfreecount = count;
+					wornblock = block;
+					wornlevel = wearlevel;
+				}
+			} else
+#endif
+			{
+				allocblock = block;
+				allocfreecount = count;
+				break;
+			}
+
+			block = dev->freeindex.next[block];
+		} while (block != dev->freeindex.head[count]);
+	}
+#else
 	block = dev->lastallocblock;
 	for (x = 0; x < dev->neraseblocks; x++) {
 		/* Test if this block has more free blocks than the
@@ -3455,6 +4129,7 @@ retry:
 			block = 0;
 		}
 	}
+#endif							/* CONFIG_MTD_SMART_BLOCK_INDEX */
 
 	/* Check if we found an allocblock. */
 
@@ -3594,40 +4269,141 @@ retry:
 						fdbg("Error %d releasing corrupted sector\n", -ret);
 						goto error;
 					}
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 					smart_add_count(dev, dev->freecount, x / dev->sectorsPerBlk, -1);
 					smart_add_count(dev, dev->releasecount, allocblock, 1);
-#else
-					dev->freecount[x / dev->sectorsPerBlk]--;
-					dev->releasecount[allocblock]++;
-#endif
 					dev->freesectors--;
 					dev->releasesectors++;
 				}
 #ifdef CONFIG_SMARTFS_BAD_SECTOR
 			}
 #endif
-		}
-	}
+		}
+	}
+
+error:
+	if (physicalsector == 0xFFFF || physicalsector >= dev->totalsectors) {
+		if (bitflipped) {
+			fdbg("retry allocation \n");
+			canrelocate = FALSE;
+			kmm_free(sector_buff);
+			goto retry;
+		}
+		if (physicalsector == 0xFFFF) {
+			dbg("Program bug!  Expected a free sector %d\n", allocblock);
+		} else if (physicalsector >= dev->totalsectors) {
+			dbg("Program bug!  Selected sector too big!!!\n");
+		}
+	}
+
+	kmm_free(sector_buff);
+
+	return physicalsector;
+}
+
+/****************************************************************************
+ * Name: smart_findcollectblock
+ *
+ * Description:  Finds the block with the most released sectors that isn't
+ *               worn completely.  Returns 0xFFFF if no block has released
+ *               sectors.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_WRITABLE
+static uint16_t smart_findcollectblock(FAR struct smart_struct_s *dev, FAR uint16_t *releasemax)
+{
+	uint16_t collectblock;
+	int x;
+#if defined(CONFIG_MTD_SMART_PACK_COUNTS) || defined(CONFIG_MTD_SMART_BLOCK_INDEX)
+	uint16_t count;
+#endif
+
+	collectblock = 0xFFFF;
+	*releasemax = 0;
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	for (count = smart_index_maxcount(&dev->releaseindex); count > 0 && collectblock == 0xFFFF; count--) {
+		x = dev->releaseindex.head[count];
+		if (x == 0xFFFF) {
+			continue;
+		}
+
+		do {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+			/* Don't collect blocks that have been worn completely */
+
+			if (smart_get_wear_level(dev, x) < SMART_WEAR_REORG_THRESHOLD)
+#endif
+			{
+				*releasemax = count;
+				collectblock = x;
+				break;
+			}
+
+			x = dev->releaseindex.next[x];
+		} while (x != dev->releaseindex.head[count]);
+	}
+#else
+	for (x = 0; x < dev->neraseblocks; x++) {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+		/* Don't collect blocks that have been worn completely */
+
+		if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD) {
+			continue;
+		}
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+		count = smart_get_count(dev, dev->releasecount, x);
+		if (count > *releasemax) {
+			*releasemax = count;
+			collectblock = x;
+		}
+#else
+		if (dev->releasecount[x] > *releasemax) {
+			*releasemax = dev->releasecount[x];
+			collectblock = x;
+		}
+#endif
+	}
+#endif							/* CONFIG_MTD_SMART_BLOCK_INDEX */
+
+	return collectblock;
+}
+
+/****************************************************************************
+ * Name: smart_collectblock
+ *
+ * Description:  Relocates the active data of a block and erases it.
+ *
+ ****************************************************************************/
+
+static int smart_collectblock(FAR struct smart_struct_s *dev, uint16_t collectblock)
+{
+	int ret;
+
+#ifdef CONFIG_SMART_LOCAL_CHECKFREE
+	if (smart_checkfree(dev, __LINE__) != OK) {
+		fdbg("   ...before collecting block %d\n", collectblock);
+	}
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+	fvdbg("Collecting block %d, free=%d released=%d, totalfree=%d, totalrelease=%d\n", collectblock, smart_get_count(dev, dev->freecount, collectblock), smart_get_count(dev, dev->releasecount, collectblock), dev->freesectors, dev->releasesectors);
+#else
+	fvdbg("Collecting block %d, free=%d released=%d\n", collectblock, dev->freecount[collectblock], dev->releasecount[collectblock]);
+#endif
 
-error:
-	if (physicalsector == 0xFFFF || physicalsector >= dev->totalsectors) {
-		if (bitflipped) {
-			fdbg("retry allocation \n");
-			canrelocate = FALSE;
-			kmm_free(sector_buff);
-			goto retry;
-		}
-		if (physicalsector == 0xFFFF) {
-			dbg("Program bug!  Expected a free sector %d\n", allocblock);
-		} else if (physicalsector >= dev->totalsectors) {
-			dbg("Program bug!  Selected sector too big!!!\n");
-		}
-	}
+	/* Relocate the active data in the collection block */
 
-	kmm_free(sector_buff);
+	ret = smart_relocate_block(dev, collectblock);
 
-	return physicalsector;
+#ifdef CONFIG_SMART_LOCAL_CHECKFREE
+	if (smart_checkfree(dev, __LINE__) != OK) {
+		fdbg("   ...while collecting block %d\n", collectblock);
+	}
+#endif
+
+	return ret;
 }
 
 /****************************************************************************
@@ -3635,25 +4411,23 @@ error:
  *
  * Description:  Performs garbage collection if needed.  This is determined
  *               by the count of released sectors relative to free and
- *               total sectors.
+ *               total sectors.  With CONFIG_MTD_SMART_BGGC, only the
+ *               reserved free sectors are refilled here, the rest is left
+ *               to the background collection.
  *
  ****************************************************************************/
 
-#ifdef CONFIG_FS_WRITABLE
 static int smart_garbagecollect(FAR struct smart_struct_s *dev)
 {
 	uint16_t collectblock;
 	uint16_t releasemax;
 	bool collect = TRUE;
-	int x;
 	int ret;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-	uint8_t count;
-#endif
 
 	while (collect) {
 		collect = FALSE;
 
+#ifndef CONFIG_MTD_SMART_BGGC
 		/* Test if the released sectors count is greater than the
 		 * free sectors.  If it is, then we will do garbage collection.
 		 */
@@ -3661,6 +4435,7 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
 		if (dev->releasesectors > dev->freesectors && dev->freesectors < (dev->totalsectors >> 5)) {
 			collect = TRUE;
 		}
+#endif
 
 		/* Test if we have more reached our reserved free sector limit */
 
@@ -3673,60 +4448,15 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
 		if (collect) {
 			/* Find the block with the most released sectors */
 
-			collectblock = 0xFFFF;
-			releasemax = 0;
-			for (x = 0; x < dev->neraseblocks; x++) {
-#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-				/* Don't collect blocks that have been worn completely */
-
-				if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD) {
-					continue;
-				}
-#endif
-
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-				count = smart_get_count(dev, dev->releasecount, x);
-				if (count > releasemax) {
-					releasemax = count;
-					collectblock = x;
-				}
-#else
-				if (dev->releasecount[x] > releasemax) {
-					releasemax = dev->releasecount[x];
-					collectblock = x;
-				}
-#endif
-			}
-			//releasemax = smart_get_count(dev, dev->releasecount, collectblock);
-
+			collectblock = smart_findcollectblock(dev, &releasemax);
 			if (collectblock == 0xFFFF) {
 				/* Need to collect, but no sectors with released blocks! */
 
 				ret = -ENOSPC;
 				goto errout;
 			}
-#ifdef CONFIG_SMART_LOCAL_CHECKFREE
-			if (smart_checkfree(dev, __LINE__) != OK) {
-				fdbg("   ...before collecting block %d\n", collectblock);
-			}
-#endif
-
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-			fvdbg("Collecting block %d, free=%d released=%d, totalfree=%d, totalrelease=%d\n", collectblock, smart_get_count(dev, dev->freecount, collectblock), smart_get_count(dev, dev->releasecount, collectblock), dev->freesectors, dev->releasesectors);
-#else
-			fvdbg("Collecting block %d, free=%d released=%d\n", collectblock, dev->freecount[collectblock], dev->releasecount[collectblock]);
-#endif
-
-			/* Relocate the active data in the collection block */
-
-			ret = smart_relocate_block(dev, collectblock);
-
-#ifdef CONFIG_SMART_LOCAL_CHECKFREE
-			if (smart_checkfree(dev, __LINE__) != OK) {
-				fdbg("   ...while collecting block %d\n", collectblock);
-			}
-#endif
 
+			ret = smart_collectblock(dev, collectblock);
 			if (ret != OK) {
 				goto errout;
 			}
@@ -4021,34 +4751,33 @@ static int smart_write_alloc_sector(FAR struct smart_struct_s *dev, uint16_t log
 #endif
 
 /****************************************************************************
- * Name: smart_validate_crc
+ * Name: smart_validate_buffer_crc
  *
- * Description:  Validates the CRC data in the sector's header against the
- *               data in the sector.  Assumes the entire sector has been
- *               read into the RW buffer already.
+ * Description:  Validates the CRC data in the header of a sector read into
+ *               a buffer against the data in the sector.
  *
  ****************************************************************************/
 
-static int smart_validate_crc(FAR struct smart_struct_s *dev)
+static int smart_validate_buffer_crc(FAR struct smart_struct_s *dev, FAR const uint8_t *buffer)
 {
 	crc_t crc;
-	FAR struct smart_sect_header_s *header;
+	FAR const struct smart_sect_header_s *header;
 
 	/* Calculate CRC on data region of the sector */
 
-	crc = smart_calc_sector_crc(dev);
-	header = (FAR struct smart_sect_header_s *)dev->rwbuffer;
+	crc = smart_calc_buffer_crc(dev, buffer);
+	header = (FAR const struct smart_sect_header_s *)buffer;
 
 #ifdef CONFIG_SMART_CRC_16
 
 	/* Test 16-bit CRC */
 
-	if (crc != *((uint16_t *)header->crc16)) {
+	if (crc != *((FAR const uint16_t *)header->crc16)) {
 		return -EIO;
 	}
 #elif defined(CONFIG_SMART_CRC_32)
 
-	if (crc != *((uint32_t *)header->crc32)) {
+	if (crc != *((FAR const uint32_t *)header->crc32)) {
 		return -EIO;
 	}
 #else
@@ -4064,6 +4793,20 @@ static int smart_validate_crc(FAR struct smart_struct_s *dev)
 	return OK;
 }
 
+/****************************************************************************
+ * Name: smart_validate_crc
+ *
+ * Description:  Validates the CRC data in the sector's header against the
+ *               data in the sector.  Assumes the entire sector has been
+ *               read into the RW buffer already.
+ *
+ ****************************************************************************/
+
+static int smart_validate_crc(FAR struct smart_struct_s *dev)
+{
+	return smart_validate_buffer_crc(dev, (FAR const uint8_t *)dev->rwbuffer);
+}
+
 
 /****************************************************************************
  * Name: smart_writesector
@@ -4393,13 +5136,8 @@ relocate_good_sector:
 		/* Update releasecount for released sector and freecount for the
 		 * newly allocated physical sector. */
 		block = oldphyssector / dev->sectorsPerBlk;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 		smart_add_count(dev, dev->releasecount, block, 1);
 		smart_add_count(dev, dev->freecount, physsector / dev->sectorsPerBlk, -1);
-#else
-		dev->releasecount[block]++;
-		dev->freecount[physsector / dev->sectorsPerBlk]--;
-#endif
 		dev->freesectors--;
 		dev->releasesectors++;
 
@@ -4513,13 +5251,8 @@ errout:
 		 * newly allocated but bad physical sector. */
 
 		block = physsector / dev->sectorsPerBlk;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 		smart_add_count(dev, dev->releasecount, block, 1);
 		smart_add_count(dev, dev->freecount, physsector / dev->sectorsPerBlk, -1);
-#else
-		dev->releasecount[block]++;
-		dev->freecount[physsector / dev->sectorsPerBlk]--;
-#endif
 		dev->freesectors--;
 		dev->releasesectors++;
 
@@ -4693,6 +5426,151 @@ errout:
 	return ret;
 }
 
+/****************************************************************************
+ * Name: smart_readsectors
+ *
+ * Description:  Reads data from a list of logical sectors.  The physical
+ *               sectors of the whole list are looked up in one pass, and
+ *               runs of adjacent physical sectors, up to
+ *               CONFIG_MTD_SMART_VECTORED_RUN sectors, are read from the
+ *               device with one transfer.  Consecutive requests may read
+ *               from the same sector.  Returns the number of bytes read.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+static int smart_readsectors(FAR struct smart_struct_s *dev, unsigned long arg)
+{
+	FAR struct smart_multi_rw_s *multi;
+	FAR struct smart_read_write_s *req;
+	FAR struct smart_sect_header_s *header;
+	uint16_t physsector[CONFIG_MTD_SMART_VECTORED_RUN];
+	uint16_t first;
+	uint16_t nreqs;
+	uint16_t nphys;
+	uint16_t phys;
+	uint16_t x;
+	int total = 0;
+	int ret;
+
+	fvdbg("Entry\n");
+	multi = (FAR struct smart_multi_rw_s *)arg;
+
+	/* Gather the requests of each run, looking up every sector once */
+
+	first = 0;
+	phys = 0xFFFF;
+	while (first < multi->nsectors) {
+		nreqs = 0;
+		nphys = 0;
+		while (first + nreqs < multi->nsectors && nreqs < CONFIG_MTD_SMART_VECTORED_RUN) {
+			req = &multi->sectors[first + nreqs];
+			DEBUGASSERT(req->offset + req->count <= dev->sectorsize - sizeof(struct smart_sect_header_s));
+
+			if (phys == 0xFFFF) {
+				if (req->logsector >= dev->totalsectors) {
+					fdbg("Logical sector %d too large\n", req->logsector);
+					return -EINVAL;
+				}
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+				phys = dev->sMap[req->logsector];
+#else
+				phys = smart_cache_lookup(dev, req->logsector);
+#endif
+				if (phys == 0xFFFF) {
+					fdbg("Logical sector %d not allocated\n", req->logsector);
+					return -EINVAL;
+				}
+			}
+
+			/* The run continues with the same sector or the next one */
+
+			if (nreqs > 0 && phys != physsector[nreqs - 1] && phys != physsector[nreqs - 1] + 1) {
+				break;
+			}
+
+			if (nreqs == 0 || phys != physsector[nreqs - 1]) {
+				nphys++;
+			}
+
+			physsector[nreqs++] = phys;
+			phys = 0xFFFF;
+		}
+
+		/* Read the sectors of the run */
+
+		ret = MTD_BREAD(dev->mtd, physsector[0] * dev->mtdBlksPerSector, nphys * dev->mtdBlksPerSector, dev->runbuffer);
+		if (ret != nphys * dev->mtdBlksPerSector) {
+			fdbg("Error reading phys sectors %d-%d\n", physsector[0], physsector[0] + nphys - 1);
+			return -EIO;
+		}
+
+		/* Validate each sector once and copy the data to the requests */
+
+		for (x = 0; x < nreqs; x++) {
+			req = &multi->sectors[first + x];
+			header = (FAR struct smart_sect_header_s *)&dev->runbuffer[(physsector[x] - physsector[0]) * dev->sectorsize];
+
+			if (x == 0 || physsector[x] != physsector[x - 1]) {
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+#if SMART_STATUS_VERSION == 1
+				if ((header->status & SMART_STATUS_CRC) != (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_CRC))
+#endif
+				{
+					if (smart_validate_buffer_crc(dev, (FAR const uint8_t *)header) != OK) {
+						fdbg("Error validating sector %d CRC during read\n", physsector[x]);
+						return -EIO;
+					}
+				}
+#else
+				if ((UINT8TOUINT16(header->logicalsector) != req->logsector) || (!(SECTOR_IS_COMMITTED((*header))))) {
+					fdbg("Error in logical sector %d header, phys=%d\n", req->logsector, physsector[x]);
+					return -EIO;
+				}
+#endif
+			}
+
+			memcpy((FAR uint8_t *)req->buffer, (FAR uint8_t *)header + sizeof(struct smart_sect_header_s) + req->offset, req->count);
+			total += req->count;
+		}
+
+		first += nreqs;
+	}
+
+	return total;
+}
+
+/****************************************************************************
+ * Name: smart_writesectors
+ *
+ * Description:  Writes data to a list of logical sectors.  Each write may
+ *               move its sector, and the old sector is released after the
+ *               new one is committed, so the sectors are written in turn.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_WRITABLE
+static int smart_writesectors(FAR struct smart_struct_s *dev, unsigned long arg)
+{
+	FAR struct smart_multi_rw_s *multi;
+	uint16_t x;
+	int ret;
+
+	fvdbg("Entry\n");
+	multi = (FAR struct smart_multi_rw_s *)arg;
+
+	for (x = 0; x < multi->nsectors; x++) {
+		ret = smart_writesector(dev, (unsigned long)&multi->sectors[x]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return OK;
+}
+#endif							/* CONFIG_FS_WRITABLE */
+#endif							/* CONFIG_MTD_SMART_VECTORED_IO */
+
 /****************************************************************************
  * Name: smart_allocsector
  *
@@ -4888,11 +5766,7 @@ static inline int smart_allocsector(FAR struct smart_struct_s *dev, unsigned lon
 	smart_add_sector_to_cache(dev, logsector, physicalsector, __LINE__);
 #endif
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 	smart_add_count(dev, dev->freecount, physicalsector / dev->sectorsPerBlk, -1);
-#else
-	dev->freecount[physicalsector / dev->sectorsPerBlk]--;
-#endif
 	dev->freesectors--;
 
 	/* Return the logical sector number */
@@ -4981,11 +5855,7 @@ static inline int smart_freesector(FAR struct smart_struct_s *dev, unsigned long
 
 	dev->releasesectors++;
 	block = physsector / dev->sectorsPerBlk;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 	smart_add_count(dev, dev->releasecount, block, 1);
-#else
-	dev->releasecount[block]++;
-#endif
 
 	/* Unmap this logical sector */
 
@@ -5006,6 +5876,119 @@ errout:
 }
 #endif							/* CONFIG_FS_WRITABLE */
 
+/****************************************************************************
+ * Name: smart_lock / smart_unlock
+ *
+ * Description: Get and release exclusive access to the device, which the
+ *              background garbage collection shares with the ioctls.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BGGC
+static void smart_lock(FAR struct smart_struct_s *dev)
+{
+	while (sem_wait(&dev->exclsem) != OK) {
+		/* The only case that an error should occur here is if the wait was
+		 * awakened by a signal.
+		 */
+
+		ASSERT(*get_errno_ptr() == EINTR);
+	}
+}
+
+static void smart_unlock(FAR struct smart_struct_s *dev)
+{
+	sem_post(&dev->exclsem);
+}
+
+/****************************************************************************
+ * Name: smart_bggc_needed
+ *
+ * Description: Returns true if the free sectors are below the watermark
+ *              and enough sectors are released to be worth collecting.
+ *
+ ****************************************************************************/
+
+static bool smart_bggc_needed(FAR struct smart_struct_s *dev)
+{
+	return dev->freesectors < SMART_BGGC_WATERMARK(dev) && dev->releasesectors >= SMART_BGGC_MINRELEASE(dev);
+}
+
+/****************************************************************************
+ * Name: smart_bggc_worker
+ *
+ * Description: Collects up to CONFIG_MTD_SMART_BGGC_BLOCKS blocks on the low
+ *              priority work queue, so that the ioctls wait at most for the
+ *              collection of that many blocks.  Collection goes on in
+ *              further steps until the free sectors are above the
+ *              watermark.
+ *
+ ****************************************************************************/
+
+static void smart_bggc_worker(FAR void *arg)
+{
+	FAR struct smart_struct_s *dev = (FAR struct smart_struct_s *)arg;
+	uint16_t collectblock;
+	uint16_t releasemax;
+	int x;
+
+	smart_lock(dev);
+
+	/* The device was closed while the collection waited for it */
+
+	if (dev->crefs == 0) {
+		smart_unlock(dev);
+		return;
+	}
+
+	for (x = 0; x < CONFIG_MTD_SMART_BGGC_BLOCKS && smart_bggc_needed(dev); x++) {
+		/* Leave the blocks with few released sectors for later, relocating
+		 * their data costs more than it frees.
+		 */
+
+		collectblock = smart_findcollectblock(dev, &releasemax);
+		if (collectblock == 0xFFFF || releasemax < SMART_BGGC_MINRELEASE(dev)) {
+			break;
+		}
+
+		if (smart_collectblock(dev, collectblock) != OK) {
+			fdbg("Error collecting block %d\n", collectblock);
+			break;
+		}
+	}
+
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+	if (dev->wearflags & SMART_WEARFLAGS_WRITE_NEEDED) {
+		/* Write new wear status bits to the device */
+
+		smart_write_wearstatus(dev);
+	}
+#endif
+
+	if (x == CONFIG_MTD_SMART_BGGC_BLOCKS) {
+		smart_bggc_schedule(dev);
+	}
+
+	smart_unlock(dev);
+}
+
+/****************************************************************************
+ * Name: smart_bggc_schedule
+ *
+ * Description: Schedules the background garbage collection if the device
+ *              is open, the collection is needed and it isn't scheduled
+ *              yet.
+ *
+ ****************************************************************************/
+
+static void smart_bggc_schedule(FAR struct smart_struct_s *dev)
+{
+	if (dev->crefs > 0 && smart_bggc_needed(dev) && work_available(&dev->gcwork)) {
+		(void)work_queue(LPWORK, &dev->gcwork, smart_bggc_worker, dev, MSEC2TICK(CONFIG_MTD_SMART_BGGC_DELAY));
+	}
+}
+#endif							/* CONFIG_MTD_SMART_BGGC */
+
 /****************************************************************************
  * Name: smart_ioctl
  *
@@ -5030,6 +6013,10 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 	dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
+#ifdef CONFIG_MTD_SMART_BGGC
+	smart_lock(dev);
+#endif
+
 	/* Process the ioctl's we care about first, pass any we don't respond
 	 * to directly to the underlying MTD device.
 	 */
@@ -5044,7 +6031,8 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #ifdef CONFIG_DEBUG
 		if (arg == 0) {
 			fdbg("ERROR: BIOC_XIPBASE argument is NULL\n");
-			return -EINVAL;
+			ret = -EINVAL;
+			goto ok_out;
 		}
 #endif
 
@@ -5070,6 +6058,15 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 		ret = smart_readsector(dev, arg);
 		goto ok_out;
 
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+	case BIOC_READSECTS:
+
+		/* Read a list of logical sectors */
+
+		ret = smart_readsectors(dev, arg);
+		goto ok_out;
+#endif
+
 #ifdef CONFIG_FS_WRITABLE
 	case BIOC_LLFORMAT:
 
@@ -5107,6 +6104,24 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #endif
 
 		goto ok_out;
+
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+	case BIOC_WRITESECTS:
+
+		/* Write to a list of sectors */
+
+		ret = smart_writesectors(dev, arg);
+
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+		if (dev->wearflags & SMART_WEARFLAGS_WRITE_NEEDED) {
+			/* Write new wear status bits to the device */
+
+			smart_write_wearstatus(dev);
+		}
+#endif
+
+		goto ok_out;
+#endif
 #endif							/* CONFIG_FS_WRITABLE */
 
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
@@ -5176,6 +6191,12 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 	}
 
 ok_out:
+#ifdef CONFIG_MTD_SMART_BGGC
+	/* Collect the sectors released by the writes in the background */
+
+	smart_bggc_schedule(dev);
+	smart_unlock(dev);
+#endif
 	return ret;
 }
 
@@ -5267,6 +6288,17 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd, FAR const char *partn
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 		dev->wearstatus = NULL;
 #endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+		dev->freeindex.head = NULL;
+#endif
+#ifdef CONFIG_MTD_SMART_VECTORED_IO
+		dev->runbuffer = NULL;
+#endif
+#ifdef CONFIG_MTD_SMART_BGGC
+		sem_init(&dev->exclsem, 0, 1);
+		memset(&dev->gcwork, 0, sizeof(struct work_s));
+		dev->crefs = 0;
+#endif
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
 		dev->allocsector = NULL;
 #endif
@@ -5380,6 +6412,11 @@ errout:
 		smart_free(dev, dev->wearstatus);
 	}
 #endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	if (dev->freeindex.head != NULL) {
+		smart_free(dev, dev->freeindex.head);
+	}
+#endif
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
 	smart_free(dev, dev->erasecounts);
 #endif
@@ -5503,11 +6540,7 @@ int smart_recoversectors(FAR struct inode *inode, char *validsectors, int *nobso
 
 			dev->releasesectors++;
 			block = sector / dev->sectorsPerBlk;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
 			smart_add_count(dev, dev->releasecount, block, 1);
-#else
-			dev->releasecount[block]++;
-#endif
 
 			/* if the mapping is sane, Unmap this logical->physicalsector map */
 			if (physsector == sector) {
@@ -96,6 +96,10 @@ extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
+extern const struct procfs_operations heapinfo_operations;
+extern const struct procfs_operations meminfo_operations;
+extern const struct procfs_operations wqueue_operations;
+extern const struct procfs_operations irqs_operations;
 
 /* This is not good.  These are implemented in drivers/mtd.  Having to
  * deal with them here is not a good coupling.
@@ -131,6 +135,14 @@ static const struct procfs_entry_s g_procfsentries[] = {
 	{"fs/smartfs**", &smartfs_procfsoperations},
 #endif
 
+#if defined(CONFIG_DEBUG_MM_HEAPINFO_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_HEAPINFO)
+	{"heapinfo", &heapinfo_operations},
+#endif
+
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
+	{"meminfo", &meminfo_operations},
+#endif
+
 #if defined(CONFIG_MTD) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MTD)
 	{"mtd", &mtd_procfsoperations},
 #endif
@@ -151,6 +163,14 @@ static const struct procfs_entry_s g_procfsentries[] = {
 	{"version", &version_operations},
 #endif
 
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+	{"wqueue", &wqueue_operations},
+#endif
+
+#if defined(CONFIG_IRQ_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IRQS)
+	{"irqs", &irqs_operations},
+#endif
+
 #if defined(CONFIG_CM) && !defined(CONFIG_FS_PROCFS_EXCLUDE_CONNECTIVITY)
 	{"connectivity**", &cm_operations},
 #endif
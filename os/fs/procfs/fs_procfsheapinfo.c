@@ -0,0 +1,377 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/procfs/fs_procfsheapinfo.c
+ *
+ * /proc/heapinfo shows the incremental per-task and per-caller usage of the
+ * user heap (CONFIG_DEBUG_MM_HEAPINFO_STATS).  The statistics are copied
+ * when the file is opened, so reading it never walks the heap.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/sched.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/mm/mm.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_DEBUG_MM_HEAPINFO_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_HEAPINFO)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define HEAPINFO_LINELEN 64
+
+/* The lines of the file: the total, the task table and the caller table */
+
+#define HEAPINFO_LINE_TOTAL      0
+#define HEAPINFO_LINE_PIDHDR     1
+#define HEAPINFO_LINE_PID        2
+#define HEAPINFO_LINE_PIDOTHER   (HEAPINFO_LINE_PID + CONFIG_MAX_TASKS)
+#define HEAPINFO_LINE_CALLERHDR  (HEAPINFO_LINE_PIDOTHER + 1)
+#define HEAPINFO_LINE_CALLER     (HEAPINFO_LINE_CALLERHDR + 1)
+#define HEAPINFO_LINE_CALLEROTHER (HEAPINFO_LINE_CALLER + CONFIG_DEBUG_MM_HEAPINFO_NCALLERS)
+#define HEAPINFO_NLINES          (HEAPINFO_LINE_CALLEROTHER + 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct heapinfo_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	struct heapinfo_stats_s stats;	/* Statistics copied at open time */
+	char line[HEAPINFO_LINELEN];	/* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int heapinfo_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int heapinfo_close(FAR struct file *filep);
+static ssize_t heapinfo_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+static int heapinfo_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int heapinfo_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations heapinfo_operations = {
+	heapinfo_open,				/* open */
+	heapinfo_close,				/* close */
+	heapinfo_read,				/* read */
+	NULL,						/* write */
+
+	heapinfo_dup,				/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	heapinfo_stat				/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: heapinfo_open
+ ****************************************************************************/
+
+static int heapinfo_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct heapinfo_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "heapinfo" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "heapinfo") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct heapinfo_file_s *)kmm_zalloc(sizeof(struct heapinfo_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Take the snapshot that all reads of this open file will show */
+
+	heapinfo_stats_snapshot(mm_get_heap_info(), &attr->stats);
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: heapinfo_close
+ ****************************************************************************/
+
+static int heapinfo_close(FAR struct file *filep)
+{
+	FAR struct heapinfo_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct heapinfo_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: heapinfo_line
+ *
+ * Description:
+ *   Format one line of the file into attr->line.  Returns the length of
+ *   the line or zero if there is nothing to show for this line.
+ *
+ ****************************************************************************/
+
+static size_t heapinfo_line(FAR struct heapinfo_file_s *attr, int lineno)
+{
+	FAR struct heapinfo_stats_s *stats = &attr->stats;
+	FAR struct heapinfo_pidstat_s *pstat;
+	FAR struct heapinfo_callerstat_s *cstat;
+
+	if (lineno == HEAPINFO_LINE_TOTAL) {
+		return snprintf(attr->line, HEAPINFO_LINELEN, "Total: %u bytes, peak %u bytes\n",
+						stats->total_alloc_size, stats->peak_alloc_size);
+	}
+
+	if (lineno == HEAPINFO_LINE_PIDHDR) {
+		return snprintf(attr->line, HEAPINFO_LINELEN, "\n  PID  | CHUNKS |   CURR   |   PEAK\n");
+	}
+
+	if (lineno < HEAPINFO_LINE_CALLERHDR) {
+		if (lineno == HEAPINFO_LINE_PIDOTHER) {
+			pstat = &stats->pid_other;
+		} else {
+			pstat = &stats->pid[lineno - HEAPINFO_LINE_PID];
+		}
+
+		if (pstat->nallocs == 0 && pstat->peak_size == 0) {
+			return 0;
+		}
+
+		if (lineno == HEAPINFO_LINE_PIDOTHER) {
+			return snprintf(attr->line, HEAPINFO_LINELEN, " other | %6u | %8u | %8u\n",
+							pstat->nallocs, pstat->curr_size, pstat->peak_size);
+		}
+
+		/* Tasks that have exited but still own memory are marked with '*' */
+
+		return snprintf(attr->line, HEAPINFO_LINELEN, " %5d%c| %6u | %8u | %8u\n",
+						pstat->pid, sched_gettcb(pstat->pid) == NULL ? '*' : ' ',
+						pstat->nallocs, pstat->curr_size, pstat->peak_size);
+	}
+
+	if (lineno == HEAPINFO_LINE_CALLERHDR) {
+		return snprintf(attr->line, HEAPINFO_LINELEN, "\n  CALLER    |  PID  | CHUNKS |   CURR   |   PEAK\n");
+	}
+
+	if (lineno == HEAPINFO_LINE_CALLEROTHER) {
+		cstat = &stats->caller_other;
+		if (cstat->nallocs == 0 && cstat->peak_size == 0) {
+			return 0;
+		}
+
+		return snprintf(attr->line, HEAPINFO_LINELEN, " other      |       | %6u | %8u | %8u\n",
+						cstat->nallocs, cstat->curr_size, cstat->peak_size);
+	}
+
+	cstat = &stats->caller[lineno - HEAPINFO_LINE_CALLER];
+	if (cstat->caller == 0) {
+		return 0;
+	}
+
+	return snprintf(attr->line, HEAPINFO_LINELEN, " 0x%08x | %5d | %6u | %8u | %8u\n",
+					cstat->caller, cstat->pid, cstat->nallocs, cstat->curr_size, cstat->peak_size);
+}
+
+/****************************************************************************
+ * Name: heapinfo_read
+ ****************************************************************************/
+
+static ssize_t heapinfo_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct heapinfo_file_s *attr;
+	size_t remaining;
+	size_t linesize;
+	size_t copysize;
+	size_t totalsize;
+	off_t offset;
+	int lineno;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct heapinfo_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	offset = filep->f_pos;
+	remaining = buflen;
+	totalsize = 0;
+
+	for (lineno = 0; lineno < HEAPINFO_NLINES && totalsize < buflen; lineno++) {
+		linesize = heapinfo_line(attr, lineno);
+		if (linesize == 0) {
+			continue;
+		}
+
+		copysize = procfs_memcpy(attr->line, linesize, buffer, remaining, &offset);
+		totalsize += copysize;
+		buffer += copysize;
+		remaining -= copysize;
+	}
+
+	if (totalsize > 0) {
+		filep->f_pos += totalsize;
+	}
+
+	return totalsize;
+}
+
+/****************************************************************************
+ * Name: heapinfo_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int heapinfo_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct heapinfo_file_s *oldattr;
+	FAR struct heapinfo_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct heapinfo_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct heapinfo_file_s *)kmm_malloc(sizeof(struct heapinfo_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct heapinfo_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: heapinfo_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int heapinfo_stat(const char *relpath, struct stat *buf)
+{
+	/* "heapinfo" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "heapinfo") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "heapinfo" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif							/* CONFIG_DEBUG_MM_HEAPINFO_STATS && !CONFIG_FS_PROCFS_EXCLUDE_HEAPINFO */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
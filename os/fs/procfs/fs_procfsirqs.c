@@ -0,0 +1,356 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/procfs/fs_procfsirqs.c
+ *
+ * /proc/irqs shows the timing statistics of the interrupts, in cycles of
+ * the CPU.  Each IRQ that occurred has a line with its count, the longest
+ * entry latency, the longest and the average handler duration, followed by
+ * the histograms of the entry latency and of the handler duration.  The
+ * longest interrupts disabled section comes last.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/irq.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_IRQ_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IRQS)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic: a histogram, which is
+ * a 7 character name and 8 characters per bucket, plus the newline and the
+ * NUL terminator.
+ */
+
+#define IRQS_NBUCKETS IRQ_STATS_NBUCKETS
+#define IRQS_LINELEN  (7 + 8 * IRQS_NBUCKETS + 2)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct irqs_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	char line[IRQS_LINELEN];	/* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int irqs_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int irqs_close(FAR struct file *filep);
+static ssize_t irqs_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+static int irqs_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int irqs_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations irqs_operations = {
+	irqs_open,					/* open */
+	irqs_close,					/* close */
+	irqs_read,					/* read */
+	NULL,						/* write */
+
+	irqs_dup,					/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	irqs_stat					/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irqs_open
+ ****************************************************************************/
+
+static int irqs_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct irqs_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "irqs" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "irqs") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct irqs_file_s *)kmm_zalloc(sizeof(struct irqs_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: irqs_close
+ ****************************************************************************/
+
+static int irqs_close(FAR struct file *filep)
+{
+	FAR struct irqs_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct irqs_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: irqs_histogram
+ *
+ * Description:
+ *   Format a histogram line.  With 'counts' NULL, format the bucket bounds.
+ *
+ ****************************************************************************/
+
+static size_t irqs_histogram(FAR char *line, FAR const char *name, FAR const uint32_t *counts)
+{
+	uint32_t bound;
+	size_t linesize;
+	int i;
+
+	linesize = snprintf(line, IRQS_LINELEN, "%7s", name);
+	for (i = 0; i < IRQS_NBUCKETS && linesize < IRQS_LINELEN; i++) {
+		if (counts) {
+			linesize += snprintf(&line[linesize], IRQS_LINELEN - linesize, " %7u", (unsigned int)counts[i]);
+		} else {
+			/* Bucket i holds the times below 2^(IRQ_STATS_BUCKET0 + i) and
+			 * the last bucket the times from the bound of the one before.
+			 */
+
+			bound = (uint32_t)1 << (IRQ_STATS_BUCKET0 + (i < IRQS_NBUCKETS - 1 ? i : i - 1));
+			if (bound >= 1024) {
+				linesize += snprintf(&line[linesize], IRQS_LINELEN - linesize, " %s%4uK", i < IRQS_NBUCKETS - 1 ? " <" : ">=", (unsigned int)(bound >> 10));
+			} else {
+				linesize += snprintf(&line[linesize], IRQS_LINELEN - linesize, " %s%5u", i < IRQS_NBUCKETS - 1 ? " <" : ">=", (unsigned int)bound);
+			}
+		}
+	}
+
+	/* Always end the line, even if it was truncated */
+
+	if (linesize > IRQS_LINELEN - 2) {
+		linesize = IRQS_LINELEN - 2;
+	}
+
+	line[linesize++] = '\n';
+
+	return linesize;
+}
+
+/****************************************************************************
+ * Name: irqs_read
+ ****************************************************************************/
+
+static ssize_t irqs_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct irqs_file_s *attr;
+	struct irq_stats_s stats;
+#ifdef CONFIG_IRQ_STATS_CSECTION
+	struct irq_csection_s csection;
+#endif
+	size_t linesize;
+	size_t totalsize;
+	off_t offset;
+	int irq;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct irqs_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* The file is generated a line at a time.  The lines before the file
+	 * offset are skipped by procfs_memcpy().
+	 */
+
+	offset = filep->f_pos;
+	totalsize = 0;
+
+	linesize = snprintf(attr->line, IRQS_LINELEN, "%3s %10s %8s %8s %8s\n", "IRQ", "COUNT", "MAXLAT", "MAXDUR", "AVGDUR");
+	totalsize += procfs_memcpy(attr->line, linesize, &buffer[totalsize], buflen - totalsize, &offset);
+
+	linesize = irqs_histogram(attr->line, "", NULL);
+	totalsize += procfs_memcpy(attr->line, linesize, &buffer[totalsize], buflen - totalsize, &offset);
+
+	for (irq = 0; irq < NR_IRQS && totalsize < buflen; irq++) {
+		if (irq_getstats(irq, &stats) != OK || stats.count == 0) {
+			continue;
+		}
+
+		linesize = snprintf(attr->line, IRQS_LINELEN, "%3d %10u %8u %8u %8u\n", irq, (unsigned int)stats.count, (unsigned int)stats.maxlatency, (unsigned int)stats.maxduration, (unsigned int)(stats.totalduration / stats.count));
+		totalsize += procfs_memcpy(attr->line, linesize, &buffer[totalsize], buflen - totalsize, &offset);
+
+		linesize = irqs_histogram(attr->line, "lat", stats.latency);
+		totalsize += procfs_memcpy(attr->line, linesize, &buffer[totalsize], buflen - totalsize, &offset);
+
+		linesize = irqs_histogram(attr->line, "dur", stats.duration);
+		totalsize += procfs_memcpy(attr->line, linesize, &buffer[totalsize], buflen - totalsize, &offset);
+	}
+
+#ifdef CONFIG_IRQ_STATS_CSECTION
+	/* Show the longest interrupts disabled section */
+
+	if (totalsize < buflen) {
+		irq_getcsection(&csection);
+		linesize = snprintf(attr->line, IRQS_LINELEN, "csection %u at %p\n", (unsigned int)csection.maxcycles, csection.caller);
+		totalsize += procfs_memcpy(attr->line, linesize, &buffer[totalsize], buflen - totalsize, &offset);
+	}
+#endif
+
+	/* Update the file offset */
+
+	filep->f_pos += totalsize;
+	return totalsize;
+}
+
+/****************************************************************************
+ * Name: irqs_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int irqs_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct irqs_file_s *oldattr;
+	FAR struct irqs_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct irqs_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct irqs_file_s *)kmm_malloc(sizeof(struct irqs_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct irqs_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: irqs_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int irqs_stat(const char *relpath, struct stat *buf)
+{
+	/* "irqs" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "irqs") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "irqs" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+#endif							/* CONFIG_IRQ_STATS && !CONFIG_FS_PROCFS_EXCLUDE_IRQS */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
@@ -0,0 +1,449 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/procfs/fs_procfsmeminfo.c
+ *
+ * /proc/meminfo shows the usage of the heaps and, with CONFIG_MM_FRAGINFO,
+ * their fragmentation: the largest free chunk, the fragmentation index and
+ * the number of free chunks per power-of-two size class.  The information
+ * is collected when the file is opened.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/mm/mm.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define MEMINFO_LINELEN 96
+
+/* The heaps that can be shown from the kernel.  The user heap of the
+ * protected and kernel builds is not accessible here.
+ */
+
+#if !defined(CONFIG_BUILD_PROTECTED) && !defined(CONFIG_BUILD_KERNEL)
+#define MEMINFO_UMEM
+#endif
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+#define MEMINFO_KMEM
+#endif
+
+#define MEMINFO_HEAP_UMEM   0
+#define MEMINFO_HEAP_KMEM   1
+#define MEMINFO_NHEAPS      2
+
+/* The lines of the file: the usage table, the realloc() statistics of each
+ * heap and, per heap, the fragmentation summary and the free chunk
+ * histogram.
+ */
+
+#define MEMINFO_LINE_HDR    0
+#define MEMINFO_LINE_USAGE  1
+#define MEMINFO_LINE_REALLOC (MEMINFO_LINE_USAGE + MEMINFO_NHEAPS)
+#ifdef CONFIG_MM_REALLOC_STATS
+#define MEMINFO_LINE_FRAG   (MEMINFO_LINE_REALLOC + MEMINFO_NHEAPS)
+#else
+#define MEMINFO_LINE_FRAG   MEMINFO_LINE_REALLOC
+#endif
+#ifdef CONFIG_MM_FRAGINFO
+#define MEMINFO_FRAGLINES   (2 + MM_NNODES)
+#define MEMINFO_NLINES      (MEMINFO_LINE_FRAG + MEMINFO_NHEAPS * MEMINFO_FRAGLINES)
+#else
+#define MEMINFO_NLINES      MEMINFO_LINE_FRAG
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The information of one heap */
+
+struct meminfo_heap_s {
+	bool valid;					/* The heap is accessible */
+	struct mallinfo mem;		/* Heap usage */
+#ifdef CONFIG_MM_REALLOC_STATS
+	struct mm_reallocinfo_s realloc;	/* realloc() statistics */
+#endif
+#ifdef CONFIG_MM_FRAGINFO
+	struct mm_fraginfo_s frag;	/* Fragmentation report */
+#endif
+};
+
+/* This structure describes one open "file" */
+
+struct meminfo_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	struct meminfo_heap_s heap[MEMINFO_NHEAPS];	/* Collected at open time */
+	char line[MEMINFO_LINELEN];	/* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int meminfo_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int meminfo_close(FAR struct file *filep);
+static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+static int meminfo_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int meminfo_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char *g_meminfo_names[MEMINFO_NHEAPS] = { "Umem", "Kmem" };
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations meminfo_operations = {
+	meminfo_open,				/* open */
+	meminfo_close,				/* close */
+	meminfo_read,				/* read */
+	NULL,						/* write */
+
+	meminfo_dup,				/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	meminfo_stat				/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: meminfo_open
+ ****************************************************************************/
+
+static int meminfo_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct meminfo_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "meminfo" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "meminfo") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct meminfo_file_s *)kmm_zalloc(sizeof(struct meminfo_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Collect the information that all reads of this open file will show */
+
+#ifdef MEMINFO_UMEM
+	attr->heap[MEMINFO_HEAP_UMEM].valid = true;
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	attr->heap[MEMINFO_HEAP_UMEM].mem = mallinfo();
+#else
+	(void)mallinfo(&attr->heap[MEMINFO_HEAP_UMEM].mem);
+#endif
+#ifdef CONFIG_MM_REALLOC_STATS
+	(void)umm_reallocinfo(&attr->heap[MEMINFO_HEAP_UMEM].realloc);
+#endif
+#ifdef CONFIG_MM_FRAGINFO
+	(void)umm_fraginfo(&attr->heap[MEMINFO_HEAP_UMEM].frag);
+#endif
+#endif
+
+#ifdef MEMINFO_KMEM
+	attr->heap[MEMINFO_HEAP_KMEM].valid = true;
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	attr->heap[MEMINFO_HEAP_KMEM].mem = kmm_mallinfo();
+#else
+	(void)kmm_mallinfo(&attr->heap[MEMINFO_HEAP_KMEM].mem);
+#endif
+#ifdef CONFIG_MM_REALLOC_STATS
+	(void)kmm_reallocinfo(&attr->heap[MEMINFO_HEAP_KMEM].realloc);
+#endif
+#ifdef CONFIG_MM_FRAGINFO
+	(void)kmm_fraginfo(&attr->heap[MEMINFO_HEAP_KMEM].frag);
+#endif
+#endif
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: meminfo_close
+ ****************************************************************************/
+
+static int meminfo_close(FAR struct file *filep)
+{
+	FAR struct meminfo_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct meminfo_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: meminfo_line
+ *
+ * Description:
+ *   Format one line of the file into attr->line.  Returns the length of
+ *   the line or zero if there is nothing to show for this line.
+ *
+ ****************************************************************************/
+
+static size_t meminfo_line(FAR struct meminfo_file_s *attr, int lineno)
+{
+	FAR struct meminfo_heap_s *heap;
+#ifdef CONFIG_MM_FRAGINFO
+	int bin;
+#endif
+
+	if (lineno == MEMINFO_LINE_HDR) {
+		return snprintf(attr->line, MEMINFO_LINELEN, "             total       used       free    largest\n");
+	}
+
+	if (lineno < MEMINFO_LINE_USAGE + MEMINFO_NHEAPS) {
+		heap = &attr->heap[lineno - MEMINFO_LINE_USAGE];
+		if (!heap->valid) {
+			return 0;
+		}
+
+		return snprintf(attr->line, MEMINFO_LINELEN, "%s: %11d%11d%11d%11d\n", g_meminfo_names[lineno - MEMINFO_LINE_USAGE],
+						heap->mem.arena, heap->mem.uordblks, heap->mem.fordblks, heap->mem.mxordblk);
+	}
+
+#ifdef CONFIG_MM_REALLOC_STATS
+	if (lineno < MEMINFO_LINE_REALLOC + MEMINFO_NHEAPS) {
+		heap = &attr->heap[lineno - MEMINFO_LINE_REALLOC];
+		if (!heap->valid) {
+			return 0;
+		}
+
+		return snprintf(attr->line, MEMINFO_LINELEN, "%s realloc: %u kept, %u grown, %u moved, %u copied, %u bytes\n",
+						g_meminfo_names[lineno - MEMINFO_LINE_REALLOC], heap->realloc.nkeep, heap->realloc.ngrow,
+						heap->realloc.nmove, heap->realloc.ncopy, heap->realloc.copied);
+	}
+#endif
+
+#ifdef CONFIG_MM_FRAGINFO
+	heap = &attr->heap[(lineno - MEMINFO_LINE_FRAG) / MEMINFO_FRAGLINES];
+	if (!heap->valid) {
+		return 0;
+	}
+
+	lineno = (lineno - MEMINFO_LINE_FRAG) % MEMINFO_FRAGLINES;
+	if (lineno == 0) {
+		return snprintf(attr->line, MEMINFO_LINELEN, "\n%s: %u free chunks, largest %u, fragmentation %d%%\n",
+						g_meminfo_names[heap - attr->heap], heap->frag.nfree, heap->frag.largest, heap->frag.fragindex);
+	}
+
+	if (lineno == 1) {
+		return snprintf(attr->line, MEMINFO_LINELEN, "  %10s %8s\n", "CHUNK >=", "COUNT");
+	}
+
+	bin = lineno - 2;
+	if (heap->frag.nchunks[bin] == 0) {
+		return 0;
+	}
+
+	return snprintf(attr->line, MEMINFO_LINELEN, "  %10u %8u\n", MM_MIN_CHUNK << bin, heap->frag.nchunks[bin]);
+#else
+	return 0;
+#endif
+}
+
+/****************************************************************************
+ * Name: meminfo_read
+ ****************************************************************************/
+
+static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct meminfo_file_s *attr;
+	size_t remaining;
+	size_t linesize;
+	size_t copysize;
+	size_t totalsize;
+	off_t offset;
+	int lineno;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct meminfo_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	offset = filep->f_pos;
+	remaining = buflen;
+	totalsize = 0;
+
+	for (lineno = 0; lineno < MEMINFO_NLINES && totalsize < buflen; lineno++) {
+		linesize = meminfo_line(attr, lineno);
+		if (linesize == 0) {
+			continue;
+		}
+
+		copysize = procfs_memcpy(attr->line, linesize, buffer, remaining, &offset);
+		totalsize += copysize;
+		buffer += copysize;
+		remaining -= copysize;
+	}
+
+	if (totalsize > 0) {
+		filep->f_pos += totalsize;
+	}
+
+	return totalsize;
+}
+
+/****************************************************************************
+ * Name: meminfo_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int meminfo_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct meminfo_file_s *oldattr;
+	FAR struct meminfo_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct meminfo_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct meminfo_file_s *)kmm_malloc(sizeof(struct meminfo_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct meminfo_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: meminfo_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int meminfo_stat(const char *relpath, struct stat *buf)
+{
+	/* "meminfo" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "meminfo") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "meminfo" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif							/* !CONFIG_FS_PROCFS_EXCLUDE_MEMINFO */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
@@ -78,7 +78,7 @@
 #include <tinyara/fs/procfs.h>
 #include <tinyara/fs/dirent.h>
 
-#ifdef CONFIG_SCHED_CPULOAD
+#if defined(CONFIG_SCHED_CPULOAD) || defined(CONFIG_SCHED_CPUACCT)
 #include <tinyara/clock.h>
 #endif
 
@@ -109,6 +109,9 @@ enum proc_node_e {
 	PROC_CMDLINE,				/* Task command line */
 #ifdef CONFIG_SCHED_CPULOAD
 	PROC_LOADAVG,				/* Average CPU utilization */
+#endif
+#ifdef CONFIG_SCHED_CPUACCT
+	PROC_CPUACCT,				/* Task CPU accounting */
 #endif
 	PROC_STACK,					/* Task stack info */
 	PROC_GROUP,					/* Group directory */
@@ -155,6 +158,9 @@ static ssize_t proc_cmdline(FAR struct proc_file_s *procfile, FAR struct tcb_s *
 #ifdef CONFIG_SCHED_CPULOAD
 static ssize_t proc_loadavg(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset);
 #endif
+#ifdef CONFIG_SCHED_CPUACCT
+static ssize_t proc_cpuacct(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset);
+#endif
 static ssize_t proc_stack(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset);
 static ssize_t proc_groupstatus(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset);
 static ssize_t proc_groupfd(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset);
@@ -223,6 +229,12 @@ static const struct proc_node_s g_loadavg = {
 };
 #endif
 
+#ifdef CONFIG_SCHED_CPUACCT
+static const struct proc_node_s g_cpuacct = {
+	"stat", "stat", (uint8_t)PROC_CPUACCT, DTYPE_FILE	/* Task CPU accounting */
+};
+#endif
+
 static const struct proc_node_s g_stack = {
 	"stack", "stack", (uint8_t)PROC_STACK, DTYPE_FILE	/* Task stack info */
 };
@@ -246,6 +258,9 @@ static FAR const struct proc_node_s *const g_nodeinfo[] = {
 	&g_cmdline,					/* Task command line */
 #ifdef CONFIG_SCHED_CPULOAD
 	&g_loadavg,					/* Average CPU utilization */
+#endif
+#ifdef CONFIG_SCHED_CPUACCT
+	&g_cpuacct,					/* Task CPU accounting */
 #endif
 	&g_stack,					/* Task stack info */
 	&g_group,					/* Group directory */
@@ -262,6 +277,9 @@ static const struct proc_node_s *const g_level0info[] = {
 	&g_cmdline,					/* Task command line */
 #ifdef CONFIG_SCHED_CPULOAD
 	&g_loadavg,					/* Average CPU utilization */
+#endif
+#ifdef CONFIG_SCHED_CPUACCT
+	&g_cpuacct,					/* Task CPU accounting */
 #endif
 	&g_stack,					/* Task stack info */
 	&g_group,					/* Group directory */
@@ -545,6 +563,60 @@ static ssize_t proc_loadavg(FAR struct proc_file_s *procfile, FAR struct tcb_s *
 }
 #endif
 
+/****************************************************************************
+ * Name: proc_cpuacct
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPUACCT
+static ssize_t proc_cpuacct(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset)
+{
+	struct cpuacct_s cpuacct;
+	size_t remaining;
+	size_t linesize;
+	size_t copysize;
+	size_t totalsize;
+
+	/* The thread is valid, interrupts are disabled by the caller */
+
+	(void)sched_cpuacct(procfile->pid, &cpuacct);
+
+	remaining = buflen;
+	totalsize = 0;
+
+	/* Show the run time and the interrupt time in seconds */
+
+	linesize = snprintf(procfile->line, STATUS_LINELEN, "%-12s%u.%06u\n", "RunTime:", (unsigned int)(cpuacct.runtime / USEC_PER_SEC), (unsigned int)(cpuacct.runtime % USEC_PER_SEC));
+	copysize = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+	totalsize += copysize;
+	buffer += copysize;
+	remaining -= copysize;
+
+	if (totalsize >= buflen) {
+		return totalsize;
+	}
+
+	linesize = snprintf(procfile->line, STATUS_LINELEN, "%-12s%u.%06u\n", "IrqTime:", (unsigned int)(cpuacct.irqtime / USEC_PER_SEC), (unsigned int)(cpuacct.irqtime % USEC_PER_SEC));
+	copysize = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+	totalsize += copysize;
+	buffer += copysize;
+	remaining -= copysize;
+
+	if (totalsize >= buflen) {
+		return totalsize;
+	}
+
+	/* Show the number of times that the thread was switched in */
+
+	linesize = snprintf(procfile->line, STATUS_LINELEN, "%-12s%u\n", "Switches:", (unsigned int)cpuacct.nswitches);
+	copysize = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+	totalsize += copysize;
+	return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_stack
  ****************************************************************************/
@@ -555,6 +627,9 @@ static ssize_t proc_stack(FAR struct proc_file_s *procfile, FAR struct tcb_s *tc
 	size_t linesize;
 	size_t copysize;
 	size_t totalsize;
+#ifdef CONFIG_STACK_COLORATION
+	size_t used;
+#endif
 
 	remaining = buflen;
 	totalsize = 0;
@@ -587,9 +662,25 @@ static ssize_t proc_stack(FAR struct proc_file_s *procfile, FAR struct tcb_s *tc
 		return totalsize;
 	}
 
-	/* Show the stack size */
+	/* Show the stack high water mark.  Only the stack below the mark of the
+	 * last check is scanned, so this can be read periodically.
+	 */
 
-	linesize = snprintf(procfile->line, STATUS_LINELEN, "\n%-12s%ld", "StackUsed:", (long)up_check_tcbstack(tcb));
+	used = up_check_tcbstack_hwm(tcb);
+	linesize = snprintf(procfile->line, STATUS_LINELEN, "\n%-12s%ld", "StackUsed:", (long)used);
+	copysize = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+	totalsize += copysize;
+	buffer += copysize;
+	remaining -= copysize;
+
+	if (totalsize >= buflen) {
+		return totalsize;
+	}
+
+	/* Show the stack space that has never been used */
+
+	linesize = snprintf(procfile->line, STATUS_LINELEN, "\n%-12s%ld", "StackFree:", (long)tcb->adj_stack_size - (long)used);
 	copysize = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
 
 	totalsize += copysize;
@@ -964,6 +1055,11 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 	case PROC_LOADAVG:			/* Average CPU utilization */
 		ret = proc_loadavg(procfile, tcb, buffer, buflen, filep->f_pos);
 		break;
+#endif
+#ifdef CONFIG_SCHED_CPUACCT
+	case PROC_CPUACCT:			/* Task CPU accounting */
+		ret = proc_cpuacct(procfile, tcb, buffer, buflen, filep->f_pos);
+		break;
 #endif
 	case PROC_STACK:			/* Task stack info */
 		ret = proc_stack(procfile, tcb, buffer, buflen, filep->f_pos);
@@ -359,6 +359,23 @@ struct smartfs_ofile_s {
 								 * causes the sector to change. */
 };
 
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+/* This structure is one entry of the directory entry cache.  It remembers
+ * the result of smartfs_finddirentry() for one relative path, both when the
+ * entry was found and when it does not exist.  The cache is protected by
+ * the volume semaphore.
+ */
+
+struct smartfs_dcache_entry_s {
+	uint32_t hash;				/* Hash of the path, 0 if the entry is free */
+	int16_t result;				/* OK or -ENOENT */
+	int16_t fileoffset;			/* Offset of the filename in the path, or -1 */
+	uint16_t parentdirsector;	/* Parent directory sector reported */
+	struct smartfs_entry_s entry;	/* The entry when found, without the name */
+	char path[CONFIG_SMARTFS_DIRENT_CACHE_PATHLEN];
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of this
  * structure is retained as inode private data on each mountpoint that is
  * mounted with a smartfs filesystem.
@@ -381,6 +398,9 @@ struct smartfs_mountpt_s {
 #endif
 #ifdef CONFIG_SMARTFS_JOURNALING
 	struct journal_transaction_manager_s *journal;
+#endif
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+	struct smartfs_dcache_entry_s *fs_dcache;	/* Directory entry cache */
 #endif
 	uint8_t fs_rootsector;		/* Root directory sector num */
 };
@@ -527,6 +547,15 @@ void smartfs_wrle32(uint8_t *dest, uint32_t val);
 struct smartfs_mountpt_s *smartfs_get_first_mount(void);
 #endif
 
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+void smartfs_dcache_init(struct smartfs_mountpt_s *fs);
+void smartfs_dcache_release(struct smartfs_mountpt_s *fs);
+bool smartfs_dcache_lookup(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *direntry, const char *relpath, uint16_t *parentdirsector, const char **filename, int *result);
+void smartfs_dcache_add(struct smartfs_mountpt_s *fs, const struct smartfs_entry_s *direntry, const char *relpath, uint16_t parentdirsector, const char *filename, int result);
+void smartfs_dcache_flush(struct smartfs_mountpt_s *fs);
+void smartfs_dcache_invalidate(struct smartfs_mountpt_s *fs, uint16_t firstsector);
+#endif
+
 #ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
 uint16_t get_leftover_used_byte_count(uint8_t *buffer, uint16_t base_index);
 uint16_t get_used_byte_count_from_end(uint8_t *buffer);
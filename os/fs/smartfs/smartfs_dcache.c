@@ -0,0 +1,245 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/smartfs/smartfs_dcache.c
+ *
+ * Directory entry cache of SMARTFS.
+ *
+ * Every open(), stat() or unlink() looks up its path with
+ * smartfs_finddirentry(), which reads each directory of the path from the
+ * device and, for a file, every sector of the file to find its length.
+ * The cache remembers the result of the lookup of a path, including that
+ * the path does not exist, in a direct mapped table indexed by the hash of
+ * the path.
+ *
+ * A change of any directory flushes the whole cache, since it may move or
+ * remove the entries of any path below it.  A change of the data of a file
+ * only drops the entries of that file.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+
+#include "smartfs.h"
+
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SMARTFS_DCACHE_SIZE     CONFIG_SMARTFS_DIRENT_CACHE_SIZE
+#define SMARTFS_DCACHE_PATHLEN  CONFIG_SMARTFS_DIRENT_CACHE_PATHLEN
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartfs_dcache_hash
+ *
+ * Description: Return the FNV-1a hash of a path, which is never 0, and the
+ *              length of the path.
+ *
+ ****************************************************************************/
+
+static uint32_t smartfs_dcache_hash(const char *path, size_t *len)
+{
+	const char *ptr;
+	uint32_t hash = 2166136261u;
+
+	for (ptr = path; *ptr != '\0'; ptr++) {
+		hash ^= (uint8_t)*ptr;
+		hash *= 16777619u;
+	}
+
+	*len = ptr - path;
+	return hash != 0 ? hash : 1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartfs_dcache_init
+ *
+ * Description: Allocate the cache of a mount.  The mount works without a
+ *              cache if there is no memory for it.
+ *
+ ****************************************************************************/
+
+void smartfs_dcache_init(struct smartfs_mountpt_s *fs)
+{
+	fs->fs_dcache = (struct smartfs_dcache_entry_s *)kmm_zalloc(SMARTFS_DCACHE_SIZE * sizeof(struct smartfs_dcache_entry_s));
+	if (fs->fs_dcache == NULL) {
+		fdbg("No memory for the directory entry cache\n");
+	}
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_release
+ ****************************************************************************/
+
+void smartfs_dcache_release(struct smartfs_mountpt_s *fs)
+{
+	if (fs->fs_dcache != NULL) {
+		kmm_free(fs->fs_dcache);
+		fs->fs_dcache = NULL;
+	}
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_lookup
+ *
+ * Description: Look up a path in the cache.  On a hit, returns true with
+ *              the results of smartfs_finddirentry() filled in.  The name
+ *              of direntry is left as it is.
+ *
+ ****************************************************************************/
+
+bool smartfs_dcache_lookup(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *direntry, const char *relpath, uint16_t *parentdirsector, const char **filename, int *result)
+{
+	struct smartfs_dcache_entry_s *dentry;
+	FAR char *name;
+	uint32_t hash;
+	size_t len;
+
+	if (fs->fs_dcache == NULL) {
+		return false;
+	}
+
+	hash = smartfs_dcache_hash(relpath, &len);
+	if (len >= SMARTFS_DCACHE_PATHLEN) {
+		return false;
+	}
+
+	dentry = &fs->fs_dcache[hash % SMARTFS_DCACHE_SIZE];
+	if (dentry->hash != hash || strcmp(dentry->path, relpath) != 0) {
+		return false;
+	}
+
+	if (dentry->result == OK) {
+		name = direntry->name;
+		memcpy(direntry, &dentry->entry, sizeof(struct smartfs_entry_s));
+		direntry->name = name;
+	}
+
+	*parentdirsector = dentry->parentdirsector;
+	*filename = dentry->fileoffset >= 0 ? relpath + dentry->fileoffset : NULL;
+	*result = dentry->result;
+	return true;
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_add
+ *
+ * Description: Remember the result of smartfs_finddirentry() for a path.
+ *              Only found entries and entries that do not exist are
+ *              cached, and the entry replaces any entry of the same slot.
+ *
+ ****************************************************************************/
+
+void smartfs_dcache_add(struct smartfs_mountpt_s *fs, const struct smartfs_entry_s *direntry, const char *relpath, uint16_t parentdirsector, const char *filename, int result)
+{
+	struct smartfs_dcache_entry_s *dentry;
+	uint32_t hash;
+	size_t len;
+
+	if (fs->fs_dcache == NULL || (result != OK && result != -ENOENT)) {
+		return;
+	}
+
+	hash = smartfs_dcache_hash(relpath, &len);
+	if (len >= SMARTFS_DCACHE_PATHLEN) {
+		return;
+	}
+
+	dentry = &fs->fs_dcache[hash % SMARTFS_DCACHE_SIZE];
+	dentry->hash = hash;
+	dentry->result = result;
+	dentry->fileoffset = filename != NULL ? filename - relpath : -1;
+	dentry->parentdirsector = parentdirsector;
+	if (result == OK) {
+		memcpy(&dentry->entry, direntry, sizeof(struct smartfs_entry_s));
+		dentry->entry.name = NULL;
+	}
+
+	memcpy(dentry->path, relpath, len + 1);
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_flush
+ *
+ * Description: Drop every entry.  Called before a directory is changed.
+ *
+ ****************************************************************************/
+
+void smartfs_dcache_flush(struct smartfs_mountpt_s *fs)
+{
+	int i;
+
+	if (fs->fs_dcache == NULL) {
+		return;
+	}
+
+	for (i = 0; i < SMARTFS_DCACHE_SIZE; i++) {
+		fs->fs_dcache[i].hash = 0;
+	}
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_invalidate
+ *
+ * Description: Drop the entries of the file that starts at firstsector.
+ *              Called before the data of the file is changed, which
+ *              changes its length.
+ *
+ ****************************************************************************/
+
+void smartfs_dcache_invalidate(struct smartfs_mountpt_s *fs, uint16_t firstsector)
+{
+	struct smartfs_dcache_entry_s *dentry;
+	int i;
+
+	if (fs->fs_dcache == NULL) {
+		return;
+	}
+
+	for (i = 0; i < SMARTFS_DCACHE_SIZE; i++) {
+		dentry = &fs->fs_dcache[i];
+		if (dentry->hash != 0 && dentry->result == OK && dentry->entry.firstsector == firstsector) {
+			dentry->hash = 0;
+		}
+	}
+}
+
+#endif							/* CONFIG_SMARTFS_DIRENT_CACHE */
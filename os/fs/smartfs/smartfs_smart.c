@@ -82,6 +82,19 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* With the vectored sector ioctls of the SMART driver, the reads fetch the
+ * chain header and the data of a sector with one transfer, and the appends
+ * write whole sectors with their chain headers in one call.  The appends
+ * need a plain used byte count and no journal entry per write.
+ */
+
+#if defined(CONFIG_MTD_SMART_VECTORED_IO) && !defined(CONFIG_SMARTFS_DYNAMIC_HEADER)
+#define SMARTFS_VECTORED_READ
+#if !defined(CONFIG_SMARTFS_USE_SECTOR_BUFFER) && !defined(CONFIG_SMARTFS_JOURNALING)
+#define SMARTFS_VECTORED_APPEND
+#endif
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -117,6 +130,9 @@ static void smartfs_stat_common(FAR struct smartfs_mountpt_s *fs, FAR struct sma
 static int smartfs_stat(struct inode *mountpt, const char *relpath, struct stat *buf);
 
 static off_t smartfs_seek_internal(struct smartfs_mountpt_s *fs, struct smartfs_ofile_s *sf, off_t offset, int whence);
+#ifdef SMARTFS_VECTORED_APPEND
+static ssize_t smartfs_append_sectors(struct smartfs_mountpt_s *fs, struct smartfs_ofile_s *sf, const char *buffer, size_t buflen);
+#endif
 
 /****************************************************************************
  * Private Variables
@@ -471,6 +487,12 @@ static ssize_t smartfs_read(FAR struct file *filep, char *buffer, size_t buflen)
 	struct smartfs_ofile_s *sf;
 	struct smart_read_write_s readwrite;
 	struct smartfs_chain_header_s *header;
+#ifdef SMARTFS_VECTORED_READ
+	struct smart_read_write_s requests[2];
+	struct smart_multi_rw_s multi;
+	struct smartfs_chain_header_s chain;
+	bool direct;
+#endif
 	int ret = OK;
 	uint32_t bytesread;
 	uint16_t bytestoread;
@@ -504,22 +526,46 @@ static ssize_t smartfs_read(FAR struct file *filep, char *buffer, size_t buflen)
 			break;
 		}
 
-		/* Read the curent sector into our buffer */
+#ifdef SMARTFS_VECTORED_READ
+		direct = buflen - bytesread >= fs->fs_llformat.availbytes - sf->curroffset;
+		if (direct) {
+			/* The rest of the sector fits in the caller's buffer.  Read the
+			 * chain header and the data straight into it with one transfer.
+			 */
+
+			requests[0].logsector = sf->currsector;
+			requests[0].offset = 0;
+			requests[0].count = sizeof(struct smartfs_chain_header_s);
+			requests[0].buffer = (uint8_t *)&chain;
+			requests[1].logsector = sf->currsector;
+			requests[1].offset = sf->curroffset;
+			requests[1].count = fs->fs_llformat.availbytes - sf->curroffset;
+			requests[1].buffer = (uint8_t *)&buffer[bytesread];
+			multi.sectors = requests;
+			multi.nsectors = 2;
+			ret = FS_IOCTL(fs, BIOC_READSECTS, (unsigned long)&multi);
+			header = &chain;
+		} else
+#endif
+		{
+			/* Read the curent sector into our buffer */
+
+			readwrite.logsector = sf->currsector;
+			readwrite.offset = 0;
+			readwrite.buffer = (uint8_t *)fs->fs_rwbuffer;
+			readwrite.count = fs->fs_llformat.availbytes;
+			ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
+
+			/* Point header to the read data to get used byte count */
+
+			header = (struct smartfs_chain_header_s *)fs->fs_rwbuffer;
+		}
 
-		readwrite.logsector = sf->currsector;
-		readwrite.offset = 0;
-		readwrite.buffer = (uint8_t *)fs->fs_rwbuffer;
-		readwrite.count = fs->fs_llformat.availbytes;
-		ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
 		if (ret < 0) {
 			fdbg("Error %d reading sector %d data\n", ret, sf->currsector);
 			goto errout_with_semaphore;
 		}
 
-		/* Point header to the read data to get used byte count */
-
-		header = (struct smartfs_chain_header_s *)fs->fs_rwbuffer;
-
 		/* Get number of used bytes in this sector */
 #ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
 		bytesinsector = get_leftover_used_byte_count((uint8_t *)readwrite.buffer, get_used_byte_count((uint8_t *)header->used));
@@ -546,7 +592,13 @@ static ssize_t smartfs_read(FAR struct file *filep, char *buffer, size_t buflen)
 		if (bytestoread > 0) {
 			/* Do incremental copy from this sector */
 
-			memcpy(&buffer[bytesread], &fs->fs_rwbuffer[sf->curroffset], bytestoread);
+#ifdef SMARTFS_VECTORED_READ
+			if (!direct)
+#endif
+			{
+				memcpy(&buffer[bytesread], &fs->fs_rwbuffer[sf->curroffset], bytestoread);
+			}
+
 			bytesread += bytestoread;
 			sf->filepos += bytestoread;
 			sf->curroffset += bytestoread;
@@ -604,6 +656,10 @@ static int smartfs_sync_internal(struct smartfs_mountpt_s *fs, struct smartfs_of
 
 #ifdef CONFIG_SMARTFS_USE_SECTOR_BUFFER
 	if (sf->bflags & SMARTFS_BFLAG_DIRTY) {
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+		smartfs_dcache_invalidate(fs, sf->entry.firstsector);
+#endif
+
 		/* Update the header with the number of bytes written */
 
 		header = (struct smartfs_chain_header_s *)sf->buffer;
@@ -646,6 +702,9 @@ static int smartfs_sync_internal(struct smartfs_mountpt_s *fs, struct smartfs_of
 
 	if (sf->byteswritten > 0) {
 		fvdbg("Syncing sector %d\n", sf->currsector);
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+		smartfs_dcache_invalidate(fs, sf->entry.firstsector);
+#endif
 
 		/* Read the existing sector used bytes value */
 
@@ -764,6 +823,12 @@ static ssize_t smartfs_write(FAR struct file *filep, const char *buffer, size_t
 		ret = -EACCES;
 		goto errout_with_semaphore;
 	}
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+
+	/* The write changes the length of the file that lookups report */
+
+	smartfs_dcache_invalidate(fs, sf->entry.firstsector);
+#endif
 
 	/* First test if we are overwriting an existing location or writing to
 	 * a new one. */
@@ -871,6 +936,21 @@ static ssize_t smartfs_write(FAR struct file *filep, const char *buffer, size_t
 		sf->bflags |= SMARTFS_BFLAG_DIRTY;
 
 #else							/* CONFIG_SMARTFS_USE_SECTOR_BUFFER */
+#ifdef SMARTFS_VECTORED_APPEND
+		if (sf->curroffset == sizeof(struct smartfs_chain_header_s) && sf->byteswritten == 0 && buflen >= fs->fs_llformat.availbytes - sizeof(struct smartfs_chain_header_s)) {
+			/* Write the whole sectors at once */
+
+			ret = smartfs_append_sectors(fs, sf, &buffer[byteswritten], buflen);
+			if (ret < 0) {
+				goto errout_with_semaphore;
+			}
+
+			buflen -= ret;
+			byteswritten += ret;
+			continue;
+		}
+#endif
+
 		readwrite.offset = sf->curroffset;
 		readwrite.logsector = sf->currsector;
 		readwrite.buffer = (uint8_t *)&buffer[byteswritten];
@@ -1025,6 +1105,97 @@ errout_with_semaphore:
 	return ret;
 }
 
+/****************************************************************************
+ * Name: smartfs_append_sectors
+ *
+ * Description: Appends whole sectors of data to a file that ends at the
+ *              start of its current sector.  Up to
+ *              CONFIG_MTD_SMART_VECTORED_RUN sectors are chained, then their
+ *              data and chain headers are written with one BIOC_WRITESECTS
+ *              call.  Returns the number of bytes written.
+ *
+ ****************************************************************************/
+
+#ifdef SMARTFS_VECTORED_APPEND
+static ssize_t smartfs_append_sectors(struct smartfs_mountpt_s *fs, struct smartfs_ofile_s *sf, const char *buffer, size_t buflen)
+{
+	struct smart_read_write_s requests[2 * CONFIG_MTD_SMART_VECTORED_RUN];
+	struct smartfs_chain_header_s headers[CONFIG_MTD_SMART_VECTORED_RUN];
+	struct smart_multi_rw_s multi;
+	uint16_t datasize;
+	uint16_t sector;
+	uint16_t nextsector;
+	size_t written;
+	int nsectors;
+	int ret;
+
+	datasize = fs->fs_llformat.availbytes - sizeof(struct smartfs_chain_header_s);
+	sector = sf->currsector;
+	nextsector = sector;
+	written = 0;
+	nsectors = 0;
+	while (nsectors < CONFIG_MTD_SMART_VECTORED_RUN && buflen - written >= datasize && nextsector != SMARTFS_ERASEDSTATE_16BIT) {
+		sector = nextsector;
+
+		/* Chain a new sector if data remains after this one.  If the
+		 * allocation fails, the sector ends the chain and the caller
+		 * reports the error when it allocates again.
+		 */
+
+		nextsector = SMARTFS_ERASEDSTATE_16BIT;
+		if (buflen - written > datasize) {
+			ret = FS_IOCTL(fs, BIOC_ALLOCSECT, 0xFFFF);
+			if (ret >= 0) {
+				nextsector = (uint16_t)ret;
+			}
+		}
+
+		/* The data, then the next sector and used bytes of the header */
+
+		memset(&headers[nsectors], CONFIG_SMARTFS_ERASEDSTATE, sizeof(struct smartfs_chain_header_s));
+		headers[nsectors].nextsector[0] = (uint8_t)(nextsector & 0x00FF);
+		headers[nsectors].nextsector[1] = (uint8_t)(nextsector >> 8);
+		headers[nsectors].used[0] = (uint8_t)(datasize & 0x00FF);
+		headers[nsectors].used[1] = (uint8_t)(datasize >> 8);
+
+		requests[2 * nsectors].logsector = sector;
+		requests[2 * nsectors].offset = sizeof(struct smartfs_chain_header_s);
+		requests[2 * nsectors].count = datasize;
+		requests[2 * nsectors].buffer = (uint8_t *)&buffer[written];
+
+		requests[2 * nsectors + 1].logsector = sector;
+		requests[2 * nsectors + 1].offset = offsetof(struct smartfs_chain_header_s, nextsector);
+		requests[2 * nsectors + 1].count = offsetof(struct smartfs_chain_header_s, used) + sizeof(uint16_t) - offsetof(struct smartfs_chain_header_s, nextsector);
+		requests[2 * nsectors + 1].buffer = (uint8_t *)headers[nsectors].nextsector;
+
+		written += datasize;
+		nsectors++;
+	}
+
+	multi.sectors = requests;
+	multi.nsectors = 2 * nsectors;
+	ret = FS_IOCTL(fs, BIOC_WRITESECTS, (unsigned long)&multi);
+	if (ret < 0) {
+		fdbg("Error %d writing sectors %d to %d\n", ret, sf->currsector, sector);
+		return ret;
+	}
+
+	/* The last sector is full.  Move to the next one if it was chained */
+
+	sf->entry.datlen += written;
+	sf->filepos += written;
+	if (nextsector == SMARTFS_ERASEDSTATE_16BIT) {
+		sf->currsector = sector;
+		sf->curroffset = fs->fs_llformat.availbytes;
+	} else {
+		sf->currsector = nextsector;
+		sf->curroffset = sizeof(struct smartfs_chain_header_s);
+	}
+
+	return written;
+}
+#endif
+
 /****************************************************************************
  * Name: smartfs_seek_internal
  *
@@ -604,6 +604,10 @@ int smartfs_mount(struct smartfs_mountpt_s *fs, bool writeable)
 	fs->fs_workbuffer = (char *)kmm_malloc(256);
 	fs->fs_rootsector = SMARTFS_ROOT_DIR_SECTOR;
 
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+	smartfs_dcache_init(fs);
+#endif
+
 	/* We did it! */
 
 	fs->fs_mounted = TRUE;
@@ -747,6 +751,10 @@ int smartfs_unmount(struct smartfs_mountpt_s *fs)
 	kmm_free(fs->fs_workbuffer);
 #endif
 
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+	smartfs_dcache_release(fs);
+#endif
+
 	return ret;
 }
 
@@ -804,6 +812,14 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 		*parentdirsector = 0;	/* Our parent is the format sector I guess */
 		return OK;
 	}
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+
+	/* Test if the result for this path is cached */
+
+	if (smartfs_dcache_lookup(fs, direntry, relpath, parentdirsector, filename, &ret)) {
+		goto errout;
+	}
+#endif
 
 	/* Parse through each segment of relpath */
 
@@ -989,6 +1005,13 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 
 							*parentdirsector = dirstack[depth];
 							*filename = segment;
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+							/* Don't cache a length that a read error cut short */
+
+							if (ret >= 0) {
+								smartfs_dcache_add(fs, direntry, relpath, *parentdirsector, *filename, OK);
+							}
+#endif
 							ret = OK;
 							goto errout;
 						} else {
@@ -1064,6 +1087,9 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 			}
 
 			ret = -ENOENT;
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+			smartfs_dcache_add(fs, NULL, relpath, *parentdirsector, *filename, ret);
+#endif
 			goto errout;
 		}
 	}
@@ -1098,6 +1124,12 @@ int smartfs_createentry(struct smartfs_mountpt_s *fs, uint16_t parentdirsector,
 	struct smartfs_entry_header_s *entry;
 	struct smartfs_chain_header_s *chainheader;
 
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+	/* The new entry changes the result of cached lookups */
+
+	smartfs_dcache_flush(fs);
+#endif
+
 	/* Start at the 1st sector in the parent directory */
 
 	psector = parentdirsector;
@@ -1336,6 +1368,10 @@ int smartfs_deleteentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *en
 	struct smartfs_chain_header_s *header;
 	struct smart_read_write_s readwrite;
 
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+	smartfs_dcache_flush(fs);
+#endif
+
 	/* Okay, delete the file.  Loop through each sector and release them
 
 	 * TODO:  We really should walk the list backward to avoid lost
@@ -1594,6 +1630,10 @@ int smartfs_truncatefile(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *e
 	struct smartfs_chain_header_s *header;
 	struct smart_read_write_s readwrite;
 
+#ifdef CONFIG_SMARTFS_DIRENT_CACHE
+	smartfs_dcache_invalidate(fs, entry->firstsector);
+#endif
+
 	/* Walk through the directory's sectors and count entries */
 
 	nextsector = entry->firstsector;
@@ -64,6 +64,9 @@
 #include <time.h>
 
 #include <tinyara/wqueue.h>
+#ifdef CONFIG_SIG_EVTHREAD
+#include <tinyara/signal.h>
+#endif
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -155,6 +158,9 @@ struct aiocb {
 
 	volatile ssize_t aio_result;	/* Support for aio_error() and aio_return() */
 	FAR void *aio_priv;			/* Used by signal handlers */
+#ifdef CONFIG_SIG_EVTHREAD
+	struct sigwork_s aio_sigwork;	/* SIGEV_THREAD notification */
+#endif
 };
 
 /****************************************************************************
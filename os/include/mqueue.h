@@ -189,6 +189,28 @@ int mq_setattr(mqd_t mqdes, FAR const struct mq_attr *mq_stat, FAR struct mq_att
  */
 int mq_getattr(mqd_t mqdes, FAR struct mq_attr *mq_stat);
 
+#ifdef CONFIG_MQ_ZEROCOPY
+/**
+ * @brief pass the ownership of a buffer through a message queue
+ * @details @b #include <mqueue.h> \n
+ * SYSTEM CALL API \n
+ * The buffer must be allocated with malloc().  It is queued without a copy
+ * and its length is not limited by the maximum message size.  On success,
+ * the receiver owns the buffer and the caller must not use it any more.
+ * @since TizenRT v2.0 PRE
+ */
+int mq_sendbuf(mqd_t mqdes, FAR void *buffer, size_t buflen, int prio);
+/**
+ * @brief receive a message from a message queue as a buffer
+ * @details @b #include <mqueue.h> \n
+ * SYSTEM CALL API \n
+ * Returns the length of the message and its buffer in *buffer.  The caller
+ * owns the buffer and must free() it.
+ * @since TizenRT v2.0 PRE
+ */
+ssize_t mq_receivebuf(mqd_t mqdes, FAR void **buffer, FAR int *prio);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
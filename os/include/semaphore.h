@@ -94,6 +94,12 @@ struct tcb_s;					/* Forward reference */
 struct semholder_s {
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
 	struct semholder_s *flink;	/* Implements singly linked list */
+#endif
+#ifdef CONFIG_SEM_HOLDER_INDEX
+	struct semholder_s *blink;	/* Makes the semaphore's list doubly linked */
+	struct semholder_s *tflink;	/* Doubly linked list of the holder TCB */
+	struct semholder_s *tblink;
+	FAR struct sem_s *sem;		/* The semaphore held */
 #endif
 	FAR struct tcb_s *htcb;		/* Holder TCB */
 	int16_t counts;				/* Number of counts owned by this holder */
@@ -218,6 +218,9 @@
 
 #define SIGEV_NONE      0		/* No notification desired */
 #define SIGEV_SIGNAL    1		/* Notify via signal */
+#ifdef CONFIG_SIG_EVTHREAD
+#define SIGEV_THREAD    2		/* Notify via a function called in a thread */
+#endif
 
 /* Special values of sigaction (all treated like NULL) */
 
@@ -250,6 +253,21 @@ union sigval {
 	FAR void *sival_ptr;		/* Pointer value */
 };
 
+#ifdef CONFIG_SIG_EVTHREAD
+/**
+ * @ingroup SIGNAL_KERNEL
+ * @brief The notification function of SIGEV_THREAD
+ * @since TizenRT v1.1
+ */
+#ifdef CONFIG_CAN_PASS_STRUCTS
+typedef CODE void (*sigev_notify_function_t)(union sigval value);
+#else
+typedef CODE void (*sigev_notify_function_t)(FAR void *sival_ptr);
+#endif
+
+struct pthread_attr_s;
+#endif
+
 /**
  * @ingroup SIGNAL_KERNEL
  * @brief Structure for elements that define a queue signal. The following is
@@ -257,9 +275,13 @@ union sigval {
  * available on a queue
  */
 struct sigevent {
-	uint8_t sigev_notify;		/* Notification method: SIGEV_SIGNAL or SIGEV_NONE */
+	uint8_t sigev_notify;		/* Notification method: SIGEV_SIGNAL, SIGEV_NONE or SIGEV_THREAD */
 	uint8_t sigev_signo;		/* Notification signal */
 	union sigval sigev_value;	/* Data passed with notification */
+#ifdef CONFIG_SIG_EVTHREAD
+	sigev_notify_function_t sigev_notify_function;	/* Notification function */
+	FAR struct pthread_attr_s *sigev_notify_attributes;	/* Not used */
+#endif
 };
 
 /**
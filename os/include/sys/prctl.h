@@ -80,6 +80,24 @@
  *
  *      char myname[CONFIG_TASK_NAME_SIZE];
  *      prctl(PR_GET_NAME, myname, 0);
+ *
+ *  PR_SET_TIMERSLACK
+ *    Set the timer slack, in microseconds, of the thread whose ID is in
+ *    required arg2 (int) to the value of required arg1 (unsigned long).  The
+ *    sleeps of the thread may then end up to that much later, so that the
+ *    wakeup is shared with other timers.  Requires
+ *    CONFIG_SCHED_TICKLESS_SLACK.  The slack is rounded up to clock ticks.
+ *    As an example:
+ *
+ *      prctl(PR_SET_TIMERSLACK, 20000UL, 0);
+ *
+ *  PR_GET_TIMERSLACK
+ *    Return the timer slack, in microseconds, of the thread whose ID is in
+ *    required arg2 (int) in the location pointed to by required arg1
+ *    (unsigned long *).  As an example:
+ *
+ *      unsigned long slack;
+ *      prctl(PR_GET_TIMERSLACK, &slack, 0);
  */
 
 /**
@@ -90,6 +108,14 @@
  * @ingroup SCHED_KERNEL
  */
 #define PR_GET_NAME 2
+/**
+ * @ingroup SCHED_KERNEL
+ */
+#define PR_SET_TIMERSLACK 3
+/**
+ * @ingroup SCHED_KERNEL
+ */
+#define PR_GET_TIMERSLACK 4
 
 /****************************************************************************
  * Public Type Definitions
@@ -375,7 +375,14 @@
 #define SYS_mq_timedreceive            (__SYS_mqueue+7)
 #define SYS_mq_timedsend               (__SYS_mqueue+8)
 #define SYS_mq_unlink                  (__SYS_mqueue+9)
+
+#ifdef CONFIG_MQ_ZEROCOPY
+#define SYS_mq_receivebuf              (__SYS_mqueue+10)
+#define SYS_mq_sendbuf                 (__SYS_mqueue+11)
+#define __SYS_environ                  (__SYS_mqueue+12)
+#else
 #define __SYS_environ                  (__SYS_mqueue+10)
+#endif
 #else
 #define __SYS_environ                  __SYS_mqueue
 #endif
@@ -1363,6 +1363,20 @@ void up_disable_irq(int irq);
 int up_prioritize_irq(int irq, int priority);
 #endif
 
+/****************************************************************************
+ * Name: up_cyclecount
+ *
+ * Description:
+ *   Return the free running cycle counter of the CPU.  The count wraps
+ *   around at 32 bits, so only differences of counts that are less than
+ *   that apart are meaningful.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_CYCLECOUNTER
+uint32_t up_cyclecount(void);
+#endif
+
 /****************************************************************************
  * Tickless OS Support.
  *
@@ -1788,6 +1802,10 @@ void irq_dispatch(int irq, FAR void *context);
  * Input Parameters:
  *   None
  *
+ *   up_check_tcbstack_hwm() is the cheap variant for periodic sampling:
+ *   it only scans the stack below the high water mark found by the previous
+ *   check of the task (see CONFIG_STACK_COLORATION_GAP).
+ *
  * Returned value:
  *   The estimated amount of stack space used.
  *
@@ -1796,6 +1814,7 @@ void irq_dispatch(int irq, FAR void *context);
 #ifdef CONFIG_STACK_COLORATION
 struct tcb_s;
 size_t up_check_tcbstack(FAR struct tcb_s *tcb);
+size_t up_check_tcbstack_hwm(FAR struct tcb_s *tcb);
 ssize_t up_check_tcbstack_remain(FAR struct tcb_s *tcb);
 size_t up_check_stack(void);
 ssize_t up_check_stack_remain(void);
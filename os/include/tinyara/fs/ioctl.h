@@ -231,6 +231,16 @@
 										 *      the block with specific debug
 										 *      command and data.
 										 * OUT: None.  */
+#define BIOC_READSECTS  _BIOC(0x000C)	/* Read a list of logical sectors from the
+										 * block device.
+										 * IN:  Pointer to the list of sector
+										 *      read data (struct smart_multi_rw_s)
+										 * OUT: Number of bytes read or error */
+#define BIOC_WRITESECTS _BIOC(0x000D)	/* Write data to a list of logical sectors
+										 * IN:  Pointer to the list of sector
+										 *      write data (struct smart_multi_rw_s)
+										 * OUT: None (ioctl return value provides
+										 *      success/failure indication). */
 
 /* TinyAra MTD driver ioctl definitions ***************************************/
 
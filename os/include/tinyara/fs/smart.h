@@ -102,6 +102,15 @@ struct smart_read_write_s {
 	const uint8_t *buffer;		/* Pointer to the data to write */
 };
 
+/* The following defines a list of logical sector reads or writes for the
+ * BIOC_READSECTS and BIOC_WRITESECTS ioctls.
+ */
+
+struct smart_multi_rw_s {
+	FAR struct smart_read_write_s *sectors;	/* The sector requests */
+	uint16_t nsectors;			/* Number of sector requests */
+};
+
 /* The following defines the procfs data exchange interface between the
  * SMART MTD and FS layers.
  */
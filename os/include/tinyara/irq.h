@@ -57,6 +57,7 @@
  ****************************************************************************/
 
 #ifndef __ASSEMBLY__
+#include <stdint.h>
 #include <assert.h>
 #endif
 
@@ -85,6 +86,32 @@
 typedef int (*xcpt_t)(int irq, FAR void *context, FAR void *arg);
 #endif
 
+/* Timing statistics of one IRQ, in cycles of the CPU.  Histogram bucket 0
+ * counts the times below 2^IRQ_STATS_BUCKET0 cycles, bucket n the times
+ * below 2^(IRQ_STATS_BUCKET0 + n) and the last bucket all longer times.
+ */
+
+#if defined(CONFIG_IRQ_STATS) && !defined(__ASSEMBLY__)
+#define IRQ_STATS_NBUCKETS 12
+#define IRQ_STATS_BUCKET0  7
+
+struct irq_stats_s {
+	uint32_t count;				/* Number of interrupts */
+	uint32_t maxlatency;		/* Longest entry latency */
+	uint32_t maxduration;		/* Longest handler duration */
+	uint64_t totalduration;		/* Sum of the handler durations */
+	uint32_t latency[IRQ_STATS_NBUCKETS];	/* Entry latency histogram */
+	uint32_t duration[IRQ_STATS_NBUCKETS];	/* Handler duration histogram */
+};
+
+/* The longest interrupts disabled section */
+
+struct irq_csection_s {
+	uint32_t maxcycles;			/* Its length in cycles of the CPU */
+	FAR void *caller;			/* The code address of its irqsave() */
+};
+#endif
+
 /* Now include architecture-specific types */
 
 #include <arch/irq.h>
@@ -134,6 +161,45 @@ void irq_info(void);
 
 #endif
 
+#ifdef CONFIG_IRQ_STATS
+
+/****************************************************************************
+ * Name: irq_stats_entry
+ *
+ * Description:
+ *   Called by the architecture as early as possible on the entry of an
+ *   interrupt.  The entry latency of the interrupt is measured from here.
+ *
+ ****************************************************************************/
+
+void irq_stats_entry(void);
+
+/****************************************************************************
+ * Name: irq_getstats
+ *
+ * Description:
+ *   Return the timing statistics of an IRQ.  -EINVAL if 'irq' is not a
+ *   valid IRQ number.
+ *
+ ****************************************************************************/
+
+int irq_getstats(int irq, FAR struct irq_stats_s *stats);
+
+#ifdef CONFIG_IRQ_STATS_CSECTION
+
+/****************************************************************************
+ * Name: irq_getcsection
+ *
+ * Description:
+ *   Return the longest interrupts disabled section timed so far.
+ *
+ ****************************************************************************/
+
+void irq_getcsection(FAR struct irq_csection_s *csection);
+
+#endif
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -216,6 +216,9 @@ void gran_reserve(GRAN_HANDLE handle, uintptr_t start, size_t size);
  * Description:
  *   Allocate memory from the granule heap.
  *
+ *   An allocation of a single granule does not wait for the GAT semaphore
+ *   and may be done from interrupt handlers.
+ *
  *   NOTE: The current implementation also restricts the maximum allocation
  *   size to 32 granules.  That restriction could be eliminated with some
  *   additional coding effort.
@@ -240,7 +243,8 @@ FAR void *gran_alloc(GRAN_HANDLE handle, size_t size);
  * Name: gran_free
  *
  * Description:
- *   Return memory to the granule heap.
+ *   Return memory to the granule heap.  This does not wait for the GAT
+ *   semaphore and may be done from interrupt handlers.
  *
  * Input Parameters:
  *   handle - The handle previously returned by gran_initialize
@@ -179,6 +179,51 @@
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
 
+#ifdef CONFIG_MM_TLCACHE
+/* Per-thread allocation cache definitions.  Chunks up to
+ * MM_TLCACHE_MAXCHUNK (including the allocnode) are cached in one class per
+ * MM_MIN_CHUNK granule.
+ */
+
+#define MM_TLCACHE_MAXCHUNK  MM_ALIGN_UP(CONFIG_MM_TLCACHE_MAXSIZE + SIZEOF_MM_ALLOCNODE)
+#define MM_TLCACHE_NCLASSES  (MM_TLCACHE_MAXCHUNK >> MM_MIN_SHIFT)
+#define MM_TLCACHE_NDX(s)    (((s) >> MM_MIN_SHIFT) - 1)
+#endif
+
+#ifdef CONFIG_MM_ARENA
+/* Arena definitions.  Memory handed out by an arena is aligned to
+ * MM_ARENA_ALIGN bytes.
+ */
+
+#define MM_ARENA_ALIGN       8
+#define MM_ARENA_ALIGN_UP(a) (((a) + MM_ARENA_ALIGN - 1) & ~(MM_ARENA_ALIGN - 1))
+#define MM_ARENA_MINBLOCK    256
+#endif
+
+/* Free list index definitions.
+ *
+ * By default there is one free list per power-of-two size class and the
+ * lists are chained into one sorted list that mm_malloc() walks.
+ *
+ * With CONFIG_MM_TLSF, each power-of-two (first level) class is divided
+ * into MM_SLCOUNT linearly spaced second level classes, each with its own
+ * unsorted free list.  Two levels of bitmaps record which lists are not
+ * empty, so that a fitting free chunk is found in constant time.
+ */
+
+#ifdef CONFIG_MM_TLSF
+#if CONFIG_MM_TLSF_SLSHIFT > MM_MIN_SHIFT
+#error CONFIG_MM_TLSF_SLSHIFT must not be larger than MM_MIN_SHIFT
+#endif
+#define MM_SL_SHIFT      CONFIG_MM_TLSF_SLSHIFT
+#define MM_SLCOUNT       (1 << MM_SL_SHIFT)
+#define MM_NLISTS        (MM_NNODES << MM_SL_SHIFT)
+#define MM_NDX2BIN(n)    ((n) >> MM_SL_SHIFT)
+#else
+#define MM_NLISTS        MM_NNODES
+#define MM_NDX2BIN(n)    (n)
+#endif
+
 #define MM_GRAN_MASK     (MM_MIN_CHUNK-1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
 #define MM_ALIGN_DOWN(a) ((a) & ~MM_GRAN_MASK)
@@ -307,6 +352,68 @@ struct mm_freenode_s {
 #define CHECK_FREENODE_SIZE \
 	DEBUGASSERT(sizeof(struct mm_freenode_s) == SIZEOF_MM_FREENODE)
 
+#ifdef CONFIG_MM_SLAB
+/* Slab front-end definitions.
+ *
+ * Small allocations are served from fixed-size objects carved out of
+ * "slab pages", which are ordinary allocated chunks of the heap.  Every
+ * slab object carries a normal allocnode header so that mm_free() and the
+ * heapinfo logic can handle it like any other allocation.  A slab object is
+ * distinguished from a real heap chunk by bit 0 of its 'preceding' field,
+ * which is always zero for real chunks since all chunk sizes are even.
+ *
+ * MM_SLAB_MAXCHUNK - the largest chunk (including the allocnode) served
+ *   by the slab layer.
+ * MM_SLAB_NCLASSES - one size class per MM_MIN_CHUNK granule up to
+ *   MM_SLAB_MAXCHUNK.
+ */
+
+#define MM_SLAB_BIT        0x1
+#define MM_SLAB_MAXCHUNK   MM_ALIGN_UP(CONFIG_MM_SLAB_MAXSIZE + SIZEOF_MM_ALLOCNODE)
+#define MM_SLAB_NCLASSES   (MM_SLAB_MAXCHUNK >> MM_MIN_SHIFT)
+#define MM_SLAB_NDX(s)     (((s) >> MM_MIN_SHIFT) - 1)
+#define MM_SLAB_CHUNK(n)   (((n) + 1) << MM_MIN_SHIFT)
+#define MM_IS_SLAB(n)      (((n)->preceding & MM_SLAB_BIT) != 0)
+#endif
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO_STATS
+/* Heap usage of one task, maintained at allocation and free time.  Stacks
+ * are not included.
+ */
+
+struct heapinfo_pidstat_s {
+	pid_t pid;				/* Task ID */
+	uint32_t nallocs;			/* Number of allocated chunks */
+	size_t curr_size;			/* Allocated bytes */
+	size_t peak_size;			/* Largest curr_size */
+};
+
+/* Heap usage of one caller (return address of the allocation API) */
+
+struct heapinfo_callerstat_s {
+	mmaddress_t caller;			/* Return address of the allocation */
+	pid_t pid;				/* Task ID of the last allocation */
+	uint32_t nallocs;			/* Number of allocated chunks */
+	size_t curr_size;			/* Allocated bytes */
+	size_t peak_size;			/* Largest curr_size */
+};
+
+/* Incremental heap statistics.  'pid' is indexed by the PID hash.  The
+ * usage that does not fit in the tables (exited tasks replaced by a new
+ * task with the same hash, allocations from interrupt context and callers
+ * that do not fit in the caller hash) is accounted in the 'other' entries.
+ */
+
+struct heapinfo_stats_s {
+	size_t total_alloc_size;		/* Copy of the heap total, snapshot only */
+	size_t peak_alloc_size;			/* Copy of the heap peak, snapshot only */
+	struct heapinfo_pidstat_s pid[CONFIG_MAX_TASKS];
+	struct heapinfo_pidstat_s pid_other;
+	struct heapinfo_callerstat_s caller[CONFIG_DEBUG_MM_HEAPINFO_NCALLERS];
+	struct heapinfo_callerstat_s caller_other;
+};
+#endif
+
 #ifdef CONFIG_HEAPINFO_USER_GROUP
 struct heapinfo_group_info_s {
 	int pid;
@@ -321,6 +428,103 @@ struct heapinfo_group_s {
 	int heap_size;
 };
 #endif
+#ifdef CONFIG_MM_SLAB
+/* This describes one size class of the slab front-end */
+
+struct mm_slabclass_s {
+	FAR struct mm_allocnode_s *freelist;	/* Singly linked list of free objects */
+	uint16_t npages;			/* Number of slab pages of this class */
+	uint16_t nfree;				/* Number of free objects */
+	uint16_t nused;				/* Number of allocated objects */
+	uint32_t nallocs;			/* Allocations served by this class */
+	uint32_t nmisses;			/* Allocations that fell back to the heap */
+#ifdef CONFIG_MM_COMPACT
+	FAR struct mm_allocnode_s *pages[CONFIG_MM_SLAB_MAXPAGES];	/* The slab pages */
+#endif
+};
+
+/* Statistics of one slab size class as returned by mm_slab_info() */
+
+struct mm_slabinfo_s {
+	size_t chunksize;			/* Chunk size including the allocnode */
+	int npages;				/* Number of slab pages */
+	int nused;				/* Number of allocated objects */
+	int nfree;				/* Number of free objects */
+	uint32_t nallocs;			/* Allocations served by this class */
+	uint32_t nmisses;			/* Allocations that fell back to the heap */
+};
+#endif
+
+#ifdef CONFIG_MM_TLCACHE
+/* This describes the allocation cache of one thread.  It is referenced by
+ * the TCB and only accessed by the owning thread.
+ */
+
+struct mm_tlcache_s {
+	uint8_t ncached[MM_TLCACHE_NCLASSES];	/* Number of cached chunks per class */
+	FAR void *cached[MM_TLCACHE_NCLASSES][CONFIG_MM_TLCACHE_DEPTH];
+	uint32_t nhits;				/* Allocations served by the cache */
+	uint32_t nmisses;			/* Allocations that went to the heap */
+	FAR struct mm_tlcache_s *flink;	/* Next cache waiting to be drained */
+};
+#endif
+
+#ifdef CONFIG_MM_ARENA
+/* This describes one block of an arena.  The memory handed out from the
+ * block follows this header.
+ */
+
+struct mm_arenablock_s {
+	FAR struct mm_arenablock_s *next;	/* Next block of the arena */
+	size_t size;				/* Usable size of this block */
+};
+
+/* This describes one arena (see mm_arena.c) */
+
+struct mm_arena_s {
+	FAR struct mm_heap_s *heap;		/* The heap the blocks come from */
+	FAR struct mm_arenablock_s *blocks;	/* All blocks, the current one first */
+	FAR char *next;				/* Next free byte of the current block */
+	FAR char *end;				/* End of the current block */
+	size_t blksize;				/* Usable size of a regular block */
+	size_t largesize;			/* Larger requests get a block of their own */
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	mmaddress_t caller_retaddr;		/* Owner of the blocks */
+#endif
+	size_t used;				/* Bytes allocated since the last reset */
+	size_t peak;				/* Largest 'used' at a reset */
+	uint32_t nallocs;			/* Allocations since the last reset */
+	uint32_t nheapallocs;			/* Blocks taken from the heap in total */
+};
+#endif
+
+#ifdef CONFIG_MM_FRAGINFO
+/* Fragmentation report of one heap as returned by mm_fraginfo().  Only the
+ * free chunks of the heap are included; free objects cached by the slab
+ * front-end and the per-thread caches are not.
+ */
+
+struct mm_fraginfo_s {
+	size_t freebytes;			/* Total size of the free chunks */
+	size_t largest;				/* Size of the largest free chunk */
+	uint32_t nfree;				/* Number of free chunks */
+	int fragindex;				/* 100 - largest * 100 / freebytes */
+	uint32_t nchunks[MM_NNODES];		/* Free chunks per power-of-two bin */
+};
+#endif
+
+#ifdef CONFIG_MM_REALLOC_STATS
+/* realloc() statistics of one heap as returned by mm_reallocinfo() */
+
+struct mm_reallocinfo_s {
+	uint32_t nkeep;				/* Served by the current chunk, shrunk or not */
+	uint32_t ngrow;				/* Extended in place into the next chunk */
+	uint32_t nmove;				/* Extended into the previous chunk with memmove() */
+	uint32_t ncopy;				/* Copied to a new chunk */
+	size_t copied;				/* Bytes moved by memmove() or copied */
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s {
@@ -342,6 +546,9 @@ struct mm_heap_s {
 	int max_group;
 	struct heapinfo_group_s group[HEAPINFO_USER_GROUP_NUM];
 #endif
+#ifdef CONFIG_DEBUG_MM_HEAPINFO_STATS
+	struct heapinfo_stats_s stats;
+#endif
 #endif
 
 	/* This is the first and last nodes of the heap */
@@ -358,7 +565,38 @@ struct mm_heap_s {
 	 * speed searches for free nodes.
 	 */
 
-	struct mm_freenode_s mm_nodelist[MM_NNODES];
+	struct mm_freenode_s mm_nodelist[MM_NLISTS];
+
+#ifdef CONFIG_MM_TLSF
+	/* Bitmaps of the non-empty free lists.  Bit n of mm_flbitmap is set if
+	 * any bit of mm_slbitmap[n] is set.  Bit m of mm_slbitmap[n] is set if
+	 * mm_nodelist[(n << MM_SL_SHIFT) + m] is not empty.
+	 */
+
+	uint32_t mm_flbitmap;
+	uint32_t mm_slbitmap[MM_NNODES];
+#endif
+
+#ifdef CONFIG_MM_FRAGINFO
+	/* Free chunk statistics, maintained by mm_addfreechunk() and
+	 * mm_delfreechunk().  Bin n counts the free chunks of the nodelist
+	 * power-of-two class n.
+	 */
+
+	size_t mm_freebytes;
+	uint32_t mm_nfreechunks[MM_NNODES];
+#endif
+
+#ifdef CONFIG_MM_REALLOC_STATS
+	struct mm_reallocinfo_s mm_reallocstats;
+#endif
+
+#ifdef CONFIG_MM_SLAB
+	/* Free lists and statistics of the slab front-end, one per size class */
+
+	bool mm_slab_enabled;
+	struct mm_slabclass_s mm_slab[MM_SLAB_NCLASSES];
+#endif
 };
 
 /****************************************************************************
@@ -439,6 +677,16 @@ int umm_trysemaphore(void);
 void umm_givesemaphore(void);
 #endif
 
+/* Functions contained in umm_tlcache.c ************************************/
+
+#ifdef CONFIG_MM_TLCACHE
+struct tcb_s;					/* Forward reference */
+int umm_tlcache_enable(bool enable);
+FAR void *umm_tlcache_alloc(size_t size);
+bool umm_tlcache_free(FAR void *mem);
+void umm_tlcache_release(FAR struct tcb_s *tcb);
+#endif
+
 /* Functions contained in kmm_sem.c ****************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
@@ -487,10 +735,23 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size,
 FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size);
 #endif
 
+#ifdef CONFIG_MM_REALLOC_STATS
+int mm_reallocinfo(FAR struct mm_heap_s *heap, FAR struct mm_reallocinfo_s *info);
+
+/* Functions contained in umm_realloc.c *************************************/
+
+#if !defined(CONFIG_BUILD_PROTECTED) || !defined(__KERNEL__)
+int umm_reallocinfo(FAR struct mm_reallocinfo_s *info);
+#endif
+#endif
+
 /* Functions contained in kmm_realloc.c *************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 FAR void *kmm_realloc(FAR void *oldmem, size_t newsize);
+#ifdef CONFIG_MM_REALLOC_STATS
+int kmm_reallocinfo(FAR struct mm_reallocinfo_s *info);
+#endif
 #endif
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 
@@ -618,11 +879,90 @@ void mm_shrinkchunk(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node,
 /* Functions contained in mm_addfreechunk.c *********************************/
 
 void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node);
+void mm_delfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node);
+#ifdef CONFIG_MM_TLSF
+int mm_findfreelist(FAR struct mm_heap_s *heap, int ndx);
+#endif
 
 /* Functions contained in mm_size2ndx.c.c ***********************************/
 
 int mm_size2ndx(size_t size);
 
+/* Functions contained in mm_slab.c *****************************************/
+
+#ifdef CONFIG_MM_SLAB
+void mm_slab_initialize(FAR struct mm_heap_s *heap);
+void mm_slab_enable(FAR struct mm_heap_s *heap, bool enable);
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR void *mm_slab_alloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr);
+#else
+FAR void *mm_slab_alloc(FAR struct mm_heap_s *heap, size_t size);
+#endif
+void mm_slab_free(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node);
+int mm_slab_info(FAR struct mm_heap_s *heap, int ndx, FAR struct mm_slabinfo_s *info);
+size_t mm_slab_freebytes(FAR struct mm_heap_s *heap);
+#ifdef CONFIG_MM_COMPACT
+size_t mm_slab_compact(FAR struct mm_heap_s *heap);
+#endif
+#endif
+
+/* Functions contained in mm_fraginfo.c *************************************/
+
+#ifdef CONFIG_MM_FRAGINFO
+int mm_fraginfo(FAR struct mm_heap_s *heap, FAR struct mm_fraginfo_s *info);
+
+/* Functions contained in umm_fraginfo.c ************************************/
+
+#if !defined(CONFIG_BUILD_PROTECTED) || !defined(__KERNEL__)
+int umm_fraginfo(FAR struct mm_fraginfo_s *info);
+#endif
+
+/* Functions contained in kmm_fraginfo.c ************************************/
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+int kmm_fraginfo(FAR struct mm_fraginfo_s *info);
+#endif
+#endif
+
+/* Functions contained in mm_compact.c **************************************/
+
+#ifdef CONFIG_MM_COMPACT
+size_t mm_compact(FAR struct mm_heap_s *heap);
+
+/* Functions contained in umm_compact.c *************************************/
+
+#if !defined(CONFIG_BUILD_PROTECTED) || !defined(__KERNEL__)
+size_t umm_compact(void);
+#endif
+
+/* Functions contained in kmm_compact.c *************************************/
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+size_t kmm_compact(void);
+#endif
+#endif
+
+/* Functions contained in mm_arena.c ****************************************/
+
+#ifdef CONFIG_MM_ARENA
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR struct mm_arena_s *mm_arena_create(FAR struct mm_heap_s *heap, size_t blksize, mmaddress_t caller_retaddr);
+#else
+FAR struct mm_arena_s *mm_arena_create(FAR struct mm_heap_s *heap, size_t blksize);
+#endif
+FAR void *mm_arena_alloc(FAR struct mm_arena_s *arena, size_t size);
+FAR void *mm_arena_zalloc(FAR struct mm_arena_s *arena, size_t size);
+void mm_arena_setlargesize(FAR struct mm_arena_s *arena, size_t size);
+void mm_arena_reset(FAR struct mm_arena_s *arena);
+void mm_arena_destroy(FAR struct mm_arena_s *arena);
+
+/* Functions contained in umm_arena.c ***************************************/
+
+#if !defined(CONFIG_BUILD_PROTECTED) || !defined(__KERNEL__)
+FAR struct mm_arena_s *umm_arena_create(size_t blksize);
+#endif
+#endif
+
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 /* Functions contained in kmm_mallinfo.c . Used to display memory allocation details */
 void heapinfo_parse(FAR struct mm_heap_s *heap, int mode, pid_t pid);
@@ -631,8 +971,12 @@ void heapinfo_update_node(FAR struct mm_allocnode_s *node, mmaddress_t caller_re
 
 void heapinfo_add_size(pid_t pid, mmsize_t size);
 void heapinfo_subtract_size(pid_t pid, mmsize_t size);
-void heapinfo_update_total_size(struct mm_heap_s *heap, mmsize_t size, pid_t pid);
+void heapinfo_update_total_size(struct mm_heap_s *heap, mmsize_t size, FAR struct mm_allocnode_s *node);
 void heapinfo_exclude_stacksize(void *stack_ptr);
+#ifdef CONFIG_DEBUG_MM_HEAPINFO_STATS
+void heapinfo_stats_initialize(FAR struct mm_heap_s *heap);
+void heapinfo_stats_snapshot(FAR struct mm_heap_s *heap, FAR struct heapinfo_stats_s *stats);
+#endif
 #ifdef CONFIG_HEAPINFO_USER_GROUP
 void heapinfo_update_group_info(pid_t pid, int group, int type);
 void heapinfo_check_group_list(pid_t pid, char *name);
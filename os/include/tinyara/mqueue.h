@@ -62,6 +62,7 @@
 #include <sys/types.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <mqueue.h>
 #include <queue.h>
 #include <signal.h>
@@ -72,6 +73,10 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Number of words of the bitmap of the queued message priorities */
+
+#define MQ_PRIOMAP_NWORDS ((MQ_PRIO_MAX >> 5) + 1)
+
 /****************************************************************************
  * Global Type Declarations
  ****************************************************************************/
@@ -79,6 +84,7 @@
 /* This structure defines a message queue */
 
 struct mq_des;					/* forward reference */
+struct mqueue_msg_s;			/* forward reference */
 
 struct mqueue_inode_s {
 	FAR struct inode *inode;	/* Containing inode */
@@ -98,6 +104,10 @@ struct mqueue_inode_s {
 	int ntsigno;				/* Notification: Signal number */
 	union sigval ntvalue;		/* Notification: Signal value */
 #endif
+#ifdef CONFIG_MQ_PRIORITY_INDEX
+	uint32_t priomap[MQ_PRIOMAP_NWORDS];	/* Priorities of the queued messages */
+	FAR struct mqueue_msg_s *priolast[MQ_PRIO_MAX + 1];	/* Last message of each priority */
+#endif
 };
 
 /* This describes the message queue descriptor that is held in the
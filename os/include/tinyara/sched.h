@@ -416,6 +416,12 @@ struct task_group_s {
 	/* POSIX Signal Control Fields *********************************************** */
 
 	sq_queue_t sigpendingq;		/* List of pending signals                  */
+#ifdef CONFIG_SIG_PENDING_BITMAP
+	sigset_t sigpendingset;		/* Pending signals sent by kill()           */
+#ifdef CONFIG_SCHED_HAVE_PARENT
+	pid_t sigpendingpid[MAX_SIGNO + 1];	/* Their senders                   */
+#endif
+#endif
 #endif
 
 #ifndef CONFIG_DISABLE_ENVIRON
@@ -520,6 +526,9 @@ struct tcb_s {
 	uint8_t pend_reprios[CONFIG_SEM_NNESTPRIO];
 #endif
 	uint8_t base_priority;		/* "Normal" priority of the thread     */
+#ifdef CONFIG_SEM_HOLDER_INDEX
+	FAR struct semholder_s *holdhead;	/* Semaphores held by the thread */
+#endif
 #endif
 
 	uint8_t task_state;			/* Current state of the thread         */
@@ -533,6 +542,15 @@ struct tcb_s {
 	int timeslice;				/* RR timeslice interval remaining     */
 #endif
 	FAR struct wdog_s *waitdog;	/* All timed waits used this wdog      */
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+	int timerslack;				/* Slack of the sleeps, in ticks       */
+#endif
+
+#ifdef CONFIG_SCHED_CPUACCT
+	uint64_t runcycles;			/* CPU cycles run, interrupts included */
+	uint64_t irqcycles;			/* CPU cycles spent in interrupts      */
+	uint32_t nswitches;			/* Number of times switched in         */
+#endif
 
 	/* Stack-Related Fields ****************************************************** */
 
@@ -543,6 +561,9 @@ struct tcb_s {
 	/* Need to deallocate stack            */
 	FAR void *adj_stack_ptr;	/* Adjusted stack_alloc_ptr for HW     */
 	/* The initial stack pointer value     */
+#ifdef CONFIG_STACK_COLORATION
+	size_t stack_hwm;			/* Stack used at the last check        */
+#endif
 
 #ifdef CONFIG_MPU_STACKGUARD
 	FAR void *stack_guard;          /* address of the stack guard */
@@ -593,6 +614,10 @@ struct tcb_s {
 	int peak_alloc_size;
 	int num_alloc_free;
 #endif
+
+#ifdef CONFIG_MM_TLCACHE
+	FAR struct mm_tlcache_s *tlcache;	/* Per-thread allocation cache         */
+#endif
 };
 
 /* struct task_tcb_s *************************************************************/
@@ -675,6 +700,16 @@ struct pthread_tcb_s {
 
 typedef void (*sched_foreach_t)(FAR struct tcb_s *tcb, FAR void *arg);
 
+/* This structure is used to report the CPU accounting of a thread */
+
+#ifdef CONFIG_SCHED_CPUACCT
+struct cpuacct_s {
+	uint64_t runtime;			/* Run time in microseconds, interrupts included */
+	uint64_t irqtime;			/* Time spent in interrupts in microseconds */
+	uint32_t nswitches;			/* Number of times switched in */
+};
+#endif
+
 #endif							/* __ASSEMBLY__ */
 
 /********************************************************************************
@@ -738,6 +773,33 @@ void sched_foreach(sched_foreach_t handler, FAR void *arg);
  */
 FAR struct tcb_s *sched_gettcb(pid_t pid);
 
+#ifdef CONFIG_SCHED_CPUACCT
+/**
+ * @ingroup SCHED_KERNEL
+ * @brief Return the CPU accounting of a thread
+ * @details @b #include <tinyara/sched.h> \n
+ *   The run time of the calling thread includes the time up to this call.
+ * @param[in] pid The task ID of the thread, 0 for the IDLE thread
+ * @param[out] cpuacct The location to return the CPU accounting
+ * @return OK (0) on success; -ESRCH if 'pid' does not refer to a thread
+ * @since TizenRT v1.1
+ */
+int sched_cpuacct(pid_t pid, FAR struct cpuacct_s *cpuacct);
+#endif
+
+#ifdef CONFIG_SCHED_TICKLESS
+/**
+ * @ingroup SCHED_KERNEL
+ * @brief Return the number of times that the interval timer of the
+ *   tick-less OS expired
+ * @details @b #include <tinyara/sched.h> \n
+ *   Each expiration wakes up the CPU.  The count wraps around.
+ * @return The number of expirations since boot
+ * @since TizenRT v1.1
+ */
+uint32_t sched_timer_wakeups(void);
+#endif
+
 /* File system helpers **********************************************************/
 /* These functions all extract lists from the group structure assocated with the
  * currently executing task.
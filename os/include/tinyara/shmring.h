@@ -0,0 +1,221 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * include/tinyara/shmring.h
+ *
+ * Single-producer/single-consumer ring of variable sized frames in memory
+ * shared by two tasks.  The producer reserves space for a frame, fills it
+ * in place and commits it; the consumer gets a pointer to the oldest frame
+ * and releases it when it is done.  The frame data is never copied by the
+ * ring.
+ *
+ * The indexes are only written by one side each, so no lock is taken.  A
+ * side that has to wait sleeps on a semaphore of the ring that the other
+ * side posts only when it sees the waiting flag set.
+ *
+ * The ring contains no pointers, so it can be mapped at different
+ * addresses by the two tasks.  Any memory that both tasks can access can
+ * be used: a heap or static buffer in the flat build, or a shared memory
+ * segment (CONFIG_MM_SHM) with shmring_create()/shmring_attach().
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_TINYARA_SHMRING_H
+#define __INCLUDE_TINYARA_SHMRING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <semaphore.h>
+
+#ifdef CONFIG_MM_SHM
+#include <sys/ipc.h>
+#endif
+
+#ifdef CONFIG_LIBC_SHMRING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Frames are stored after a header of SHMRING_ALIGN bytes holding their
+ * length, so that the frame data is aligned to SHMRING_ALIGN.
+ */
+
+#define SHMRING_ALIGN         8
+#define SHMRING_ALIGN_UP(n)   (((n) + SHMRING_ALIGN - 1) & ~(SHMRING_ALIGN - 1))
+#define SHMRING_FRAMEHDR      SHMRING_ALIGN
+
+/* The size of the ring header that precedes the frame data */
+
+#define SHMRING_HDRSIZE       SHMRING_ALIGN_UP(sizeof(struct shmring_s))
+
+/* The memory needed for a ring with 'datasize' bytes of frame data.
+ * 'datasize' should be a power of two.
+ */
+
+#define SHMRING_MEMSIZE(datasize) (SHMRING_HDRSIZE + (datasize))
+
+/* The largest frame of a ring.  One frame may take at most half of the
+ * frame data so that it always fits once the ring is empty.
+ */
+
+#define SHMRING_MAXFRAME(ring) ((ring)->sr_size / 2 - SHMRING_FRAMEHDR)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The ring header.  The frame data follows at SHMRING_HDRSIZE. */
+
+struct shmring_s {
+	uint32_t sr_size;			/* Size of the frame data, a power of two */
+	volatile uint32_t sr_head;	/* Free running write offset (producer) */
+	volatile uint32_t sr_tail;	/* Free running read offset (consumer) */
+	volatile uint8_t sr_rwait;	/* The consumer waits for a frame */
+	volatile uint8_t sr_wwait;	/* The producer waits for space */
+	sem_t sr_datasem;			/* Posted when a frame is committed */
+	sem_t sr_spacesem;			/* Posted when a frame is released */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C" {
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: shmring_initialize
+ *
+ * Description:
+ *   Create an empty ring in 'mem'.  The frame data takes the largest power
+ *   of two that fits in 'memsize' after the ring header.
+ *
+ * Return Value:
+ *   The ring on success; NULL if 'memsize' is too small.
+ *
+ ****************************************************************************/
+
+FAR struct shmring_s *shmring_initialize(FAR void *mem, size_t memsize);
+
+/****************************************************************************
+ * Name: shmring_uninitialize
+ *
+ * Description:
+ *   Release the semaphores of a ring.  Neither side may use it afterwards.
+ *
+ ****************************************************************************/
+
+void shmring_uninitialize(FAR struct shmring_s *ring);
+
+/****************************************************************************
+ * Name: shmring_reserve
+ *
+ * Description:
+ *   Producer: return the address where the next frame of up to 'len' bytes
+ *   is to be written.  The frame is not visible to the consumer until it
+ *   is committed with shmring_commit().  Only one frame can be reserved at
+ *   a time.
+ *
+ * Return Value:
+ *   The frame address on success.  NULL with errno set to EMSGSIZE if
+ *   'len' exceeds SHMRING_MAXFRAME(), or to EAGAIN if the ring is full and
+ *   'wait' is false.
+ *
+ ****************************************************************************/
+
+FAR void *shmring_reserve(FAR struct shmring_s *ring, size_t len, bool wait);
+
+/****************************************************************************
+ * Name: shmring_commit
+ *
+ * Description:
+ *   Producer: publish the reserved frame with its final length 'len',
+ *   which may be less than the reserved length, and wake up the consumer
+ *   if it is waiting.
+ *
+ ****************************************************************************/
+
+void shmring_commit(FAR struct shmring_s *ring, size_t len);
+
+/****************************************************************************
+ * Name: shmring_peek
+ *
+ * Description:
+ *   Consumer: return the oldest frame and its length in 'len'.  The frame
+ *   stays valid until it is released with shmring_release().
+ *
+ * Return Value:
+ *   The frame address on success.  NULL with errno set to EAGAIN if the
+ *   ring is empty and 'wait' is false.
+ *
+ ****************************************************************************/
+
+FAR void *shmring_peek(FAR struct shmring_s *ring, FAR size_t *len, bool wait);
+
+/****************************************************************************
+ * Name: shmring_release
+ *
+ * Description:
+ *   Consumer: give the space of the frame returned by shmring_peek() back
+ *   to the producer and wake it up if it is waiting.
+ *
+ ****************************************************************************/
+
+void shmring_release(FAR struct shmring_s *ring);
+
+#ifdef CONFIG_MM_SHM
+/****************************************************************************
+ * Name: shmring_create / shmring_attach / shmring_detach
+ *
+ * Description:
+ *   shmring_create() creates a shared memory segment for a ring with
+ *   'datasize' bytes of frame data under 'key', attaches it and
+ *   initializes the ring.  The other task gets the ring with
+ *   shmring_attach().  Both sides detach with shmring_detach().  The
+ *   segment is removed with shmctl(IPC_RMID).
+ *
+ * Return Value:
+ *   The ring on success; NULL with errno set on failure.
+ *
+ ****************************************************************************/
+
+FAR struct shmring_s *shmring_create(key_t key, size_t datasize);
+FAR struct shmring_s *shmring_attach(key_t key);
+int shmring_detach(FAR struct shmring_s *ring);
+#endif
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif							/* CONFIG_LIBC_SHMRING */
+#endif							/* __INCLUDE_TINYARA_SHMRING_H */
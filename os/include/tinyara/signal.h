@@ -26,14 +26,38 @@
 #include <sched.h>
 #include <signal.h>
 
+#ifdef CONFIG_SIG_EVTHREAD
+#include <tinyara/wqueue.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* The work queue that calls the SIGEV_THREAD notification functions */
+
+#ifdef CONFIG_SIG_EVTHREAD
+#define SIG_EVTHREAD_WORK LPWORK
+#endif
+
 /****************************************************************************
  * Global Type Declarations
  ****************************************************************************/
 
+#ifdef CONFIG_SIG_EVTHREAD
+/* The SIGEV_THREAD notification of a POSIX timer or of an aiocb.  It is
+ * part of the object that notifies.  The owner sets the function and the
+ * value from the sigevent.  sig_evthread() copies both into a preallocated
+ * work structure, so that the object may be released while the function is
+ * about to be called.
+ */
+
+struct sigwork_s {
+	union sigval value;			/* Value passed to the function */
+	sigev_notify_function_t func;	/* Notification function */
+};
+#endif
+
 /****************************************************************************
  * Global Variables
  ****************************************************************************/
@@ -55,6 +79,43 @@ extern "C" {
  */
 int sig_sethandler(struct tcb_s *tcb, int signo, struct sigaction *act);
 bool sig_is_handler_registered(struct tcb_s *tcb, int signo);
+
+#ifdef CONFIG_SIG_EVTHREAD
+/****************************************************************************
+ * Name: sig_evthread
+ *
+ * Description:
+ *   Queue a SIGEV_THREAD notification.  The notification function is
+ *   called with the value on the SIG_EVTHREAD_WORK work queue.  If the
+ *   previous notification with the same work structure was not called
+ *   yet, the function is called only once for both.
+ *
+ * Parameters:
+ *   work - The notification work structure of the notifying object
+ *
+ * Return Value:
+ *   0 (OK) on success; a negated errno value on failure.  -ENOMEM means
+ *   that CONFIG_SIG_EVTHREAD_NWORK notifications are already queued.
+ *
+ * Assumptions:
+ *   May be called from the interrupt context.
+ *
+ ****************************************************************************/
+
+int sig_evthread(FAR struct sigwork_s *work);
+
+/****************************************************************************
+ * Name: sig_cancel_evthread
+ *
+ * Description:
+ *   Cancel the notification that is queued with a work structure, before
+ *   the notifying object is released.  A notification that was already
+ *   taken from the work queue is still called.
+ *
+ ****************************************************************************/
+
+void sig_cancel_evthread(FAR struct sigwork_s *work);
+#endif
 /**
  * @endcond
  */
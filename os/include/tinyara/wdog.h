@@ -103,10 +103,22 @@
 #define WDOG_ISALLOCED(w)  (((w)->flags & WDOGF_ALLOCED) != 0)
 #define WDOG_ISSTATIC(w)   (((w)->flags & WDOGF_STATIC) != 0)
 
+/* Set the slack of a watchdog: the number of ticks (zero or more) that it
+ * may expire after its delay, so that it can be handled together with other
+ * watchdogs.  The slack is zero when the watchdog is created and applies to
+ * every following wd_start().
+ */
+
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+#define wd_setslack(w, s)  do { (w)->slack = (s); } while (0)
+#else
+#define wd_setslack(w, s)
+#endif
+
 /* Initialization of statically allocated timers ****************************/
 
 #define wd_static(w) \
-	do { (w)->next = NULL; (w)->flags = WDOGF_STATIC; } while (0)
+	do { (w)->next = NULL; (w)->flags = WDOGF_STATIC; wd_setslack(w, 0); } while (0)
 
 #ifdef CONFIG_PIC
 #define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
@@ -152,7 +164,16 @@ struct wdog_s {
 	int lag;					/* Timer associated with the delay */
 	uint8_t flags;				/* See WDOGF_* definitions above */
 	uint8_t argc;				/* The number of parameters to pass */
+#ifdef CONFIG_WDOG_TIMERWHEEL
+	uint8_t slot;				/* Slot of the timer wheel */
+#endif
 	uint32_t parm[CONFIG_MAX_WDOGPARMS];
+#ifdef CONFIG_WDOG_TIMERWHEEL
+	FAR struct wdog_s *prev;	/* Support for the timer wheel slot lists */
+#endif
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+	int slack;					/* Ticks that the expiration may be late */
+#endif
 };
 
 /* Watchdog 'handle' */
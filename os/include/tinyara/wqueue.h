@@ -107,6 +107,21 @@
  * CONFIG_SCHED_LPWORKSTACKSIZE - The stack size allocated for the lower
  *   priority worker thread.  Default: 2048.
  *
+ * CONFIG_SCHED_FSWORK. If CONFIG_SCHED_FSWORK is selected then a work
+ *   queue of its own is created for file system and flash work, so that
+ *   long flash operations do not delay the work on the other queues.
+ * CONFIG_SCHED_FSWORKPRIORITY - The execution priority of the file system
+ *   worker thread.  Default: 40
+ * CONFIG_SCHED_FSWORKPERIOD - How often the file system worker thread
+ *  checks for work in units of microseconds.  Default: 100*1000 (100 MS).
+ * CONFIG_SCHED_FSWORKSTACKSIZE - The stack size allocated for the file
+ *   system worker thread.  Default: 2048.
+ *
+ * CONFIG_SCHED_WORKQUEUE_HEAP - Keep the pending work of each kernel work
+ *   queue in a heap ordered by expiration time.
+ * CONFIG_SCHED_WORKQUEUE_STATS - Keep latency and backlog statistics of
+ *   each kernel work queue, see work_getstats().
+ *
  * The user-mode work queue is only available in the protected or kernel
  * builds.  This those configurations, the user-mode work queue provides the
  * same (non-standard) facility for use by applications.
@@ -133,6 +148,7 @@
 
 #undef CONFIG_SCHED_HPWORK
 #undef CONFIG_SCHED_LPWORK
+#undef CONFIG_SCHED_FSWORK
 #undef CONFIG_SCHED_WORKQUEUE
 
 /* User-space worker threads are not built in a kernel build when we are
@@ -232,6 +248,24 @@
 
 #endif							/* CONFIG_SCHED_LPWORK */
 
+/* File system, kernel work queue configuration *****************************/
+
+#ifdef CONFIG_SCHED_FSWORK
+
+#ifndef CONFIG_SCHED_FSWORKPRIORITY
+#define CONFIG_SCHED_FSWORKPRIORITY 40
+#endif
+
+#ifndef CONFIG_SCHED_FSWORKPERIOD
+#define CONFIG_SCHED_FSWORKPERIOD (100*1000)	/* 100 milliseconds */
+#endif
+
+#ifndef CONFIG_SCHED_FSWORKSTACKSIZE
+#define CONFIG_SCHED_FSWORKSTACKSIZE CONFIG_IDLETHREAD_STACKSIZE
+#endif
+
+#endif							/* CONFIG_SCHED_FSWORK */
+
 /* User space work queue configuration **************************************/
 
 #ifdef CONFIG_LIB_USRWORK
@@ -260,6 +294,10 @@
  *     used for any purpose.  if CONFIG_SCHED_LPWORK is not defined, then
  *     there is only one kernel work queue and LPWORK == HPWORK.
  *
+ *   FSWORK: This is the ID of the work queue for file system and flash
+ *     work, such as write buffer flushes, that may block for a long time.
+ *     If CONFIG_SCHED_FSWORK is not defined, then FSWORK == LPWORK.
+ *
  * User Work Queue:
  *   USRWORK:  In the kernel phase a a kernel build, there should be no
  *     references to user-space work queues.  That would be an error.
@@ -273,6 +311,7 @@
 #define USRWORK  2				/* User mode work queue */
 #define HPWORK   USRWORK		/* Redirect kernel-mode references */
 #define LPWORK   USRWORK
+#define FSWORK   USRWORK
 
 #else
 /* Kernel mode */
@@ -283,6 +322,11 @@
 #else
 #define LPWORK HPWORK			/* Redirect low-priority references */
 #endif
+#ifdef CONFIG_SCHED_FSWORK
+#define FSWORK   3				/* File system, kernel-mode work queue */
+#else
+#define FSWORK LPWORK			/* Redirect file system references */
+#endif
 #define USRWORK  LPWORK			/* Redirect user-mode references */
 
 #endif							/* CONFIG_LIB_USRWORK && !__KERNEL__ */
@@ -308,7 +352,28 @@ struct work_s {
 	FAR void *arg;				/* Callback argument */
 	systime_t qtime;			/* Time work queued */
 	systime_t delay;			/* Delay until work performed */
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+	systime_t slack;			/* Ticks that the work may be late */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_HEAP
+	FAR struct work_s *child;	/* First child in the heap of pending work */
+	uint32_t seq;				/* Orders work that expires at the same time */
+#endif
+};
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+/* Statistics of one kernel work queue.  Times are in clock ticks. */
+
+struct work_stats_s {
+	uint32_t queued;			/* Work queued */
+	uint32_t done;				/* Work performed */
+	uint16_t backlog;			/* Work pending now */
+	uint16_t maxbacklog;		/* Most work pending at one time */
+	uint32_t totallatency;		/* Sum of the latencies of the work performed */
+	uint32_t maxlatency;		/* Longest time from expiration to start */
+	uint32_t maxruntime;		/* Longest time that one work took */
 };
+#endif
 
 /****************************************************************************
  * Public Data
@@ -375,6 +440,33 @@ int work_usrstart(void);
 
 int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, uint32_t delay);
 
+/****************************************************************************
+ * Name: work_queue_slack
+ *
+ * Description:
+ *   Queue work to a kernel work queue like work_queue(), with a slack: the
+ *   work may be performed up to 'slack' clock ticks after its delay, so
+ *   that the worker thread wakes up once for it and other timer events.
+ *   work_queue() queues work with no slack.
+ *
+ * Input parameters:
+ *   qid    - The work queue ID
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked
+ *   arg    - The argument that will be passed to the worker callback
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            may be invoked
+ *   slack  - Clock ticks that the worker may be invoked after the delay
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(CONFIG_SCHED_TICKLESS_SLACK)
+int work_queue_slack(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, uint32_t delay, uint32_t slack);
+#endif
+
 /****************************************************************************
  * Name: work_cancel
  *
@@ -432,6 +524,26 @@ int work_signal(int qid);
 
 #define work_available(work) ((work)->worker == NULL)
 
+/****************************************************************************
+ * Name: work_getstats
+ *
+ * Description:
+ *   Get the statistics of a kernel work queue.  The latency of a work is
+ *   the time from its expiration until the worker thread starts it.
+ *
+ * Input parameters:
+ *   qid   - The work queue ID
+ *   stats - Receives the statistics
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(CONFIG_SCHED_WORKQUEUE_STATS)
+int work_getstats(int qid, FAR struct work_stats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: lpwork_boostpriority
  *
@@ -201,6 +201,15 @@ static inline void os_workqueues(void)
 	(void)work_lpstart();
 
 #endif							/* CONFIG_SCHED_LPWORK */
+
+#ifdef CONFIG_SCHED_FSWORK
+	/* Start the file system worker thread for flash and write buffer work
+	 * that may block for a long time
+	 */
+
+	(void)work_fsstart();
+
+#endif							/* CONFIG_SCHED_FSWORK */
 }
 
 #else							/* CONFIG_SCHED_WORKQUEUE */
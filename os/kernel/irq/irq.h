@@ -81,6 +81,9 @@ struct irq {
 	char irq_name[MAX_IRQNAME_SIZE + 1]; /* Includes the terminating Null */
 	size_t count;
 #endif
+#ifdef CONFIG_IRQ_STATS
+	struct irq_stats_s stats;
+#endif
 };
 
 extern struct irq g_irqvector[NR_IRQS];
@@ -103,6 +106,11 @@ extern "C" {
 void weak_function irq_initialize(void);
 int irq_unexpected_isr(int irq, FAR void *context, FAR void *arg);
 
+#ifdef CONFIG_IRQ_STATS
+bool irq_stats_latency(uint32_t start, FAR uint32_t *latency);
+void irq_stats_update(int irq, uint32_t latency, uint32_t duration);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
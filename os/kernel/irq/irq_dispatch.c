@@ -103,6 +103,11 @@ void irq_dispatch(int irq, FAR void *context)
 {
 	xcpt_t vector;
 	FAR void *arg;
+#ifdef CONFIG_IRQ_STATS
+	uint32_t latency;
+	uint32_t start;
+	bool timed;
+#endif
 
 	/* Perform some sanity checks */
 
@@ -128,5 +133,16 @@ void irq_dispatch(int irq, FAR void *context)
 
 	/* Then dispatch to the interrupt handler */
 
+#ifdef CONFIG_IRQ_STATS
+	start = up_cyclecount();
+	timed = irq_stats_latency(start, &latency);
+
 	vector(irq, context, arg);
+
+	if (timed && vector != irq_unexpected_isr) {
+		irq_stats_update(irq, latency, up_cyclecount() - start);
+	}
+#else
+	vector(irq, context, arg);
+#endif
 }
@@ -0,0 +1,296 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/irq/irq_stats.c
+ *
+ * Interrupt timing statistics, in cycles of the CPU.
+ *
+ * The entry latency of an interrupt runs from irq_stats_entry(), called by
+ * the architecture when it enters the interrupt, to the call of the
+ * handler by irq_dispatch().  The handler duration includes the handlers of
+ * any interrupts that preempt it.  The entry time stamps are kept on a
+ * small stack indexed by the nesting depth, so that a nested interrupt
+ * does not overwrite the stamp of the one it preempted.  Interrupts nested
+ * deeper than IRQ_STATS_NESTING are not timed.
+ *
+ * An interrupts disabled section runs from the irqsave() that disables the
+ * interrupts to the irqrestore() that enables them again.  A thread may
+ * block inside the section, and the next thread may run with interrupts
+ * enabled, so a section is only taken into account if no interrupt was
+ * dispatched while it was open.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/irq.h>
+
+#include "irq/irq.h"
+
+#ifdef CONFIG_IRQ_STATS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define IRQ_STATS_NESTING 8
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+
+/* The cycle count at the entry of each nesting level of interrupts */
+
+static uint32_t g_irq_entry[IRQ_STATS_NESTING];
+static volatile int g_irq_nesting;
+
+#ifdef CONFIG_IRQ_STATS_CSECTION
+static uint32_t g_irq_ndispatched;	/* Number of interrupts dispatched */
+
+/* The section that is open */
+
+static bool g_csection_open;
+static uint32_t g_csection_start;
+static uint32_t g_csection_ndispatched;
+static FAR void *g_csection_caller;
+
+/* The longest section so far */
+
+static struct irq_csection_s g_csection_max;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_stats_bucket
+ *
+ * Description:
+ *   Return the histogram bucket of a time in cycles.
+ *
+ ****************************************************************************/
+
+static inline int irq_stats_bucket(uint32_t cycles)
+{
+	int bucket;
+
+	if (cycles < (1 << IRQ_STATS_BUCKET0)) {
+		return 0;
+	}
+
+	bucket = 32 - __builtin_clz(cycles) - IRQ_STATS_BUCKET0;
+	return bucket < IRQ_STATS_NBUCKETS ? bucket : IRQ_STATS_NBUCKETS - 1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_stats_entry
+ ****************************************************************************/
+
+void irq_stats_entry(void)
+{
+	uint32_t now = up_cyclecount();
+	int depth;
+
+	/* Take the level before storing into it.  An interrupt that preempts
+	 * this one before the level is taken uses and releases the same slot
+	 * first, and one that preempts it later uses the next slot.
+	 */
+
+	depth = g_irq_nesting++;
+	if (depth < IRQ_STATS_NESTING) {
+		g_irq_entry[depth] = now;
+	}
+}
+
+/****************************************************************************
+ * Name: irq_stats_latency
+ *
+ * Description:
+ *   Return the entry latency of the interrupt that is being dispatched and
+ *   release its nesting level.
+ *
+ * Inputs:
+ *   start   - The cycle count when the handler is called
+ *   latency - The location to return the entry latency in cycles
+ *
+ * Return Value:
+ *   true if the latency is known; false if the interrupt was nested too
+ *   deeply to keep its entry time.
+ *
+ * Assumptions:
+ *   Called by irq_dispatch() in the interrupt context, once for every
+ *   irq_stats_entry().
+ *
+ ****************************************************************************/
+
+bool irq_stats_latency(uint32_t start, FAR uint32_t *latency)
+{
+	int depth = g_irq_nesting - 1;
+	bool known = false;
+
+	DEBUGASSERT(depth >= 0);
+
+	/* Read the stamp before the level is released */
+
+	if (depth < IRQ_STATS_NESTING) {
+		*latency = start - g_irq_entry[depth];
+		known = true;
+	}
+
+	g_irq_nesting = depth;
+	return known;
+}
+
+/****************************************************************************
+ * Name: irq_stats_update
+ *
+ * Description:
+ *   Account an interrupt that was handled.
+ *
+ * Inputs:
+ *   irq      - The IRQ number, which is valid
+ *   latency  - The entry latency in cycles
+ *   duration - The handler duration in cycles
+ *
+ * Assumptions:
+ *   Called by irq_dispatch() in the interrupt context.
+ *
+ ****************************************************************************/
+
+void irq_stats_update(int irq, uint32_t latency, uint32_t duration)
+{
+	FAR struct irq_stats_s *stats = &g_irqvector[irq].stats;
+
+	stats->count++;
+	stats->totalduration += duration;
+
+	if (latency > stats->maxlatency) {
+		stats->maxlatency = latency;
+	}
+
+	if (duration > stats->maxduration) {
+		stats->maxduration = duration;
+	}
+
+	stats->latency[irq_stats_bucket(latency)]++;
+	stats->duration[irq_stats_bucket(duration)]++;
+
+#ifdef CONFIG_IRQ_STATS_CSECTION
+	g_irq_ndispatched++;
+#endif
+}
+
+/****************************************************************************
+ * Name: irq_getstats
+ ****************************************************************************/
+
+int irq_getstats(int irq, FAR struct irq_stats_s *stats)
+{
+	irqstate_t flags;
+
+	DEBUGASSERT(stats);
+
+	if ((unsigned)irq >= NR_IRQS) {
+		return -EINVAL;
+	}
+
+	flags = irqsave();
+	memcpy(stats, &g_irqvector[irq].stats, sizeof(struct irq_stats_s));
+	irqrestore(flags);
+
+	return OK;
+}
+
+#ifdef CONFIG_IRQ_STATS_CSECTION
+
+/****************************************************************************
+ * Name: irq_csection_enter
+ *
+ * Description:
+ *   Called by irqsave() when it has disabled the interrupts.  The caller of
+ *   this function is the code that irqsave() was inlined into.
+ *
+ ****************************************************************************/
+
+void irq_csection_enter(void)
+{
+	g_csection_caller = __builtin_return_address(0);
+	g_csection_ndispatched = g_irq_ndispatched;
+	g_csection_open = true;
+	g_csection_start = up_cyclecount();
+}
+
+/****************************************************************************
+ * Name: irq_csection_leave
+ *
+ * Description:
+ *   Called by irqrestore() when it is about to enable the interrupts.
+ *
+ ****************************************************************************/
+
+void irq_csection_leave(void)
+{
+	uint32_t elapsed;
+
+	if (!g_csection_open) {
+		return;
+	}
+
+	elapsed = up_cyclecount() - g_csection_start;
+	g_csection_open = false;
+
+	if (g_irq_ndispatched == g_csection_ndispatched && elapsed > g_csection_max.maxcycles) {
+		g_csection_max.maxcycles = elapsed;
+		g_csection_max.caller = g_csection_caller;
+	}
+}
+
+/****************************************************************************
+ * Name: irq_getcsection
+ ****************************************************************************/
+
+void irq_getcsection(FAR struct irq_csection_s *csection)
+{
+	irqstate_t flags;
+
+	DEBUGASSERT(csection);
+
+	flags = irqsave();
+	csection->maxcycles = g_csection_max.maxcycles;
+	csection->caller = g_csection_max.caller;
+	irqrestore(flags);
+}
+
+#endif							/* CONFIG_IRQ_STATS_CSECTION */
+#endif							/* CONFIG_IRQ_STATS */
@@ -114,6 +114,13 @@ void mq_msgqfree(FAR struct mqueue_inode_s *msgq)
 		/* Deallocate the message structure. */
 
 		next = curr->next;
+#ifdef CONFIG_MQ_ZEROCOPY
+		/* Nobody has taken over the buffer passed with the message */
+
+		if (curr->buffer) {
+			kumm_free(curr->buffer);
+		}
+#endif
 		mq_msgfree(curr);
 		curr = next;
 	}
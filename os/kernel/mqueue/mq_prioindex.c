@@ -0,0 +1,193 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/mqueue/mq_prioindex.c
+ *
+ * Priority index of the message list of a message queue.
+ *
+ * The list stays sorted by priority, highest first, with the messages of
+ * one priority in FIFO order.  The index remembers the last message of
+ * each priority and has a bitmap of the priorities that are queued.  A
+ * message of priority p belongs right after the last message of the lowest
+ * queued priority that is not below p, which is found with a count leading
+ * zeros search of the bitmap, or at the head of the list if there is none.
+ *
+ * The bitmap is ordered for that search: priority p is bit (31 - p % 32)
+ * of word p / 32, so the lowest priority of a word is its leading bit.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <queue.h>
+
+#include <tinyara/mqueue.h>
+
+#include "mqueue/mqueue.h"
+
+#ifdef CONFIG_MQ_PRIORITY_INDEX
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PRIOINDEX_BIT(prio)   (0x80000000 >> ((prio) & 31))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_prioindex_find
+ *
+ * Description:
+ *   Return the lowest priority queued in the message queue that is not
+ *   below 'prio', or -1 if there is none.
+ *
+ ****************************************************************************/
+
+static inline int mq_prioindex_find(FAR struct mqueue_inode_s *msgq, int prio)
+{
+	int word = prio >> 5;
+	uint32_t bits;
+
+	/* Ignore the priorities below 'prio' in its own word */
+
+	bits = msgq->priomap[word] & (0xffffffff >> (prio & 31));
+	while (bits == 0) {
+		if (++word >= MQ_PRIOMAP_NWORDS) {
+			return -1;
+		}
+
+		bits = msgq->priomap[word];
+	}
+
+	return (word << 5) + __builtin_clz(bits);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_prioindex_add
+ *
+ * Description:
+ *   Add a message to the message list after all messages of higher or the
+ *   same priority.
+ *
+ * Inputs:
+ *   msgq  - The message queue
+ *   mqmsg - The message, with its priority set
+ *
+ * Assumptions:
+ * - Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void mq_prioindex_add(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg)
+{
+	int prio = mqmsg->priority;
+	int found;
+
+	found = mq_prioindex_find(msgq, prio);
+	if (found < 0) {
+		sq_addfirst((FAR sq_entry_t *)mqmsg, &msgq->msglist);
+	} else {
+		sq_addafter((FAR sq_entry_t *)msgq->priolast[found], (FAR sq_entry_t *)mqmsg, &msgq->msglist);
+	}
+
+	/* The new message is the last one of its priority now */
+
+	msgq->priolast[prio] = mqmsg;
+	msgq->priomap[prio >> 5] |= PRIOINDEX_BIT(prio);
+}
+
+/****************************************************************************
+ * Name: mq_prioindex_addfirst
+ *
+ * Description:
+ *   Put a message that was just removed with mq_prioindex_remfirst() back
+ *   at the head of the message list.
+ *
+ * Inputs:
+ *   msgq  - The message queue
+ *   mqmsg - The message
+ *
+ * Assumptions:
+ * - Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void mq_prioindex_addfirst(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg)
+{
+	int prio = mqmsg->priority;
+
+	sq_addfirst((FAR sq_entry_t *)mqmsg, &msgq->msglist);
+
+	if (msgq->priolast[prio] == NULL) {
+		msgq->priolast[prio] = mqmsg;
+		msgq->priomap[prio >> 5] |= PRIOINDEX_BIT(prio);
+	}
+}
+
+/****************************************************************************
+ * Name: mq_prioindex_remfirst
+ *
+ * Description:
+ *   Remove the first message, of the highest priority, from the message
+ *   list.
+ *
+ * Inputs:
+ *   msgq - The message queue
+ *
+ * Return Value:
+ *   The removed message or NULL if the message list is empty.
+ *
+ * Assumptions:
+ * - Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+FAR struct mqueue_msg_s *mq_prioindex_remfirst(FAR struct mqueue_inode_s *msgq)
+{
+	FAR struct mqueue_msg_s *mqmsg;
+	int prio;
+
+	mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msglist);
+	if (mqmsg) {
+		/* Being the first, the message was the last one of its priority
+		 * only if it was the only one.
+		 */
+
+		prio = mqmsg->priority;
+		if (msgq->priolast[prio] == mqmsg) {
+			msgq->priolast[prio] = NULL;
+			msgq->priomap[prio >> 5] &= ~PRIOINDEX_BIT(prio);
+		}
+	}
+
+	return mqmsg;
+}
+
+#endif							/* CONFIG_MQ_PRIORITY_INDEX */
@@ -66,6 +66,7 @@
 #include <debug.h>
 
 #include <tinyara/arch.h>
+#include <tinyara/kmalloc.h>
 #include <tinyara/cancelpt.h>
 #include <tinyara/ttrace.h>
 
@@ -92,6 +93,83 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: mq_wakesender
+ *
+ * Description:
+ *   Wake up the highest priority task that waits for the message queue to
+ *   become not full, if there is one.
+ *
+ * Parameters:
+ *   msgq - The message queue
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void mq_wakesender(FAR struct mqueue_inode_s *msgq)
+{
+	FAR struct tcb_s *btcb;
+	irqstate_t saved_state;
+
+	if (msgq->nwaitnotfull > 0) {
+		/* Find the highest priority task that is waiting for
+		 * this queue to be not-full in g_waitingformqnotfull list.
+		 * This must be performed in a critical section because
+		 * messages can be sent from interrupt handlers.
+		 */
+
+		saved_state = irqsave();
+		for (btcb = (FAR struct tcb_s *)g_waitingformqnotfull.head; btcb && btcb->msgwaitq != msgq; btcb = btcb->flink) ;
+
+		/* If one was found, unblock it.  NOTE:  There is a race
+		 * condition here:  the queue might be full again by the
+		 * time the task is unblocked
+		 */
+
+		ASSERT(btcb);
+
+		btcb->msgwaitq = NULL;
+		msgq->nwaitnotfull--;
+		up_unblock_task(btcb);
+
+		irqrestore(saved_state);
+	}
+}
+
+#ifdef CONFIG_MQ_ZEROCOPY
+/****************************************************************************
+ * Name: mq_putback
+ *
+ * Description:
+ *   Put a message obtained by mq_waitreceive() back where it was, at the
+ *   head of the queue.
+ *
+ * Parameters:
+ *   msgq  - The message queue
+ *   mqmsg - The message
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void mq_putback(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg)
+{
+	irqstate_t saved_state;
+
+	saved_state = irqsave();
+#ifdef CONFIG_MQ_PRIORITY_INDEX
+	mq_prioindex_addfirst(msgq, mqmsg);
+#else
+	sq_addfirst((FAR sq_entry_t *)mqmsg, &msgq->msglist);
+#endif
+	msgq->nmsgs++;
+	irqrestore(saved_state);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -195,7 +273,11 @@ FAR struct mqueue_msg_s *mq_waitreceive(mqd_t mqdes)
 
 	/* Get the message from the head of the queue */
 
+#ifdef CONFIG_MQ_PRIORITY_INDEX
+	while ((rcvmsg = mq_prioindex_remfirst(msgq)) == NULL) {
+#else
 	while ((rcvmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msglist)) == NULL) {
+#endif
 		/* The queue is empty!  Should we block until there the above condition
 		 * has been satisfied?
 		 */
@@ -255,10 +337,14 @@ FAR struct mqueue_msg_s *mq_waitreceive(mqd_t mqdes)
  *   mqdes - Message queue descriptor
  *   mqmsg   - The message obtained by mq_waitmsg()
  *   ubuffer - The address of the user provided buffer to receive the message
+ *   msglen  - Size of the user provided buffer in bytes
  *   prio    - The user-provided location to return the message priority.
  *
  * Return Value:
- *   Returns the length of the received message.  This function does not fail.
+ *   Returns the length of the received message.  If the message passes a
+ *   buffer (mq_sendbuf) that does not fit in the user buffer, the message
+ *   is put back in the queue and -1 (ERROR) is returned with the errno set
+ *   to EMSGSIZE.
  *
  * Assumptions:
  * - The caller has provided all validity checking of the input parameters
@@ -269,22 +355,42 @@ FAR struct mqueue_msg_s *mq_waitreceive(mqd_t mqdes)
  *
  ****************************************************************************/
 
-ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR char *ubuffer, int *prio)
+ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR char *ubuffer, size_t msglen, int *prio)
 {
-	FAR struct tcb_s *btcb;
-	irqstate_t saved_state;
-	FAR struct mqueue_inode_s *msgq;
 	ssize_t rcvmsglen;
 
 	trace_begin(TTRACE_TAG_IPC, "mq_doreceive");
 
-	/* Get the length of the message (also the return value) */
+#ifdef CONFIG_MQ_ZEROCOPY
+	if (mqmsg->buffer) {
+		/* The message passes a buffer, which may be larger than the maximum
+		 * message size.  A buffer that does not fit is refused as the copy
+		 * path refuses a small user buffer, and stays queued so that it can
+		 * still be taken with mq_receivebuf().  Else the data is copied and
+		 * the buffer is released.
+		 */
 
-	rcvmsglen = mqmsg->msglen;
+		rcvmsglen = mqmsg->buflen;
+		if ((size_t)rcvmsglen > msglen) {
+			mq_putback(mqdes->msgq, mqmsg);
+			trace_end(TTRACE_TAG_IPC);
+			set_errno(EMSGSIZE);
+			return ERROR;
+		}
 
-	/* Copy the message into the caller's buffer */
+		memcpy(ubuffer, (FAR const void *)mqmsg->buffer, rcvmsglen);
+		kumm_free(mqmsg->buffer);
+	} else
+#endif
+	{
+		/* Get the length of the message (also the return value) */
 
-	memcpy(ubuffer, (const void *)mqmsg->mail, rcvmsglen);
+		rcvmsglen = mqmsg->msglen;
+
+		/* Copy the message into the caller's buffer */
+
+		memcpy(ubuffer, (const void *)mqmsg->mail, rcvmsglen);
+	}
 
 	/* Copy the message priority as well (if a buffer is provided) */
 
@@ -298,34 +404,84 @@ ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR char *ubuf
 
 	/* Check if any tasks are waiting for the MQ not full event. */
 
-	msgq = mqdes->msgq;
-	if (msgq->nwaitnotfull > 0) {
-		/* Find the highest priority task that is waiting for
-		 * this queue to be not-full in g_waitingformqnotfull list.
-		 * This must be performed in a critical section because
-		 * messages can be sent from interrupt handlers.
-		 */
+	mq_wakesender(mqdes->msgq);
 
-		saved_state = irqsave();
-		for (btcb = (FAR struct tcb_s *)g_waitingformqnotfull.head; btcb && btcb->msgwaitq != msgq; btcb = btcb->flink) ;
+	trace_end(TTRACE_TAG_IPC);
 
-		/* If one was found, unblock it.  NOTE:  There is a race
-		 * condition here:  the queue might be full again by the
-		 * time the task is unblocked
-		 */
+	/* Return the length of the message transferred to the user buffer */
 
-		ASSERT(btcb);
+	return rcvmsglen;
+}
 
-		btcb->msgwaitq = NULL;
-		msgq->nwaitnotfull--;
-		up_unblock_task(btcb);
+#ifdef CONFIG_MQ_ZEROCOPY
+/****************************************************************************
+ * Name: mq_doreceivebuf
+ *
+ * Description:
+ *   This is the counterpart of mq_doreceive() for mq_receivebuf().  It
+ *   hands the buffer of the message obtained by mq_waitreceive() over to
+ *   the caller.  The data of a message sent with mq_send() is copied into
+ *   a buffer allocated from the user heap.  Then it notifies any threads
+ *   that were waiting for the message queue to become non-full and
+ *   disposes of the message structure.
+ *
+ * Parameters:
+ *   mqdes  - Message queue descriptor
+ *   mqmsg  - The message obtained by mq_waitreceive()
+ *   buffer - The location to return the buffer
+ *   prio   - The user-provided location to return the message priority.
+ *
+ * Return Value:
+ *   Returns the length of the buffer.  If a buffer for the data of a
+ *   copied message cannot be allocated, the message is put back in the
+ *   queue and -1 (ERROR) is returned with the errno set to ENOMEM.
+ *
+ * Assumptions:
+ * - The caller has provided all validity checking of the input parameters.
+ * - Pre-emption should be disabled throughout this call.
+ *
+ ****************************************************************************/
 
-		irqrestore(saved_state);
+ssize_t mq_doreceivebuf(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR void **buffer, FAR int *prio)
+{
+	FAR struct mqueue_inode_s *msgq = mqdes->msgq;
+	ssize_t rcvmsglen;
+
+	trace_begin(TTRACE_TAG_IPC, "mq_doreceivebuf");
+
+	if (mqmsg->buffer) {
+		/* The caller takes over the buffer */
+
+		*buffer = mqmsg->buffer;
+		rcvmsglen = mqmsg->buflen;
+	} else {
+		*buffer = kumm_malloc(mqmsg->msglen > 0 ? mqmsg->msglen : 1);
+		if (*buffer == NULL) {
+			mq_putback(msgq, mqmsg);
+			trace_end(TTRACE_TAG_IPC);
+			set_errno(ENOMEM);
+			return ERROR;
+		}
+
+		rcvmsglen = mqmsg->msglen;
+		memcpy(*buffer, (FAR const void *)mqmsg->mail, rcvmsglen);
 	}
 
-	trace_end(TTRACE_TAG_IPC);
+	/* Copy the message priority as well (if a buffer is provided) */
 
-	/* Return the length of the message transferred to the user buffer */
+	if (prio) {
+		*prio = mqmsg->priority;
+	}
+
+	/* We are done with the message.  Deallocate it now. */
+
+	mq_msgfree(mqmsg);
 
+	/* Check if any tasks are waiting for the MQ not full event. */
+
+	mq_wakesender(msgq);
+
+	trace_end(TTRACE_TAG_IPC);
 	return rcvmsglen;
 }
+#endif							/* CONFIG_MQ_ZEROCOPY */
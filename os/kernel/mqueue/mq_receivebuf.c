@@ -0,0 +1,116 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/mqueue/mq_receivebuf.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <mqueue.h>
+#include <debug.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/cancelpt.h>
+
+#include "mqueue/mqueue.h"
+
+#ifdef CONFIG_MQ_ZEROCOPY
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_receivebuf
+ *
+ * Description:
+ *   This function receives the oldest of the highest priority messages
+ *   from the message queue specified by "mqdes" as a buffer that the
+ *   caller owns and has to free().  The buffer of a message sent with
+ *   mq_sendbuf() is handed over without a copy.  The data of a message
+ *   sent with mq_send() is copied into a newly allocated buffer.
+ *
+ *   Blocking and O_NONBLOCK work as for mq_receive().
+ *
+ * Parameters:
+ *   mqdes  - Message Queue Descriptor
+ *   buffer - The location to return the buffer
+ *   prio   - If not NULL, the location to store message priority.
+ *
+ * Return Value:
+ *   One success, the length of the buffer in bytes is returned.  On
+ *   failure, -1 (ERROR) is returned and the errno is set appropriately:
+ *
+ *   EAGAIN   The queue was empty, and the O_NONBLOCK flag was set
+ *            for the message queue description referred to by 'mqdes'.
+ *   EPERM    Message queue opened not opened for reading.
+ *   ENOMEM   No buffer for the data of a copied message.  The message
+ *            stays in the queue.
+ *   EINTR    The call was interrupted by a signal handler.
+ *   EINVAL   Invalid 'buffer' or 'mqdes'
+ *
+ ****************************************************************************/
+
+ssize_t mq_receivebuf(mqd_t mqdes, FAR void **buffer, FAR int *prio)
+{
+	FAR struct mqueue_msg_s *mqmsg;
+	irqstate_t saved_state;
+	ssize_t ret = ERROR;
+
+	DEBUGASSERT(up_interrupt_context() == false);
+
+	/* mq_receivebuf() is a cancellation point */
+
+	(void)enter_cancellation_point();
+
+	if (!buffer || !mqdes) {
+		set_errno(EINVAL);
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	if ((mqdes->oflags & O_RDOK) == 0) {
+		set_errno(EPERM);
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	/* Get the next message from the message queue as mq_receive() does */
+
+	sched_lock();
+	saved_state = irqsave();
+	mqmsg = mq_waitreceive(mqdes);
+	irqrestore(saved_state);
+
+	if (mqmsg) {
+		ret = mq_doreceivebuf(mqdes, mqmsg, buffer, prio);
+	}
+
+	sched_unlock();
+	leave_cancellation_point();
+	return ret;
+}
+
+#endif							/* CONFIG_MQ_ZEROCOPY */
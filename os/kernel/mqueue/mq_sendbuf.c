@@ -0,0 +1,129 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/mqueue/mq_sendbuf.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <mqueue.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/cancelpt.h>
+
+#include "mqueue/mqueue.h"
+
+#ifdef CONFIG_MQ_ZEROCOPY
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_sendbuf
+ *
+ * Description:
+ *   This function passes the ownership of a buffer through the message
+ *   queue (mqdes).  The buffer is queued like a message of mq_send(), but
+ *   its data is not copied and its length is not limited by the maximum
+ *   message size of the message queue.  The receiver of the message owns
+ *   the buffer and has to free() it.  mq_receive() copies the data out of
+ *   the buffer instead and fails with EMSGSIZE, leaving the message
+ *   queued, when the data does not fit in its buffer.
+ *
+ *   The buffer has to be allocated with malloc() and must not be used by
+ *   the caller once mq_sendbuf() has succeeded.  If the message queue is
+ *   removed while the message is queued, the buffer is freed with it.
+ *
+ *   Blocking, O_NONBLOCK and the priority work as for mq_send().
+ *
+ * Parameters:
+ *   mqdes  - Message queue descriptor
+ *   buffer - The buffer to pass
+ *   buflen - The length of the buffer in bytes
+ *   prio   - The priority of the message
+ *
+ * Return Value:
+ *   On success, mq_sendbuf() returns 0 (OK); on error, -1 (ERROR)
+ *   is returned, with errno set to indicate the error.  The caller still
+ *   owns the buffer then.
+ *
+ *   EAGAIN   The queue was full, and the O_NONBLOCK flag was set for the
+ *            message queue description referred to by mqdes.
+ *   EINVAL   Either buffer or mqdes is NULL or the value of prio is invalid.
+ *   EPERM    Message queue opened not opened for writing.
+ *   EINTR    The call was interrupted by a signal handler.
+ *
+ ****************************************************************************/
+
+int mq_sendbuf(mqd_t mqdes, FAR void *buffer, size_t buflen, int prio)
+{
+	FAR struct mqueue_inode_s *msgq;
+	FAR struct mqueue_msg_s *mqmsg = NULL;
+	irqstate_t saved_state;
+	int ret = ERROR;
+
+	/* mq_sendbuf() is a cancellation point */
+
+	(void)enter_cancellation_point();
+
+	/* The message itself carries no data */
+
+	if (mq_verifysend(mqdes, (FAR const char *)buffer, 0, prio) != OK) {
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	/* Get a pointer to the message queue */
+
+	sched_lock();
+	msgq = mqdes->msgq;
+
+	/* Allocate a message structure as mq_send() does */
+
+	saved_state = irqsave();
+	if (up_interrupt_context() ||	/* In an interrupt handler */
+		msgq->nmsgs < msgq->maxmsgs ||	/* OR Message queue not full */
+		mq_waitsend(mqdes) == OK) {	/* OR Successfully waited for mq not full */
+		irqrestore(saved_state);
+		mqmsg = mq_msgalloc();
+	} else {
+		irqrestore(saved_state);
+	}
+
+	if (mqmsg) {
+		/* Attach the buffer and send the message */
+
+		mqmsg->buffer = buffer;
+		mqmsg->buflen = buflen;
+		ret = mq_dosend(mqdes, mqmsg, NULL, 0, prio);
+	}
+
+	sched_unlock();
+	leave_cancellation_point();
+	return ret;
+}
+
+#endif							/* CONFIG_MQ_ZEROCOPY */
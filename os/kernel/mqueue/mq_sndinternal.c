@@ -220,6 +220,14 @@ FAR struct mqueue_msg_s *mq_msgalloc(void)
 		}
 	}
 
+#ifdef CONFIG_MQ_ZEROCOPY
+	/* The data is in the message unless mq_sendbuf() passes a buffer */
+
+	if (mqmsg) {
+		mqmsg->buffer = NULL;
+	}
+#endif
+
 	return mqmsg;
 }
 
@@ -350,8 +358,10 @@ int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR const char *msg,
 {
 	FAR struct tcb_s *btcb;
 	FAR struct mqueue_inode_s *msgq;
+#ifndef CONFIG_MQ_PRIORITY_INDEX
 	FAR struct mqueue_msg_s *next;
 	FAR struct mqueue_msg_s *prev;
+#endif
 	irqstate_t saved_state;
 
 	trace_begin(TTRACE_TAG_IPC, "mq_dosend");
@@ -366,19 +376,31 @@ int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR const char *msg,
 	mqmsg->priority = prio;
 	mqmsg->msglen = msglen;
 
-	/* Copy the message data into the message */
+	/* Copy the message data into the message.  There is none if the message
+	 * passes a buffer.
+	 */
 
-	memcpy((void *)mqmsg->mail, (FAR const void *)msg, msglen);
+	if (msglen > 0) {
+		memcpy((void *)mqmsg->mail, (FAR const void *)msg, msglen);
+	}
 
 	/* Insert the new message in the message queue */
 
 	saved_state = irqsave();
 
+#ifdef CONFIG_MQ_PRIORITY_INDEX
+	mq_prioindex_add(msgq, mqmsg);
+#else
 	/* Search the message list to find the location to insert the new
 	 * message. Each is list is maintained in ascending priority order.
+	 * Messages that do not have a higher priority than the last one, the
+	 * common case, go to the tail without a search.
 	 */
 
-	for (prev = NULL, next = (FAR struct mqueue_msg_s *)msgq->msglist.head; next && prio <= next->priority; prev = next, next = next->next) ;
+	prev = (FAR struct mqueue_msg_s *)msgq->msglist.tail;
+	if (prev && prio > prev->priority) {
+		for (prev = NULL, next = (FAR struct mqueue_msg_s *)msgq->msglist.head; next && prio <= next->priority; prev = next, next = next->next) ;
+	}
 
 	/* Add the message at the right place */
 
@@ -387,6 +409,7 @@ int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR const char *msg,
 	} else {
 		sq_addfirst((FAR sq_entry_t *)mqmsg, &msgq->msglist);
 	}
+#endif
 
 	/* Increment the count of messages in the queue */
 
@@ -112,6 +112,10 @@ struct mqueue_msg_s {
 	uint8_t msglen;					/* Message data length */
 #else
 	uint16_t msglen;				/* Message data length */
+#endif
+#ifdef CONFIG_MQ_ZEROCOPY
+	FAR void *buffer;				/* Passed buffer, NULL if the data is in mail[] */
+	size_t buflen;					/* Length of the passed buffer */
 #endif
 	char mail[MQ_MAX_BYTES];		/* Message data */
 };
@@ -166,7 +170,10 @@ void mq_waitirq(FAR struct tcb_s *wtcb, int errcode);
 
 int mq_verifyreceive(mqd_t mqdes, FAR char *msg, size_t msglen);
 FAR struct mqueue_msg_s *mq_waitreceive(mqd_t mqdes);
-ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR char *ubuffer, FAR int *prio);
+ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR char *ubuffer, size_t msglen, FAR int *prio);
+#ifdef CONFIG_MQ_ZEROCOPY
+ssize_t mq_doreceivebuf(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR void **buffer, FAR int *prio);
+#endif
 
 /* mq_sndinternal.c ********************************************************/
 
@@ -175,6 +182,14 @@ FAR struct mqueue_msg_s *mq_msgalloc(void);
 int mq_waitsend(mqd_t mqdes);
 int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR const char *msg, size_t msglen, int prio);
 
+/* mq_prioindex.c **********************************************************/
+
+#ifdef CONFIG_MQ_PRIORITY_INDEX
+void mq_prioindex_add(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg);
+void mq_prioindex_addfirst(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg);
+FAR struct mqueue_msg_s *mq_prioindex_remfirst(FAR struct mqueue_inode_s *msgq);
+#endif
+
 /* mq_release.c ************************************************************/
 
 struct task_group_s;			/* Forward reference */
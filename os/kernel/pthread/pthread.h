@@ -140,6 +140,10 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex, bool intr);
 int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex);
 int pthread_mutex_give(FAR struct pthread_mutex_s *mutex);
 void pthread_mutex_inconsistent(FAR struct pthread_tcb_s *tcb);
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+bool pthread_mutex_fasttake(FAR struct pthread_mutex_s *mutex);
+bool pthread_mutex_fastgive(FAR struct pthread_mutex_s *mutex);
+#endif
 #else
 #define pthread_mutex_take(m, i) pthread_sem_take(&(m)->sem, (i))
 #define pthread_mutex_trytake(m) pthread_sem_trytake(&(m)->sem)
@@ -65,6 +65,7 @@
 #include <tinyara/sched.h>
 
 #include "sched/sched.h"
+#include "semaphore/semaphore.h"
 #include "pthread/pthread.h"
 
 /****************************************************************************
@@ -100,6 +101,110 @@ static void pthread_mutex_add(FAR struct pthread_mutex_s *mutex)
 	irqrestore(flags);
 }
 
+/****************************************************************************
+ * Name: pthread_mutex_remove
+ *
+ * Description:
+ *   Remove the mutex from the list of mutexes held by this thread.
+ *
+ * Parameters:
+ *  mutex - The mux to be unlocked
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void pthread_mutex_remove(FAR struct pthread_mutex_s *mutex)
+{
+	FAR struct pthread_tcb_s *rtcb = (FAR struct pthread_tcb_s *)this_task();
+	FAR struct pthread_mutex_s *curr;
+	FAR struct pthread_mutex_s *prev;
+	irqstate_t flags;
+
+	flags = irqsave();
+
+	/* Remove the mutex from the list of mutexes held by this task */
+
+	for (prev = NULL, curr = rtcb->mhead; curr != NULL && curr != mutex; prev = curr, curr = curr->flink) ;
+
+	DEBUGASSERT(curr == mutex);
+
+	/* Remove the mutex from the list.  prev == NULL means that the mutex
+	 * to be removed is at the head of the list.
+	 */
+
+	if (prev == NULL) {
+		rtcb->mhead = mutex->flink;
+	} else {
+		prev->flink = mutex->flink;
+	}
+
+	mutex->flink = NULL;
+	irqrestore(flags);
+}
+
+#if defined(CONFIG_PTHREAD_MUTEX_FASTPATH) && defined(CONFIG_PRIORITY_INHERITANCE)
+/****************************************************************************
+ * Name: pthread_mutex_hasholder
+ *
+ * Description:
+ *   Return true if the semaphore underlying the mutex has a holder record.
+ *
+ ****************************************************************************/
+
+static inline bool pthread_mutex_hasholder(FAR struct pthread_mutex_s *mutex)
+{
+#if CONFIG_SEM_PREALLOCHOLDERS > 0
+	return mutex->sem.hhead != NULL;
+#else
+	return mutex->sem.holder.htcb != NULL;
+#endif
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_inflate
+ *
+ * Description:
+ *   A mutex locked on the fast path has no holder record, so a thread that
+ *   is about to wait for it could not boost the priority of the owner.
+ *   Register the owner as the holder of the semaphore before waiting.
+ *
+ *   The owner is always known here: the fast path takes the semaphore count
+ *   and sets the mutex->pid with interrupts disabled.  If there is already
+ *   a holder record, the semaphore was taken with sem_wait() or is being
+ *   handed over by sem_post(), and the record is the right one.
+ *
+ * Parameters:
+ *  mutex - The mutex that the caller is about to wait for
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   The scheduler is locked.
+ *
+ ****************************************************************************/
+
+static void pthread_mutex_inflate(FAR struct pthread_mutex_s *mutex)
+{
+	FAR struct tcb_s *htcb;
+	irqstate_t flags;
+
+	flags = irqsave();
+	if (mutex->sem.semcount <= 0 && mutex->pid > 0 && !pthread_mutex_hasholder(mutex)) {
+		htcb = sched_gettcb(mutex->pid);
+		if (htcb != NULL) {
+			sem_addholder_tcb(htcb, &mutex->sem);
+		}
+	}
+
+	irqrestore(flags);
+}
+#else
+#define pthread_mutex_inflate(mutex)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -138,6 +243,12 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex, bool intr)
 		if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0) {
 			ret = EOWNERDEAD;
 		} else {
+			/* Make sure that the owner of a mutex locked on the fast path
+			 * inherits our priority if we have to wait.
+			 */
+
+			pthread_mutex_inflate(mutex);
+
 			/* Take semaphore underlying the mutex.  pthread_sem_take
 			 * returns zero on success and a positive errno value on failure.
 			 */
@@ -236,45 +347,156 @@ int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex)
 
 int pthread_mutex_give(FAR struct pthread_mutex_s *mutex)
 {
-	FAR struct pthread_mutex_s *curr;
-	FAR struct pthread_mutex_s *prev;
 	int ret = EINVAL;
 
 	/* Verify input parameters */
 
 	DEBUGASSERT(mutex != NULL);
 	if (mutex != NULL) {
-		FAR struct pthread_tcb_s *rtcb = (FAR struct pthread_tcb_s *)this_task();
-		irqstate_t flags;
+		/* Remove the mutex from the list of mutexes held by this task */
 
-		flags = irqsave();
+		pthread_mutex_remove(mutex);
 
-		/* Remove the mutex from the list of mutexes held by this task */
+		/* Now release the underlying semaphore */
 
-		for (prev = NULL, curr = rtcb->mhead; curr != NULL && curr != mutex; prev = curr, curr = curr->flink) ;
+		ret = pthread_sem_give(&mutex->sem);
+	}
 
-		DEBUGASSERT(curr == mutex);
+	return ret;
+}
 
-		/* Remove the mutex from the list.  prev == NULL means that the mutex
-		 * to be removed is at the head of the list.
-		 */
+/****************************************************************************
+ * Name: pthread_mutex_fasttake
+ *
+ * Description:
+ *   Lock a free mutex without locking the scheduler and without a holder
+ *   record.  The mutex is owned once the semaphore count is taken with an
+ *   atomic compare and exchange.  The mutex->pid is set right after, with
+ *   interrupts disabled across both steps, so that a thread that finds the
+ *   count taken always finds the owner too.
+ *
+ * Parameters:
+ *  mutex - The mutex to be locked
+ *
+ * Return Value:
+ *   true if the mutex was locked; false if it is not free, in which case
+ *   the caller must take the slow path.
+ *
+ ****************************************************************************/
 
-		if (prev == NULL) {
-			rtcb->mhead = mutex->flink;
-		} else {
-			prev->flink = mutex->flink;
-		}
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+bool pthread_mutex_fasttake(FAR struct pthread_mutex_s *mutex)
+{
+	int mypid = (int)getpid();
+	irqstate_t flags;
+
+	if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0) {
+		return false;
+	}
+
+	/* Only the count decides the ownership.  Claiming the pid first could
+	 * leave a preempted thread owning the mutex with the pid that a slow
+	 * path unlock restored to -1 in between.
+	 */
 
-		mutex->flink = NULL;
+	flags = irqsave();
+	if (!up_cmpxchg16(&mutex->sem.semcount, 1, 0)) {
 		irqrestore(flags);
+		return false;
+	}
 
-		/* Now release the underlying semaphore */
+	mutex->pid = mypid;
+	irqrestore(flags);
 
-		ret = pthread_sem_give(&mutex->sem);
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+	mutex->nlocks = 1;
+#endif
+	pthread_mutex_add(mutex);
+	return true;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_fastgive
+ *
+ * Description:
+ *   Unlock a mutex held by the calling thread.  If nobody waits for the
+ *   mutex, the semaphore count is given back with an atomic compare and
+ *   exchange.  Otherwise the semaphore is posted, which hands the mutex over
+ *   to the waiter and restores the priority of the caller.
+ *
+ * Parameters:
+ *  mutex - The mutex to be unlocked
+ *
+ * Return Value:
+ *   true if the mutex was unlocked; false if the caller does not hold it or
+ *   holds a recursive mutex more than once, in which case the caller must
+ *   take the slow path.
+ *
+ ****************************************************************************/
+
+bool pthread_mutex_fastgive(FAR struct pthread_mutex_s *mutex)
+{
+	int mypid = (int)getpid();
+#ifdef CONFIG_PRIORITY_INHERITANCE
+	irqstate_t flags;
+#endif
+
+	if (mutex->pid != mypid) {
+		return false;
 	}
 
-	return ret;
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+	if (mutex->nlocks > 1) {
+		return false;
+	}
+#endif
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+	/* A holder record left by sem_wait() or by a waiter in
+	 * pthread_mutex_inflate() must be released by sem_post(), which also
+	 * restores the priority of the caller.  Releasing the count and the pid
+	 * first would let another thread fast-take the mutex while the stale
+	 * record still names the caller.  Interrupts stay disabled until the
+	 * count is released so that no record can be added in between.
+	 */
+
+	flags = irqsave();
+	if (pthread_mutex_hasholder(mutex)) {
+		irqrestore(flags);
+		return false;
+	}
+#endif
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+	mutex->nlocks = 0;
+#endif
+	pthread_mutex_remove(mutex);
+
+	if (!up_cmpxchg16(&mutex->sem.semcount, 0, 1)) {
+		/* There are waiters */
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+		irqrestore(flags);
+#endif
+		sched_lock();
+		mutex->pid = -1;
+		(void)pthread_sem_give(&mutex->sem);
+		sched_unlock();
+		return true;
+	}
+
+	/* The mutex is free.  Release the pid unless a new owner already took
+	 * the mutex and set its own.
+	 */
+
+	(void)up_cmpxchg(&mutex->pid, mypid, -1);
+#ifdef CONFIG_PRIORITY_INHERITANCE
+	irqrestore(flags);
+#endif
+
+	return true;
 }
+#endif							/* CONFIG_PTHREAD_MUTEX_FASTPATH */
 
 /****************************************************************************
  * Name: pthread_disable_cancel() and pthread_enable_cancel()
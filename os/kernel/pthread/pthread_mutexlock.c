@@ -150,6 +150,14 @@ int pthread_mutex_lock(FAR pthread_mutex_t *mutex)
 	DEBUGASSERT(mutex != NULL);
 
 	if (mutex != NULL) {
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+		/* Lock a free mutex without locking the scheduler */
+
+		if (pthread_mutex_fasttake(mutex)) {
+			return OK;
+		}
+#endif
+
 		/* Make sure the semaphore is stable while we make the following
 		 * checks.  This all needs to be one atomic action.
 		 */
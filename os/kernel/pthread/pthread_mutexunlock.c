@@ -154,6 +154,14 @@ int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
 		return EINVAL;
 	}
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+	/* Unlock without locking the scheduler if nobody waits for the mutex */
+
+	if (pthread_mutex_fastgive(mutex)) {
+		return OK;
+	}
+#endif
+
 	/* Make sure the semaphore is stable while we make the following checks.
 	 * This all needs to be one atomic action.
 	 */
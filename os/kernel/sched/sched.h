@@ -251,6 +251,13 @@ bool sched_addreadytorun(FAR struct tcb_s *rtrtcb);
 bool sched_removereadytorun(FAR struct tcb_s *rtrtcb);
 bool sched_addprioritized(FAR struct tcb_s *newTcb, DSEG dq_queue_t *list);
 bool sched_mergepending(void);
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+bool sched_prioindex_add(FAR struct tcb_s *tcb, DSEG dq_queue_t *list);
+void sched_removeprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list);
+#else
+#define sched_removeprioritized(tcb, list) \
+		dq_rem((FAR dq_entry_t *)(tcb), (list))
+#endif
 void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void sched_removeblocked(FAR struct tcb_s *btcb);
 int sched_setpriority(FAR struct tcb_s *tcb, int sched_priority);
@@ -276,6 +283,13 @@ void sched_timer_reassess(void);
 void weak_function sched_process_cpuload(void);
 #endif
 
+#ifdef CONFIG_SCHED_CPUACCT
+void sched_cpuacct_switch(FAR struct tcb_s *tcb);
+void sched_cpuacct_irqenter(void);
+void sched_cpuacct_irqleave(void);
+void sched_cpuacct_release(FAR struct tcb_s *tcb);
+#endif
+
 bool sched_verifytcb(FAR struct tcb_s *tcb);
 int sched_releasetcb(FAR struct tcb_s *tcb, uint8_t ttype);
 
@@ -123,6 +123,14 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
 	ASSERT(sched_priority >= SCHED_PRIORITY_MIN);
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+	/* The ready-to-run lists have an index to find the spot */
+
+	if (list == (FAR dq_queue_t *)&g_readytorun || list == (FAR dq_queue_t *)&g_pendingtasks) {
+		return sched_prioindex_add(tcb, list);
+	}
+#endif
+
 	/* Search the list to find the location to insert the new Tcb.
 	 * Each is list is maintained in ascending sched_priority order.
 	 */
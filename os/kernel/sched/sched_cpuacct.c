@@ -0,0 +1,288 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/sched/sched_cpuacct.c
+ *
+ * Task CPU accounting with the cycle counter of the CPU.
+ *
+ * The architecture reports every context switch with the thread that is
+ * switched in, and the entry and the exit of every interrupt.  The cycles
+ * from one report to the next are charged to the thread that was running,
+ * and the cycles of an interrupt are also added to its interrupt time.
+ * The timer interrupt makes sure that the 32 bit counter is read often
+ * enough not to lose a wrap around.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/clock.h>
+#include <tinyara/sched.h>
+#include <arch/irq.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_CPUACCT
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The thread that the cycles are charged to.  NULL after the thread is
+ * released and before the first context switch.
+ */
+
+static FAR struct tcb_s *g_cpuacct_tcb;
+
+static uint32_t g_cpuacct_start;	/* Count when last charged */
+static uint32_t g_cpuacct_irqstart;	/* Count when last charged in an interrupt */
+static int g_cpuacct_irqnest;	/* Interrupt nesting level */
+
+/* The cycles since the counter was started in up_initialize(), together
+ * with the system time, for measuring the rate of the counter.
+ */
+
+#if CONFIG_SCHED_CPUACCT_CYCLEFREQ <= 0
+static uint64_t g_cpuacct_total;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_cpuacct_charge
+ *
+ * Description:
+ *   Charge the cycles since the last call to the current thread.
+ *
+ * Return Value:
+ *   The cycle count now.
+ *
+ ****************************************************************************/
+
+static inline uint32_t sched_cpuacct_charge(void)
+{
+	uint32_t now = up_cyclecount();
+	uint32_t elapsed = now - g_cpuacct_start;
+
+	g_cpuacct_start = now;
+	if (g_cpuacct_tcb) {
+		g_cpuacct_tcb->runcycles += elapsed;
+	}
+#if CONFIG_SCHED_CPUACCT_CYCLEFREQ <= 0
+	g_cpuacct_total += elapsed;
+#endif
+
+	return now;
+}
+
+/****************************************************************************
+ * Name: sched_cpuacct_usec
+ *
+ * Description:
+ *   Convert cycles to microseconds, without overflowing for large counts.
+ *
+ ****************************************************************************/
+
+static uint64_t sched_cpuacct_usec(uint64_t cycles, uint64_t freq)
+{
+	if (freq == 0) {
+		return 0;
+	}
+
+	return (cycles / freq) * USEC_PER_SEC + (cycles % freq) * USEC_PER_SEC / freq;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_cpuacct_switch
+ *
+ * Description:
+ *   Called by the architecture when a thread is switched in, right before
+ *   its context is restored.
+ *
+ * Inputs:
+ *   tcb - The thread that runs next
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void sched_cpuacct_switch(FAR struct tcb_s *tcb)
+{
+	uint32_t now;
+
+	now = sched_cpuacct_charge();
+
+	/* A switch in an interrupt handler splits the interrupt between the
+	 * two threads.
+	 */
+
+	if (g_cpuacct_irqnest > 0) {
+		if (g_cpuacct_tcb) {
+			g_cpuacct_tcb->irqcycles += now - g_cpuacct_irqstart;
+		}
+
+		g_cpuacct_irqstart = now;
+	}
+
+	if (tcb != g_cpuacct_tcb) {
+		tcb->nswitches++;
+		g_cpuacct_tcb = tcb;
+	}
+}
+
+/****************************************************************************
+ * Name: sched_cpuacct_irqenter
+ *
+ * Description:
+ *   Called by the architecture on the entry of an interrupt.
+ *
+ ****************************************************************************/
+
+void sched_cpuacct_irqenter(void)
+{
+	if (g_cpuacct_irqnest++ == 0) {
+		g_cpuacct_irqstart = sched_cpuacct_charge();
+	}
+}
+
+/****************************************************************************
+ * Name: sched_cpuacct_irqleave
+ *
+ * Description:
+ *   Called by the architecture on the exit of an interrupt, after any
+ *   context switch that it caused.
+ *
+ ****************************************************************************/
+
+void sched_cpuacct_irqleave(void)
+{
+	uint32_t now;
+
+	if (--g_cpuacct_irqnest == 0) {
+		now = sched_cpuacct_charge();
+		if (g_cpuacct_tcb) {
+			g_cpuacct_tcb->irqcycles += now - g_cpuacct_irqstart;
+		}
+	}
+}
+
+/****************************************************************************
+ * Name: sched_cpuacct_release
+ *
+ * Description:
+ *   Called when the TCB of a thread is released.  If it is the thread that
+ *   is charged, it is charged up to now and the cycles until the next
+ *   context switch are not charged to any thread.
+ *
+ ****************************************************************************/
+
+void sched_cpuacct_release(FAR struct tcb_s *tcb)
+{
+	irqstate_t flags;
+
+	flags = irqsave();
+	if (tcb == g_cpuacct_tcb) {
+		(void)sched_cpuacct_charge();
+		g_cpuacct_tcb = NULL;
+	}
+
+	irqrestore(flags);
+}
+
+/****************************************************************************
+ * Name: sched_cpuacct
+ *
+ * Description:
+ *   Return the CPU accounting of a thread.
+ *
+ * Parameters:
+ *   pid - The task ID of the thread.  pid == 0 is the IDLE thread.
+ *   cpuacct - The location to return the CPU accounting
+ *
+ * Return Value:
+ *   OK (0) on success; -ESRCH if 'pid' does not refer to a thread.
+ *
+ ****************************************************************************/
+
+int sched_cpuacct(pid_t pid, FAR struct cpuacct_s *cpuacct)
+{
+	FAR struct tcb_s *tcb;
+	irqstate_t flags;
+	uint64_t runcycles;
+	uint64_t irqcycles;
+	uint64_t freq;
+#if CONFIG_SCHED_CPUACCT_CYCLEFREQ <= 0
+	systime_t ticks;
+#endif
+
+	DEBUGASSERT(cpuacct);
+
+	/* Keep the thread valid and its counts consistent while they are read.
+	 * The thread that is running, normally the caller, is charged up to now
+	 * first.
+	 */
+
+	flags = irqsave();
+
+	tcb = sched_gettcb(pid);
+	if (tcb == NULL) {
+		irqrestore(flags);
+		return -ESRCH;
+	}
+
+	if (g_cpuacct_irqnest == 0) {
+		(void)sched_cpuacct_charge();
+	}
+
+	runcycles = tcb->runcycles;
+	irqcycles = tcb->irqcycles;
+	cpuacct->nswitches = tcb->nswitches;
+
+#if CONFIG_SCHED_CPUACCT_CYCLEFREQ > 0
+	freq = CONFIG_SCHED_CPUACCT_CYCLEFREQ;
+#else
+	/* Cycles per second measured against the system timer */
+
+	ticks = clock_systimer();
+	freq = ticks > 0 ? g_cpuacct_total * CLOCKS_PER_SEC / ticks : 0;
+#endif
+
+	irqrestore(flags);
+
+	cpuacct->runtime = sched_cpuacct_usec(runcycles, freq);
+	cpuacct->irqtime = sched_cpuacct_usec(irqcycles, freq);
+	return OK;
+}
+
+#endif							/* CONFIG_SCHED_CPUACCT */
@@ -56,6 +56,10 @@
 
 #include <tinyara/config.h>
 #include <tinyara/kmalloc.h>
+#if defined(CONFIG_MM_COMPACT) && CONFIG_MM_COMPACT_INTERVAL > 0
+#include <tinyara/clock.h>
+#include <tinyara/mm/mm.h>
+#endif
 
 #include "sched/sched.h"
 
@@ -75,6 +79,12 @@
  * Private Variables
  ****************************************************************************/
 
+#if defined(CONFIG_MM_COMPACT) && CONFIG_MM_COMPACT_INTERVAL > 0
+/* The time of the last background heap compaction */
+
+static clock_t g_last_compaction;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -172,6 +182,43 @@ static inline void sched_kcleanup(void)
 #define sched_kcleanup()
 #endif
 
+/****************************************************************************
+ * Name: sched_compaction
+ *
+ * Description:
+ *   Compact the heaps if CONFIG_MM_COMPACT_INTERVAL seconds have passed
+ *   since the last compaction.
+ *
+ * Input parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_MM_COMPACT) && CONFIG_MM_COMPACT_INTERVAL > 0
+static inline void sched_compaction(void)
+{
+	clock_t now = clock_systimer();
+
+	if (now - g_last_compaction < SEC2TICK(CONFIG_MM_COMPACT_INTERVAL)) {
+		return;
+	}
+
+	g_last_compaction = now;
+
+#if !defined(CONFIG_BUILD_PROTECTED) && !defined(CONFIG_BUILD_KERNEL)
+	(void)umm_compact();
+#endif
+#ifdef CONFIG_MM_KERNEL_HEAP
+	(void)kmm_compact();
+#endif
+}
+#else
+#define sched_compaction()
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -206,4 +253,8 @@ void sched_garbagecollection(void)
 	/* Handle deferred dealloctions for the user heap */
 
 	sched_kucleanup();
+
+	/* Then compact the heaps from time to time */
+
+	sched_compaction();
 }
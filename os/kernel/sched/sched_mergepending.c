@@ -109,6 +109,35 @@
  *
  ************************************************************************/
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+bool sched_mergepending(void)
+{
+	FAR struct tcb_s *rtrtcb = this_task();
+	FAR struct tcb_s *pndtcb;
+	bool ret = false;
+
+	/* Move every TCB from the g_pendingtasks list, highest priority first.
+	 * The index finds the spot in the g_readytorun list of each one.
+	 */
+
+	while ((pndtcb = (FAR struct tcb_s *)g_pendingtasks.head) != NULL) {
+		sched_removeprioritized(pndtcb, (FAR dq_queue_t *)&g_pendingtasks);
+
+		if (sched_prioindex_add(pndtcb, (FAR dq_queue_t *)&g_readytorun)) {
+			/* pndtcb is the new head of the list */
+
+			rtrtcb->task_state = TSTATE_TASK_READYTORUN;
+			pndtcb->task_state = TSTATE_TASK_RUNNING;
+			rtrtcb = pndtcb;
+			ret = true;
+		} else {
+			pndtcb->task_state = TSTATE_TASK_READYTORUN;
+		}
+	}
+
+	return ret;
+}
+#else
 bool sched_mergepending(void)
 {
 	FAR struct tcb_s *pndtcb;
@@ -177,3 +206,4 @@ bool sched_mergepending(void)
 
 	return ret;
 }
+#endif
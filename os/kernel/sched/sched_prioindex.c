@@ -0,0 +1,227 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/sched/sched_prioindex.c
+ *
+ * Priority index of the g_readytorun and g_pendingtasks lists.
+ *
+ * The lists stay sorted by priority, with the tasks of one priority in FIFO
+ * order.  The index remembers the last task of each priority in the list
+ * and has a bitmap of the priorities that are present.  A task of priority
+ * p belongs right after the last task of the lowest present priority that
+ * is not below p, which is found with a count leading zeros search of the
+ * bitmap, or at the head of the list if there is none.
+ *
+ * The bitmap is ordered for that search: priority p is bit (31 - p % 32)
+ * of word p / 32, so the lowest priority of a word is its leading bit.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sched.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PRIOINDEX_NWORDS      ((SCHED_PRIORITY_MAX >> 5) + 1)
+#define PRIOINDEX_BIT(prio)   (0x80000000 >> ((prio) & 31))
+
+/****************************************************************************
+ * Private Type Declarations
+ ****************************************************************************/
+
+struct sched_prioindex_s {
+	uint32_t bitmap[PRIOINDEX_NWORDS];	/* Priorities present in the list */
+	FAR struct tcb_s *last[SCHED_PRIORITY_MAX + 1];	/* Last task of each priority */
+};
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+
+static struct sched_prioindex_s g_readytorun_index;
+static struct sched_prioindex_s g_pendingtasks_index;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_prioindex
+ *
+ * Description:
+ *   Return the index of a task list or NULL if the list has no index.
+ *
+ ****************************************************************************/
+
+static inline FAR struct sched_prioindex_s *sched_prioindex(DSEG dq_queue_t *list)
+{
+	if (list == (FAR dq_queue_t *)&g_readytorun) {
+		return &g_readytorun_index;
+	} else if (list == (FAR dq_queue_t *)&g_pendingtasks) {
+		return &g_pendingtasks_index;
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_find
+ *
+ * Description:
+ *   Return the lowest priority present in the list that is not below
+ *   'prio', or -1 if there is none.
+ *
+ ****************************************************************************/
+
+static inline int sched_prioindex_find(FAR struct sched_prioindex_s *index, int prio)
+{
+	int word = prio >> 5;
+	uint32_t bits;
+
+	/* Ignore the priorities below 'prio' in its own word */
+
+	bits = index->bitmap[word] & (0xffffffff >> (prio & 31));
+	while (bits == 0) {
+		if (++word >= PRIOINDEX_NWORDS) {
+			return -1;
+		}
+
+		bits = index->bitmap[word];
+	}
+
+	return (word << 5) + __builtin_clz(bits);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_prioindex_add
+ *
+ * Description:
+ *   Insert a TCB into g_readytorun or g_pendingtasks after all tasks of
+ *   higher or the same priority.  This is sched_addprioritized() for the
+ *   two indexed lists, with the same assumptions.
+ *
+ * Inputs:
+ *   tcb - Points to the TCB to add
+ *   list - g_readytorun or g_pendingtasks
+ *
+ * Return Value:
+ *   true if the head of the list has changed.
+ *
+ ****************************************************************************/
+
+bool sched_prioindex_add(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
+{
+	FAR struct sched_prioindex_s *index = sched_prioindex(list);
+	FAR struct tcb_s *prev;
+	FAR struct tcb_s *next;
+	int prio = tcb->sched_priority;
+	int found;
+
+	DEBUGASSERT(index != NULL);
+
+	found = sched_prioindex_find(index, prio);
+	if (found < 0) {
+		/* No task of higher or the same priority: insert at the head */
+
+		prev = NULL;
+		next = (FAR struct tcb_s *)list->head;
+		list->head = (FAR dq_entry_t *)tcb;
+	} else {
+		prev = index->last[found];
+		next = prev->flink;
+		prev->flink = tcb;
+	}
+
+	if (next) {
+		next->blink = tcb;
+	} else {
+		list->tail = (FAR dq_entry_t *)tcb;
+	}
+
+	tcb->flink = next;
+	tcb->blink = prev;
+
+	/* The new TCB is the last one of its priority now */
+
+	index->last[prio] = tcb;
+	index->bitmap[prio >> 5] |= PRIOINDEX_BIT(prio);
+
+	return prev == NULL;
+}
+
+/****************************************************************************
+ * Name: sched_removeprioritized
+ *
+ * Description:
+ *   Remove a TCB from the task list it is in, prioritized or not.  This is
+ *   the counterpart of sched_addprioritized() that keeps the indexes of
+ *   g_readytorun and g_pendingtasks up to date.  The priority of the TCB
+ *   must be the same as when it was added.
+ *
+ * Inputs:
+ *   tcb - Points to the TCB to remove
+ *   list - The task list of the TCB
+ *
+ * Assumptions:
+ * - The caller has established a critical section before calling this
+ *   function.
+ *
+ ****************************************************************************/
+
+void sched_removeprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
+{
+	FAR struct sched_prioindex_s *index = sched_prioindex(list);
+	FAR struct tcb_s *prev = tcb->blink;
+	int prio = tcb->sched_priority;
+
+	if (index && index->last[prio] == tcb) {
+		/* The previous TCB is the last one of the priority if it has the
+		 * same priority, otherwise the priority is not in the list any more.
+		 */
+
+		if (prev && prev->sched_priority == prio) {
+			index->last[prio] = prev;
+		} else {
+			index->last[prio] = NULL;
+			index->bitmap[prio >> 5] &= ~PRIOINDEX_BIT(prio);
+		}
+	}
+
+	dq_rem((FAR dq_entry_t *)tcb, list);
+}
+
+#endif							/* CONFIG_SCHED_PRIORITY_BITMAP */
@@ -66,10 +66,11 @@
 #include "sched/sched.h"
 #include "group/group.h"
 #include "timer/timer.h"
+#include "semaphore/semaphore.h"
 #if defined(CONFIG_ENABLE_STACKMONITOR) && defined(CONFIG_DEBUG)
 #include <apps/system/utils.h>
 #endif
-#ifdef CONFIG_DEBUG_MM_HEAPINFO
+#if defined(CONFIG_DEBUG_MM_HEAPINFO) || defined(CONFIG_MM_TLCACHE)
 #include <tinyara/mm/mm.h>
 #endif
 
@@ -162,6 +163,24 @@ int sched_releasetcb(FAR struct tcb_s *tcb, uint8_t ttype)
 		}
 #endif
 
+#ifdef CONFIG_MM_TLCACHE
+		/* Return the chunks held in the thread's allocation cache */
+
+		umm_tlcache_release(tcb);
+#endif
+
+#ifdef CONFIG_SEM_HOLDER_INDEX
+		/* Free the holder records of the semaphores that it still holds */
+
+		sem_freeholders(tcb);
+#endif
+
+#ifdef CONFIG_SCHED_CPUACCT
+		/* Stop charging the CPU time to the thread */
+
+		sched_cpuacct_release(tcb);
+#endif
+
 		/* Release the task's process ID if one was assigned.  PID
 		 * zero is reserved for the IDLE task.  The TCB of the IDLE
 		 * task is never release so a value of zero simply means that
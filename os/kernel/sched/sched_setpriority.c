@@ -161,9 +161,19 @@ int sched_setpriority(FAR struct tcb_s *tcb, int sched_priority)
 		/* Otherwise, we can just change priority since it has no effect */
 
 		else {
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+			/* The task stays at the head, but the index has to move it to
+			 * its new priority.
+			 */
+
+			sched_removeprioritized(tcb, (FAR dq_queue_t *)&g_readytorun);
+			tcb->sched_priority = (uint8_t)sched_priority;
+			(void)sched_addprioritized(tcb, (FAR dq_queue_t *)&g_readytorun);
+#else
 			/* Change the task priority */
 
 			tcb->sched_priority = (uint8_t)sched_priority;
+#endif
 		}
 		break;
 
@@ -213,7 +223,7 @@ int sched_setpriority(FAR struct tcb_s *tcb, int sched_priority)
 		if (g_tasklisttable[task_state].prioritized) {
 			/* Remove the TCB from the prioritized task list */
 
-			dq_rem((FAR dq_entry_t *)tcb, (FAR dq_queue_t *)g_tasklisttable[task_state].list);
+			sched_removeprioritized(tcb, (FAR dq_queue_t *)g_tasklisttable[task_state].list);
 
 			/* Change the task priority */
 
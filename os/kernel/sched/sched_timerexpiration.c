@@ -131,6 +131,10 @@ uint32_t g_oneshot_maxticks = UINT32_MAX;
 
 static unsigned int g_timer_interval;
 
+/* The number of times that the timer expired, see sched_timer_wakeups() */
+
+static uint32_t g_timer_nwakeups;
+
 #ifdef CONFIG_SCHED_TICKLESS_ALARM
 /* This is the time that the timer was stopped.  All future times are
  * calculated against this time.  It must be valid at all times when
@@ -367,6 +371,10 @@ static unsigned int sched_process_timeslice(unsigned int ticks, bool noswitches)
  *   The number of ticks to use when setting up the next timer.  Zero if
  *   there is no interesting event to be timed.
  *
+ *   With CONFIG_SCHED_TICKLESS_SLACK, the delay for the watchdogs is the
+ *   latest that the watchdogs due next accept, see wd_timer().  An earlier
+ *   time slice event handles the watchdogs that are due by then as well.
+ *
  ****************************************************************************/
 
 static unsigned int sched_timer_process(unsigned int ticks, bool noswitches)
@@ -517,6 +525,7 @@ void sched_alarm_expiration(FAR const struct timespec *ts)
 
 	g_stop_time.tv_sec = ts->tv_sec;
 	g_stop_time.tv_nsec = ts->tv_nsec;
+	g_timer_nwakeups++;
 
 	/* Get the interval associated with last expiration */
 
@@ -556,6 +565,7 @@ void sched_timer_expiration(void)
 
 	elapsed = g_timer_interval;
 	g_timer_interval = 0;
+	g_timer_nwakeups++;
 
 	/* Process the timer ticks and set up the next interval (or not) */
 
@@ -683,6 +693,27 @@ void sched_timer_resume(void)
 	sched_timer_start(nexttime);
 }
 
+/****************************************************************************
+ * Name:  sched_timer_wakeups
+ *
+ * Description:
+ *   Return the number of times that the interval timer expired since boot.
+ *   Each expiration is one wakeup of the CPU, so the rate of the count
+ *   shows how well the timer events are batched.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The number of expirations.  The count wraps around.
+ *
+ ****************************************************************************/
+
+uint32_t sched_timer_wakeups(void)
+{
+	return g_timer_nwakeups;
+}
+
 /****************************************************************************
  * Name:  sched_timer_reassess
  *
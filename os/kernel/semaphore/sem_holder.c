@@ -106,7 +106,7 @@ static FAR struct semholder_s *g_freeholders;
  * Name: sem_allocholder
  ****************************************************************************/
 
-static inline FAR struct semholder_s *sem_allocholder(sem_t *sem)
+static inline FAR struct semholder_s *sem_allocholder(sem_t *sem, FAR struct tcb_s *htcb)
 {
 	FAR struct semholder_s *pholder;
 
@@ -126,6 +126,25 @@ static inline FAR struct semholder_s *sem_allocholder(sem_t *sem)
 		pholder->flink = sem->hhead;
 		sem->hhead = pholder;
 
+#ifdef CONFIG_SEM_HOLDER_INDEX
+		/* And into the list of the holder thread */
+
+		pholder->blink = NULL;
+		if (pholder->flink) {
+			pholder->flink->blink = pholder;
+		}
+
+		pholder->tblink = NULL;
+		pholder->tflink = htcb->holdhead;
+		if (pholder->tflink) {
+			pholder->tflink->tblink = pholder;
+		}
+
+		htcb->holdhead = pholder;
+		pholder->sem = sem;
+		pholder->htcb = htcb;
+#endif
+
 		/* Make sure the initial count is zero */
 
 		pholder->counts = 0;
@@ -151,6 +170,26 @@ static inline FAR struct semholder_s *sem_allocholder(sem_t *sem)
 static FAR struct semholder_s *sem_findholder(sem_t *sem, FAR struct tcb_s *htcb)
 {
 	FAR struct semholder_s *pholder;
+#ifdef CONFIG_SEM_HOLDER_INDEX
+	FAR struct semholder_s *tholder;
+
+	/* The holder is in the list of the semaphore and in the list of the
+	 * thread.  Search both side by side; it is not there if either list ends
+	 * without it.
+	 */
+
+	for (pholder = sem->hhead, tholder = htcb->holdhead; pholder && tholder; pholder = pholder->flink, tholder = tholder->tflink) {
+		if (pholder->htcb == htcb) {
+			return pholder;
+		}
+
+		if (tholder->sem == sem) {
+			return tholder;
+		}
+	}
+
+	return NULL;
+#else
 
 	/* Try to find the holder in the list of holders associated with this
 	 * semaphore
@@ -172,6 +211,7 @@ static FAR struct semholder_s *sem_findholder(sem_t *sem, FAR struct tcb_s *htcb
 	/* The holder does not appear in the list */
 
 	return NULL;
+#endif
 }
 
 /****************************************************************************
@@ -182,7 +222,7 @@ static inline FAR struct semholder_s *sem_findorallocateholder(sem_t *sem, FAR s
 {
 	FAR struct semholder_s *pholder = sem_findholder(sem, htcb);
 	if (!pholder) {
-		pholder = sem_allocholder(sem);
+		pholder = sem_allocholder(sem, htcb);
 	}
 
 	return pholder;
@@ -194,6 +234,38 @@ static inline FAR struct semholder_s *sem_findorallocateholder(sem_t *sem, FAR s
 
 static inline void sem_freeholder(sem_t *sem, FAR struct semholder_s *pholder)
 {
+#ifdef CONFIG_SEM_HOLDER_INDEX
+	/* Remove the holder from both of its lists */
+
+	if (pholder->blink) {
+		pholder->blink->flink = pholder->flink;
+	} else {
+		sem->hhead = pholder->flink;
+	}
+
+	if (pholder->flink) {
+		pholder->flink->blink = pholder->blink;
+	}
+
+	if (pholder->tblink) {
+		pholder->tblink->tflink = pholder->tflink;
+	} else {
+		pholder->htcb->holdhead = pholder->tflink;
+	}
+
+	if (pholder->tflink) {
+		pholder->tflink->tblink = pholder->tblink;
+	}
+
+	/* Release the holder and counts and put it in the free list */
+
+	pholder->htcb = NULL;
+	pholder->counts = 0;
+	pholder->sem = NULL;
+
+	pholder->flink = g_freeholders;
+	g_freeholders = pholder;
+#else
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
 	FAR struct semholder_s *curr;
 	FAR struct semholder_s *prev;
@@ -224,6 +296,7 @@ static inline void sem_freeholder(sem_t *sem, FAR struct semholder_s *pholder)
 		g_freeholders = pholder;
 	}
 #endif
+#endif
 }
 
 /****************************************************************************
@@ -559,6 +632,7 @@ static int sem_restoreholderprioA(FAR struct semholder_s *pholder, FAR sem_t *se
  *
  ****************************************************************************/
 
+#ifndef CONFIG_SEM_HOLDER_INDEX
 static int sem_restoreholderprioB(FAR struct semholder_s *pholder, FAR sem_t *sem, FAR void *arg)
 {
 	FAR struct tcb_s *rtcb = this_task();
@@ -569,6 +643,7 @@ static int sem_restoreholderprioB(FAR struct semholder_s *pholder, FAR sem_t *se
 
 	return 0;
 }
+#endif
 
 /****************************************************************************
  * Name: sem_restorebaseprio_irq
@@ -686,7 +761,14 @@ static inline void sem_restorebaseprio_task(FAR struct tcb_s *stcb, FAR sem_t *s
 
 		/* Now, find an reprioritize only the ready to run task */
 
+#ifdef CONFIG_SEM_HOLDER_INDEX
+		pholder = sem_findholder(sem, rtcb);
+		if (pholder) {
+			(void)sem_restoreholderprio(pholder, sem, stcb);
+		}
+#else
 		(void)sem_foreachholder(sem, sem_restoreholderprioB, stcb);
+#endif
 	}
 
 	/* If there are no tasks waiting for available counts, then all holders
@@ -1009,6 +1091,40 @@ void sem_canceled(FAR struct tcb_s *stcb, FAR sem_t *sem)
 }
 #endif
 
+/****************************************************************************
+ * Name: sem_freeholders
+ *
+ * Description:
+ *   Called from sched_releasetcb() to free the holder records of the
+ *   semaphores that a thread still held when it exited.  Its counts are
+ *   lost, but the records no longer point to the released TCB.
+ *
+ * Parameters:
+ *   tcb - The TCB of the thread being released
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_HOLDER_INDEX
+void sem_freeholders(FAR struct tcb_s *tcb)
+{
+	FAR struct semholder_s *pholder;
+	irqstate_t flags;
+
+	flags = irqsave();
+	while ((pholder = tcb->holdhead) != NULL) {
+		sdbg("TCB 0x%08x released holding counts\n", tcb);
+		sem_freeholder(pholder->sem, pholder);
+	}
+
+	irqrestore(flags);
+}
+#endif
+
 /****************************************************************************
  * Name: sem_enumholders
  *
@@ -120,6 +120,9 @@ void sem_canceled(FAR struct tcb_s *stcb, FAR sem_t *sem);
 #else
 #define sem_canceled(stcb, sem)
 #endif
+#ifdef CONFIG_SEM_HOLDER_INDEX
+void sem_freeholders(FAR struct tcb_s *tcb);
+#endif
 #else
 #define sem_initholders()
 #define sem_destroyholder(sem)
@@ -142,4 +142,8 @@ void sig_release(FAR struct task_group_s *group)
 	while ((sigpend = (FAR sigpendq_t *)sq_remfirst(&group->sigpendingq)) != NULL) {
 		sig_releasependingsignal(sigpend);
 	}
+
+#ifdef CONFIG_SIG_PENDING_BITMAP
+	group->sigpendingset = NULL_SIGNAL_SET;
+#endif
 }
@@ -56,6 +56,7 @@
 
 #include <tinyara/config.h>
 
+#include <stdbool.h>
 #include <string.h>
 #include <signal.h>
 #include <unistd.h>
@@ -230,6 +231,56 @@ static FAR sigpendq_t *sig_findpendingsignal(FAR struct task_group_s *group, int
 	return sigpend;
 }
 
+/****************************************************************************
+ * Name: sig_addpendingbit
+ *
+ * Description:
+ *   Add a signal sent by kill() to the pending signal bitmap, unless the
+ *   signal is already pending in the list.  The information of such a
+ *   signal is given by its number and its sender.
+ *
+ * Returned Value:
+ *   true if the signal is pending in the bitmap; false if it must be added
+ *   to the list.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIG_PENDING_BITMAP
+static bool sig_addpendingbit(FAR struct task_group_s *group, FAR siginfo_t *info)
+{
+	irqstate_t saved_state;
+	bool inbitmap;
+
+	inbitmap = (info->si_code == SI_USER && info->si_value.sival_ptr == NULL);
+
+	saved_state = irqsave();
+
+	if (sigismember(&group->sigpendingset, info->si_signo)) {
+		/* The signal is already pending in the bitmap.  A signal with a
+		 * value takes its place in the list.
+		 */
+
+		if (!inbitmap) {
+			sigdelset(&group->sigpendingset, info->si_signo);
+		}
+	} else if (inbitmap && !sq_empty(&group->sigpendingq)) {
+		/* The list keeps the signal if it is already there */
+
+		inbitmap = (sig_findpendingsignal(group, info->si_signo) == NULL);
+	}
+
+	if (inbitmap) {
+		sigaddset(&group->sigpendingset, info->si_signo);
+#ifdef CONFIG_SCHED_HAVE_PARENT
+		group->sigpendingpid[info->si_signo] = info->si_pid;
+#endif
+	}
+
+	irqrestore(saved_state);
+	return inbitmap;
+}
+#endif
+
 /****************************************************************************
  * Name: sig_addpendingsignal
  *
@@ -239,9 +290,13 @@ static FAR sigpendq_t *sig_findpendingsignal(FAR struct task_group_s *group, int
  *   was done intentionally so that a run-away sender cannot consume
  *   all of memory.
  *
+ * Returned Value:
+ *   Returns 0 (OK) on success or -ENOMEM if no pending signal entry could
+ *   be allocated.
+ *
  ****************************************************************************/
 
-static FAR sigpendq_t *sig_addpendingsignal(FAR struct tcb_s *stcb, FAR siginfo_t *info)
+static int sig_addpendingsignal(FAR struct tcb_s *stcb, FAR siginfo_t *info)
 {
 	FAR struct task_group_s *group = stcb->group;
 	FAR sigpendq_t *sigpend;
@@ -249,6 +304,16 @@ static FAR sigpendq_t *sig_addpendingsignal(FAR struct tcb_s *stcb, FAR siginfo_
 
 	DEBUGASSERT(group);
 
+#ifdef CONFIG_SIG_PENDING_BITMAP
+	/* Signals sent by kill() only need their bit, as long as the list does
+	 * not hold the same signal.
+	 */
+
+	if (sig_addpendingbit(group, info)) {
+		return OK;
+	}
+#endif
+
 	/* Check if the signal is already pending */
 
 	sigpend = sig_findpendingsignal(group, info->si_signo);
@@ -264,20 +329,22 @@ static FAR sigpendq_t *sig_addpendingsignal(FAR struct tcb_s *stcb, FAR siginfo_
 		/* Allocate a new pending signal entry */
 
 		sigpend = sig_allocatependingsignal();
-		if (sigpend) {
-			/* Put the signal information into the allocated structure */
+		if (!sigpend) {
+			return -ENOMEM;
+		}
 
-			memcpy(&sigpend->info, info, sizeof(siginfo_t));
+		/* Put the signal information into the allocated structure */
 
-			/* Add the structure to the pending signal list */
+		memcpy(&sigpend->info, info, sizeof(siginfo_t));
 
-			saved_state = irqsave();
-			sq_addlast((FAR sq_entry_t *)sigpend, &group->sigpendingq);
-			irqrestore(saved_state);
-		}
+		/* Add the structure to the pending signal list */
+
+		saved_state = irqsave();
+		sq_addlast((FAR sq_entry_t *)sigpend, &group->sigpendingq);
+		irqrestore(saved_state);
 	}
 
-	return sigpend;
+	return OK;
 }
 
 /****************************************************************************
@@ -341,7 +408,7 @@ int sig_tcbdispatch(FAR struct tcb_s *stcb, siginfo_t *info)
 
 		else {
 			irqrestore(saved_state);
-			ASSERT(sig_addpendingsignal(stcb, info));
+			VERIFY(sig_addpendingsignal(stcb, info));
 		}
 	}
 
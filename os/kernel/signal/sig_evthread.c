@@ -0,0 +1,191 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/signal/sig_evthread.c
+ *
+ * SIGEV_THREAD notification.  The notification function is called on a
+ * work queue instead of sending a signal.  The function and the value of
+ * the timer or the aiocb that notifies are copied into a preallocated work
+ * structure when the notification is queued, so the notifying object may
+ * be released at any time.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <signal.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/signal.h>
+#include <tinyara/wqueue.h>
+
+#ifdef CONFIG_SIG_EVTHREAD
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A queued notification.  The entry is free when func is NULL. */
+
+struct sig_evwork_s {
+	struct work_s work;			/* Work queue entry */
+	FAR struct sigwork_s *owner;	/* Notifying object, NULL once canceled */
+	union sigval value;			/* Value passed to the function */
+	sigev_notify_function_t func;	/* Notification function */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct sig_evwork_s g_sig_evwork[CONFIG_SIG_EVTHREAD_NWORK];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sig_evthread_worker
+ *
+ * Description:
+ *   Free the work structure and call the notification function on the
+ *   work queue thread.
+ *
+ ****************************************************************************/
+
+static void sig_evthread_worker(FAR void *arg)
+{
+	FAR struct sig_evwork_s *evwork = (FAR struct sig_evwork_s *)arg;
+	sigev_notify_function_t func;
+	union sigval value;
+	irqstate_t flags;
+
+	DEBUGASSERT(evwork && evwork->func);
+
+	flags = irqsave();
+	func = evwork->func;
+	value = evwork->value;
+	evwork->owner = NULL;
+	evwork->func = NULL;
+	irqrestore(flags);
+
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	func(value);
+#else
+	func(value.sival_ptr);
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sig_evthread
+ ****************************************************************************/
+
+int sig_evthread(FAR struct sigwork_s *work)
+{
+	FAR struct sig_evwork_s *evwork = NULL;
+	irqstate_t flags;
+	int ret;
+	int i;
+
+	DEBUGASSERT(work);
+
+	if (work->func == NULL) {
+		return -EINVAL;
+	}
+
+	flags = irqsave();
+
+	/* A notification that is still queued is delivered only once, like a
+	 * signal that is already pending.
+	 */
+
+	for (i = 0; i < CONFIG_SIG_EVTHREAD_NWORK; i++) {
+		if (g_sig_evwork[i].owner == work && !work_available(&g_sig_evwork[i].work)) {
+			irqrestore(flags);
+			return OK;
+		}
+
+		if (evwork == NULL && g_sig_evwork[i].func == NULL) {
+			evwork = &g_sig_evwork[i];
+		}
+	}
+
+	if (evwork == NULL) {
+		irqrestore(flags);
+		return -ENOMEM;
+	}
+
+	evwork->owner = work;
+	evwork->value = work->value;
+	evwork->func = work->func;
+
+	ret = work_queue(SIG_EVTHREAD_WORK, &evwork->work, sig_evthread_worker, evwork, 0);
+	if (ret < 0) {
+		evwork->owner = NULL;
+		evwork->func = NULL;
+	}
+
+	irqrestore(flags);
+	return ret;
+}
+
+/****************************************************************************
+ * Name: sig_cancel_evthread
+ ****************************************************************************/
+
+void sig_cancel_evthread(FAR struct sigwork_s *work)
+{
+	FAR struct sig_evwork_s *evwork;
+	irqstate_t flags;
+	int i;
+
+	DEBUGASSERT(work);
+
+	flags = irqsave();
+	for (i = 0; i < CONFIG_SIG_EVTHREAD_NWORK; i++) {
+		evwork = &g_sig_evwork[i];
+		if (evwork->owner != work) {
+			continue;
+		}
+
+		/* A notification that was already taken from the work queue has its
+		 * own copy of the function and the value, so it only forgets the
+		 * owner.
+		 */
+
+		if (work_cancel(SIG_EVTHREAD_WORK, &evwork->work) == OK) {
+			evwork->func = NULL;
+		}
+
+		evwork->owner = NULL;
+	}
+
+	irqrestore(flags);
+}
+
+#endif							/* CONFIG_SIG_EVTHREAD */
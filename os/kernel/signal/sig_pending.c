@@ -121,7 +121,8 @@ int sigpending(FAR sigset_t *set)
  * Name: sig_pendingset
  *
  * Description:
- *   Convert the list of pending signals into a signal set
+ *   Convert the list of pending signals into a signal set, together with
+ *   the pending signal bitmap.
  *
  ****************************************************************************/
 
@@ -134,9 +135,14 @@ sigset_t sig_pendingset(FAR struct tcb_s *stcb)
 
 	DEBUGASSERT(group);
 
+	saved_state = irqsave();
+
+#ifdef CONFIG_SIG_PENDING_BITMAP
+	sigpendset = group->sigpendingset;
+#else
 	sigpendset = NULL_SIGNAL_SET;
+#endif
 
-	saved_state = irqsave();
 	for (sigpend = (FAR sigpendq_t *)group->sigpendingq.head; (sigpend); sigpend = sigpend->flink) {
 		sigaddset(&sigpendset, sigpend->info.si_signo);
 	}
@@ -56,8 +56,10 @@
 
 #include <tinyara/config.h>
 
+#include <string.h>
 #include <unistd.h>
 #include <signal.h>
+#include <errno.h>
 #include <time.h>
 #include <assert.h>
 #include <debug.h>
@@ -97,11 +99,20 @@
  * Name: sig_removependingsignal
  *
  * Description:
- *   Remove the specified signal from the signal pending list
+ *   Remove the specified signal from the signals pending for the group
+ *   of the task, return its information and release its entry.
+ *
+ * Parameters:
+ *   stcb  - A task of the group
+ *   signo - The signal to remove
+ *   info  - The location to return the signal information, or NULL
+ *
+ * Return Value:
+ *   0 (OK) if the signal was pending; -ENOENT otherwise.
  *
  ************************************************************************/
 
-FAR sigpendq_t *sig_removependingsignal(FAR struct tcb_s *stcb, int signo)
+int sig_removependingsignal(FAR struct tcb_s *stcb, int signo, FAR siginfo_t *info)
 {
 	FAR struct task_group_s *group = stcb->group;
 	FAR sigpendq_t *currsig;
@@ -112,6 +123,26 @@ FAR sigpendq_t *sig_removependingsignal(FAR struct tcb_s *stcb, int signo)
 
 	saved_state = irqsave();
 
+#ifdef CONFIG_SIG_PENDING_BITMAP
+	/* A signal of the bitmap was sent by kill() */
+
+	if (sigismember(&group->sigpendingset, signo)) {
+		sigdelset(&group->sigpendingset, signo);
+		if (info) {
+			info->si_signo = signo;
+			info->si_code = SI_USER;
+			info->si_value.sival_ptr = NULL;
+#ifdef CONFIG_SCHED_HAVE_PARENT
+			info->si_pid = group->sigpendingpid[signo];
+			info->si_status = OK;
+#endif
+		}
+
+		irqrestore(saved_state);
+		return OK;
+	}
+#endif
+
 	for (prevsig = NULL, currsig = (FAR sigpendq_t *)group->sigpendingq.head; (currsig && currsig->info.si_signo != signo); prevsig = currsig, currsig = currsig->flink) ;
 
 	if (currsig) {
@@ -124,5 +155,14 @@ FAR sigpendq_t *sig_removependingsignal(FAR struct tcb_s *stcb, int signo)
 
 	irqrestore(saved_state);
 
-	return currsig;
+	if (!currsig) {
+		return -ENOENT;
+	}
+
+	if (info) {
+		memcpy(info, &currsig->info, sizeof(siginfo_t));
+	}
+
+	sig_releasependingsignal(currsig);
+	return OK;
 }
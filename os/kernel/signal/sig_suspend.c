@@ -131,7 +131,6 @@ int sigsuspend(FAR const sigset_t *set)
 	FAR struct tcb_s *rtcb = this_task();
 	sigset_t intersection;
 	sigset_t saved_sigprocmask;
-	FAR sigpendq_t *sigpend;
 	irqstate_t saved_state;
 	int unblocksigno;
 
@@ -159,10 +158,7 @@ int sigsuspend(FAR const sigset_t *set)
 		 */
 
 		unblocksigno = sig_lowest(&intersection);
-		sigpend = sig_removependingsignal(rtcb, unblocksigno);
-		ASSERT(sigpend);
-
-		sig_releasependingsignal(sigpend);
+		VERIFY(sig_removependingsignal(rtcb, unblocksigno, NULL));
 		irqrestore(saved_state);
 	} else {
 		/* Its time to wait. Save a copy of the old sigprocmask and install
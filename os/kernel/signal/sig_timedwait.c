@@ -191,7 +191,6 @@ int sigtimedwait(FAR const sigset_t *set, FAR struct siginfo *info, FAR const st
 {
 	FAR struct tcb_s *rtcb = this_task();
 	sigset_t intersection;
-	FAR sigpendq_t *sigpend;
 	irqstate_t saved_state;
 	int32_t waitticks;
 	int ret = ERROR;
@@ -222,22 +221,12 @@ int sigtimedwait(FAR const sigset_t *set, FAR struct siginfo *info, FAR const st
 		 * pending.
 		 */
 
-		sigpend = sig_removependingsignal(rtcb, sig_lowest(&intersection));
-		ASSERT(sigpend);
-
-		/* Return the signal info to the caller if so requested */
-
-		if (info) {
-			memcpy(info, &sigpend->info, sizeof(struct siginfo));
-		}
-
-		/* The return value is the number of the signal that awakened us */
-
-		ret = sigpend->info.si_signo;
-
-		/* Then dispose of the pending signal structure properly */
+		/* The return value is the number of the signal that awakened us.
+		 * Return the signal info to the caller if so requested.
+		 */
 
-		sig_releasependingsignal(sigpend);
+		ret = sig_lowest(&intersection);
+		VERIFY(sig_removependingsignal(rtcb, ret, info));
 		irqrestore(saved_state);
 	}
 
@@ -282,8 +271,9 @@ int sigtimedwait(FAR const sigset_t *set, FAR struct siginfo *info, FAR const st
 				wdparm_t wdparm;
 				wdparm.pvarg = (FAR void *)rtcb;
 
-				/* Start the watchdog */
+				/* Start the watchdog with the timer slack of the thread */
 
+				wd_setslack(rtcb->waitdog, rtcb->timerslack);
 				wd_start(rtcb->waitdog, waitticks, (wdentry_t)sig_timeout, 1, wdparm.dwarg);
 
 				/* Now wait for either the signal or the watchdog */
@@ -99,7 +99,7 @@ void sig_unmaskpendingsignal(void)
 {
 	FAR struct tcb_s *rtcb = this_task();
 	sigset_t unmaskedset;
-	FAR sigpendq_t *pendingsig;
+	siginfo_t info;
 	int signo;
 
 	/* Prohibit any context switches until we are done with this.
@@ -135,7 +135,7 @@ void sig_unmaskpendingsignal(void)
 
 			/* Remove the pending signal from the list of pending signals */
 
-			if ((pendingsig = sig_removependingsignal(rtcb, signo)) != NULL) {
+			if (sig_removependingsignal(rtcb, signo, &info) == OK) {
 				/* If there is one, then process it like a normal signal.
 				 * Since the signal was pending, then unblocked on this
 				 * thread, we can skip the normal group signal dispatching
@@ -143,11 +143,7 @@ void sig_unmaskpendingsignal(void)
 				 * other than this thread.
 				 */
 
-				sig_tcbdispatch(rtcb, &pendingsig->info);
-
-				/* Then remove it from the pending signal list */
-
-				sig_releasependingsignal(pendingsig);
+				sig_tcbdispatch(rtcb, &info);
 			}
 		}
 	}
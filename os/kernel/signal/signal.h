@@ -208,7 +208,7 @@ int sig_mqnotempty(int tid, int signo, FAR void *sival_ptr);
 #endif
 void sig_releasependingsigaction(FAR sigq_t *sigq);
 void sig_releasependingsignal(FAR sigpendq_t *sigpend);
-FAR sigpendq_t *sig_removependingsignal(FAR struct tcb_s *stcb, int signo);
+int sig_removependingsignal(FAR struct tcb_s *stcb, int signo, FAR siginfo_t *info);
 void sig_unmaskpendingsignal(void);
 
 #endif							/* __SCHED_SIGNAL_SIGNAL_H */
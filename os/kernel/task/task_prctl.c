@@ -58,11 +58,13 @@
 
 #include <sys/prctl.h>
 #include <stdarg.h>
+#include <limits.h>
 #include <string.h>
 #include <errno.h>
 #include <debug.h>
 
 #include <tinyara/sched.h>
+#include <tinyara/clock.h>
 #include <tinyara/ttrace.h>
 
 #include "sched/sched.h"
@@ -166,17 +168,69 @@ int prctl(int option, ...)
 	goto errout;
 #endif
 
+	case PR_SET_TIMERSLACK:
+	case PR_GET_TIMERSLACK:
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+	{
+		FAR struct tcb_s *tcb;
+		int pid;
+
+		/* The slack is passed by value and returned by reference */
+
+		if (option == PR_SET_TIMERSLACK) {
+			unsigned long usec = va_arg(ap, unsigned long);
+			unsigned long ticks;
+
+			pid = va_arg(ap, int);
+			tcb = pid ? sched_gettcb(pid) : this_task();
+			if (!tcb) {
+				sdbg("Pid does not correspond to a task: %d\n", pid);
+				err = ESRCH;
+				goto errout;
+			}
+
+			/* Round up to whole ticks */
+
+			ticks = usec / USEC_PER_TICK + (usec % USEC_PER_TICK != 0);
+			tcb->timerslack = ticks < INT_MAX ? (int)ticks : INT_MAX;
+		} else {
+			FAR unsigned long *usec = va_arg(ap, FAR unsigned long *);
+
+			pid = va_arg(ap, int);
+			tcb = pid ? sched_gettcb(pid) : this_task();
+			if (!tcb) {
+				sdbg("Pid does not correspond to a task: %d\n", pid);
+				err = ESRCH;
+				goto errout;
+			}
+
+			if (!usec) {
+				sdbg("No slack location provided\n");
+				err = EFAULT;
+				goto errout;
+			}
+
+			*usec = TICK2USEC((unsigned long)tcb->timerslack);
+		}
+	}
+	break;
+#else
+	sdbg("Option not enabled: %d\n", option);
+	err = ENOSYS;
+	goto errout;
+#endif
+
 	default:
 		sdbg("Unrecognized option: %d\n", option);
 		err = EINVAL;
 		goto errout;
 	}
 
-	/* Not reachable unless CONFIG_TASK_NAME_SIZE is > 0.  NOTE: This might
-	 * change if additional commands are supported.
+	/* Not reachable unless CONFIG_TASK_NAME_SIZE is > 0 or
+	 * CONFIG_SCHED_TICKLESS_SLACK is defined.
 	 */
 
-#if CONFIG_TASK_NAME_SIZE > 0
+#if CONFIG_TASK_NAME_SIZE > 0 || defined(CONFIG_SCHED_TICKLESS_SLACK)
 	va_end(ap);
 	trace_end(TTRACE_TAG_TASK);
 	return OK;
@@ -179,7 +179,7 @@ int task_restart(pid_t pid)
 		 */
 
 		state = irqsave();
-		dq_rem((FAR dq_entry_t *)tcb, (dq_queue_t *)g_tasklisttable[tcb->cmn.task_state].list);
+		sched_removeprioritized(&tcb->cmn, (dq_queue_t *)g_tasklisttable[tcb->cmn.task_state].list);
 		tcb->cmn.task_state = TSTATE_TASK_INVALID;
 		irqrestore(state);
 
@@ -64,6 +64,9 @@
 
 #include <tinyara/compiler.h>
 #include <tinyara/wdog.h>
+#ifdef CONFIG_SIG_EVTHREAD
+#include <tinyara/signal.h>
+#endif
 
 /********************************************************************************
  * Definitions
@@ -93,6 +96,9 @@ struct posix_timer_s {
 	int pt_last;				/* Last value used to set watchdog */
 	WDOG_ID pt_wdog;			/* The watchdog that provides the timing */
 	union sigval pt_value;		/* Data passed with notification */
+#ifdef CONFIG_SIG_EVTHREAD
+	struct sigwork_s pt_work;	/* SIGEV_THREAD notification if pt_work.func */
+#endif
 };
 
 #define PT_ISVALID(x)         (((x) != NULL) && (((struct posix_timer_s *)(x))->pt_flags & PT_FLAGS_INUSE))
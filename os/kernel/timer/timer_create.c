@@ -164,6 +164,10 @@ static struct posix_timer_s *timer_allocate(void)
  *   the sigev_signo having a default signal number, and the sigev_value member
  *   having the value of the timer ID.
  *
+ *   With CONFIG_SIG_EVTHREAD, a sigev_notify of SIGEV_THREAD calls the
+ *   sigev_notify_function with the sigev_value on a work queue at each
+ *   expiration instead of sending a signal.
+ *
  *   Each implementation defines a set of clocks that can be used as timing bases
  *   for per-thread timers. All implementations shall support a clock_id of
  *   CLOCK_REALTIME.
@@ -205,6 +209,13 @@ int timer_create(clockid_t clockid, FAR struct sigevent *evp, FAR timer_t *timer
 		return ERROR;
 	}
 
+#ifdef CONFIG_SIG_EVTHREAD
+	if (evp && evp->sigev_notify == SIGEV_THREAD && !evp->sigev_notify_function) {
+		set_errno(EINVAL);
+		return ERROR;
+	}
+#endif
+
 	/* Allocate a watchdog to provide the underling CLOCK_REALTIME timer */
 
 	wdog = wd_create();
@@ -236,6 +247,17 @@ int timer_create(clockid_t clockid, FAR struct sigevent *evp, FAR timer_t *timer
 #else
 		ret->pt_value.sival_ptr = evp->sigev_value.sival_ptr;
 #endif
+
+#ifdef CONFIG_SIG_EVTHREAD
+		/* The notification function is called instead of sending the
+		 * signal.  Other notification methods send the signal.
+		 */
+
+		if (evp->sigev_notify == SIGEV_THREAD) {
+			ret->pt_work.func = evp->sigev_notify_function;
+			ret->pt_work.value.sival_ptr = evp->sigev_value.sival_ptr;
+		}
+#endif
 	} else {
 		ret->pt_signo = SIGALRM;
 		ret->pt_value.sival_ptr = ret;
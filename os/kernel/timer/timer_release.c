@@ -163,6 +163,14 @@ int timer_release(FAR struct posix_timer_s *timer)
 
 	(void)wd_delete(timer->pt_wdog);
 
+#ifdef CONFIG_SIG_EVTHREAD
+	/* A notification that is still queued is not delivered */
+
+	if (timer->pt_work.func) {
+		sig_cancel_evthread(&timer->pt_work);
+	}
+#endif
+
 	/* Mark this timer is not in use before releasing the timer.
 	 * This prevents returning some value when timer API is called after release
 	 */
@@ -96,7 +96,8 @@ static void timer_timeout(int argc, uint32_t itimer);
  *
  * Description:
  *   This function basically reimplements sigqueue() so that the si_code can
- *   be correctly set to SI_TIMER
+ *   be correctly set to SI_TIMER.  A SIGEV_THREAD timer queues the call of
+ *   its notification function instead.
  *
  * Parameters:
  *   timer - A reference to the POSIX timer that just timed out
@@ -113,6 +114,13 @@ static inline void timer_sigqueue(FAR struct posix_timer_s *timer)
 {
 	siginfo_t info;
 
+#ifdef CONFIG_SIG_EVTHREAD
+	if (timer->pt_work.func) {
+		(void)sig_evthread(&timer->pt_work);
+		return;
+	}
+#endif
+
 	/* Create the siginfo structure */
 
 	info.si_signo = timer->pt_signo;
@@ -137,10 +137,11 @@ WDOG_ID wd_create(void)
 			DEBUGASSERT(g_wdnfree > 0);
 			g_wdnfree--;
 
-			/* Yes.. Clear the forward link and all flags */
+			/* Yes.. Clear the forward link, all flags and the slack */
 
 			wdog->next = NULL;
 			wdog->flags = 0;
+			wd_setslack(wdog, 0);
 		} else {
 			/* If wdog is Null, g_wdnfree must be zero, else assert */
 			DEBUGASSERT(g_wdnfree == 0);
@@ -162,10 +163,13 @@ WDOG_ID wd_create(void)
 		/* Did we get one? */
 
 		if (wdog) {
-			/* Yes.. Clear the forward link and set the allocated flag */
+			/* Yes.. Clear the forward link and the slack and set the
+			 * allocated flag
+			 */
 
 			wdog->next = NULL;
 			wdog->flags = WDOGF_ALLOCED;
+			wd_setslack(wdog, 0);
 		}
 	}
 
@@ -78,12 +78,14 @@
 
 sq_queue_t g_wdfreelist;
 
+#ifndef CONFIG_WDOG_TIMERWHEEL
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 sq_queue_t g_wdactivelist;
+#endif
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -137,7 +139,11 @@ void wd_initialize(void)
 	/* Initialize watchdog lists */
 
 	sq_init(&g_wdfreelist);
+#ifdef CONFIG_WDOG_TIMERWHEEL
+	wd_wheel_initialize();
+#else
 	sq_init(&g_wdactivelist);
+#endif
 
 	/* The g_wdfreelist must be loaded at initialization time to hold the
 	 * configured number of watchdogs.
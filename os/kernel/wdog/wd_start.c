@@ -59,6 +59,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdarg.h>
+#include <limits.h>
 #include <unistd.h>
 #include <sched.h>
 #include <assert.h>
@@ -111,6 +112,56 @@ typedef void (*wdentry4_t)(int argc, uint32_t arg1, uint32_t arg2, uint32_t arg3
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
+/****************************************************************************
+ * Name: wd_execute
+ *
+ * Description:
+ *   Execute the function of a watchdog that has been removed from the
+ *   active watchdogs.
+ *
+ ****************************************************************************/
+
+static inline void wd_execute(FAR struct wdog_s *wdog)
+{
+	/* Indicate that the watchdog is no longer active. */
+
+	WDOG_CLRACTIVE(wdog);
+
+	/* Execute the watchdog function */
+
+	up_setpicbase(wdog->picbase);
+	switch (wdog->argc) {
+	default:
+		DEBUGPANIC();
+		break;
+
+	case 0:
+		(*((wdentry0_t)(wdog->func)))(0);
+		break;
+
+#if CONFIG_MAX_WDOGPARMS > 0
+	case 1:
+		(*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
+		break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 1
+	case 2:
+		(*((wdentry2_t)(wdog->func)))(2, wdog->parm[0], wdog->parm[1]);
+		break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 2
+	case 3:
+		(*((wdentry3_t)(wdog->func)))(3, wdog->parm[0], wdog->parm[1], wdog->parm[2]);
+		break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 3
+	case 4:
+		(*((wdentry4_t)(wdog->func)))(4, wdog->parm[0], wdog->parm[1], wdog->parm[2], wdog->parm[3]);
+		break;
+#endif
+	}
+}
+
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -118,6 +169,9 @@ typedef void (*wdentry4_t)(int argc, uint32_t arg1, uint32_t arg2, uint32_t arg3
  *   Check if the timer for the watchdog at the head of list is ready to
  *   run.  If so, remove the watchdog from the list and execute it.
  *
+ *   With CONFIG_WDOG_TIMERWHEEL, execute all watchdogs that expire at the
+ *   current tick of the timer wheel instead.
+ *
  * Parameters:
  *   None
  *
@@ -132,6 +186,15 @@ static inline void wd_expiration(void)
 {
 	FAR struct wdog_s *wdog;
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+	/* The watchdogs are removed one at a time, so the function of one can
+	 * still cancel or restart the others.
+	 */
+
+	while ((wdog = wd_wheel_expired()) != NULL) {
+		wd_execute(wdog);
+	}
+#else
 	/* Check if the watchdog at the head of the list is ready to run */
 
 	if (((FAR struct wdog_s *)g_wdactivelist.head)->lag <= 0) {
@@ -152,46 +215,58 @@ static inline void wd_expiration(void)
 				((FAR struct wdog_s *)g_wdactivelist.head)->lag += wdog->lag;
 			}
 
-			/* Indicate that the watchdog is no longer active. */
+			/* Execute the watchdog function */
 
-			WDOG_CLRACTIVE(wdog);
+			wd_execute(wdog);
+		}
+	}
+#endif
+}
 
-			/* Execute the watchdog function */
+/****************************************************************************
+ * Name: wd_nextexpiration
+ *
+ * Description:
+ *   Return the delay for the next timer event.  That is the latest time at
+ *   which every active watchdog is still within its slack, so that all the
+ *   watchdogs that expire by then are handled with one timer event.  Only
+ *   the watchdogs that expire before that time need to be looked at.
+ *
+ * Return Value:
+ *   The delay in ticks; zero if there are no active watchdogs.
+ *
+ * Assumptions:
+ *   Called with interrupts disabled.
+ *
+ ****************************************************************************/
 
-			up_setpicbase(wdog->picbase);
-			switch (wdog->argc) {
-			default:
-				DEBUGPANIC();
-				break;
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+static inline unsigned int wd_nextexpiration(void)
+{
+	FAR struct wdog_s *wdog;
+	int expiry;
+	int latest;
 
-			case 0:
-				(*((wdentry0_t)(wdog->func)))(0);
-				break;
+	wdog = (FAR struct wdog_s *)g_wdactivelist.head;
+	if (wdog == NULL) {
+		return 0;
+	}
 
-#if CONFIG_MAX_WDOGPARMS > 0
-			case 1:
-				(*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
-				break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 1
-			case 2:
-				(*((wdentry2_t)(wdog->func)))(2, wdog->parm[0], wdog->parm[1]);
-				break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 2
-			case 3:
-				(*((wdentry3_t)(wdog->func)))(3, wdog->parm[0], wdog->parm[1], wdog->parm[2]);
-				break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 3
-			case 4:
-				(*((wdentry4_t)(wdog->func)))(4, wdog->parm[0], wdog->parm[1], wdog->parm[2], wdog->parm[3]);
-				break;
-#endif
-			}
+	expiry = wdog->lag;
+	latest = expiry + wdog->slack;
+	if (latest < expiry) {
+		latest = INT_MAX;
+	}
+
+	while ((wdog = wdog->next) != NULL && (expiry += wdog->lag) < latest) {
+		if (wdog->slack < latest - expiry) {
+			latest = expiry + wdog->slack;
 		}
 	}
+
+	return latest;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -233,10 +308,12 @@ static inline void wd_expiration(void)
 int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 {
 	va_list ap;
+#ifndef CONFIG_WDOG_TIMERWHEEL
 	FAR struct wdog_s *curr;
 	FAR struct wdog_s *prev;
 	FAR struct wdog_s *next;
 	int32_t now;
+#endif
 	irqstate_t state;
 	int i;
 
@@ -292,6 +369,11 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 	(void)sched_timer_cancel();
 #endif
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+	/* Hash the watchdog into the timer wheel by its expiration tick */
+
+	wd_wheel_add(wdog, delay);
+#else
 	/* Do the easy case first -- when the watchdog timer queue is empty. */
 
 	if (g_wdactivelist.head == NULL) {
@@ -363,9 +445,13 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 		}
 	}
 
-	/* Put the lag into the watchdog structure and mark it as active. */
+	/* Put the lag into the watchdog structure */
 
 	wdog->lag = delay;
+#endif
+
+	/* Mark the watchdog as active */
+
 	WDOG_SETACTIVE(wdog);
 
 #ifdef CONFIG_SCHED_TICKLESS
@@ -400,14 +486,48 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
  *   If CONFIG_SCHED_TICKLESS is defined then the number of ticks for the
  *   next delay is provided (zero if no delay).  Otherwise, this function
  *   has no returned value.
+ *   With CONFIG_SCHED_TICKLESS_SLACK, the delay is the latest time at which
+ *   the watchdogs that are due next are still within their slack.
  *
  * Assumptions:
  *   Called from interrupt handler logic with interrupts disabled.
  *
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
 #ifdef CONFIG_SCHED_TICKLESS
 unsigned int wd_timer(int ticks)
+{
+	/* Skip the ticks at which the wheel has nothing to do, then advance the
+	 * wheel by one tick and execute the watchdogs that expire.
+	 */
+
+	while (ticks > 0) {
+		ticks -= wd_wheel_skip(ticks);
+		if (ticks > 0) {
+			wd_wheel_tick();
+			wd_expiration();
+			ticks--;
+		}
+	}
+
+	/* Return the delay for the next tick at which the wheel has work to do.
+	 * That may be a tick at which watchdogs only move to a lower level.
+	 */
+
+	return wd_wheel_next();
+}
+
+#else
+void wd_timer(void)
+{
+	wd_wheel_tick();
+	wd_expiration();
+}
+#endif							/* CONFIG_SCHED_TICKLESS */
+
+#elif defined(CONFIG_SCHED_TICKLESS)
+unsigned int wd_timer(int ticks)
 {
 	FAR struct wdog_s *wdog;
 	int decr;
@@ -419,7 +539,7 @@ unsigned int wd_timer(int ticks)
 
 		wdog = (FAR struct wdog_s *)g_wdactivelist.head;
 
-#ifndef CONFIG_SCHED_TICKLESS_ALARM
+#if !defined(CONFIG_SCHED_TICKLESS_ALARM) && !defined(CONFIG_SCHED_TICKLESS_SLACK)
 		/* There is logic to handle the case where ticks is greater than
 		 * the watchdog lag, but if the scheduling is working properly
 		 * that should never happen.
@@ -443,7 +563,11 @@ unsigned int wd_timer(int ticks)
 
 	/* Return the delay for the next watchdog to expire */
 
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+	return wd_nextexpiration();
+#else
 	return g_wdactivelist.head ? ((FAR struct wdog_s *)g_wdactivelist.head)->lag : 0;
+#endif
 }
 
 #else
@@ -461,4 +585,4 @@ void wd_timer(void)
 		wd_expiration();
 	}
 }
-#endif							/* CONFIG_SCHED_TICKLESS */
+#endif							/* CONFIG_WDOG_TIMERWHEEL */
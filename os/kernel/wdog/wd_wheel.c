@@ -0,0 +1,349 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/wdog/wd_wheel.c
+ *
+ * Hierarchical timer wheel of the active watchdogs.
+ *
+ * The wheel has WHEEL_LEVELS levels of WHEEL_SLOTS slots.  A slot of level
+ * L covers 32^L ticks, so a watchdog that expires within 32^(L+1) ticks is
+ * hashed into level L by the bits of its expiration tick that select the
+ * slot at that level.  Each slot is a circular, doubly linked list, so
+ * adding and removing a watchdog takes constant time.
+ *
+ * Whenever the wheel time reaches the start of the span of a slot of a
+ * higher level, that slot is emptied and its watchdogs are hashed again
+ * into the lower levels (cascading).  All watchdogs of the current level 0
+ * slot expire at the current tick.
+ *
+ * The expiration tick is kept in the 'lag' field of the watchdog.  Ticks
+ * are unsigned and wrap around; only differences to the wheel time are
+ * used.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include <tinyara/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WHEEL_BITS            5
+#define WHEEL_SLOTS           (1 << WHEEL_BITS)
+#define WHEEL_MASK            (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS          6
+
+/* The first tick of a slot of level 'l' and the slot of tick 't' */
+
+#define WHEEL_SHIFT(l)        ((l) * WHEEL_BITS)
+#define WHEEL_SLOT(l, t)      (((t) >> WHEEL_SHIFT(l)) & WHEEL_MASK)
+
+/* Longer delays are placed at the far end of the wheel and hashed again
+ * when the wheel gets there.
+ */
+
+#define WHEEL_RANGE           ((uint32_t)1 << WHEEL_SHIFT(WHEEL_LEVELS))
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+
+/* The slots of all levels; slot s of level l is at (l << WHEEL_BITS) + s */
+
+static FAR struct wdog_s *g_wdwheel[WHEEL_LEVELS << WHEEL_BITS];
+
+/* Bit s of g_wdwheelmap[l] is set if slot s of level l is not empty */
+
+static uint32_t g_wdwheelmap[WHEEL_LEVELS];
+
+/* The current tick of the wheel */
+
+static uint32_t g_wdwheeltime;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_place
+ *
+ * Description:
+ *   Hash a watchdog into the wheel by its expiration tick.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_place(FAR struct wdog_s *wdog)
+{
+	FAR struct wdog_s *head;
+	uint32_t expires = (uint32_t)wdog->lag;
+	uint32_t delta = expires - g_wdwheeltime;
+	int level;
+	int index;
+
+	if (delta >= WHEEL_RANGE) {
+		expires = g_wdwheeltime + WHEEL_RANGE - 1;
+		delta = WHEEL_RANGE - 1;
+	}
+
+	for (level = 0; delta >= ((uint32_t)1 << WHEEL_SHIFT(level + 1)); level++) ;
+
+	/* Add the watchdog at the tail of the slot */
+
+	index = (level << WHEEL_BITS) + WHEEL_SLOT(level, expires);
+	head = g_wdwheel[index];
+	if (head == NULL) {
+		wdog->next = wdog;
+		wdog->prev = wdog;
+		g_wdwheel[index] = wdog;
+		g_wdwheelmap[level] |= (uint32_t)1 << (index & WHEEL_MASK);
+	} else {
+		wdog->next = head;
+		wdog->prev = head->prev;
+		head->prev->next = wdog;
+		head->prev = wdog;
+	}
+
+	wdog->slot = (uint8_t)index;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Empty a slot of a higher level and hash its watchdogs again.  Called
+ *   when the wheel time has reached the first tick of the slot.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(int level, int slot)
+{
+	FAR struct wdog_s *head;
+	FAR struct wdog_s *wdog;
+	FAR struct wdog_s *next;
+	int index = (level << WHEEL_BITS) + slot;
+
+	head = g_wdwheel[index];
+	if (head == NULL) {
+		return;
+	}
+
+	g_wdwheel[index] = NULL;
+	g_wdwheelmap[level] &= ~((uint32_t)1 << slot);
+
+	/* The watchdogs are taken in order, so the ones that end up in the same
+	 * slot keep their order.
+	 */
+
+	wdog = head;
+	do {
+		next = wdog->next;
+		wd_wheel_place(wdog);
+		wdog = next;
+	} while (wdog != head);
+}
+
+#ifdef CONFIG_SCHED_TICKLESS
+/****************************************************************************
+ * Name: wd_wheel_first
+ *
+ * Description:
+ *   Return how many slots after 'slot' the first non-empty slot in 'map'
+ *   is, counting from 'slot' itself and wrapping around.
+ *
+ ****************************************************************************/
+
+static inline int wd_wheel_first(uint32_t map, int slot)
+{
+	if (slot != 0) {
+		map = (map >> slot) | (map << (WHEEL_SLOTS - slot));
+	}
+
+	return __builtin_ctz(map);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ ****************************************************************************/
+
+void wd_wheel_initialize(void)
+{
+	int i;
+
+	for (i = 0; i < (WHEEL_LEVELS << WHEEL_BITS); i++) {
+		g_wdwheel[i] = NULL;
+	}
+
+	for (i = 0; i < WHEEL_LEVELS; i++) {
+		g_wdwheelmap[i] = 0;
+	}
+
+	g_wdwheeltime = 0;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_add
+ ****************************************************************************/
+
+void wd_wheel_add(FAR struct wdog_s *wdog, int delay)
+{
+	wdog->lag = (int)(g_wdwheeltime + (uint32_t)delay);
+	wd_wheel_place(wdog);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ ****************************************************************************/
+
+bool wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+	int index = wdog->slot;
+
+	if (wdog->next == wdog) {
+		/* The watchdog was the only one in the slot */
+
+		g_wdwheel[index] = NULL;
+		g_wdwheelmap[index >> WHEEL_BITS] &= ~((uint32_t)1 << (index & WHEEL_MASK));
+		return true;
+	}
+
+	wdog->prev->next = wdog->next;
+	wdog->next->prev = wdog->prev;
+	if (g_wdwheel[index] == wdog) {
+		g_wdwheel[index] = wdog->next;
+	}
+
+	return false;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remaining
+ ****************************************************************************/
+
+int wd_wheel_remaining(FAR struct wdog_s *wdog)
+{
+	int remaining = (int)((uint32_t)wdog->lag - g_wdwheeltime);
+
+	return remaining > 0 ? remaining : 0;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_tick
+ ****************************************************************************/
+
+void wd_wheel_tick(void)
+{
+	uint32_t now = ++g_wdwheeltime;
+	int level;
+
+	/* Cascade the slots of the higher levels that start at this tick, the
+	 * lower levels first.
+	 */
+
+	for (level = 1; level < WHEEL_LEVELS && (now & (((uint32_t)1 << WHEEL_SHIFT(level)) - 1)) == 0; level++) {
+		wd_wheel_cascade(level, WHEEL_SLOT(level, now));
+	}
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(void)
+{
+	FAR struct wdog_s *wdog = g_wdwheel[g_wdwheeltime & WHEEL_MASK];
+
+	if (wdog != NULL) {
+		DEBUGASSERT((uint32_t)wdog->lag == g_wdwheeltime);
+		(void)wd_wheel_remove(wdog);
+		wdog->next = NULL;
+	}
+
+	return wdog;
+}
+
+#ifdef CONFIG_SCHED_TICKLESS
+/****************************************************************************
+ * Name: wd_wheel_next
+ ****************************************************************************/
+
+unsigned int wd_wheel_next(void)
+{
+	uint32_t now = g_wdwheeltime;
+	uint32_t next = 0;
+	uint32_t ticks;
+	uint32_t base;
+	int level;
+
+	/* The next tick at which either a level 0 slot expires or a slot of a
+	 * higher level cascades.  That is the first non-empty slot after the
+	 * current one on each level.
+	 */
+
+	for (level = 0; level < WHEEL_LEVELS; level++) {
+		if (g_wdwheelmap[level] == 0) {
+			continue;
+		}
+
+		base = (now >> WHEEL_SHIFT(level)) + 1;
+		base += wd_wheel_first(g_wdwheelmap[level], base & WHEEL_MASK);
+		ticks = (base << WHEEL_SHIFT(level)) - now;
+		if (next == 0 || ticks < next) {
+			next = ticks;
+		}
+	}
+
+	return next;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_skip
+ ****************************************************************************/
+
+unsigned int wd_wheel_skip(unsigned int ticks)
+{
+	unsigned int next = wd_wheel_next();
+
+	if (next != 0 && next <= ticks) {
+		ticks = next - 1;
+	}
+
+	g_wdwheeltime += ticks;
+	return ticks;
+}
+#endif							/* CONFIG_SCHED_TICKLESS */
+
+#endif							/* CONFIG_WDOG_TIMERWHEEL */
@@ -90,12 +90,14 @@ extern "C" {
 
 extern sq_queue_t g_wdfreelist;
 
+#ifndef CONFIG_WDOG_TIMERWHEEL
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 extern sq_queue_t g_wdactivelist;
+#endif
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -148,6 +150,8 @@ void weak_function wd_initialize(void);
  *   If CONFIG_SCHED_TICKLESS is defined then the number of ticks for the
  *   next delay is provided (zero if no delay).  Otherwise, this function
  *   has no returned value.
+ *   With CONFIG_SCHED_TICKLESS_SLACK, the delay is the latest time at which
+ *   the watchdogs that are due next are still within their slack.
  *
  * Assumptions:
  *   Called from interrupt handler logic with interrupts disabled.
@@ -182,6 +186,44 @@ void wd_timer(void);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+/****************************************************************************
+ * Name: wd_wheel_*
+ *
+ * Description:
+ *   The timer wheel that holds the active watchdogs with
+ *   CONFIG_WDOG_TIMERWHEEL, see wd_wheel.c.  All functions must be called
+ *   with interrupts disabled.
+ *
+ *   wd_wheel_initialize - Empty the wheel.
+ *   wd_wheel_add        - Add a watchdog that expires 'delay' ticks after
+ *                         the current tick of the wheel.
+ *   wd_wheel_remove     - Remove a watchdog.  Returns true if its slot is
+ *                         empty now, so that the next timer event may have
+ *                         changed.
+ *   wd_wheel_remaining  - The ticks until a watchdog in the wheel expires.
+ *   wd_wheel_tick       - Advance the wheel by one tick.
+ *   wd_wheel_expired    - Remove and return the next watchdog that expires
+ *                         at the current tick; NULL if there is none.
+ *   wd_wheel_next       - The ticks until the next tick at which the wheel
+ *                         has work to do; zero if the wheel is empty.
+ *   wd_wheel_skip       - Advance the wheel by up to 'ticks' ticks at which
+ *                         it has nothing to do.  Returns the ticks skipped.
+ *
+ ****************************************************************************/
+
+void wd_wheel_initialize(void);
+void wd_wheel_add(FAR struct wdog_s *wdog, int delay);
+bool wd_wheel_remove(FAR struct wdog_s *wdog);
+int wd_wheel_remaining(FAR struct wdog_s *wdog);
+void wd_wheel_tick(void);
+FAR struct wdog_s *wd_wheel_expired(void);
+#ifdef CONFIG_SCHED_TICKLESS
+unsigned int wd_wheel_next(void);
+unsigned int wd_wheel_skip(unsigned int ticks);
+#endif
+#endif							/* CONFIG_WDOG_TIMERWHEEL */
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -87,7 +87,6 @@
  * Private Functions
  ****************************************************************************/
 
-#if defined(CONFIG_SCHED_HPWORK) || defined(CONFIG_SCHED_LPWORK)
 /****************************************************************************
  * Name: work_qcancel
  *
@@ -111,7 +110,9 @@
 
 static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *work)
 {
+#ifndef CONFIG_SCHED_WORKQUEUE_HEAP
 	struct work_s *cur_work;
+#endif
 	irqstate_t flags;
 	int ret = -ENOENT;
 
@@ -124,6 +125,13 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *wo
 
 	flags = irqsave();
 	if (work->worker != NULL) {
+#ifdef CONFIG_SCHED_WORKQUEUE_HEAP
+		/* Remove the work from the heap of pending work and make sure that
+		 * it is marked as available (i.e., the worker field is nullified).
+		 */
+
+		work_heap_remove(wqueue, work);
+#else
 		/* A little test of the integrity of the work queue */
 
 		DEBUGASSERT(work->dq.flink || (FAR dq_entry_t *)work == wqueue->q.tail);
@@ -147,14 +155,17 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *wo
 		 */
 
 		dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+#endif
 		work->worker = NULL;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+		wqueue->stats.backlog--;
+#endif
 		ret = OK;
 	}
 
 	irqrestore(flags);
 	return ret;
 }
-#endif
 
 /****************************************************************************
  * Public Functions
@@ -169,7 +180,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *wo
  *   by calling work_queue() again.
  *
  * Input parameters:
- *   qid    - The work queue ID (must be HPWORK or LPWORK)
+ *   qid    - The work queue ID (must be HPWORK, LPWORK or FSWORK)
  *   work   - The previously queue work structure to cancel
  *
  * Returned Value:
@@ -183,23 +194,13 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *wo
 
 int work_cancel(int qid, FAR struct work_s *work)
 {
-#ifdef CONFIG_SCHED_HPWORK
-	if (qid == HPWORK) {
-		/* Cancel high priority work */
+	FAR struct kwork_wqueue_s *wqueue = work_qid2wqueue(qid);
 
-		return work_qcancel((FAR struct kwork_wqueue_s *)&g_hpwork, work);
-	} else
-#endif
-#ifdef CONFIG_SCHED_LPWORK
-		if (qid == LPWORK) {
-			/* Cancel low priority work */
+	if (wqueue == NULL) {
+		return -EINVAL;
+	}
 
-			return work_qcancel((FAR struct kwork_wqueue_s *)&g_lpwork, work);
-		} else
-#endif
-		{
-			return -EINVAL;
-		}
+	return work_qcancel(wqueue, work);
 }
 
 #endif							/* CONFIG_SCHED_WORKQUEUE */
@@ -0,0 +1,133 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/wqueue/kwork_fsthread.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <errno.h>
+#include <queue.h>
+#include <debug.h>
+
+#include <tinyara/wqueue.h>
+#include <tinyara/kthread.h>
+#include <tinyara/clock.h>
+
+#include "wqueue/wqueue.h"
+
+#ifdef CONFIG_SCHED_FSWORK
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The state of the kernel mode, file system work queue. */
+
+struct fs_wqueue_s g_fswork;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_fsthread
+ *
+ * Description:
+ *   This is the worker thread that performs the actions placed on the file
+ *   system work queue.  Write buffer flushes and other flash work can take
+ *   a long time; on a queue of their own they do not delay the work of the
+ *   other queues.
+ *
+ * Input parameters:
+ *   argc, argv (not used)
+ *
+ * Returned Value:
+ *   Does not return
+ *
+ ****************************************************************************/
+
+static int work_fsthread(int argc, char *argv[])
+{
+	/* Loop forever */
+
+	for (;;) {
+		/* Process queued work.  work_process will not return until: (1)
+		 * there is no further work in the work queue, and (2) the polling
+		 * period provided by g_fswork.delay expires.
+		 */
+
+		work_process((FAR struct kwork_wqueue_s *)&g_fswork, g_fswork.delay, 0);
+	}
+
+	return OK;					/* To keep some compilers happy */
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_fsstart
+ *
+ * Description:
+ *   Start the file system, kernel-mode work queue.
+ *
+ * Input parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The task ID of the worker thread is returned on success.  A negated
+ *   errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+int work_fsstart(void)
+{
+	int pid;
+
+	/* Initialize work queue data structures */
+
+	g_fswork.delay = CONFIG_SCHED_FSWORKPERIOD / USEC_PER_TICK;
+	work_qinit((FAR struct kwork_wqueue_s *)&g_fswork);
+
+	/* Start the file system, kernel mode worker thread */
+
+	svdbg("Starting file system kernel worker thread\n");
+
+	pid = kernel_thread(FSWORKNAME, CONFIG_SCHED_FSWORKPRIORITY, CONFIG_SCHED_FSWORKSTACKSIZE, (main_t)work_fsthread, (FAR char *const *)NULL);
+
+	DEBUGASSERT(pid > 0);
+	if (pid < 0) {
+		int errcode = errno;
+		DEBUGASSERT(errcode > 0);
+
+		slldbg("kernel_thread failed: %d\n", errcode);
+		return -errcode;
+	}
+
+	g_fswork.worker[0].pid = pid;
+	g_fswork.worker[0].busy = true;
+	return pid;
+}
+
+#endif							/* CONFIG_SCHED_FSWORK */
@@ -0,0 +1,219 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/wqueue/kwork_heap.c
+ *
+ * The pending work of a work queue with CONFIG_SCHED_WORKQUEUE_HEAP.
+ *
+ * The work is kept in a pairing heap, so the next work to expire is always
+ * at the root.  Queueing work takes constant time; removing the root or
+ * cancelled work takes logarithmic time, amortized.  The heap needs no
+ * memory besides the links in the work structures:
+ *
+ *   child    - The first child of the work
+ *   dq.flink - The next sibling of the work
+ *   dq.blink - The previous sibling of the work, or its parent if it is the
+ *              first child, or NULL for the root
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <queue.h>
+
+#include <tinyara/clock.h>
+#include <tinyara/wqueue.h>
+
+#include "wqueue/wqueue.h"
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(CONFIG_SCHED_WORKQUEUE_HEAP)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WORK_NEXT(w)          ((FAR struct work_s *)(w)->dq.flink)
+#define WORK_PREV(w)          ((FAR struct work_s *)(w)->dq.blink)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_before
+ *
+ * Description:
+ *   Return true if work 'a' has to be performed before work 'b'.  The
+ *   expiration times may wrap around.
+ *
+ ****************************************************************************/
+
+static inline bool work_before(FAR struct work_s *a, FAR struct work_s *b)
+{
+	systime_t diff = (a->qtime + a->delay) - (b->qtime + b->delay);
+
+	if (diff != 0) {
+		return diff > ((systime_t)-1 >> 1);
+	}
+
+	return (int32_t)(a->seq - b->seq) < 0;
+}
+
+/****************************************************************************
+ * Name: work_heap_link
+ *
+ * Description:
+ *   Merge two heaps whose roots have no siblings.  Returns the new root.
+ *
+ ****************************************************************************/
+
+static FAR struct work_s *work_heap_link(FAR struct work_s *a, FAR struct work_s *b)
+{
+	FAR struct work_s *tmp;
+
+	if (work_before(b, a)) {
+		tmp = a;
+		a = b;
+		b = tmp;
+	}
+
+	/* b becomes the first child of a */
+
+	b->dq.blink = (FAR dq_entry_t *)a;
+	b->dq.flink = (FAR dq_entry_t *)a->child;
+	if (a->child) {
+		a->child->dq.blink = (FAR dq_entry_t *)b;
+	}
+
+	a->child = b;
+	return a;
+}
+
+/****************************************************************************
+ * Name: work_heap_merge
+ *
+ * Description:
+ *   Merge a list of siblings into one heap, pairwise from the first to the
+ *   last, then the pairs from the last to the first.  Returns the root.
+ *
+ ****************************************************************************/
+
+static FAR struct work_s *work_heap_merge(FAR struct work_s *first)
+{
+	FAR struct work_s *pairs = NULL;
+	FAR struct work_s *root = NULL;
+	FAR struct work_s *work;
+	FAR struct work_s *next;
+
+	while (first != NULL) {
+		work = first;
+		next = WORK_NEXT(work);
+		work->dq.flink = NULL;
+		work->dq.blink = NULL;
+
+		if (next != NULL) {
+			first = WORK_NEXT(next);
+			next->dq.flink = NULL;
+			next->dq.blink = NULL;
+			work = work_heap_link(work, next);
+		} else {
+			first = NULL;
+		}
+
+		/* The pairs are kept in reverse order */
+
+		work->dq.flink = (FAR dq_entry_t *)pairs;
+		pairs = work;
+	}
+
+	while (pairs != NULL) {
+		work = pairs;
+		pairs = WORK_NEXT(work);
+		work->dq.flink = NULL;
+		root = root ? work_heap_link(root, work) : work;
+	}
+
+	return root;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_heap_insert
+ ****************************************************************************/
+
+void work_heap_insert(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *work)
+{
+	work->seq = wqueue->seq++;
+	work->child = NULL;
+	work->dq.flink = NULL;
+	work->dq.blink = NULL;
+
+	wqueue->heap = wqueue->heap ? work_heap_link(wqueue->heap, work) : work;
+}
+
+/****************************************************************************
+ * Name: work_heap_remove
+ ****************************************************************************/
+
+void work_heap_remove(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *work)
+{
+	FAR struct work_s *prev = WORK_PREV(work);
+	FAR struct work_s *next = WORK_NEXT(work);
+	FAR struct work_s *sub;
+
+	sub = work_heap_merge(work->child);
+	work->child = NULL;
+	work->dq.flink = NULL;
+	work->dq.blink = NULL;
+
+	if (prev == NULL) {
+		/* The root: its children make up the new heap */
+
+		wqueue->heap = sub;
+		return;
+	}
+
+	/* Unlink the work from its parent or previous sibling, then merge its
+	 * children back into the heap.
+	 */
+
+	if (prev->child == work) {
+		prev->child = next;
+	} else {
+		prev->dq.flink = (FAR dq_entry_t *)next;
+	}
+
+	if (next != NULL) {
+		next->dq.blink = (FAR dq_entry_t *)prev;
+	}
+
+	if (sub != NULL) {
+		wqueue->heap = work_heap_link(wqueue->heap, sub);
+	}
+}
+
+#endif							/* CONFIG_SCHED_WORKQUEUE && CONFIG_SCHED_WORKQUEUE_HEAP */
@@ -176,7 +176,7 @@ int work_hpstart(void)
 	/* Initialize work queue data structures */
 
 	g_hpwork.delay = CONFIG_SCHED_HPWORKPERIOD / USEC_PER_TICK;
-	dq_init(&g_hpwork.q);
+	work_qinit((FAR struct kwork_wqueue_s *)&g_hpwork);
 
 	/* Start the high-priority, kernel mode worker thread */
 
@@ -211,7 +211,7 @@ int work_lpstart(void)
 	memset(&g_lpwork, 0, sizeof(struct kwork_wqueue_s));
 
 	g_lpwork.delay = CONFIG_SCHED_LPWORKPERIOD / USEC_PER_TICK;
-	dq_init(&g_lpwork.q);
+	work_qinit((FAR struct kwork_wqueue_s *)&g_lpwork);
 
 	/* Don't permit any of the threads to run until we have fully initialized
 	 * g_lpwork.
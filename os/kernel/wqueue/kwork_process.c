@@ -66,6 +66,9 @@
 
 #include <arch/irq.h>
 
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+#include "sched/sched.h"
+#endif
 #include "wqueue/wqueue.h"
 
 #ifdef CONFIG_SCHED_WORKQUEUE
@@ -104,6 +107,67 @@
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+/****************************************************************************
+ * Name: work_stats_start / work_stats_end
+ *
+ * Description:
+ *   Account for work that is about to be performed 'latency' ticks after
+ *   it expired, and for the time that it took.
+ *
+ ****************************************************************************/
+
+static inline void work_stats_start(FAR struct kwork_wqueue_s *wqueue, systime_t latency)
+{
+	wqueue->stats.done++;
+	wqueue->stats.backlog--;
+	wqueue->stats.totallatency += (uint32_t)latency;
+	if (latency > wqueue->stats.maxlatency) {
+		wqueue->stats.maxlatency = (uint32_t)latency;
+	}
+}
+
+static inline void work_stats_end(FAR struct kwork_wqueue_s *wqueue, systime_t runtime)
+{
+	if (runtime > wqueue->stats.maxruntime) {
+		wqueue->stats.maxruntime = (uint32_t)runtime;
+	}
+}
+#endif
+
+/****************************************************************************
+ * Name: work_slack
+ *
+ * Description:
+ *   Return the ticks that the worker thread may wake up after 'next', when
+ *   the work that expires first is 'work' and expires then.  The work that
+ *   may expire after it is 'later' and its siblings; the slack ends when
+ *   the first of them expires, so that it does not become late.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_TICKLESS_SLACK) && \
+	(defined(CONFIG_SCHED_WORKQUEUE_SORTING) || defined(CONFIG_SCHED_WORKQUEUE_HEAP))
+static inline systime_t work_slack(FAR volatile struct work_s *work, FAR struct work_s *later, systime_t ctick, systime_t next)
+{
+	systime_t slack = work->slack;
+	systime_t elapsed;
+	systime_t remaining;
+
+	for (; later != NULL && slack > 0; later = (FAR struct work_s *)later->dq.flink) {
+		elapsed = ctick - later->qtime;
+		remaining = elapsed < later->delay ? later->delay - elapsed : 0;
+		if (remaining <= next) {
+			slack = 0;
+		} else if (remaining - next < slack) {
+			slack = remaining - next;
+		}
+	}
+
+	return slack;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -131,20 +195,81 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, uint32_t period, int wndx)
 	irqstate_t flags;
 	FAR void *arg;
 	systime_t elapsed;
-#ifndef CONFIG_SCHED_WORKQUEUE_SORTING
+#if !defined(CONFIG_SCHED_WORKQUEUE_SORTING) && !defined(CONFIG_SCHED_WORKQUEUE_HEAP)
 	systime_t remaining;
 #endif
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	systime_t rtick;
+#endif
+#ifndef CONFIG_SCHED_WORKQUEUE_HEAP
 	systime_t stick;
+#endif
 	systime_t ctick;
 	systime_t next;
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+	systime_t latest;
+#endif
 
 	/* Then process queued work.  We need to keep interrupts disabled while
 	 * we process items in the work list.
 	 */
 
 	next = period;
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+	latest = period;
+#endif
 	flags = irqsave();
 
+#ifdef CONFIG_SCHED_WORKQUEUE_HEAP
+	/* The work at the root of the heap expires first.  Nothing else needs
+	 * to be looked at until it has been performed.
+	 */
+
+	while ((work = wqueue->heap) != NULL) {
+		ctick = clock_systimer();
+		elapsed = ctick - work->qtime;
+
+		if (elapsed < work->delay) {
+			/* Not ready.  Wake up when it is. */
+
+			next = work->delay - elapsed;
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+			latest = next + work_slack(work, work->child, ctick, next);
+#endif
+			break;
+		}
+
+		/* Remove the work from the heap and extract the work description
+		 * (in case the work instance is re-used after it has been
+		 * de-queued), then mark it as no longer being queued.
+		 */
+
+		work_heap_remove(wqueue, (FAR struct work_s *)work);
+		worker = work->worker;
+		arg = work->arg;
+		work->worker = NULL;
+		DEBUGASSERT(worker != NULL);
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+		work_stats_start(wqueue, elapsed - work->delay);
+		rtick = ctick;
+#endif
+
+		/* Do the work with interrupts enabled */
+
+		irqrestore(flags);
+		worker(arg);
+		flags = irqsave();
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+		work_stats_end(wqueue, clock_systimer() - rtick);
+#endif
+	}
+
+	if (wqueue->heap == NULL) {
+		period = 0;
+	}
+#else
 	/* Get the time that we started this polling cycle in clock ticks. */
 
 	stick = clock_systimer();
@@ -189,6 +314,11 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, uint32_t period, int wndx)
 
 				work->worker = NULL;
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+				work_stats_start(wqueue, elapsed - work->delay);
+				rtick = clock_systimer();
+#endif
+
 				/* Do the work.  Re-enable interrupts while the work is being
 				 * performed... we don't have any idea how long this will take!
 				 */
@@ -196,6 +326,10 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, uint32_t period, int wndx)
 				irqrestore(flags);
 				worker(arg);
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+				work_stats_end(wqueue, clock_systimer() - rtick);
+#endif
+
 				/* Now, unfortunately, since we re-enabled interrupts we don't
 				 * know the state of the work list and we will have to start
 				 * back at the head of the list.
@@ -230,6 +364,9 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, uint32_t period, int wndx)
 
 #ifdef CONFIG_SCHED_WORKQUEUE_SORTING
 			next = work->delay - elapsed;
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+			latest = next + work_slack(work, (FAR struct work_s *)work->dq.flink, ctick, next);
+#endif
 
 			/* Then break at while loop due to sorted list */
 			break;
@@ -239,6 +376,13 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, uint32_t period, int wndx)
 				/* Yes.. Then schedule to wake up when the work is ready */
 				next = remaining;
 			}
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+			/* Wake up no later than the work accepts */
+
+			if (remaining < latest && work->slack < latest - remaining) {
+				latest = remaining + work->slack;
+			}
+#endif
 
 			/* Then try the next in the list. */
 
@@ -252,8 +396,10 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, uint32_t period, int wndx)
 		period = 0;
 	}
 #endif
+#endif							/* CONFIG_SCHED_WORKQUEUE_HEAP */
 
-#if (defined(CONFIG_SCHED_LPWORK) && CONFIG_SCHED_LPNTHREADS > 0) || defined(CONFIG_SCHED_WORKQUEUE_SORTING)
+#if (defined(CONFIG_SCHED_LPWORK) && CONFIG_SCHED_LPNTHREADS > 0) || defined(CONFIG_SCHED_WORKQUEUE_SORTING) || \
+	defined(CONFIG_SCHED_WORKQUEUE_HEAP)
 	/* Value of zero for period means that we should wait indefinitely until
 	 * signalled.  This option is used only for the case where there are
 	 * multiple, low-priority worker threads.  In that case, only one of
@@ -275,7 +421,7 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, uint32_t period, int wndx)
 	} else
 #endif
 	{
-#ifdef CONFIG_SCHED_WORKQUEUE_SORTING
+#if defined(CONFIG_SCHED_WORKQUEUE_SORTING) || defined(CONFIG_SCHED_WORKQUEUE_HEAP)
 		if (next > 0) {
 #else
 		/* Get the delay (in clock ticks) since we started the sampling */
@@ -290,11 +436,21 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, uint32_t period, int wndx)
 
 			remaining = period - elapsed;
 			next = MIN(next, remaining);
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+			latest = MIN(latest, remaining);
+#endif
 #endif
 			/* Wait awhile to check the work list.  We will wait here until
 			 * either the time elapses or until we are awakened by a signal.
 			 * Interrupts will be re-enabled while we wait.
 			 */
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+			/* The sleep may last until the latest time that the pending
+			 * work accepts.
+			 */
+
+			this_task()->timerslack = latest > next ? (int)(latest - next) : 0;
+#endif
 			wqueue->worker[wndx].busy = false;
 			usleep(next * USEC_PER_TICK);
 			wqueue->worker[wndx].busy = true;
@@ -56,6 +56,7 @@
 #include <tinyara/config.h>
 
 #include <stdint.h>
+#include <string.h>
 #include <queue.h>
 #include <assert.h>
 #include <errno.h>
@@ -88,7 +89,6 @@
  * Private Functions
  ****************************************************************************/
 
-#if defined(CONFIG_SCHED_HPWORK) || defined(CONFIG_SCHED_LPWORK)
 /****************************************************************************
  * Name: work_qqueue
  *
@@ -112,22 +112,37 @@
  *            int is invoked.
  *   delay  - Delay (in clock ticks) from the time queue until the worker
  *            is invoked. Zero means to perform the work immediately.
+ *   slack  - Clock ticks that the worker may be invoked after the delay,
+ *            with CONFIG_SCHED_TICKLESS_SLACK
  *
  * Returned Value:
  *   Zero (OK) on success, a negated errno on failure.
  *
  ****************************************************************************/
 
-static int work_qqueue(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *work, worker_t worker, FAR void *arg, uint32_t delay)
+static int work_qqueue(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *work, worker_t worker, FAR void *arg, uint32_t delay, uint32_t slack)
 {
+#ifndef CONFIG_SCHED_WORKQUEUE_HEAP
 	struct work_s *cur_work;
 	struct work_s *next_work;
+#endif
 	irqstate_t flags;
 	DEBUGASSERT(work != NULL);
 
-	next_work = NULL;
 	flags = irqsave();
 
+#ifdef CONFIG_SCHED_WORKQUEUE_HEAP
+	/* Work in the heap cannot be found without a search, so work that has
+	 * not been performed or cancelled yet is taken as queued.
+	 */
+
+	if (work->worker != NULL) {
+		irqrestore(flags);
+		return -EALREADY;
+	}
+#else
+	next_work = NULL;
+
 	/* check whether requested work is in queue list or not */
 	cur_work = (struct work_s *)wqueue->q.head;
 	while (cur_work != NULL) {
@@ -142,13 +157,19 @@ static int work_qqueue(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *wor
 
 		cur_work = (struct work_s *)cur_work->dq.flink;
 	}
+#endif
 
 	work->worker = worker;		/* Work callback */
 	work->arg = arg;			/* Callback argument */
 	work->delay = delay;		/* Delay until work performed */
 	work->qtime = clock_systimer();	/* Time work queued */
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+	work->slack = slack;		/* Ticks that the work may be late */
+#endif
 
-#ifdef CONFIG_SCHED_WORKQUEUE_SORTING
+#if defined(CONFIG_SCHED_WORKQUEUE_HEAP)
+	work_heap_insert(wqueue, work);
+#elif defined(CONFIG_SCHED_WORKQUEUE_SORTING)
 	if (next_work) {
 		dq_addbefore((FAR dq_entry_t *)next_work, (FAR dq_entry_t *)work, &wqueue->q);
 	} else {
@@ -158,11 +179,17 @@ static int work_qqueue(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *wor
 	dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
 #endif
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	wqueue->stats.queued++;
+	if (++wqueue->stats.backlog > wqueue->stats.maxbacklog) {
+		wqueue->stats.maxbacklog = wqueue->stats.backlog;
+	}
+#endif
+
 	irqrestore(flags);
 
 	return OK;
 }
-#endif
 
 /****************************************************************************
  * Public Functions
@@ -199,34 +226,103 @@ static int work_qqueue(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *wor
 
 int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, uint32_t delay)
 {
-#if defined(CONFIG_SCHED_HPWORK) || defined(CONFIG_SCHED_LPWORK)
+	FAR struct kwork_wqueue_s *wqueue = work_qid2wqueue(qid);
+	int result;
+
+	if (wqueue == NULL) {
+		return -EINVAL;
+	}
+
+	result = work_qqueue(wqueue, work, worker, arg, delay, 0);
+	if (result != OK) {
+		return result;
+	}
+
+	return work_signal(qid);
+}
+
+/****************************************************************************
+ * Name: work_queue_slack
+ *
+ * Description:
+ *   Queue kernel-mode work like work_queue(), but let it be performed up to
+ *   'slack' clock ticks after its delay.  The worker thread then sleeps
+ *   until the latest time that all of its pending work accepts, so that it
+ *   can wake up together with other timer events.
+ *
+ * Input parameters:
+ *   qid    - The work queue ID (index)
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked
+ *   arg    - The argument that will be passed to the worker callback
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            may be invoked
+ *   slack  - Clock ticks that the worker may be invoked after the delay
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+int work_queue_slack(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, uint32_t delay, uint32_t slack)
+{
+	FAR struct kwork_wqueue_s *wqueue = work_qid2wqueue(qid);
 	int result;
+
+	if (wqueue == NULL) {
+		return -EINVAL;
+	}
+
+	result = work_qqueue(wqueue, work, worker, arg, delay, slack);
+	if (result != OK) {
+		return result;
+	}
+
+	return work_signal(qid);
+}
+#endif
+
+/****************************************************************************
+ * Name: work_qinit
+ ****************************************************************************/
+
+void work_qinit(FAR struct kwork_wqueue_s *wqueue)
+{
+#ifdef CONFIG_SCHED_WORKQUEUE_HEAP
+	wqueue->heap = NULL;
+	wqueue->seq = 0;
+#else
+	dq_init(&wqueue->q);
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	memset(&wqueue->stats, 0, sizeof(struct work_stats_s));
 #endif
+}
+
+/****************************************************************************
+ * Name: work_qid2wqueue
+ ****************************************************************************/
+
+FAR struct kwork_wqueue_s *work_qid2wqueue(int qid)
+{
 #ifdef CONFIG_SCHED_HPWORK
 	if (qid == HPWORK) {
-		/* Cancel high priority work */
-
-		result = work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork, work, worker, arg, delay);
-		if (result != OK) {
-			return result;
-		}
-		return work_signal(HPWORK);
-	} else
+		return (FAR struct kwork_wqueue_s *)&g_hpwork;
+	}
 #endif
 #ifdef CONFIG_SCHED_LPWORK
-		if (qid == LPWORK) {
-			/* Cancel low priority work */
-
-			result = work_qqueue((FAR struct kwork_wqueue_s *)&g_lpwork, work, worker, arg, delay);
-			if (result != OK) {
-				return result;
-			}
-			return work_signal(LPWORK);
-		} else
+	if (qid == LPWORK) {
+		return (FAR struct kwork_wqueue_s *)&g_lpwork;
+	}
 #endif
-		{
-			return -EINVAL;
-		}
+#ifdef CONFIG_SCHED_FSWORK
+	if (qid == FSWORK) {
+		return (FAR struct kwork_wqueue_s *)&g_fswork;
+	}
+#endif
+
+	return NULL;
 }
 
 #endif							/* CONFIG_SCHED_WORKQUEUE */
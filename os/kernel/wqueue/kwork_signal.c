@@ -120,6 +120,11 @@ int work_signal(int qid)
 
 			pid = g_lpwork.worker[wndx].pid;
 		} else
+#endif
+#ifdef CONFIG_SCHED_FSWORK
+			if (qid == FSWORK) {
+				pid = g_fswork.worker[0].pid;
+			} else
 #endif
 		{
 			return -EINVAL;
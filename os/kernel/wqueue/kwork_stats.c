@@ -0,0 +1,74 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/wqueue/kwork_stats.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <errno.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/wqueue.h>
+
+#include "wqueue/wqueue.h"
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(CONFIG_SCHED_WORKQUEUE_STATS)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_getstats
+ *
+ * Description:
+ *   Get the statistics of a kernel work queue.
+ *
+ * Input parameters:
+ *   qid   - The work queue ID
+ *   stats - Receives the statistics
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_getstats(int qid, FAR struct work_stats_s *stats)
+{
+	FAR struct kwork_wqueue_s *wqueue = work_qid2wqueue(qid);
+	irqstate_t flags;
+
+	if (wqueue == NULL || stats == NULL) {
+		return -EINVAL;
+	}
+
+	/* Take a consistent snapshot */
+
+	flags = irqsave();
+	*stats = wqueue->stats;
+	irqrestore(flags);
+
+	return OK;
+}
+
+#endif							/* CONFIG_SCHED_WORKQUEUE && CONFIG_SCHED_WORKQUEUE_STATS */
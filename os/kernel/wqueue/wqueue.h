@@ -63,6 +63,8 @@
 #include <stdbool.h>
 #include <queue.h>
 
+#include <tinyara/wqueue.h>
+
 #ifdef CONFIG_SCHED_WORKQUEUE
 
 /****************************************************************************
@@ -73,6 +75,7 @@
 
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
+#define FSWORKNAME "fswork"
 
 /****************************************************************************
  * Public Type Definitions
@@ -88,7 +91,15 @@ struct kworker_s {
 
 struct kwork_wqueue_s {
 	uint32_t delay;				/* Delay between polling cycles (ticks) */
+#ifdef CONFIG_SCHED_WORKQUEUE_HEAP
+	FAR struct work_s *heap;	/* The heap of pending work */
+	uint32_t seq;				/* Sequence number of the next work */
+#else
 	struct dq_queue_s q;		/* The queue of pending work */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency and backlog statistics */
+#endif
 	struct kworker_s worker[1];	/* Describes a worker thread */
 };
 
@@ -99,7 +110,15 @@ struct kwork_wqueue_s {
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s {
 	uint32_t delay;				/* Delay between polling cycles (ticks) */
+#ifdef CONFIG_SCHED_WORKQUEUE_HEAP
+	FAR struct work_s *heap;	/* The heap of pending work */
+	uint32_t seq;				/* Sequence number of the next work */
+#else
 	struct dq_queue_s q;		/* The queue of pending work */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency and backlog statistics */
+#endif
 	struct kworker_s worker[1];	/* Describes the single high priority worker */
 };
 #endif
@@ -111,7 +130,15 @@ struct hp_wqueue_s {
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s {
 	uint32_t delay;				/* Delay between polling cycles (ticks) */
+#ifdef CONFIG_SCHED_WORKQUEUE_HEAP
+	FAR struct work_s *heap;	/* The heap of pending work */
+	uint32_t seq;				/* Sequence number of the next work */
+#else
 	struct dq_queue_s q;		/* The queue of pending work */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency and backlog statistics */
+#endif
 
 	/* Describes each thread in the low priority queue's thread pool */
 
@@ -119,6 +146,26 @@ struct lp_wqueue_s {
 };
 #endif
 
+/* This structure defines the state of the file system work queue.  This
+ * structure must be cast compatible with kwork_wqueue_s
+ */
+
+#ifdef CONFIG_SCHED_FSWORK
+struct fs_wqueue_s {
+	uint32_t delay;				/* Delay between polling cycles (ticks) */
+#ifdef CONFIG_SCHED_WORKQUEUE_HEAP
+	FAR struct work_s *heap;	/* The heap of pending work */
+	uint32_t seq;				/* Sequence number of the next work */
+#else
+	struct dq_queue_s q;		/* The queue of pending work */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency and backlog statistics */
+#endif
+	struct kworker_s worker[1];	/* Describes the single file system worker */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -135,6 +182,12 @@ extern struct hp_wqueue_s g_hpwork;
 extern struct lp_wqueue_s g_lpwork;
 #endif
 
+#ifdef CONFIG_SCHED_FSWORK
+/* The state of the kernel mode, file system work queue. */
+
+extern struct fs_wqueue_s g_fswork;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -177,6 +230,68 @@ int work_hpstart(void);
 int work_lpstart(void);
 #endif
 
+/****************************************************************************
+ * Name: work_fsstart
+ *
+ * Description:
+ *   Start the file system, kernel-mode worker thread
+ *
+ * Input parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The task ID of the worker thread is returned on success.  A negated
+ *   errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_FSWORK
+int work_fsstart(void);
+#endif
+
+/****************************************************************************
+ * Name: work_qinit
+ *
+ * Description:
+ *   Initialize the pending work and the statistics of a work queue.
+ *
+ * Input parameters:
+ *   wqueue - Describes the work queue to be initialized
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void work_qinit(FAR struct kwork_wqueue_s *wqueue);
+
+/****************************************************************************
+ * Name: work_qid2wqueue
+ *
+ * Description:
+ *   Return the kernel work queue with the ID 'qid' or NULL if there is
+ *   none.
+ *
+ ****************************************************************************/
+
+FAR struct kwork_wqueue_s *work_qid2wqueue(int qid);
+
+#ifdef CONFIG_SCHED_WORKQUEUE_HEAP
+/****************************************************************************
+ * Name: work_heap_insert / work_heap_remove
+ *
+ * Description:
+ *   Add work to or remove work from the heap of pending work of a work
+ *   queue.  The heap is ordered by the expiration time of the work, then
+ *   by the order in which the work was queued.  Must be called with
+ *   interrupts disabled.
+ *
+ ****************************************************************************/
+
+void work_heap_insert(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *work);
+void work_heap_remove(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *work);
+#endif
+
 /****************************************************************************
  * Name: work_process
  *
@@ -20,6 +20,7 @@
 #include <string.h>
 #include <stdint.h>
 #include <sys/types.h>
+#include <sys/prctl.h>
 #include <arch/irq.h>
 #include <tinyara/logm.h>
 #include <tinyara/config.h>
@@ -96,6 +97,10 @@ int logm_task(int argc, char *argv[])
 			}
 			irqrestore(flags);
 		}
+#ifdef CONFIG_SCHED_TICKLESS_SLACK
+		/* Flushing the buffer can wait for other timers to wake up the CPU */
+		prctl(PR_SET_TIMERSLACK, (unsigned long)logm_print_interval / 2, 0);
+#endif
 		usleep(logm_print_interval);
 	}
 	return 0;					// Just to make compiler happy
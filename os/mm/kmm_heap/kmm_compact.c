@@ -0,0 +1,53 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/kmm_heap/kmm_compact.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <tinyara/mm/mm.h>
+
+#if defined(CONFIG_MM_KERNEL_HEAP) && defined(CONFIG_MM_COMPACT)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmm_compact
+ *
+ * Description:
+ *   Merge the contiguous regions of the kernel heap and return the unused
+ *   slab memory to it.  See mm_compact().
+ *
+ * Return Value:
+ *   The number of bytes that were returned to the heap free lists.
+ *
+ ****************************************************************************/
+
+size_t kmm_compact(void)
+{
+	return mm_compact(&g_kmmheap);
+}
+
+#endif							/* CONFIG_MM_KERNEL_HEAP && CONFIG_MM_COMPACT */
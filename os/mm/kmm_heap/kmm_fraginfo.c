@@ -0,0 +1,52 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/kmm_heap/kmm_fraginfo.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <tinyara/mm/mm.h>
+
+#if defined(CONFIG_MM_KERNEL_HEAP) && defined(CONFIG_MM_FRAGINFO)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmm_fraginfo
+ *
+ * Description:
+ *   Return the fragmentation report of the kernel heap.
+ *
+ * Return Value:
+ *   OK on success; -EINVAL if 'info' is NULL.
+ *
+ ****************************************************************************/
+
+int kmm_fraginfo(FAR struct mm_fraginfo_s *info)
+{
+	return mm_fraginfo(&g_kmmheap, info);
+}
+
+#endif							/* CONFIG_MM_KERNEL_HEAP && CONFIG_MM_FRAGINFO */
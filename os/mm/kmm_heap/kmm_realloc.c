@@ -96,4 +96,22 @@ FAR void *kmm_realloc(FAR void *oldmem, size_t newsize)
 #endif
 }
 
+/****************************************************************************
+ * Name: kmm_reallocinfo
+ *
+ * Description:
+ *   Return the realloc() statistics of the kernel heap.
+ *
+ * Return Value:
+ *   OK on success; -EINVAL if 'info' is NULL.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REALLOC_STATS
+int kmm_reallocinfo(FAR struct mm_reallocinfo_s *info)
+{
+	return mm_reallocinfo(&g_kmmheap, info);
+}
+#endif
+
 #endif							/* CONFIG_MM_KERNEL_HEAP */
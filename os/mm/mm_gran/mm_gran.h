@@ -60,6 +60,7 @@
 #include <tinyara/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <semaphore.h>
 
 #include <arch/types.h>
@@ -74,6 +75,10 @@
 #define SIZEOF_GAT(n) ((n + 31) >> 5)
 #define SIZEOF_GRAN_S(n) (sizeof(struct gran_s) + sizeof(uint32_t) * (SIZEOF_GAT(n) - 1))
 
+/* Index of the least significant set bit of a non-zero GAT entry */
+
+#define GRAN_FFS(w) __builtin_ctz(w)
+
 /* Debug */
 
 #ifdef CONFIG_CPP_HAVE_VARARGS
@@ -103,6 +108,7 @@
 struct gran_s {
 	uint8_t    log2gran;		/* Log base 2 of the size of one granule */
 	uint16_t   ngranules;		/* The total number of (aligned) granules in the heap */
+	uint16_t   freehint;		/* GAT entries below this index have no free granule */
 #ifdef CONFIG_GRAN_INTR
 	irqstate_t irqstate;		/* For exclusive access to the GAT */
 #else
@@ -161,4 +167,25 @@ void gran_leave_critical(FAR struct gran_s *priv);
 
 void gran_mark_allocated(FAR struct gran_s *priv, uintptr_t alloc, unsigned int ngranules);
 
+/****************************************************************************
+ * Name: gran_test_and_mark
+ *
+ * Description:
+ *   Mark a range of granules as allocated if all of them are still free.
+ *   The test and the update are done with interrupts disabled so that they
+ *   are atomic with respect to the single granule allocations and the
+ *   releases, which do not take the GAT semaphore.
+ *
+ * Input Parameters:
+ *   priv  - The granule heap state structure.
+ *   alloc - The address of the allocation.
+ *   ngranules - The number of granules to allocate
+ *
+ * Returned Value:
+ *   true if the granules were marked, false if some of them are in use.
+ *
+ ****************************************************************************/
+
+bool gran_test_and_mark(FAR struct gran_s *priv, uintptr_t alloc, unsigned int ngranules);
+
 #endif							/* __MM_MM_GRAN_MM_GRAN_H */
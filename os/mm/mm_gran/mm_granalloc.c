@@ -58,6 +58,7 @@
 
 #include <assert.h>
 
+#include <arch/irq.h>
 #include <tinyara/mm/gran.h>
 
 #include "mm_gran/mm_gran.h"
@@ -73,184 +74,166 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: gran_common_alloc
+ * Name: gran_alloc_one
  *
  * Description:
- *   Allocate memory from the granule heap.
+ *   Allocate a single granule.  The first GAT entry with a free bit is
+ *   found from the free hint and the granule is taken with interrupts
+ *   disabled, so this neither waits for the GAT semaphore nor interferes
+ *   with a multiple granule search of another task.  It may be called from
+ *   interrupt handlers.
  *
  * Input Parameters:
  *   priv - The granule heap state structure.
- *   size - The size of the memory region to allocate.
  *
  * Returned Value:
  *   On success, a non-NULL pointer to the allocated memory is returned.
  *
  ****************************************************************************/
 
-static inline FAR void *gran_common_alloc(FAR struct gran_s *priv, size_t size)
+static FAR void *gran_alloc_one(FAR struct gran_s *priv)
 {
-	unsigned int ngranules;
-	size_t       tmpmask;
-	uintptr_t    alloc;
-	uint32_t     curr;
-	uint32_t     next;
-	uint32_t     mask;
-	int          granidx;
-	int          gatidx;
-	int          bitidx;
-	int          shift;
-
-	DEBUGASSERT(priv && size <= 32 * (1 << priv->log2gran));
-
-	if (priv && size > 0) {
-		/* Get exclusive access to the GAT */
-
-		gran_enter_critical(priv);
-
-		/* How many contiguous granules we we need to find? */
-
-		tmpmask = (1 << priv->log2gran) - 1;
-		ngranules = (size + tmpmask) >> priv->log2gran;
-
-		/* Then create mask for that number of granules */
-
-		DEBUGASSERT(ngranules <= 32);
-		mask = 0xffffffff >> (32 - ngranules);
+	irqstate_t   flags;
+	unsigned int nentries;
+	unsigned int gatidx;
+	unsigned int granno;
+	uint32_t     avail;
 
-		/* Now search the granule allocation table for that number of contiguous */
+	nentries = SIZEOF_GAT(priv->ngranules);
 
-		alloc = priv->heapstart;
+	flags = irqsave();
 
-		for (granidx = 0; granidx < priv->ngranules; granidx += 32) {
-			/* Get the GAT index associated with the granule table entry */
+	for (gatidx = priv->freehint; gatidx < nentries; gatidx++) {
+		avail = ~priv->gat[gatidx];
+		if (avail != 0) {
+			granno = (gatidx << 5) + GRAN_FFS(avail);
+			if (granno >= priv->ngranules) {
+				/* Only the unused bits of the last entry are clear */
 
-			gatidx = granidx >> 5;
-			curr = priv->gat[gatidx];
-
-			/* Handle the case where there are no free granules in the entry */
-
-			if (curr == 0xffffffff) {
-				alloc += (32 << priv->log2gran);
-				continue;
-			}
-
-			/* Get the next entry from the GAT to support a 64 bit shift */
-
-			if (granidx < priv->ngranules) {
-				next = priv->gat[gatidx + 1];
+				break;
 			}
 
-			/* Use all ones when are at the last entry in the GAT (meaning
-			 * nothing can be allocated.
-			 */
-
-			else {
-				next = 0xffffffff;
-			}
+			priv->gat[gatidx] |= (uint32_t)1 << (granno & 31);
+			priv->freehint = gatidx;
 
-			/* Search through the allocations in the 'curr' GAT entry
-			 * to see if we can satisfy the allocation starting in that
-			 * entry.
-			 *
-			 * This loop continues until either all of the bits have been
-			 * examined (bitidx >= 32), or until there are insufficient
-			 * granules left to satisfy the allocation.
-			 */
-
-			for (bitidx = 0; bitidx < 32 && (granidx + bitidx + ngranules) <= priv->ngranules;) {
-				/* Break out if there are no further free bits in 'curr'.
-				 * All of the zero bits might have gotten shifted out.
-				 */
+			irqrestore(flags);
+			return (FAR void *)(priv->heapstart + ((uintptr_t)granno << priv->log2gran));
+		}
+	}
 
-				if (curr == 0xffffffff) {
-					break;
-				}
+	priv->freehint = gatidx;
 
-				/* Check for the first zero bit in the lower or upper 16-bits.
-				 * From the test above, we know that at least one of the 32-
-				 * bits in 'curr' is zero.
-				 */
+	irqrestore(flags);
+	return NULL;
+}
 
-				else if ((curr & 0x0000ffff) == 0x0000ffff) {
-					/* Not in the lower 16 bits.  The first free bit must be
-					 * in the upper 16 bits.
-					 */
+/****************************************************************************
+ * Name: gran_common_alloc
+ *
+ * Description:
+ *   Allocate memory from the granule heap.
+ *
+ *   The GAT is searched one entry at a time.  The free bits of an entry and
+ *   of the following one are combined into a 64 bit word in which every set
+ *   bit starts a run of 'ngranules' free granules, and the lowest of them
+ *   that starts in the current entry is the allocation.
+ *
+ * Input Parameters:
+ *   priv - The granule heap state structure.
+ *   size - The size of the memory region to allocate.
+ *
+ * Returned Value:
+ *   On success, a non-NULL pointer to the allocated memory is returned.
+ *
+ ****************************************************************************/
 
-					shift = 16;
-				}
+static inline FAR void *gran_common_alloc(FAR struct gran_s *priv, size_t size)
+{
+	unsigned int ngranules;
+	unsigned int nentries;
+	unsigned int gatidx;
+	unsigned int granno;
+	unsigned int runlen;
+	unsigned int shift;
+	size_t       tmpmask;
+	uintptr_t    alloc;
+	uint64_t     avail;
+	uint32_t     starts;
 
-				/* We know that the first free bit is now within the lower 16
-				 * bits of 'curr'.  Is it in the upper or lower byte?
-				 */
+	DEBUGASSERT(priv && size <= 32 * (1 << priv->log2gran));
 
-				else if ((curr & 0x0000ff) == 0x000000ff) {
-					/* Not in the lower 8 bits.  The first free bit must be in
-					 * the upper 8 bits.
-					 */
+	if (priv == NULL || size == 0) {
+		return NULL;
+	}
 
-					shift = 8;
-				}
+	/* How many contiguous granules we we need to find? */
 
-				/* We know that the first free bit is now within the lower 4
-				 * bits of 'curr'.  Is it in the upper or lower nibble?
-				 */
+	tmpmask = (1 << priv->log2gran) - 1;
+	ngranules = (size + tmpmask) >> priv->log2gran;
+	DEBUGASSERT(ngranules <= 32);
 
-				else if ((curr & 0x00000f) == 0x0000000f) {
-					/* Not in the lower 4 bits.  The first free bit must be in
-					 * the upper 4 bits.
-					 */
+	if (ngranules == 1) {
+		return gran_alloc_one(priv);
+	}
 
-					shift = 4;
-				}
+	/* Get exclusive access to the GAT */
 
-				/* We know that the first free bit is now within the lower 4 bits
-				 * of 'curr'.  Is it in the upper or lower pair?
-				 */
+	gran_enter_critical(priv);
 
-				else if ((curr & 0x000003) == 0x00000003) {
-					/* Not in the lower 2 bits.  The first free bit must be in
-					 * the upper 2 bits.
-					 */
+	nentries = SIZEOF_GAT(priv->ngranules);
 
-					shift = 2;
-				}
+	for (gatidx = priv->freehint; gatidx < nentries; gatidx++) {
+		/* Handle the case where there are no free granules in the entry */
 
-				/* We know that the first free bit is now within the lower 4 bits
-				 * of 'curr'.  Check if we have the allocation at this bit position.
-				 */
+		if (priv->gat[gatidx] == 0xffffffff) {
+			continue;
+		}
 
-				else if ((curr & mask) == 0) {
-					/* Yes.. mark these granules allocated */
+		/* Get the free bits of this and of the next entry.  There is
+		 * nothing free after the last entry.
+		 */
 
-					gran_mark_allocated(priv, alloc, ngranules);
+		avail = ~(uint64_t)priv->gat[gatidx];
+		if (gatidx + 1 < nentries) {
+			avail &= ~((uint64_t)priv->gat[gatidx + 1] << 32);
+		} else {
+			avail &= 0xffffffff;
+		}
 
-					/* And return the allocation address */
+		/* Keep the bits that are followed by ngranules - 1 free bits,
+		 * doubling the length of the runs on each step.
+		 */
 
-					gran_leave_critical(priv);
-					return (FAR void *)alloc;
-				}
+		for (runlen = 1; runlen < ngranules; runlen += shift) {
+			shift  = runlen < ngranules - runlen ? runlen : ngranules - runlen;
+			avail &= avail >> shift;
+		}
 
-				/* The free allocation does not start at this position */
+		starts = (uint32_t)avail;
+		while (starts != 0) {
+			granno = (gatidx << 5) + GRAN_FFS(starts);
+			if (granno + ngranules > priv->ngranules) {
+				/* Any later start runs past the end of the heap */
 
-				else {
-					shift = 1;
-				}
+				gran_leave_critical(priv);
+				return NULL;
+			}
 
-				/* Set up for the next time through the loop.  Perform a 64
-				 * bit shift to move to the next gran position andi ncrement
-				 * to the next candidate allocation address.
-				 */
+			/* Mark the granules unless a single granule was allocated
+			 * from them by an interrupt handler meanwhile.
+			 */
 
-				alloc  += (shift << priv->log2gran);
-				curr    = (curr >> shift) | (next << (32 - shift));
-				next  >>= shift;
-				bitidx += shift;
+			alloc = priv->heapstart + ((uintptr_t)granno << priv->log2gran);
+			if (gran_test_and_mark(priv, alloc, ngranules)) {
+				gran_leave_critical(priv);
+				return (FAR void *)alloc;
 			}
-		}
 
-		gran_leave_critical(priv);
+			starts &= starts - 1;
+		}
 	}
 
+	gran_leave_critical(priv);
 	return NULL;
 }
 
@@ -58,6 +58,7 @@
 
 #include <assert.h>
 
+#include <arch/irq.h>
 #include <tinyara/mm/gran.h>
 
 #include "mm_gran/mm_gran.h"
@@ -72,7 +73,9 @@
  * Name: gran_common_free
  *
  * Description:
- *   Return memory to the granule heap.
+ *   Return memory to the granule heap.  Clearing the GAT bits only needs
+ *   interrupts to be disabled for a moment; the GAT semaphore is not
+ *   taken, so memory can also be released from interrupt handlers.
  *
  * Input Parameters:
  *   handle - The handle previously returned by gran_initialize
@@ -92,13 +95,10 @@ static inline void gran_common_free(FAR struct gran_s *priv, FAR void *memory, s
 	unsigned int ngranules;
 	unsigned int avail;
 	uint32_t     gatmask;
+	irqstate_t   flags;
 
 	DEBUGASSERT(priv && memory && size <= 32 * (1 << priv->log2gran));
 
-	/* Get exclusive access to the GAT */
-
-	gran_enter_critical(priv);
-
 	/* Determine the granule number of the first granule in the allocation */
 
 	granno = ((uintptr_t)memory - priv->heapstart) >> priv->log2gran;
@@ -117,6 +117,8 @@ static inline void gran_common_free(FAR struct gran_s *priv, FAR void *memory, s
 
 	/* Clear bits in the GAT entry or entries */
 
+	flags = irqsave();
+
 	avail = 32 - gatbit;
 	if (ngranules > avail) {
 		/* Clear bits in the first GAT entry */
@@ -147,7 +149,13 @@ static inline void gran_common_free(FAR struct gran_s *priv, FAR void *memory, s
 		priv->gat[gatidx] &= ~gatmask;
 	}
 
-	gran_leave_critical(priv);
+	/* The first entry has free granules now */
+
+	if (gatidx < priv->freehint) {
+		priv->freehint = gatidx;
+	}
+
+	irqrestore(flags);
 }
 
 /****************************************************************************
@@ -58,6 +58,7 @@
 
 #include <assert.h>
 
+#include <arch/irq.h>
 #include <tinyara/mm/gran.h>
 
 #include "mm_gran/mm_gran.h"
@@ -143,4 +144,53 @@ void gran_mark_allocated(FAR struct gran_s *priv, uintptr_t alloc, unsigned int
 	}
 }
 
+/****************************************************************************
+ * Name: gran_test_and_mark
+ *
+ * Description:
+ *   Mark a range of granules as allocated if all of them are still free.
+ *
+ * Input Parameters:
+ *   priv  - The granule heap state structure.
+ *   alloc - The address of the allocation.
+ *   ngranules - The number of granules to allocate
+ *
+ * Returned Value:
+ *   true if the granules were marked, false if some of them are in use.
+ *
+ ****************************************************************************/
+
+bool gran_test_and_mark(FAR struct gran_s *priv, uintptr_t alloc, unsigned int ngranules)
+{
+	irqstate_t flags;
+	unsigned int granno;
+	unsigned int gatidx;
+	unsigned int gatbit;
+	unsigned int avail;
+	uint32_t     gatmask;
+	bool         isfree;
+
+	granno = (alloc - priv->heapstart) >> priv->log2gran;
+	gatidx = granno >> 5;
+	gatbit = granno & 31;
+	avail  = 32 - gatbit;
+
+	flags = irqsave();
+
+	if (ngranules > avail) {
+		gatmask = 0xffffffff >> (32 - (ngranules - avail));
+		isfree  = (priv->gat[gatidx] >> gatbit) == 0 && (priv->gat[gatidx + 1] & gatmask) == 0;
+	} else {
+		gatmask = (0xffffffff >> (32 - ngranules)) << gatbit;
+		isfree  = (priv->gat[gatidx] & gatmask) == 0;
+	}
+
+	if (isfree) {
+		gran_mark_allocated(priv, alloc, ngranules);
+	}
+
+	irqrestore(flags);
+	return isfree;
+}
+
 #endif							/* CONFIG_GRAN */
@@ -56,12 +56,20 @@
 
 #include <tinyara/config.h>
 
+#include <assert.h>
+
 #include <tinyara/mm/mm.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_MM_TLSF
+/* Index of the least significant set bit of a non-zero word */
+
+#define MM_FFS(w)   __builtin_ctz(w)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -88,9 +96,21 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
 	int ndx = mm_size2ndx(node->size);
 
+#ifdef CONFIG_MM_TLSF
+	/* The lists are not sorted.  Put the new node at the head of its list
+	 * and mark the list as non-empty.
+	 */
+
+	prev = &heap->mm_nodelist[ndx];
+	next = prev->flink;
+
+	heap->mm_slbitmap[ndx >> MM_SL_SHIFT] |= (1 << (ndx & (MM_SLCOUNT - 1)));
+	heap->mm_flbitmap |= (1 << (ndx >> MM_SL_SHIFT));
+#else
 	/* Now put the new node int the next */
 
 	for (prev = &heap->mm_nodelist[ndx], next = heap->mm_nodelist[ndx].flink; next && next->size && next->size < node->size; prev = next, next = next->flink) ;
+#endif
 
 	/* Does it go in mid next or at the end? */
 
@@ -103,4 +123,103 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
 		next->blink = node;
 	}
+
+#ifdef CONFIG_MM_FRAGINFO
+	heap->mm_freebytes += node->size;
+	heap->mm_nfreechunks[MM_NDX2BIN(ndx)]++;
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_delfreechunk
+ *
+ * Description:
+ *   Remove a free chunk from the nodelist.  The size of the node must not
+ *   have been changed since it was added.  It is assumed that the caller
+ *   holds the mm semaphore
+ *
+ ****************************************************************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+#if defined(CONFIG_MM_TLSF) || defined(CONFIG_MM_FRAGINFO)
+	int ndx;
+#endif
+
+	/* There must be a predecessor, but there may not be a successor node. */
+
+	DEBUGASSERT(node->blink);
+	node->blink->flink = node->flink;
+	if (node->flink) {
+		node->flink->blink = node->blink;
+	}
+
+#if defined(CONFIG_MM_TLSF) || defined(CONFIG_MM_FRAGINFO)
+	ndx = mm_size2ndx(node->size);
+#endif
+
+#ifdef CONFIG_MM_FRAGINFO
+	heap->mm_freebytes -= node->size;
+	heap->mm_nfreechunks[MM_NDX2BIN(ndx)]--;
+#endif
+
+#ifdef CONFIG_MM_TLSF
+	/* Clear the bitmaps if that was the last node of its list */
+
+	if (heap->mm_nodelist[ndx].flink == NULL) {
+		heap->mm_slbitmap[ndx >> MM_SL_SHIFT] &= ~(1 << (ndx & (MM_SLCOUNT - 1)));
+		if (heap->mm_slbitmap[ndx >> MM_SL_SHIFT] == 0) {
+			heap->mm_flbitmap &= ~(1 << (ndx >> MM_SL_SHIFT));
+		}
+	}
+#endif
+}
+
+#ifdef CONFIG_MM_TLSF
+/****************************************************************************
+ * Name: mm_findfreelist
+ *
+ * Description:
+ *   Find the first non-empty free list at or above the given nodelist
+ *   index using the bitmaps.  It is assumed that the caller holds the mm
+ *   semaphore
+ *
+ * Return Value:
+ *   The nodelist index of the list or -1 if there is none.
+ *
+ ****************************************************************************/
+
+int mm_findfreelist(FAR struct mm_heap_s *heap, int ndx)
+{
+	uint32_t flmap;
+	uint32_t slmap;
+	int fl;
+	int sl;
+
+	if (ndx >= MM_NLISTS) {
+		return -1;
+	}
+
+	fl = ndx >> MM_SL_SHIFT;
+	sl = ndx & (MM_SLCOUNT - 1);
+
+	/* Look for a non-empty list in the same first level class */
+
+	slmap = heap->mm_slbitmap[fl] & (~0U << sl);
+	if (slmap == 0) {
+		/* None.  Take the first non-empty list of the next non-empty first
+		 * level class.
+		 */
+
+		flmap = heap->mm_flbitmap & (~0U << (fl + 1));
+		if (flmap == 0) {
+			return -1;
+		}
+
+		fl    = MM_FFS(flmap);
+		slmap = heap->mm_slbitmap[fl];
+	}
+
+	return (fl << MM_SL_SHIFT) + MM_FFS(slmap);
 }
+#endif
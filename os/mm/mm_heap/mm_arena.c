@@ -0,0 +1,319 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/mm_heap/mm_arena.c
+ *
+ * Arena (region) allocator on top of a heap.  An arena takes large blocks
+ * from its heap and hands out memory from them with a bump pointer.  The
+ * memory is never freed individually; all of it is released at once with
+ * mm_arena_reset() or mm_arena_destroy().  This suits request-scoped data
+ * such as the parsing state of a protocol request, which would otherwise
+ * need many small malloc()/free() calls and fragment the heap.
+ *
+ * An arena is not protected by any lock.  It must only be used by one
+ * thread at a time.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <tinyara/mm/mm.h>
+
+#ifdef CONFIG_MM_ARENA
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SIZEOF_MM_ARENA       MM_ARENA_ALIGN_UP(sizeof(struct mm_arena_s))
+#define SIZEOF_MM_ARENABLOCK  MM_ARENA_ALIGN_UP(sizeof(struct mm_arenablock_s))
+
+/* The first block is embedded in the allocation of the arena itself */
+
+#define MM_ARENA_FIRST(a) \
+	((FAR struct mm_arenablock_s *)((FAR char *)(a) + SIZEOF_MM_ARENA))
+
+#define MM_ARENA_DATA(b)  ((FAR char *)(b) + SIZEOF_MM_ARENABLOCK)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_arena_newblock
+ *
+ * Description:
+ *   Allocate a new block with 'size' usable bytes from the heap of the
+ *   arena.
+ *
+ ****************************************************************************/
+
+static FAR struct mm_arenablock_s *mm_arena_newblock(FAR struct mm_arena_s *arena, size_t size)
+{
+	FAR struct mm_arenablock_s *block;
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	block = (FAR struct mm_arenablock_s *)mm_malloc(arena->heap, SIZEOF_MM_ARENABLOCK + size, arena->caller_retaddr);
+#else
+	block = (FAR struct mm_arenablock_s *)mm_malloc(arena->heap, SIZEOF_MM_ARENABLOCK + size);
+#endif
+	if (block == NULL) {
+		return NULL;
+	}
+
+	block->size = size;
+	arena->nheapallocs++;
+	return block;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_arena_create
+ *
+ * Description:
+ *   Create an arena that takes blocks of 'blksize' bytes from the selected
+ *   heap.  The arena descriptor and its first block are allocated at once
+ *   and the first block is kept until the arena is destroyed, so an arena
+ *   whose usage per reset cycle fits in one block never calls the heap
+ *   again.
+ *
+ * Return Value:
+ *   The new arena or NULL if there is not enough memory.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR struct mm_arena_s *mm_arena_create(FAR struct mm_heap_s *heap, size_t blksize, mmaddress_t caller_retaddr)
+#else
+FAR struct mm_arena_s *mm_arena_create(FAR struct mm_heap_s *heap, size_t blksize)
+#endif
+{
+	FAR struct mm_arena_s *arena;
+	FAR struct mm_arenablock_s *first;
+
+	if (blksize < MM_ARENA_MINBLOCK) {
+		blksize = MM_ARENA_MINBLOCK;
+	}
+
+	blksize = MM_ARENA_ALIGN_UP(blksize);
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	arena = (FAR struct mm_arena_s *)mm_malloc(heap, SIZEOF_MM_ARENA + SIZEOF_MM_ARENABLOCK + blksize, caller_retaddr);
+#else
+	arena = (FAR struct mm_arena_s *)mm_malloc(heap, SIZEOF_MM_ARENA + SIZEOF_MM_ARENABLOCK + blksize);
+#endif
+	if (arena == NULL) {
+		return NULL;
+	}
+
+	memset(arena, 0, sizeof(struct mm_arena_s));
+	arena->heap = heap;
+	arena->blksize = blksize;
+	arena->largesize = blksize >> 2;
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	arena->caller_retaddr = caller_retaddr;
+#endif
+
+	first = MM_ARENA_FIRST(arena);
+	first->next = NULL;
+	first->size = blksize;
+
+	arena->blocks = first;
+	arena->next = MM_ARENA_DATA(first);
+	arena->end = arena->next + blksize;
+	arena->nheapallocs = 1;
+
+	return arena;
+}
+
+/****************************************************************************
+ * Name: mm_arena_alloc
+ *
+ * Description:
+ *   Allocate 'size' bytes from the arena.  The memory is aligned to
+ *   MM_ARENA_ALIGN bytes and stays valid until the arena is reset or
+ *   destroyed.
+ *
+ *   A request that does not fit in the rest of the current block starts a
+ *   new block.  A request larger than the large size, a quarter of the
+ *   block size by default, gets a block of its own, so that it does not
+ *   waste the rest of the current block.
+ *
+ * Return Value:
+ *   The address of the memory or NULL if there is not enough memory.
+ *
+ ****************************************************************************/
+
+FAR void *mm_arena_alloc(FAR struct mm_arena_s *arena, size_t size)
+{
+	FAR struct mm_arenablock_s *block;
+	FAR char *mem;
+
+	DEBUGASSERT(arena != NULL);
+
+	if (size < 1) {
+		return NULL;
+	}
+
+	size = MM_ARENA_ALIGN_UP(size);
+
+	if (size > (size_t)(arena->end - arena->next)) {
+		if (size > arena->largesize) {
+			/* Put the large block behind the current one */
+
+			block = mm_arena_newblock(arena, size);
+			if (block == NULL) {
+				return NULL;
+			}
+
+			block->next = arena->blocks->next;
+			arena->blocks->next = block;
+			arena->nallocs++;
+			arena->used += size;
+			return MM_ARENA_DATA(block);
+		}
+
+		/* Start a new current block.  The rest of the old one is lost until
+		 * the next reset.
+		 */
+
+		block = mm_arena_newblock(arena, arena->blksize);
+		if (block == NULL) {
+			return NULL;
+		}
+
+		block->next = arena->blocks;
+		arena->blocks = block;
+		arena->next = MM_ARENA_DATA(block);
+		arena->end = arena->next + arena->blksize;
+	}
+
+	mem = arena->next;
+	arena->next += size;
+	arena->nallocs++;
+	arena->used += size;
+	return mem;
+}
+
+/****************************************************************************
+ * Name: mm_arena_zalloc
+ *
+ * Description:
+ *   mm_arena_alloc() followed by clearing the memory.
+ *
+ ****************************************************************************/
+
+FAR void *mm_arena_zalloc(FAR struct mm_arena_s *arena, size_t size)
+{
+	FAR void *mem = mm_arena_alloc(arena, size);
+
+	if (mem != NULL) {
+		memset(mem, 0, size);
+	}
+
+	return mem;
+}
+
+/****************************************************************************
+ * Name: mm_arena_setlargesize
+ *
+ * Description:
+ *   Set the size above which a request that does not fit in the current
+ *   block gets a block of its own.  Raise it above the size of the main
+ *   allocation of a cycle, so that it always comes from a regular block.
+ *   It is limited to the block size.
+ *
+ ****************************************************************************/
+
+void mm_arena_setlargesize(FAR struct mm_arena_s *arena, size_t size)
+{
+	DEBUGASSERT(arena != NULL);
+
+	arena->largesize = size < arena->blksize ? size : arena->blksize;
+}
+
+/****************************************************************************
+ * Name: mm_arena_reset
+ *
+ * Description:
+ *   Release all memory allocated from the arena at once.  The blocks other
+ *   than the first one are returned to the heap.
+ *
+ ****************************************************************************/
+
+void mm_arena_reset(FAR struct mm_arena_s *arena)
+{
+	FAR struct mm_arenablock_s *first;
+	FAR struct mm_arenablock_s *block;
+	FAR struct mm_arenablock_s *next;
+
+	DEBUGASSERT(arena != NULL);
+
+	/* Large blocks may be linked behind the first block, so walk the whole
+	 * list.
+	 */
+
+	first = MM_ARENA_FIRST(arena);
+	for (block = arena->blocks; block != NULL; block = next) {
+		next = block->next;
+		if (block != first) {
+			mm_free(arena->heap, block);
+		}
+	}
+
+	if (arena->used > arena->peak) {
+		arena->peak = arena->used;
+	}
+
+	first->next = NULL;
+	arena->blocks = first;
+	arena->next = MM_ARENA_DATA(first);
+	arena->end = arena->next + arena->blksize;
+	arena->nallocs = 0;
+	arena->used = 0;
+}
+
+/****************************************************************************
+ * Name: mm_arena_destroy
+ *
+ * Description:
+ *   Release all memory allocated from the arena and the arena itself.
+ *
+ ****************************************************************************/
+
+void mm_arena_destroy(FAR struct mm_arena_s *arena)
+{
+	if (arena != NULL) {
+		mm_arena_reset(arena);
+		mvdbg("arena %p: peak %u bytes, %u heap allocations\n", arena, arena->peak, arena->nheapallocs);
+		mm_free(arena->heap, arena);
+	}
+}
+
+#endif							/* CONFIG_MM_ARENA */
@@ -0,0 +1,184 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/mm_heap/mm_compact.c
+ *
+ * Compaction helper.  Free chunks are already coalesced with their
+ * neighbors when they are released, so the remaining sources of
+ * fragmentation are the guard nodes between heap regions that are
+ * contiguous in memory and the slab pages that hold only a few objects.
+ * mm_compact() removes both.  It is meant to be called from a low priority
+ * context since it takes the mm semaphore for a while.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <debug.h>
+
+#include <tinyara/mm/mm.h>
+
+#ifdef CONFIG_MM_COMPACT
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#if CONFIG_MM_REGIONS > 1
+/****************************************************************************
+ * Name: mm_mergeregion
+ *
+ * Description:
+ *   Merge region 'second', which starts right at the end of region
+ *   'first', into 'first'.  The tail guard node of 'first' and the head
+ *   guard node of 'second' become one free chunk, which is coalesced with
+ *   its neighbors.  It is assumed that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+static void mm_mergeregion(FAR struct mm_heap_s *heap, int first, int second)
+{
+	FAR struct mm_freenode_s *node;
+	FAR struct mm_freenode_s *prev;
+	FAR struct mm_freenode_s *next;
+	FAR struct mm_allocnode_s *andbeyond;
+	int region;
+
+	node = (FAR struct mm_freenode_s *)heap->mm_heapend[first];
+	next = (FAR struct mm_freenode_s *)((FAR char *)heap->mm_heapstart[second] + heap->mm_heapstart[second]->size);
+
+	node->size       = 2 * SIZEOF_MM_ALLOCNODE;
+	node->preceding &= ~MM_ALLOC_BIT;
+	next->preceding  = node->size | (next->preceding & MM_ALLOC_BIT);
+
+	/* Merge the following chunk if it is free */
+
+	if ((next->preceding & MM_ALLOC_BIT) == 0) {
+		andbeyond = (FAR struct mm_allocnode_s *)((FAR char *)next + next->size);
+		mm_delfreechunk(heap, next);
+
+		node->size          += next->size;
+		andbeyond->preceding = node->size | (andbeyond->preceding & MM_ALLOC_BIT);
+		next                 = (FAR struct mm_freenode_s *)andbeyond;
+	}
+
+	/* And the preceding chunk */
+
+	prev = (FAR struct mm_freenode_s *)((FAR char *)node - node->preceding);
+	if ((prev->preceding & MM_ALLOC_BIT) == 0) {
+		mm_delfreechunk(heap, prev);
+
+		prev->size     += node->size;
+		next->preceding = prev->size | (next->preceding & MM_ALLOC_BIT);
+		node            = prev;
+	}
+
+	mm_addfreechunk(heap, node);
+
+	/* Remove the second region */
+
+	heap->mm_heapend[first] = heap->mm_heapend[second];
+	for (region = second + 1; region < heap->mm_nregions; region++) {
+		heap->mm_heapstart[region - 1] = heap->mm_heapstart[region];
+		heap->mm_heapend[region - 1]   = heap->mm_heapend[region];
+	}
+
+	heap->mm_nregions--;
+}
+
+/****************************************************************************
+ * Name: mm_compactregions
+ *
+ * Description:
+ *   Merge all regions that are contiguous in memory.
+ *
+ * Return Value:
+ *   The number of bytes of guard nodes that became free.
+ *
+ ****************************************************************************/
+
+static size_t mm_compactregions(FAR struct mm_heap_s *heap)
+{
+	size_t released = 0;
+	int first;
+	int second;
+
+	mm_takesemaphore(heap);
+
+	for (first = 0; first < heap->mm_nregions; first++) {
+		for (second = 0; second < heap->mm_nregions; second++) {
+			if ((FAR char *)heap->mm_heapend[first] + SIZEOF_MM_ALLOCNODE == (FAR char *)heap->mm_heapstart[second]) {
+				mvdbg("merge region %d into region %d\n", second, first);
+
+				mm_mergeregion(heap, first, second);
+				released += 2 * SIZEOF_MM_ALLOCNODE;
+
+				/* The regions were renumbered.  Start over. */
+
+				first = -1;
+				break;
+			}
+		}
+	}
+
+	mm_givesemaphore(heap);
+	return released;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_compact
+ *
+ * Description:
+ *   Reduce the fragmentation of the selected heap: merge the heap regions
+ *   that are contiguous in memory and return the unused slab memory to the
+ *   heap.  Allocated memory is never moved.
+ *
+ *   NOTE: Merging regions renumbers them, so this must not be used
+ *   together with mm_extend() on a region index.
+ *
+ * Return Value:
+ *   The number of bytes that were returned to the heap free lists.
+ *
+ ****************************************************************************/
+
+size_t mm_compact(FAR struct mm_heap_s *heap)
+{
+	size_t released = 0;
+
+#if CONFIG_MM_REGIONS > 1
+	released += mm_compactregions(heap);
+#endif
+
+#ifdef CONFIG_MM_SLAB
+	released += mm_slab_compact(heap);
+#endif
+
+	mvdbg("heap %p: %u bytes released\n", heap, released);
+	return released;
+}
+
+#endif							/* CONFIG_MM_COMPACT */
@@ -0,0 +1,144 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/mm_heap/mm_fraginfo.c
+ *
+ * Fragmentation report of a heap.  The number and the total size of the
+ * free chunks are maintained by mm_addfreechunk() and mm_delfreechunk(),
+ * so only the free chunks of the largest non-empty bin are visited to find
+ * the largest free chunk.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <string.h>
+#include <errno.h>
+
+#include <tinyara/mm/mm.h>
+
+#ifdef CONFIG_MM_FRAGINFO
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_largestfree
+ *
+ * Description:
+ *   Return the size of the largest free chunk of the given bin.  It is
+ *   assumed that the caller holds the mm semaphore.
+ *
+ *   With CONFIG_MM_TLSF, the free lists are not sorted.  Only the highest
+ *   non-empty second level list of the bin can hold the largest chunk, so
+ *   that list alone is walked.  The cost is linear in the number of free
+ *   chunks of that size range, which is why mm_fraginfo() is a report and
+ *   not something to call from an allocation path.
+ *
+ ****************************************************************************/
+
+static size_t mm_largestfree(FAR struct mm_heap_s *heap, int bin)
+{
+	FAR struct mm_freenode_s *node;
+	size_t largest = 0;
+#ifdef CONFIG_MM_TLSF
+	uint32_t slmap = heap->mm_slbitmap[bin];
+	int sl;
+
+	if (slmap == 0) {
+		return 0;
+	}
+
+	/* Find the highest non-empty second level list of the bin */
+
+	for (sl = MM_SLCOUNT - 1; (slmap & (1 << sl)) == 0; sl--) ;
+
+	for (node = heap->mm_nodelist[(bin << MM_SL_SHIFT) + sl].flink; node; node = node->flink) {
+		if (node->size > largest) {
+			largest = node->size;
+		}
+	}
+#else
+	/* The list is sorted by size.  The nodes of the bin end at the head of
+	 * the next bin, which has a size of zero.
+	 */
+
+	for (node = heap->mm_nodelist[bin].flink; node && node->size; node = node->flink) {
+		largest = node->size;
+	}
+#endif
+
+	return largest;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   Return the fragmentation report of the selected heap.
+ *
+ * Return Value:
+ *   OK on success; -EINVAL if 'info' is NULL.
+ *
+ ****************************************************************************/
+
+int mm_fraginfo(FAR struct mm_heap_s *heap, FAR struct mm_fraginfo_s *info)
+{
+	int bin;
+	int top = -1;
+
+	if (info == NULL) {
+		return -EINVAL;
+	}
+
+	memset(info, 0, sizeof(struct mm_fraginfo_s));
+
+	mm_takesemaphore(heap);
+
+	info->freebytes = heap->mm_freebytes;
+	for (bin = 0; bin < MM_NNODES; bin++) {
+		info->nchunks[bin] = heap->mm_nfreechunks[bin];
+		info->nfree += heap->mm_nfreechunks[bin];
+		if (heap->mm_nfreechunks[bin] > 0) {
+			top = bin;
+		}
+	}
+
+	if (top >= 0) {
+		info->largest = mm_largestfree(heap, top);
+	}
+
+	mm_givesemaphore(heap);
+
+	if (info->freebytes > 0) {
+		info->fragindex = 100 - (int)(((uint64_t)info->largest * 100) / info->freebytes);
+	}
+
+	return OK;
+}
+
+#endif							/* CONFIG_MM_FRAGINFO */
@@ -141,9 +141,19 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 
 	if ((alloc_node->preceding & MM_ALLOC_BIT) != 0) {
 		heapinfo_subtract_size(alloc_node->pid, alloc_node->size);
-		heapinfo_update_total_size(heap, ((-1) * alloc_node->size), alloc_node->pid);
+		heapinfo_update_total_size(heap, ((-1) * alloc_node->size), alloc_node);
 	}
 #endif
+#ifdef CONFIG_MM_SLAB
+	/* Slab objects go back to the free list of their size class */
+
+	if (MM_IS_SLAB(node)) {
+		mm_slab_free(heap, (FAR struct mm_allocnode_s *)node);
+		mm_givesemaphore(heap);
+		return;
+	}
+#endif
+
 	node->preceding &= ~MM_ALLOC_BIT;
 
 	/* Check if the following node is free and, if so, merge it */
@@ -159,15 +169,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 
 		andbeyond = (FAR struct mm_allocnode_s *)((char *)next + next->size);
 
-		/* Remove the next node.  There must be a predecessor,
-		 * but there may not be a successor node.
-		 */
+		/* Remove the next node from the free list */
 
-		DEBUGASSERT(next->blink);
-		next->blink->flink = next->flink;
-		if (next->flink) {
-			next->flink->blink = next->blink;
-		}
+		mm_delfreechunk(heap, next);
 
 		/* Then merge the two chunks */
 
@@ -182,15 +186,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 
 	prev = (FAR struct mm_freenode_s *)((char *)node - node->preceding);
 	if ((prev->preceding & MM_ALLOC_BIT) == 0) {
-		/* Remove the node.  There must be a predecessor, but there may
-		 * not be a successor node.
-		 */
+		/* Remove the node from the free list */
 
-		DEBUGASSERT(prev->blink);
-		prev->blink->flink = prev->flink;
-		if (prev->flink) {
-			prev->flink->blink = prev->blink;
-		}
+		mm_delfreechunk(heap, prev);
 
 		/* Then merge the two chunks */
 
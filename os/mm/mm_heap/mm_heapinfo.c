@@ -59,8 +59,10 @@
 #include <unistd.h>
 #include <stdint.h>
 #include <stdio.h>
-#ifdef CONFIG_HEAPINFO_USER_GROUP
+#if defined(CONFIG_HEAPINFO_USER_GROUP) || defined(CONFIG_DEBUG_MM_HEAPINFO_STATS)
 #include <string.h>
+#endif
+#ifdef CONFIG_HEAPINFO_USER_GROUP
 #include <tinyara/mm/heapinfo_internal.h>
 #endif
 
@@ -71,10 +73,149 @@
 #define HEAPINFO_INT INT16_MAX
 #define HEAPINFO_NONSCHED (INT16_MAX - 1)
 
+#ifdef CONFIG_DEBUG_MM_HEAPINFO_STATS
+#define HEAPINFO_CALLER_MASK   (CONFIG_DEBUG_MM_HEAPINFO_NCALLERS - 1)
+#define HEAPINFO_CALLER_HASH(a) ((((a) >> 1) ^ ((a) >> 9)) & HEAPINFO_CALLER_MASK)
+#define HEAPINFO_CALLER_PROBES 8
+
+#if (CONFIG_DEBUG_MM_HEAPINFO_NCALLERS & HEAPINFO_CALLER_MASK) != 0
+#error CONFIG_DEBUG_MM_HEAPINFO_NCALLERS must be a power of two
+#endif
+#endif
+
 #ifdef CONFIG_HEAPINFO_USER_GROUP
 struct heapinfo_group_info_s group_info[HEAPINFO_THREAD_NUM];
 #endif
 
+#ifdef CONFIG_DEBUG_MM_HEAPINFO_STATS
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: heapinfo_stats_pid
+ *
+ * Description:
+ * Return the statistics entry of a task. The entry of an exited task is
+ * taken over by a new task with the same PID hash, and the remaining usage
+ * of the exited task is moved to the 'other' entry. Stacks, which have a
+ * negative pid in their node, are not accounted per task.
+ ****************************************************************************/
+static struct heapinfo_pidstat_s *heapinfo_stats_pid(struct mm_heap_s *heap, pid_t pid, bool alloc)
+{
+	struct heapinfo_stats_s *stats = &heap->stats;
+	struct heapinfo_pidstat_s *entry;
+
+	if (pid < 0) {
+		return NULL;
+	}
+
+	if (pid == HEAPINFO_INT) {
+		return &stats->pid_other;
+	}
+
+	entry = &stats->pid[MM_PIDHASH(pid)];
+	if (entry->pid == pid) {
+		return entry;
+	}
+
+	if (alloc && (entry->nallocs == 0 || sched_gettcb(entry->pid) == NULL)) {
+		stats->pid_other.nallocs += entry->nallocs;
+		stats->pid_other.curr_size += entry->curr_size;
+		if (stats->pid_other.curr_size > stats->pid_other.peak_size) {
+			stats->pid_other.peak_size = stats->pid_other.curr_size;
+		}
+
+		entry->pid = pid;
+		entry->nallocs = 0;
+		entry->curr_size = 0;
+		entry->peak_size = 0;
+		return entry;
+	}
+
+	return &stats->pid_other;
+}
+
+/****************************************************************************
+ * Name: heapinfo_stats_caller
+ *
+ * Description:
+ * Return the statistics entry of a caller. The callers are kept in an open
+ * addressing hash which is never cleared, so a caller that did not fit at
+ * its first allocation is always accounted in the 'other' entry.
+ ****************************************************************************/
+static struct heapinfo_callerstat_s *heapinfo_stats_caller(struct mm_heap_s *heap, mmaddress_t caller, bool alloc)
+{
+	struct heapinfo_stats_s *stats = &heap->stats;
+	struct heapinfo_callerstat_s *entry;
+	int probe;
+
+	if (caller == 0) {
+		return &stats->caller_other;
+	}
+
+	for (probe = 0; probe < HEAPINFO_CALLER_PROBES; probe++) {
+		entry = &stats->caller[(HEAPINFO_CALLER_HASH(caller) + probe) & HEAPINFO_CALLER_MASK];
+		if (entry->caller == caller) {
+			return entry;
+		}
+
+		if (entry->caller == 0) {
+			if (alloc) {
+				entry->caller = caller;
+				return entry;
+			}
+			break;
+		}
+	}
+
+	return &stats->caller_other;
+}
+
+/****************************************************************************
+ * Name: heapinfo_stats_update
+ *
+ * Description:
+ * Add the size of an allocated chunk (size > 0) or subtract the size of a
+ * freed chunk (size < 0) to the task and caller statistics.
+ ****************************************************************************/
+static void heapinfo_stats_update(struct mm_heap_s *heap, mmsize_t size, pid_t pid, mmaddress_t caller, bool percaller)
+{
+	struct heapinfo_pidstat_s *pstat;
+	struct heapinfo_callerstat_s *cstat;
+	bool alloc = ((ssize_t)size > 0);
+
+	pstat = heapinfo_stats_pid(heap, pid, alloc);
+	if (pstat) {
+		pstat->curr_size += size;
+		if (alloc) {
+			pstat->nallocs++;
+			if (pstat->curr_size > pstat->peak_size) {
+				pstat->peak_size = pstat->curr_size;
+			}
+		} else if (pstat->nallocs > 0) {
+			pstat->nallocs--;
+		}
+	}
+
+	if (!percaller) {
+		return;
+	}
+
+	cstat = heapinfo_stats_caller(heap, caller, alloc);
+	cstat->curr_size += size;
+	if (alloc) {
+		cstat->pid = pid;
+		cstat->nallocs++;
+		if (cstat->curr_size > cstat->peak_size) {
+			cstat->peak_size = cstat->curr_size;
+		}
+	} else if (cstat->nallocs > 0) {
+		cstat->nallocs--;
+	}
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -204,6 +345,24 @@ void heapinfo_parse(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 		}
 	}
 
+#ifdef CONFIG_MM_SLAB
+	if (mode != HEAPINFO_SIMPLE) {
+		struct mm_slabinfo_s slabinfo;
+		int ndx;
+
+		printf("\n****************************************************************\n");
+		printf("Slab Size Class Summary(Size in Bytes) : %s\n", heap->mm_slab_enabled ? "enabled" : "disabled");
+		printf("****************************************************************\n");
+		printf(" CHUNK | PAGES |  USED  |  FREE  |   ALLOCS   |   MISSES   \n");
+		printf("-------|-------|--------|--------|------------|------------\n");
+		for (ndx = 0; ndx < MM_SLAB_NCLASSES; ndx++) {
+			if (mm_slab_info(heap, ndx, &slabinfo) == OK && (slabinfo.npages > 0 || slabinfo.nmisses > 0)) {
+				printf(" %5u | %5d | %6d | %6d | %10u | %10u\n", slabinfo.chunksize, slabinfo.npages, slabinfo.nused, slabinfo.nfree, slabinfo.nallocs, slabinfo.nmisses);
+			}
+		}
+	}
+#endif
+
 	return;
 }
 /****************************************************************************
@@ -280,14 +439,17 @@ void heapinfo_subtract_size(pid_t pid, mmsize_t size)
  * Description:
  * Calculate the total allocated size and update the peak allocated size for heap
  ****************************************************************************/
-void heapinfo_update_total_size(struct mm_heap_s *heap, mmsize_t size, pid_t pid)
+void heapinfo_update_total_size(struct mm_heap_s *heap, mmsize_t size, FAR struct mm_allocnode_s *node)
 {
 	heap->total_alloc_size += size;
 	if (heap->total_alloc_size > heap->peak_alloc_size) {
 		heap->peak_alloc_size = heap->total_alloc_size;
 	}
 #ifdef CONFIG_HEAPINFO_USER_GROUP
-	heapinfo_update_group(size, pid);
+	heapinfo_update_group(size, node->pid);
+#endif
+#ifdef CONFIG_DEBUG_MM_HEAPINFO_STATS
+	heapinfo_stats_update(heap, size, node->pid, node->alloc_call_addr, true);
 #endif
 }
 /****************************************************************************
@@ -326,6 +488,15 @@ void heapinfo_exclude_stacksize(void *stack_ptr)
 	ASSERT(rtcb);
 	rtcb->curr_alloc_size -= node->size;
 
+#ifdef CONFIG_DEBUG_MM_HEAPINFO_STATS
+	/* The stack is no longer accounted to the parent task. It stays
+	 * accounted to its caller until it is freed.
+	 */
+	mm_takesemaphore(mm_get_heap_info());
+	heapinfo_stats_update(mm_get_heap_info(), (-1) * node->size, node->pid, 0, false);
+	mm_givesemaphore(mm_get_heap_info());
+#endif
+
 #ifdef CONFIG_HEAPINFO_USER_GROUP
 	int check_idx;
 	int group_num;
@@ -341,6 +512,42 @@ void heapinfo_exclude_stacksize(void *stack_ptr)
 #endif
 }
 
+#ifdef CONFIG_DEBUG_MM_HEAPINFO_STATS
+/****************************************************************************
+ * Name: heapinfo_stats_initialize
+ *
+ * Description:
+ * Clear the incremental per-task and per-caller statistics of a heap
+ ****************************************************************************/
+void heapinfo_stats_initialize(FAR struct mm_heap_s *heap)
+{
+	int ndx;
+
+	memset(&heap->stats, 0, sizeof(struct heapinfo_stats_s));
+	for (ndx = 0; ndx < CONFIG_MAX_TASKS; ndx++) {
+		heap->stats.pid[ndx].pid = HEAPINFO_NONSCHED;
+	}
+	heap->stats.pid_other.pid = HEAPINFO_NONSCHED;
+}
+
+/****************************************************************************
+ * Name: heapinfo_stats_snapshot
+ *
+ * Description:
+ * Copy the incremental statistics of a heap. Unlike heapinfo_parse(), this
+ * does not walk the heap and holds the heap semaphore only for the copy, so
+ * it can be polled periodically.
+ ****************************************************************************/
+void heapinfo_stats_snapshot(FAR struct mm_heap_s *heap, FAR struct heapinfo_stats_s *stats)
+{
+	mm_takesemaphore(heap);
+	memcpy(stats, &heap->stats, sizeof(struct heapinfo_stats_s));
+	stats->total_alloc_size = heap->total_alloc_size;
+	stats->peak_alloc_size = heap->peak_alloc_size;
+	mm_givesemaphore(heap);
+}
+#endif
+
 #ifdef CONFIG_HEAPINFO_USER_GROUP
 /****************************************************************************
  * Name: heapinfo_update_group_info
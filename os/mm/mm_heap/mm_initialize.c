@@ -190,7 +190,9 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart, size_t heapsi
 
 void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart, size_t heapsize)
 {
+#ifndef CONFIG_MM_TLSF
 	int i;
+#endif
 
 	mlldbg("Heap: start=%p size=%u\n", heapstart, heapsize);
 
@@ -212,13 +214,29 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart, size_t heaps
 	heap->mm_nregions = 0;
 #endif
 
+#ifdef CONFIG_MM_FRAGINFO
+	heap->mm_freebytes = 0;
+	memset(heap->mm_nfreechunks, 0, sizeof(heap->mm_nfreechunks));
+#endif
+
+#ifdef CONFIG_MM_REALLOC_STATS
+	memset(&heap->mm_reallocstats, 0, sizeof(struct mm_reallocinfo_s));
+#endif
+
 	/* Initialize the node array */
 
-	memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * MM_NNODES);
+	memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * MM_NLISTS);
+#ifdef CONFIG_MM_TLSF
+	/* The lists are independent and searched through the bitmaps */
+
+	heap->mm_flbitmap = 0;
+	memset(heap->mm_slbitmap, 0, sizeof(heap->mm_slbitmap));
+#else
 	for (i = 1; i < MM_NNODES; i++) {
 		heap->mm_nodelist[i - 1].flink = &heap->mm_nodelist[i];
 		heap->mm_nodelist[i].blink = &heap->mm_nodelist[i - 1];
 	}
+#endif
 
 	/* Initialize the malloc semaphore to one (to support one-at-
 	 * a-time access to private data sets).
@@ -226,6 +244,18 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart, size_t heaps
 
 	mm_seminitialize(heap);
 
+#ifdef CONFIG_MM_SLAB
+	/* Initialize the slab size classes */
+
+	mm_slab_initialize(heap);
+#endif
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO_STATS
+	/* Clear the incremental per-task and per-caller statistics */
+
+	heapinfo_stats_initialize(heap);
+#endif
+
 	/* Add the initial region of memory to the heap */
 
 	mm_addregion(heap, heapstart, heapsize);
@@ -90,6 +90,9 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
 	int    ordblks  = 0;		/* Number of non-inuse chunks */
 	size_t uordblks = 0;		/* Total allocated space */
 	size_t fordblks = 0;		/* Total non-inuse space */
+#ifdef CONFIG_MM_SLAB
+	size_t slabfree;		/* Free space cached by the slab layer */
+#endif
 #if CONFIG_MM_REGIONS > 1
 	int region;
 #else
@@ -136,6 +139,19 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
 
 	DEBUGASSERT(uordblks + fordblks == heap->mm_heapsize);
 
+#ifdef CONFIG_MM_SLAB
+	/* Free objects cached by the slab front-end are reported as free space
+	 * although the slab pages holding them are allocated heap chunks.
+	 */
+
+	mm_takesemaphore(heap);
+	slabfree = mm_slab_freebytes(heap);
+	mm_givesemaphore(heap);
+
+	uordblks -= slabfree;
+	fordblks += slabfree;
+#endif
+
 	info->arena    = heap->mm_heapsize;
 	info->ordblks  = ordblks;
 	info->mxordblk = mxordblk;
@@ -129,6 +129,24 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
 	size = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
 
+#ifdef CONFIG_MM_SLAB
+	/* Small requests are served by the slab front-end if possible.  If the
+	 * size class is exhausted, fall back to the normal heap.
+	 */
+
+	if (size <= MM_SLAB_MAXCHUNK && heap->mm_slab_enabled) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		ret = mm_slab_alloc(heap, size, caller_retaddr);
+#else
+		ret = mm_slab_alloc(heap, size);
+#endif
+		if (ret) {
+			mvdbg("Allocated %p from slab, size %u\n", ret, size);
+			return ret;
+		}
+	}
+#endif
+
 	/* We need to hold the MM semaphore while we muck with the nodelist. */
 
 	mm_takesemaphore(heap);
@@ -138,13 +156,31 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 	 */
 
 	if (size >= MM_MAX_CHUNK) {
-		ndx = MM_NNODES - 1;
+		ndx = MM_NLISTS - 1;
 	} else {
 		/* Convert the request size into a nodelist index */
 
 		ndx = mm_size2ndx(size);
 	}
 
+#ifdef CONFIG_MM_TLSF
+	/* The chunks in the list of the request's own size class may or may not
+	 * be large enough, so only the head of that list is checked.  Every chunk
+	 * in a list of a larger size class fits, so take the head of the first
+	 * non-empty one.  Only the last list, which holds all chunks of
+	 * MM_MAX_CHUNK and above, has to be searched.
+	 */
+
+	node = heap->mm_nodelist[ndx].flink;
+	if (ndx == MM_NLISTS - 1) {
+		for (; node && node->size < size; node = node->flink) ;
+	} else if (!node || node->size < size) {
+		ndx  = mm_findfreelist(heap, ndx + 1);
+		node = (ndx < 0) ? NULL : heap->mm_nodelist[ndx].flink;
+	}
+
+	/* If we found a node, then this is one to use. */
+#else
 	/* Search for a large enough chunk in the list of nodes. This list is
 	 * ordered by size, but will have occasional zero sized nodes as we visit
 	 * other mm_nodelist[] entries.
@@ -156,21 +192,16 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 	 * the list is ordered, we know that is must be best fitting chunk
 	 * available.
 	 */
+#endif
 
 	if (node) {
 		FAR struct mm_freenode_s *remainder;
 		FAR struct mm_freenode_s *next;
 		size_t remaining;
 
-		/* Remove the node.  There must be a predecessor, but there may not be
-		 * a successor node.
-		 */
+		/* Remove the node from the free list */
 
-		DEBUGASSERT(node->blink);
-		node->blink->flink = node->flink;
-		if (node->flink) {
-			node->flink->blink = node->blink;
-		}
+		mm_delfreechunk(heap, node);
 
 		/* Check if we have to split the free node into one of the allocated
 		 * size and another smaller freenode.  In some cases, the remaining
@@ -213,7 +244,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 		heapinfo_update_node((struct mm_allocnode_s *)node, caller_retaddr);
 		heapinfo_add_size(((struct mm_allocnode_s *)node)->pid, node->size);
-		heapinfo_update_total_size(heap, node->size, ((struct mm_allocnode_s *)node)->pid);
+		heapinfo_update_total_size(heap, node->size, (struct mm_allocnode_s *)node);
 #endif
 		ret = (void *)((char *)node + SIZEOF_MM_ALLOCNODE);
 	}
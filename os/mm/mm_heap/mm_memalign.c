@@ -123,6 +123,16 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 	size = MM_ALIGN_UP(size);	/* Make multiples of our granule size */
 	allocsize = size + 2 * alignment;	/* Add double full alignment size */
 
+#ifdef CONFIG_MM_SLAB
+	/* The raw chunk is split below, so it must be a real heap chunk and not
+	 * an object of the slab front-end.
+	 */
+
+	if (allocsize < MM_SLAB_MAXCHUNK) {
+		allocsize = MM_SLAB_MAXCHUNK;
+	}
+#endif
+
 	/* Then malloc that size */
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 	/*Passing Zero as caller addr to avoid adding memalloc info in malloc function,
@@ -149,7 +159,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 		heapinfo_subtract_size(node->pid, node->size);
-		heapinfo_update_total_size(heap, ((-1) * (node->size)), node->pid);
+		heapinfo_update_total_size(heap, ((-1) * (node->size)), node);
 #endif
 	/* Find the aligned subregion */
 
@@ -237,7 +247,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 	heapinfo_update_node(node, caller_retaddr);
 
 	heapinfo_add_size(node->pid, node->size);
-	heapinfo_update_total_size(heap, node->size, node->pid);
+	heapinfo_update_total_size(heap, node->size, node);
 #endif
 	mm_givesemaphore(heap);
 	return (FAR void *)alignedchunk;
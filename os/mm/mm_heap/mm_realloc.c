@@ -60,6 +60,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <assert.h>
+#include <errno.h>
 
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 #include <tinyara/sched.h>
@@ -70,10 +71,69 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* With CONFIG_MM_REALLOC_HEADROOM, a growing chunk is rounded up to one of
+ * the (1 << MM_REALLOC_CLASS_SHIFT) size classes that divide each power of
+ * two.  This leaves at most 25% of headroom for the next realloc().
+ */
+
+#define MM_REALLOC_CLASS_SHIFT 2
+
+#ifdef CONFIG_MM_REALLOC_STATS
+#define mm_realloc_stat(heap, field, n) ((heap)->mm_reallocstats.field += (n))
+#else
+#define mm_realloc_stat(heap, field, n)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: mm_realloc_headroom
+ *
+ * Description:
+ *   Return the chunk size to use for a chunk that grows to 'size'.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REALLOC_HEADROOM
+static size_t mm_realloc_headroom(size_t size)
+{
+	size_t step = MM_MIN_CHUNK;
+	size_t rounded;
+
+	while ((step << (MM_REALLOC_CLASS_SHIFT + 1)) <= size) {
+		step <<= 1;
+	}
+
+	rounded = (size + step - 1) & ~(step - 1);
+	return rounded < size ? size : rounded;
+}
+#else
+#define mm_realloc_headroom(size) (size)
+#endif
+
+/****************************************************************************
+ * Name: mm_realloc_copied
+ *
+ * Description:
+ *   Account a reallocation that copied 'nbytes' to a new chunk.  Called
+ *   without the MM semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REALLOC_STATS
+static void mm_realloc_copied(FAR struct mm_heap_s *heap, size_t nbytes)
+{
+	mm_takesemaphore(heap);
+	heap->mm_reallocstats.ncopy++;
+	heap->mm_reallocstats.copied += nbytes;
+	mm_givesemaphore(heap);
+}
+#else
+#define mm_realloc_copied(heap, nbytes)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -95,10 +155,18 @@
  *     (2) Taking the additional space from the preceding free chunk.
  *     (3) Or both
  *
+ *  The following chunk is used first because the data has to be moved down
+ *  with memmove() only when the preceding chunk is taken.
+ *
  *  If the request is for more space but the current chunk cannot be
  *  extended, then malloc a new buffer, copy the data into the new buffer,
  *  and free the old buffer.
  *
+ *  With CONFIG_MM_REALLOC_HEADROOM, a chunk that grows is rounded up to a
+ *  size class when there is room for it, so that a buffer that keeps
+ *  growing is extended less often.  A chunk that is no larger than the
+ *  rounded new size is not shrunk.
+ *
  ****************************************************************************/
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size, mmaddress_t caller_retaddr)
@@ -113,9 +181,11 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 #endif
 	size_t newsize;
 	size_t oldsize;
+	size_t copysize;
 #ifndef CONFIG_DISABLE_REALLOC_NEIGHBOR_EXTENSION
 	size_t prevsize = 0;
 	size_t nextsize = 0;
+	size_t roundsize;
 #endif
 	FAR void *newmem;
 
@@ -154,17 +224,46 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 
 	oldsize = oldnode->size;
 
+#ifdef CONFIG_MM_SLAB
+	/* A slab object has no neighbors in the heap.  It can only be kept as is
+	 * if the new size still fits in its size class.
+	 */
+
+	if (MM_IS_SLAB(oldnode)) {
+		if (newsize <= oldsize) {
+			mm_realloc_stat(heap, nkeep, 1);
+			mm_givesemaphore(heap);
+			return oldmem;
+		}
+
+		mm_givesemaphore(heap);
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		newmem = (FAR void *)mm_malloc(heap, size, caller_retaddr);
+#else
+		newmem = (FAR void *)mm_malloc(heap, size);
+#endif
+		if (newmem) {
+			copysize = oldsize - SIZEOF_MM_ALLOCNODE;
+			memcpy(newmem, oldmem, copysize);
+			mm_free(heap, oldmem);
+			mm_realloc_copied(heap, copysize);
+		}
+
+		return newmem;
+	}
+#endif
+
 #ifndef CONFIG_DISABLE_REALLOC_NEIGHBOR_EXTENSION
 	if (newsize <= oldsize) {
-		/* Handle the special case where we are not going to change the size
-		 * of the allocation.
+		/* Keep the chunk as is if its size does not change or if it is
+		 * within the headroom of the new size.
 		 */
 
-		if (newsize < oldsize) {
+		if (oldsize > mm_realloc_headroom(newsize)) {
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 			/* modify the current allocated size of old node */
 			heapinfo_subtract_size(oldnode->pid, oldsize);
-			heapinfo_update_total_size(heap, (-1) * oldsize, oldnode->pid);
+			heapinfo_update_total_size(heap, (-1) * oldsize, oldnode);
 #endif
 
 			mm_shrinkchunk(heap, oldnode, newsize);
@@ -173,12 +272,13 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 			heapinfo_update_node(oldnode, caller_retaddr);
 
 			heapinfo_add_size(oldnode->pid, oldnode->size);
-			heapinfo_update_total_size(heap, oldnode->size, oldnode->pid);
+			heapinfo_update_total_size(heap, oldnode->size, oldnode);
 #endif
 		}
 
 		/* Then return the original address */
 
+		mm_realloc_stat(heap, nkeep, 1);
 		mm_givesemaphore(heap);
 		return oldmem;
 	}
@@ -198,6 +298,16 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 		prevsize = prev->size;
 	}
 
+	/* Leave some headroom for the next request if the chunk can grow in
+	 * place with it.  The headroom must not push a growth that fits in the
+	 * next chunk into the previous one, which moves the data.
+	 */
+
+	roundsize = mm_realloc_headroom(newsize);
+	if (nextsize + oldsize >= roundsize) {
+		newsize = roundsize;
+	}
+
 	/* Now, check if we can extend the current allocation or not */
 
 	if (nextsize + prevsize + oldsize >= newsize) {
@@ -208,53 +318,20 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 		/* modify the current allocated size of old node */
 		heapinfo_subtract_size(oldnode->pid, oldsize);
-		heapinfo_update_total_size(heap, (-1) * oldsize, oldnode->pid);
+		heapinfo_update_total_size(heap, (-1) * oldsize, oldnode);
 #endif
 
-		/* Check if we can extend into the previous chunk and if the
-		 * previous chunk is smaller than the next chunk.
+		/* Take what we can from the next chunk.  Only the rest, if any, is
+		 * taken from the previous chunk because extending into the
+		 * previous chunk moves the data.
 		 */
 
-		if (prevsize > 0 && (nextsize >= prevsize || nextsize < 1)) {
-			/* Can we get everything we need from the previous chunk? */
-
-			if (needed > prevsize) {
-				/* No, take the whole previous chunk and get the
-				 * rest that we need from the next chunk.
-				 */
-
-				takeprev = prevsize;
-				takenext = needed - prevsize;
-			} else {
-				/* Yes, take what we need from the previous chunk */
-
-				takeprev = needed;
-				takenext = 0;
-			}
-
-			needed = 0;
-		}
-
-		/* Check if we can extend into the next chunk and if we still need
-		 * more memory.
-		 */
-
-		if (nextsize > 0 && needed) {
-			/* Can we get everything we need from the next chunk? */
-
-			if (needed > nextsize) {
-				/* No, take the whole next chunk and get the rest that we
-				 * need from the previous chunk.
-				 */
-
-				takeprev = needed - nextsize;
-				takenext = nextsize;
-			} else {
-				/* Yes, take what we need from the previous chunk */
-
-				takeprev = 0;
-				takenext = needed;
-			}
+		if (needed > nextsize) {
+			takenext = nextsize;
+			takeprev = needed - nextsize;
+		} else {
+			takenext = needed;
+			takeprev = 0;
 		}
 
 		/* Extend into the previous free chunk */
@@ -263,15 +340,13 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 		if (takeprev) {
 			FAR struct mm_allocnode_s *newnode;
 
-			/* Remove the previous node.  There must be a predecessor, but
-			 * there may not be a successor node.
-			 */
+			/* The data to move is the old payload only */
 
-			DEBUGASSERT(prev->blink);
-			prev->blink->flink = prev->flink;
-			if (prev->flink) {
-				prev->flink->blink = prev->blink;
-			}
+			copysize = oldsize - SIZEOF_MM_ALLOCNODE;
+
+			/* Remove the previous node from the free list */
+
+			mm_delfreechunk(heap, prev);
 
 			/* Extend the node into the previous free chunk */
 			/* Did we consume the entire preceding chunk? */
@@ -301,12 +376,17 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 			oldnode = newnode;
 			oldsize = newnode->size;
 
-			/* Now we have to move the user contents 'down' in memory.  memcpy should
-			 * should be save for this.
+			/* Now we have to move the user contents 'down' in memory.  The
+			 * old and the new location overlap if less than the payload size
+			 * was taken, so this needs memmove().
 			 */
 
 			newmem = (FAR void *)((FAR char *)newnode + SIZEOF_MM_ALLOCNODE);
-			memcpy(newmem, oldmem, oldsize - SIZEOF_MM_ALLOCNODE);
+			memmove(newmem, oldmem, copysize);
+			mm_realloc_stat(heap, nmove, 1);
+			mm_realloc_stat(heap, copied, copysize);
+		} else {
+			mm_realloc_stat(heap, ngrow, 1);
 		}
 
 		/* Extend into the next free chunk */
@@ -321,15 +401,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 
 			andbeyond = (FAR struct mm_allocnode_s *)((char *)next + nextsize);
 
-			/* Remove the next node.  There must be a predecessor, but there
-			 * may not be a successor node.
-			 */
+			/* Remove the next node from the free list */
 
-			DEBUGASSERT(next->blink);
-			next->blink->flink = next->flink;
-			if (next->flink) {
-				next->flink->blink = next->blink;
-			}
+			mm_delfreechunk(heap, next);
 
 			/* Extend the node into the next chunk */
 			/* Did we consume the entire preceding chunk? */
@@ -359,7 +433,7 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 		heapinfo_update_node(oldnode, caller_retaddr);
 
 		heapinfo_add_size(oldnode->pid, oldnode->size);
-		heapinfo_update_total_size(heap, oldnode->size, oldnode->pid);
+		heapinfo_update_total_size(heap, oldnode->size, oldnode);
 #endif
 
 		mm_givesemaphore(heap);
@@ -375,16 +449,68 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 		 * leave the original memory in place.
 		 */
 		mm_givesemaphore(heap);
+
+		newmem = NULL;
+#ifdef CONFIG_MM_REALLOC_HEADROOM
+		/* Try to get the headroom for a growing buffer first */
+
+		if (newsize > oldsize && mm_realloc_headroom(newsize) > newsize) {
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
-		newmem = (FAR void *)mm_malloc(heap, size, caller_retaddr);
+			newmem = (FAR void *)mm_malloc(heap, mm_realloc_headroom(newsize) - SIZEOF_MM_ALLOCNODE, caller_retaddr);
 #else
-		newmem = (FAR void *)mm_malloc(heap, size);
+			newmem = (FAR void *)mm_malloc(heap, mm_realloc_headroom(newsize) - SIZEOF_MM_ALLOCNODE);
+#endif
+		}
+
+		if (!newmem)
+#endif
+		{
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+			newmem = (FAR void *)mm_malloc(heap, size, caller_retaddr);
+#else
+			newmem = (FAR void *)mm_malloc(heap, size);
 #endif
+		}
+
 		if (newmem) {
-			memcpy(newmem, oldmem, oldsize);
+			/* Copy the old payload, but never more than the new size */
+
+			copysize = oldsize - SIZEOF_MM_ALLOCNODE;
+			if (copysize > size) {
+				copysize = size;
+			}
+
+			memcpy(newmem, oldmem, copysize);
 			mm_free(heap, oldmem);
+			mm_realloc_copied(heap, copysize);
 		}
 
 		return newmem;
 	}
 }
+
+/****************************************************************************
+ * Name: mm_reallocinfo
+ *
+ * Description:
+ *   Return the realloc() statistics of the selected heap.
+ *
+ * Return Value:
+ *   OK on success; -EINVAL if 'info' is NULL.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REALLOC_STATS
+int mm_reallocinfo(FAR struct mm_heap_s *heap, FAR struct mm_reallocinfo_s *info)
+{
+	if (info == NULL) {
+		return -EINVAL;
+	}
+
+	mm_takesemaphore(heap);
+	memcpy(info, &heap->mm_reallocstats, sizeof(struct mm_reallocinfo_s));
+	mm_givesemaphore(heap);
+
+	return OK;
+}
+#endif
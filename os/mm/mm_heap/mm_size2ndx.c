@@ -70,16 +70,20 @@
  * Name: mm_size2ndx
  *
  * Description:
- *    Convert the size to a nodelist index.
+ *    Convert the size to a nodelist index.  With CONFIG_MM_TLSF, the index
+ *    combines the first and the second level size classes.
  *
  ****************************************************************************/
 
 int mm_size2ndx(size_t size)
 {
 	int ndx = 0;
+#ifdef CONFIG_MM_TLSF
+	size_t chunk = size;
+#endif
 
 	if (size >= MM_MAX_CHUNK) {
-		return MM_NNODES - 1;
+		return MM_NLISTS - 1;
 	}
 
 	size >>= MM_MIN_SHIFT;
@@ -88,5 +92,13 @@ int mm_size2ndx(size_t size)
 		size >>= 1;
 	}
 
+#ifdef CONFIG_MM_TLSF
+	/* The second level index is given by the MM_SL_SHIFT bits following the
+	 * most significant bit of the size.
+	 */
+
+	ndx = (ndx << MM_SL_SHIFT) + ((chunk >> (ndx + MM_MIN_SHIFT - MM_SL_SHIFT)) & (MM_SLCOUNT - 1));
+#endif
+
 	return ndx;
 }
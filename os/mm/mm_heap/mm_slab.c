@@ -0,0 +1,474 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/mm_heap/mm_slab.c
+ *
+ * Size-class front-end for small allocations.  Each size class keeps a
+ * singly linked list of fixed-size objects carved out of slab pages, which
+ * are themselves ordinary chunks allocated from the same heap.  Allocation
+ * and release of a slab object are O(1) and never split or coalesce heap
+ * chunks.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <tinyara/mm/mm.h>
+
+#ifdef CONFIG_MM_SLAB
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The link to the next free object is kept in the payload of the object */
+
+#define MM_SLAB_NEXT(n) \
+	(*(FAR struct mm_allocnode_s **)((FAR char *)(n) + SIZEOF_MM_ALLOCNODE))
+
+/* The size of a slab page.  A page holds at least two objects of the
+ * largest size class.  This also makes the page request larger than
+ * MM_SLAB_MAXCHUNK, so that mm_malloc() never serves it from the slab.
+ */
+
+#define MM_SLAB_PAGESIZE \
+	(CONFIG_MM_SLAB_PAGESIZE >= 2 * MM_SLAB_MAXCHUNK ? \
+	 CONFIG_MM_SLAB_PAGESIZE : 2 * MM_SLAB_MAXCHUNK)
+
+#ifdef CONFIG_MM_COMPACT
+/* Words of the bitmap of the free objects of one slab page.  A page may be
+ * a little larger than MM_SLAB_PAGESIZE if the heap did not split off the
+ * remainder of the chunk.
+ */
+
+#define MM_SLAB_MAPWORDS \
+	(((MM_SLAB_PAGESIZE + SIZEOF_MM_FREENODE) / MM_MIN_CHUNK + 31) / 32)
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_slab_grow
+ *
+ * Description:
+ *   Allocate one more slab page from the heap and carve it into free
+ *   objects of the given size class.  It is assumed that the caller holds
+ *   the mm semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+static int mm_slab_grow(FAR struct mm_heap_s *heap, FAR struct mm_slabclass_s *slab, size_t size, mmaddress_t caller_retaddr)
+#else
+static int mm_slab_grow(FAR struct mm_heap_s *heap, FAR struct mm_slabclass_s *slab, size_t size)
+#endif
+{
+	FAR struct mm_allocnode_s *page;
+	FAR struct mm_allocnode_s *node;
+	FAR char *mem;
+	size_t usable;
+	size_t offset;
+
+	if (slab->npages >= CONFIG_MM_SLAB_MAXPAGES) {
+		return -ENOMEM;
+	}
+
+	/* The page is larger than MM_SLAB_MAXCHUNK (see MM_SLAB_PAGESIZE), so
+	 * this never recurses into the slab layer.
+	 */
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	mem = (FAR char *)mm_malloc(heap, MM_SLAB_PAGESIZE, caller_retaddr);
+#else
+	mem = (FAR char *)mm_malloc(heap, MM_SLAB_PAGESIZE);
+#endif
+	if (mem == NULL) {
+		return -ENOMEM;
+	}
+
+	page = (FAR struct mm_allocnode_s *)(mem - SIZEOF_MM_ALLOCNODE);
+	usable = page->size - SIZEOF_MM_ALLOCNODE;
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	/* The page itself is not charged to anyone.  Each object is charged to
+	 * its owner when it is handed out instead.
+	 */
+
+	heapinfo_subtract_size(page->pid, page->size);
+	heapinfo_update_total_size(heap, (-1) * page->size, page);
+#endif
+
+	for (offset = 0; offset + size <= usable; offset += size) {
+		node            = (FAR struct mm_allocnode_s *)(mem + offset);
+		node->size      = size;
+		node->preceding = MM_SLAB_BIT;
+
+		MM_SLAB_NEXT(node) = slab->freelist;
+		slab->freelist     = node;
+		slab->nfree++;
+	}
+
+#ifdef CONFIG_MM_COMPACT
+	slab->pages[slab->npages] = page;
+#endif
+	slab->npages++;
+	mvdbg("slab %u: page %p, total %d pages\n", size, page, slab->npages);
+	return OK;
+}
+
+#ifdef CONFIG_MM_COMPACT
+/****************************************************************************
+ * Name: mm_slab_unlink
+ *
+ * Description:
+ *   Remove the free objects between 'start' and 'end' from the free list of
+ *   the size class.  It is assumed that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+static void mm_slab_unlink(FAR struct mm_slabclass_s *slab, FAR char *start, FAR char *end)
+{
+	FAR struct mm_allocnode_s **link;
+	FAR struct mm_allocnode_s *node;
+
+	for (link = &slab->freelist; *link != NULL;) {
+		node = *link;
+		if ((FAR char *)node >= start && (FAR char *)node < end) {
+			*link = MM_SLAB_NEXT(node);
+			slab->nfree--;
+		} else {
+			link = &MM_SLAB_NEXT(node);
+		}
+	}
+}
+
+/****************************************************************************
+ * Name: mm_slab_trim
+ *
+ * Description:
+ *   Return the free objects at the end of slab page 'ndx' to the heap, or
+ *   the whole page if none of its objects is in use.  It is assumed that
+ *   the caller holds the mm semaphore.
+ *
+ * Return Value:
+ *   The number of bytes returned to the heap.
+ *
+ ****************************************************************************/
+
+static size_t mm_slab_trim(FAR struct mm_heap_s *heap, FAR struct mm_slabclass_s *slab, size_t size, int ndx)
+{
+	uint32_t freemap[MM_SLAB_MAPWORDS];
+	FAR struct mm_allocnode_s *page = slab->pages[ndx];
+	FAR struct mm_allocnode_s *node;
+	FAR struct mm_freenode_s *next;
+	FAR char *mem = (FAR char *)page + SIZEOF_MM_ALLOCNODE;
+	FAR char *end = (FAR char *)page + page->size;
+	size_t oldsize = page->size;
+	size_t newsize;
+	int nobjs;
+	int nused;
+	int obj;
+
+	/* Find the free objects of this page */
+
+	memset(freemap, 0, sizeof(freemap));
+	for (node = slab->freelist; node != NULL; node = MM_SLAB_NEXT(node)) {
+		if ((FAR char *)node >= mem && (FAR char *)node < end) {
+			obj = ((FAR char *)node - mem) / size;
+			freemap[obj >> 5] |= (uint32_t)1 << (obj & 31);
+		}
+	}
+
+	/* The objects up to the last one in use must be kept */
+
+	nobjs = (page->size - SIZEOF_MM_ALLOCNODE) / size;
+	DEBUGASSERT(nobjs <= MM_SLAB_MAPWORDS * 32);
+
+	for (nused = nobjs; nused > 0; nused--) {
+		obj = nused - 1;
+		if ((freemap[obj >> 5] & ((uint32_t)1 << (obj & 31))) == 0) {
+			break;
+		}
+	}
+
+	if (nused == 0) {
+		/* Nothing is in use.  Release the whole page.  It is not charged to
+		 * anyone (see mm_slab_grow()), but mm_free() will uncharge it.
+		 */
+
+		mm_slab_unlink(slab, mem, end);
+
+		slab->npages--;
+		slab->pages[ndx] = slab->pages[slab->npages];
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		heapinfo_add_size(page->pid, page->size);
+		heapinfo_update_total_size(heap, page->size, page);
+#endif
+		mm_free(heap, mem);
+		return oldsize;
+	}
+
+	/* Shrink the page to the objects in use.  mm_shrinkchunk() only splits
+	 * off the tail if it is large enough for a free node or if the next
+	 * chunk is free, and the tail objects may only be unlinked then.
+	 */
+
+	newsize = MM_ALIGN_UP(SIZEOF_MM_ALLOCNODE + nused * size);
+	next    = (FAR struct mm_freenode_s *)end;
+	if (newsize >= oldsize || ((next->preceding & MM_ALLOC_BIT) != 0 && oldsize < newsize + SIZEOF_MM_FREENODE)) {
+		return 0;
+	}
+
+	mm_slab_unlink(slab, mem + nused * size, end);
+	mm_shrinkchunk(heap, page, newsize);
+
+	DEBUGASSERT(page->size == newsize);
+	return oldsize - newsize;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_slab_initialize
+ *
+ * Description:
+ *   Initialize the slab size classes of the selected heap.  The slab layer
+ *   is enabled by default.
+ *
+ ****************************************************************************/
+
+void mm_slab_initialize(FAR struct mm_heap_s *heap)
+{
+	memset(heap->mm_slab, 0, sizeof(heap->mm_slab));
+	heap->mm_slab_enabled = true;
+}
+
+/****************************************************************************
+ * Name: mm_slab_enable
+ *
+ * Description:
+ *   Enable or disable the slab front-end of the selected heap.  While
+ *   disabled, new small allocations go to the heap directly.  Objects that
+ *   are already allocated from the slab layer are still released to it.
+ *
+ ****************************************************************************/
+
+void mm_slab_enable(FAR struct mm_heap_s *heap, bool enable)
+{
+	mm_takesemaphore(heap);
+	heap->mm_slab_enabled = enable;
+	mm_givesemaphore(heap);
+}
+
+/****************************************************************************
+ * Name: mm_slab_alloc
+ *
+ * Description:
+ *   Allocate one object of the size class matching 'size', which is the
+ *   chunk size including the allocnode and aligned to MM_MIN_CHUNK.
+ *
+ * Return Value:
+ *   The address of the allocated memory or NULL if the class is exhausted
+ *   and no more slab pages can be allocated.  The caller should then fall
+ *   back to the normal heap.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR void *mm_slab_alloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr)
+#else
+FAR void *mm_slab_alloc(FAR struct mm_heap_s *heap, size_t size)
+#endif
+{
+	FAR struct mm_slabclass_s *slab;
+	FAR struct mm_allocnode_s *node;
+
+	DEBUGASSERT(size >= MM_MIN_CHUNK && size <= MM_SLAB_MAXCHUNK);
+
+	slab = &heap->mm_slab[MM_SLAB_NDX(size)];
+
+	mm_takesemaphore(heap);
+
+	if (slab->freelist == NULL) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		if (mm_slab_grow(heap, slab, size, caller_retaddr) < 0)
+#else
+		if (mm_slab_grow(heap, slab, size) < 0)
+#endif
+		{
+			slab->nmisses++;
+			mm_givesemaphore(heap);
+			return NULL;
+		}
+	}
+
+	/* Take the first free object */
+
+	node           = slab->freelist;
+	slab->freelist = MM_SLAB_NEXT(node);
+	slab->nfree--;
+	slab->nused++;
+	slab->nallocs++;
+
+	node->preceding |= MM_ALLOC_BIT;
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	heapinfo_update_node(node, caller_retaddr);
+	heapinfo_add_size(node->pid, node->size);
+	heapinfo_update_total_size(heap, node->size, node);
+#endif
+
+	mm_givesemaphore(heap);
+	return (FAR void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
+}
+
+/****************************************************************************
+ * Name: mm_slab_free
+ *
+ * Description:
+ *   Return a slab object to the free list of its size class.  It is
+ *   assumed that the caller holds the mm semaphore and has already updated
+ *   the heapinfo accounting of the object.
+ *
+ ****************************************************************************/
+
+void mm_slab_free(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node)
+{
+	FAR struct mm_slabclass_s *slab;
+
+	DEBUGASSERT(MM_IS_SLAB(node) && node->size <= MM_SLAB_MAXCHUNK);
+
+	slab = &heap->mm_slab[MM_SLAB_NDX(node->size)];
+
+	node->preceding &= ~MM_ALLOC_BIT;
+
+	MM_SLAB_NEXT(node) = slab->freelist;
+	slab->freelist     = node;
+	slab->nfree++;
+	slab->nused--;
+}
+
+/****************************************************************************
+ * Name: mm_slab_info
+ *
+ * Description:
+ *   Return the statistics of one slab size class.
+ *
+ * Return Value:
+ *   OK on success; -EINVAL if 'ndx' is not a valid size class.
+ *
+ ****************************************************************************/
+
+int mm_slab_info(FAR struct mm_heap_s *heap, int ndx, FAR struct mm_slabinfo_s *info)
+{
+	FAR struct mm_slabclass_s *slab;
+
+	if (ndx < 0 || ndx >= MM_SLAB_NCLASSES || info == NULL) {
+		return -EINVAL;
+	}
+
+	slab = &heap->mm_slab[ndx];
+
+	mm_takesemaphore(heap);
+	info->chunksize = MM_SLAB_CHUNK(ndx);
+	info->npages    = slab->npages;
+	info->nused     = slab->nused;
+	info->nfree     = slab->nfree;
+	info->nallocs   = slab->nallocs;
+	info->nmisses   = slab->nmisses;
+	mm_givesemaphore(heap);
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: mm_slab_freebytes
+ *
+ * Description:
+ *   Return the number of bytes held by free slab objects.  It is assumed
+ *   that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+size_t mm_slab_freebytes(FAR struct mm_heap_s *heap)
+{
+	size_t freebytes = 0;
+	int ndx;
+
+	for (ndx = 0; ndx < MM_SLAB_NCLASSES; ndx++) {
+		freebytes += heap->mm_slab[ndx].nfree * MM_SLAB_CHUNK(ndx);
+	}
+
+	return freebytes;
+}
+
+#ifdef CONFIG_MM_COMPACT
+/****************************************************************************
+ * Name: mm_slab_compact
+ *
+ * Description:
+ *   Return the unused memory of the slab pages to the heap.  Pages without
+ *   objects in use are freed and the free objects at the end of the other
+ *   pages are cut off.  Objects in use are never moved.
+ *
+ * Return Value:
+ *   The number of bytes returned to the heap.
+ *
+ ****************************************************************************/
+
+size_t mm_slab_compact(FAR struct mm_heap_s *heap)
+{
+	FAR struct mm_slabclass_s *slab;
+	size_t released = 0;
+	int ndx;
+	int page;
+
+	for (ndx = 0; ndx < MM_SLAB_NCLASSES; ndx++) {
+		slab = &heap->mm_slab[ndx];
+
+		/* Retake the semaphore for each size class to reduce latencies */
+
+		mm_takesemaphore(heap);
+
+		for (page = slab->npages - 1; page >= 0 && slab->nfree > 0; page--) {
+			released += mm_slab_trim(heap, slab, MM_SLAB_CHUNK(ndx), page);
+		}
+
+		mm_givesemaphore(heap);
+	}
+
+	return released;
+}
+#endif
+
+#endif							/* CONFIG_MM_SLAB */
@@ -0,0 +1,84 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/umm_heap/umm_arena.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <tinyara/mm/mm.h>
+
+#if defined(CONFIG_MM_ARENA) && (!defined(CONFIG_BUILD_PROTECTED) || !defined(__KERNEL__))
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_ARCH_ADDRENV) && defined(CONFIG_BUILD_KERNEL)
+/* In the kernel build, there a multiple user heaps; one for each task
+ * group.  In this build configuration, the user heap structure lies
+ * in a reserved region at the beginning of the .bss/.data address
+ * space (CONFIG_ARCH_DATA_VBASE).  The size of that region is given by
+ * ARCH_DATA_RESERVE_SIZE
+ */
+
+#include <tinyara/addrenv.h>
+#define USR_HEAP (&ARCH_DATA_RESERVE->ar_usrheap)
+
+#else
+/* Otherwise, the user heap data structures are in common .bss */
+
+#define USR_HEAP &g_mmheap
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: umm_arena_create
+ *
+ * Description:
+ *   Create an arena on the user heap.  Memory is allocated from it with
+ *   mm_arena_alloc() and released at once with mm_arena_reset() or
+ *   mm_arena_destroy().
+ *
+ * Input Parameters:
+ *   blksize - The size of the blocks taken from the heap.  It should be
+ *             large enough for the usage of one reset cycle.
+ *
+ * Return Value:
+ *   The new arena or NULL if there is not enough memory.
+ *
+ ****************************************************************************/
+
+FAR struct mm_arena_s *umm_arena_create(size_t blksize)
+{
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	ARCH_GET_RET_ADDRESS
+	return mm_arena_create(USR_HEAP, blksize, retaddr);
+#else
+	return mm_arena_create(USR_HEAP, blksize);
+#endif
+}
+
+#endif							/* CONFIG_MM_ARENA && (!CONFIG_BUILD_PROTECTED || !__KERNEL__) */
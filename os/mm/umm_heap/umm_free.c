@@ -102,6 +102,16 @@
 
 void free(FAR void *mem)
 {
+#ifdef CONFIG_MM_TLCACHE
+	/* Keep the chunk in the allocation cache of the calling thread if it
+	 * has one and there is room for this size.
+	 */
+
+	if (umm_tlcache_free(mem)) {
+		return;
+	}
+#endif
+
 	mm_free(USR_HEAP, mem);
 }
 
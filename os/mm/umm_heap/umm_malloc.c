@@ -147,6 +147,17 @@ FAR void *malloc(size_t size)
 
 	return mem;
 #else
+#ifdef CONFIG_MM_TLCACHE
+	FAR void *mem;
+
+	/* Try the allocation cache of the calling thread first */
+
+	mem = umm_tlcache_alloc(size);
+	if (mem) {
+		return mem;
+	}
+#endif
+
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 	ARCH_GET_RET_ADDRESS
 	return mm_malloc(USR_HEAP, size, retaddr);
@@ -116,4 +116,22 @@ FAR void *realloc(FAR void *oldmem, size_t size)
 #endif
 }
 
+/****************************************************************************
+ * Name: umm_reallocinfo
+ *
+ * Description:
+ *   Return the realloc() statistics of the user heap.
+ *
+ * Return Value:
+ *   OK on success; -EINVAL if 'info' is NULL.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REALLOC_STATS
+int umm_reallocinfo(FAR struct mm_reallocinfo_s *info)
+{
+	return mm_reallocinfo(USR_HEAP, info);
+}
+#endif
+
 #endif							/* !CONFIG_BUILD_PROTECTED || !__KERNEL__ */
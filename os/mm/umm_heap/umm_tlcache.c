@@ -0,0 +1,304 @@
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/umm_heap/umm_tlcache.c
+ *
+ * Per-thread allocation caches for the user heap.  A thread that opts in
+ * keeps a small "magazine" of recently freed chunks per size class.  Its
+ * malloc() and free() calls of those sizes are then served from the
+ * magazine without taking the heap semaphore.  Only the owning thread
+ * touches its magazine, so no locking is needed.  The cached chunks stay
+ * allocated from the point of view of the heap and are returned to it when
+ * the thread disables its cache or exits.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/sched.h>
+#include <tinyara/mm/mm.h>
+
+#ifdef CONFIG_MM_TLCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Per-thread caches are only supported in the flat build where the user
+ * heap is the global g_mmheap.
+ */
+
+#define USR_HEAP &g_mmheap
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The caches of the exited threads that could not be drained yet */
+
+static FAR struct mm_tlcache_s *g_tlcache_orphans;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: umm_tlcache_self
+ *
+ * Description:
+ *   Return the cache of the calling thread or NULL if it has none or if
+ *   called from interrupt level.
+ *
+ ****************************************************************************/
+
+static inline FAR struct mm_tlcache_s *umm_tlcache_self(void)
+{
+	FAR struct tcb_s *rtcb;
+
+	if (up_interrupt_context()) {
+		return NULL;
+	}
+
+	rtcb = sched_self();
+	return rtcb ? rtcb->tlcache : NULL;
+}
+
+/****************************************************************************
+ * Name: umm_tlcache_drain
+ *
+ * Description:
+ *   Return all chunks held by a cache to the heap.  They are released with
+ *   mm_free() and not free(), which would put them into the cache of the
+ *   calling thread.
+ *
+ ****************************************************************************/
+
+static void umm_tlcache_drain(FAR struct mm_tlcache_s *cache)
+{
+	int ndx;
+
+	for (ndx = 0; ndx < MM_TLCACHE_NCLASSES; ndx++) {
+		while (cache->ncached[ndx] > 0) {
+			mm_free(USR_HEAP, cache->cached[ndx][--cache->ncached[ndx]]);
+		}
+	}
+}
+
+/****************************************************************************
+ * Name: umm_tlcache_reap
+ *
+ * Description:
+ *   Drain and free the caches of the exited threads if the heap semaphore
+ *   can be taken without waiting.  Otherwise they are left for the next
+ *   call.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+static void umm_tlcache_reap(void)
+{
+	FAR struct mm_tlcache_s *cache;
+
+	if (g_tlcache_orphans == NULL || up_interrupt_context() || mm_trysemaphore(USR_HEAP) != OK) {
+		return;
+	}
+
+	while ((cache = g_tlcache_orphans) != NULL) {
+		g_tlcache_orphans = cache->flink;
+		umm_tlcache_drain(cache);
+		mm_free(USR_HEAP, cache);
+	}
+
+	mm_givesemaphore(USR_HEAP);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: umm_tlcache_enable
+ *
+ * Description:
+ *   Enable or disable the allocation cache of the calling thread.  When
+ *   disabled, the cached chunks are returned to the heap.
+ *
+ * Return Value:
+ *   OK on success; -ENOMEM if the cache could not be allocated; -EPERM if
+ *   called from interrupt level.
+ *
+ ****************************************************************************/
+
+int umm_tlcache_enable(bool enable)
+{
+	FAR struct tcb_s *rtcb;
+	FAR struct mm_tlcache_s *cache;
+	irqstate_t flags;
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	ARCH_GET_RET_ADDRESS
+#endif
+
+	if (up_interrupt_context()) {
+		return -EPERM;
+	}
+
+	rtcb = sched_self();
+
+	if (enable && rtcb->tlcache == NULL) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		cache = (FAR struct mm_tlcache_s *)mm_zalloc(USR_HEAP, sizeof(struct mm_tlcache_s), retaddr);
+#else
+		cache = (FAR struct mm_tlcache_s *)mm_zalloc(USR_HEAP, sizeof(struct mm_tlcache_s));
+#endif
+		if (cache == NULL) {
+			return -ENOMEM;
+		}
+
+		rtcb->tlcache = cache;
+	} else if (!enable && rtcb->tlcache != NULL) {
+		cache = rtcb->tlcache;
+		rtcb->tlcache = NULL;
+
+		umm_tlcache_drain(cache);
+		mm_free(USR_HEAP, cache);
+	}
+
+	flags = irqsave();
+	umm_tlcache_reap();
+	irqrestore(flags);
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: umm_tlcache_alloc
+ *
+ * Description:
+ *   Take a chunk of the requested size from the cache of the calling
+ *   thread.
+ *
+ * Return Value:
+ *   The address of the memory or NULL if the calling thread has no cache
+ *   or no chunk of this size is cached.
+ *
+ ****************************************************************************/
+
+FAR void *umm_tlcache_alloc(size_t size)
+{
+	FAR struct mm_tlcache_s *cache = umm_tlcache_self();
+	int ndx;
+
+	if (cache == NULL || size < 1 || size > CONFIG_MM_TLCACHE_MAXSIZE) {
+		return NULL;
+	}
+
+	ndx = MM_TLCACHE_NDX(MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE));
+	if (cache->ncached[ndx] == 0) {
+		cache->nmisses++;
+		return NULL;
+	}
+
+	cache->nhits++;
+	return cache->cached[ndx][--cache->ncached[ndx]];
+}
+
+/****************************************************************************
+ * Name: umm_tlcache_free
+ *
+ * Description:
+ *   Put a chunk into the cache of the calling thread instead of releasing
+ *   it to the heap.
+ *
+ * Return Value:
+ *   true if the chunk was cached; false if it must be released to the heap.
+ *
+ ****************************************************************************/
+
+bool umm_tlcache_free(FAR void *mem)
+{
+	FAR struct mm_tlcache_s *cache = umm_tlcache_self();
+	FAR struct mm_allocnode_s *node;
+	int ndx;
+
+	if (cache == NULL || mem == NULL) {
+		return false;
+	}
+
+	/* The chunk is allocated and owned by the caller, so its size can be
+	 * read without holding the heap semaphore.
+	 */
+
+	node = (FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+	DEBUGASSERT((node->preceding & MM_ALLOC_BIT) != 0);
+
+	if (node->size > MM_TLCACHE_MAXCHUNK) {
+		return false;
+	}
+
+	ndx = MM_TLCACHE_NDX(node->size);
+	if (cache->ncached[ndx] >= CONFIG_MM_TLCACHE_DEPTH) {
+		return false;
+	}
+
+	cache->cached[ndx][cache->ncached[ndx]++] = mem;
+	return true;
+}
+
+/****************************************************************************
+ * Name: umm_tlcache_release
+ *
+ * Description:
+ *   Return the chunks cached by a thread and the cache itself to the heap.
+ *   This is called when the TCB of the thread is released, possibly with
+ *   interrupts disabled where the heap semaphore can't be waited for.  If
+ *   the heap is busy, the cache is kept until a later release or
+ *   umm_tlcache_enable() call finds the heap free.
+ *
+ ****************************************************************************/
+
+void umm_tlcache_release(FAR struct tcb_s *tcb)
+{
+	FAR struct mm_tlcache_s *cache = tcb->tlcache;
+	irqstate_t flags;
+
+	flags = irqsave();
+	if (cache != NULL) {
+		mvdbg("pid %d: %u hits, %u misses\n", tcb->pid, cache->nhits, cache->nmisses);
+
+		tcb->tlcache = NULL;
+		cache->flink = g_tlcache_orphans;
+		g_tlcache_orphans = cache;
+	}
+
+	umm_tlcache_reap();
+	irqrestore(flags);
+}
+
+#endif							/* CONFIG_MM_TLCACHE */
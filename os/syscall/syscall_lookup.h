@@ -287,6 +287,10 @@ SYSCALL_LOOKUP(mq_setattr,              3, STUB_mq_setattr)
 SYSCALL_LOOKUP(mq_timedreceive,         5, STUB_mq_timedreceive)
 SYSCALL_LOOKUP(mq_timedsend,            5, STUB_mq_timedsend)
 SYSCALL_LOOKUP(mq_unlink,               1, STUB_mq_unlink)
+#ifdef CONFIG_MQ_ZEROCOPY
+SYSCALL_LOOKUP(mq_receivebuf,           3, STUB_mq_receivebuf)
+SYSCALL_LOOKUP(mq_sendbuf,              4, STUB_mq_sendbuf)
+#endif
 #endif
 
 /* The following are defined only if environment variables are supported */
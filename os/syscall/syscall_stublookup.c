@@ -311,6 +311,10 @@ uintptr_t STUB_mq_timedreceive(int nbr, uintptr_t parm1, uintptr_t parm2,
 uintptr_t STUB_mq_timedsend(int nbr, uintptr_t parm1, uintptr_t parm2,
 							uintptr_t parm3, uintptr_t parm4, uintptr_t parm5);
 uintptr_t STUB_mq_unlink(int nbr, uintptr_t parm1);
+uintptr_t STUB_mq_receivebuf(int nbr, uintptr_t parm1, uintptr_t parm2,
+							 uintptr_t parm3);
+uintptr_t STUB_mq_sendbuf(int nbr, uintptr_t parm1, uintptr_t parm2,
+						  uintptr_t parm3, uintptr_t parm4);
 
 /* The following are defined only if environment variables are supported */
 